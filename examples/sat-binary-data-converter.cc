@@ -0,0 +1,152 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2016 Magister Solutions Ltd.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: agent <agent@local>
+ *
+ */
+
+#include <list>
+#include <map>
+#include "ns3/core-module.h"
+#include "ns3/system-path.h"
+#include "ns3/singleton.h"
+#include "ns3/satellite-env-variables.h"
+#include "ns3/satellite-binary-data-file.h"
+#include "ns3/satellite-antenna-gain-pattern.h"
+#include "ns3/satellite-look-up-table.h"
+#include "ns3/satellite-base-trace-container.h"
+#include "ns3/satellite-input-fstream-time-double-container.h"
+
+/**
+ * \file sat-binary-data-converter.cc
+ * \ingroup satellite
+ * \brief Converts the antenna pattern, link results and input trace text files to binary data files.
+ *
+ * The binary data file of each text file is written to the same directory with
+ * .bin extension. The input traces are the rx power, interference and fading
+ * traces in the input directories of the trace data directories. The binary
+ * files are used automatically by the satellite module instead of parsing
+ * the text files, as long as they are not older than the corresponding text
+ * files. Thus, the converter needs to be run again after
+ * modifying the text files.
+ *
+ * This example can be run as it is, without any argument, i.e.:
+ *
+ *     $ ./waf --run="sat-binary-data-converter"
+ */
+
+using namespace ns3;
+
+NS_LOG_COMPONENT_DEFINE ("sat-binary-data-converter");
+
+/**
+ * \brief Check whether a file name has a given prefix and .txt extension
+ * \param fileName File name
+ * \param prefix Required prefix
+ * \return true, if the file name matches, otherwise false
+ */
+static bool
+IsTextFile (std::string fileName, std::string prefix)
+{
+  std::string extension = ".txt";
+
+  return fileName.size () > prefix.size () + extension.size ()
+         && fileName.compare (0, prefix.size (), prefix) == 0
+         && fileName.compare (fileName.size () - extension.size (), extension.size (), extension) == 0;
+}
+
+int
+main (int argc, char *argv[])
+{
+  bool convertAntennaPatterns = true;
+  bool convertLinkResults = true;
+  bool convertInputTraces = true;
+
+  CommandLine cmd;
+  cmd.AddValue ("antennaPatterns", "Convert the antenna pattern files", convertAntennaPatterns);
+  cmd.AddValue ("linkResults", "Convert the link results files", convertLinkResults);
+  cmd.AddValue ("inputTraces", "Convert the input trace files", convertInputTraces);
+  cmd.Parse (argc, argv);
+
+  std::string dataPath = Singleton<SatEnvVariables>::Get ()->LocateDataDirectory ();
+
+  if (convertAntennaPatterns)
+    {
+      std::string path = dataPath + "/antennapatterns/";
+      std::list<std::string> files = SystemPath::ReadFiles (path);
+
+      for (std::list<std::string>::const_iterator it = files.begin (); it != files.end (); ++it)
+        {
+          if (IsTextFile (*it, "SatAntennaGain72Beams_"))
+            {
+              std::string binaryFileName = SatBinaryDataFile::GetBinaryFileName (path + *it);
+              Ptr<SatAntennaGainPattern> pattern = CreateObject<SatAntennaGainPattern> (path + *it);
+              pattern->WriteBinaryFile (binaryFileName);
+
+              std::cout << "Output file written: " << binaryFileName << std::endl;
+            }
+        }
+    }
+
+  if (convertLinkResults)
+    {
+      std::string path = dataPath + "/linkresults/";
+      std::list<std::string> files = SystemPath::ReadFiles (path);
+
+      for (std::list<std::string>::const_iterator it = files.begin (); it != files.end (); ++it)
+        {
+          if (IsTextFile (*it, ""))
+            {
+              std::string binaryFileName = SatBinaryDataFile::GetBinaryFileName (path + *it);
+              Ptr<SatLookUpTable> table = CreateObject<SatLookUpTable> (path + *it);
+              table->WriteBinaryFile (binaryFileName);
+
+              std::cout << "Output file written: " << binaryFileName << std::endl;
+            }
+        }
+    }
+
+  if (convertInputTraces)
+    {
+      std::map<std::string, uint32_t> traceDirectories;
+      traceDirectories["/rxpowertraces/input/"] = SatBaseTraceContainer::RX_POWER_TRACE_DEFAULT_NUMBER_OF_COLUMNS;
+      traceDirectories["/interferencetraces/input/"] = SatBaseTraceContainer::INTF_TRACE_DEFAULT_NUMBER_OF_COLUMNS;
+      traceDirectories["/fadingtraces/input/"] = SatBaseTraceContainer::FADING_TRACE_DEFAULT_NUMBER_OF_COLUMNS;
+
+      for (std::map<std::string, uint32_t>::const_iterator dir = traceDirectories.begin (); dir != traceDirectories.end (); ++dir)
+        {
+          std::string path = dataPath + dir->first;
+          std::list<std::string> files = SystemPath::ReadFiles (path);
+
+          for (std::list<std::string>::const_iterator it = files.begin (); it != files.end (); ++it)
+            {
+              // Trace files have no extension
+              if (it->compare (0, 5, "BEAM_") == 0 && it->find ('.') == std::string::npos)
+                {
+                  std::string binaryFileName = SatBinaryDataFile::GetBinaryFileName (path + *it);
+                  Ptr<SatInputFileStreamTimeDoubleContainer> trace =
+                    CreateObject<SatInputFileStreamTimeDoubleContainer> (path + *it, std::ios::in, dir->second);
+                  trace->WriteBinaryFile (binaryFileName);
+
+                  std::cout << "Output file written: " << binaryFileName << std::endl;
+                }
+            }
+        }
+    }
+
+  return 0;
+}
@@ -20,19 +20,23 @@
 
 #include "ns3/log.h"
 #include "ns3/string.h"
+#include "ns3/boolean.h"
 #include "ns3/ipv4-static-routing-helper.h"
 #include "ns3/internet-stack-helper.h"
 #include "ns3/ipv4-interface.h"
 #include "ns3/mobility-helper.h"
 #include "ns3/enum.h"
 #include "ns3/pointer.h"
-#include "ns3/config.h"
 #include "../model/satellite-bstp-controller.h"
 #include "../model/satellite-const-variables.h"
 #include "../model/satellite-channel.h"
 #include "../model/satellite-phy.h"
 #include "../model/satellite-phy-tx.h"
 #include "../model/satellite-phy-rx.h"
+#include "../model/satellite-mac.h"
+#include "../model/satellite-llc.h"
+#include "../model/satellite-net-device.h"
+#include "../model/satellite-geo-net-device.h"
 #include "../model/satellite-arp-cache.h"
 #include "../model/satellite-mobility-model.h"
 #include "../model/satellite-propagation-delay-model.h"
@@ -42,8 +46,10 @@
 #include "../model/satellite-enums.h"
 #include "../model/satellite-typedefs.h"
 #include "satellite-beam-helper.h"
+#include "satellite-ipv4-routing-helper.h"
 #include "ns3/satellite-fading-input-trace-container.h"
 #include "ns3/satellite-fading-input-trace.h"
+#include "ns3/satellite-fading-external-input-trace-container.h"
 #include "ns3/singleton.h"
 #include "ns3/satellite-id-mapper.h"
 #include <ns3/satellite-typedefs.h>
@@ -85,7 +91,8 @@ SatBeamHelper::GetTypeId (void)
                    MakeEnumAccessor (&SatBeamHelper::m_raInterferenceModel),
                    MakeEnumChecker (SatPhyRxCarrierConf::IF_CONSTANT, "Constant",
                                     SatPhyRxCarrierConf::IF_TRACE, "Trace",
-                                    SatPhyRxCarrierConf::IF_PER_PACKET, "PerPacket"))
+                                    SatPhyRxCarrierConf::IF_PER_PACKET, "PerPacket",
+                                    SatPhyRxCarrierConf::IF_PER_PACKET_INDEXED, "PerPacketIndexed"))
     .AddAttribute ("RaCollisionModel",
                    "Collision model for random access",
                    EnumValue (SatPhyRxCarrierConf::RA_COLLISION_CHECK_AGAINST_SINR),
@@ -300,6 +307,7 @@ SatBeamHelper::DoDispose ()
   m_beam.clear ();
   m_gwNode.clear ();
   m_beamFreqs.clear ();
+  m_gwArpCache.clear ();
   m_markovConf = NULL;
   m_ncc = NULL;
   m_geoHelper = NULL;
@@ -465,6 +473,23 @@ SatBeamHelper::Install (NodeContainer ut,
 
   Ipv4InterfaceContainer utAddress = m_ipv4Helper.Assign (utNd);
 
+  // load external fading traces already at scenario creation
+  BooleanValue externalFading;
+  fwdUserLink->GetAttribute ("EnableExternalFadingInputTrace", externalFading);
+
+  if (externalFading.Get ())
+    {
+      SatFadingExternalInputTraceContainer* traceContainer = Singleton<SatFadingExternalInputTraceContainer>::Get ();
+
+      traceContainer->GetFadingTrace (gwId, SatEnums::FORWARD_FEEDER_CH, gwMobility);
+
+      for (uint32_t i = 0; i < utNd.GetN (); ++i)
+        {
+          uint32_t utId = Singleton<SatIdMapper>::Get ()->GetUtIdWithMac (utNd.Get (i)->GetAddress ());
+          traceContainer->GetFadingTrace (utId, SatEnums::FORWARD_USER_CH, ut.Get (i)->GetObject<SatMobilityModel> ());
+        }
+    }
+
   // set needed routings and fill ARP cache
   PopulateRoutings (ut, utNd, gwNode, gwNd, gwAddress.GetAddress (0), utAddress );
 
@@ -784,13 +809,63 @@ SatBeamHelper::EnablePacketTrace ()
    * TODO: Currently the packet trace logs all entries updated by the protocol layers. Here
    * we could restrict the protocol layers from where the traced data are collected from.
    * This could be controlled by the user using attributes.
+   *
+   * The trace sources are connected directly through the devices of the GW, UT and
+   * GEO nodes, instead of matching Config paths over all the nodes of the simulation.
    */
-  Config::ConnectWithoutContext ("/NodeList/*/DeviceList/*/PacketTrace", MakeCallback (&SatPacketTrace::AddTraceEntry, m_packetTrace));
-  Config::ConnectWithoutContext ("/NodeList/*/DeviceList/*/SatPhy/PacketTrace", MakeCallback (&SatPacketTrace::AddTraceEntry, m_packetTrace));
-  Config::ConnectWithoutContext ("/NodeList/*/DeviceList/*/UserPhy/*/PacketTrace", MakeCallback (&SatPacketTrace::AddTraceEntry, m_packetTrace));
-  Config::ConnectWithoutContext ("/NodeList/*/DeviceList/*/FeederPhy/*/PacketTrace", MakeCallback (&SatPacketTrace::AddTraceEntry, m_packetTrace));
-  Config::ConnectWithoutContext ("/NodeList/*/DeviceList/*/SatMac/PacketTrace", MakeCallback (&SatPacketTrace::AddTraceEntry, m_packetTrace));
-  Config::ConnectWithoutContext ("/NodeList/*/DeviceList/*/SatLlc/PacketTrace", MakeCallback (&SatPacketTrace::AddTraceEntry, m_packetTrace));
+  CallbackBase cb = MakeCallback (&SatPacketTrace::AddTraceEntry, m_packetTrace);
+
+  NodeContainer nodes = GetGwNodes ();
+  nodes.Add (GetUtNodes ());
+
+  for (NodeContainer::Iterator it = nodes.Begin (); it != nodes.End (); ++it)
+    {
+      for (uint32_t i = 0; i < (*it)->GetNDevices (); ++i)
+        {
+          Ptr<SatNetDevice> satDev = DynamicCast<SatNetDevice> ((*it)->GetDevice (i));
+
+          if (satDev == 0)
+            {
+              continue;
+            }
+
+          satDev->TraceConnectWithoutContext ("PacketTrace", cb);
+
+          if (satDev->GetPhy () != 0)
+            {
+              satDev->GetPhy ()->TraceConnectWithoutContext ("PacketTrace", cb);
+            }
+          if (satDev->GetMac () != 0)
+            {
+              satDev->GetMac ()->TraceConnectWithoutContext ("PacketTrace", cb);
+            }
+          if (satDev->GetLlc () != 0)
+            {
+              satDev->GetLlc ()->TraceConnectWithoutContext ("PacketTrace", cb);
+            }
+        }
+    }
+
+  for (uint32_t i = 0; i < m_geoNode->GetNDevices (); ++i)
+    {
+      Ptr<SatGeoNetDevice> geoDev = DynamicCast<SatGeoNetDevice> (m_geoNode->GetDevice (i));
+
+      if (geoDev == 0)
+        {
+          continue;
+        }
+
+      std::map<uint32_t, Ptr<SatPhy> >::const_iterator itPhy;
+
+      for (itPhy = geoDev->GetUserPhy ().begin (); itPhy != geoDev->GetUserPhy ().end (); ++itPhy)
+        {
+          itPhy->second->TraceConnectWithoutContext ("PacketTrace", cb);
+        }
+      for (itPhy = geoDev->GetFeederPhy ().begin (); itPhy != geoDev->GetFeederPhy ().end (); ++itPhy)
+        {
+          itPhy->second->TraceConnectWithoutContext ("PacketTrace", cb);
+        }
+    }
 }
 
 std::string
@@ -1033,8 +1108,11 @@ SatBeamHelper::PopulateRoutings (NodeContainer ut, NetDeviceContainer utNd, Ptr<
   NS_LOG_FUNCTION (this << gw << gwNd << gwAddr);
 
   Ipv4StaticRoutingHelper ipv4RoutingHelper;
+  SatIpv4RoutingHelper satRoutingHelper;
   Ptr<Ipv4L3Protocol> ipv4Gw = gw->GetObject<Ipv4L3Protocol> ();
-  Ptr<Ipv4StaticRouting> srGw = ipv4RoutingHelper.GetStaticRouting (ipv4Gw);
+
+  // UT network routes are resolved by prefix trie instead of static routing table
+  Ptr<SatIpv4Routing> srGw = satRoutingHelper.GetSatRouting (ipv4Gw);
 
   // Create an ARP entry of the default GW for the UTs in this beam
   Address macAddressGw = gwNd->GetAddress ();
@@ -1044,7 +1122,20 @@ SatBeamHelper::PopulateRoutings (NodeContainer ut, NetDeviceContainer utNd, Ptr<
 
   // Add the ARP entries of all the UTs in this beam
   // - MAC address vs. IPv4 address
-  Ptr<SatArpCache> gwArpCache = CreateObject<SatArpCache> ();
+  // - One ARP cache is shared by all the beams (satellite interfaces) of the GW
+  Ptr<SatArpCache> gwArpCache;
+  std::map<Ptr<Node>, Ptr<SatArpCache> >::const_iterator cacheIt = m_gwArpCache.find (gw);
+
+  if (cacheIt == m_gwArpCache.end ())
+    {
+      gwArpCache = CreateObject<SatArpCache> ();
+      m_gwArpCache.insert (std::make_pair (gw, gwArpCache));
+    }
+  else
+    {
+      gwArpCache = cacheIt->second;
+    }
+
   for (uint32_t i = 0; i < utIfs.GetN (); ++i)
     {
       NS_ASSERT (utIfs.GetN () == utNd.GetN ());
@@ -1055,7 +1146,7 @@ SatBeamHelper::PopulateRoutings (NodeContainer ut, NetDeviceContainer utNd, Ptr<
     }
 
   // Set the ARP cache to the proper GW IPv4Interface (the one for satellite
-  // link). ARP cache contains the entries for all UTs within this spot-beam.
+  // link). ARP cache contains the entries for all UTs served by the GW.
   ipv4Gw->GetInterface (gwNd->GetIfIndex ())->SetArpCache (gwArpCache);
   NS_LOG_INFO ("SatBeamHelper::PopulateRoutings, Add ARP cache to GW: " << gw->GetId () );
 
@@ -36,6 +36,7 @@
 #include "ns3/satellite-mobility-observer.h"
 #include "ns3/satellite-markov-container.h"
 #include "ns3/satellite-packet-trace.h"
+#include "ns3/satellite-arp-cache.h"
 #include "ns3/satellite-superframe-sequence.h"
 #include "ns3/satellite-typedefs.h"
 #include "satellite-geo-helper.h"
@@ -326,6 +327,7 @@ private:
   std::map<uint32_t, Ptr<Node> >            m_gwNode;      // first GW ID, second node pointer
   std::multimap<uint32_t, Ptr<Node> >       m_utNode;      // first Beam ID, second node pointer of the UT
   std::map<uint32_t, FrequencyPair_t >      m_beamFreqs;   // first beam ID, channel frequency IDs pair
+  std::map<Ptr<Node>, Ptr<SatArpCache> >    m_gwArpCache;  // first GW node, second ARP cache shared by satellite interfaces of the GW
 
   ChannelContainer_t m_channels;
 
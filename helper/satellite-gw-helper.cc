@@ -65,7 +65,8 @@ SatGwHelper::GetTypeId (void)
                    MakeEnumAccessor (&SatGwHelper::m_daInterferenceModel),
                    MakeEnumChecker (SatPhyRxCarrierConf::IF_CONSTANT, "Constant",
                                     SatPhyRxCarrierConf::IF_TRACE, "Trace",
-                                    SatPhyRxCarrierConf::IF_PER_PACKET, "PerPacket"))
+                                    SatPhyRxCarrierConf::IF_PER_PACKET, "PerPacket",
+                                    SatPhyRxCarrierConf::IF_PER_PACKET_INDEXED, "PerPacketIndexed"))
     .AddAttribute ("RtnLinkErrorModel",
                    "Return link error model for",
                    EnumValue (SatPhyRxCarrierConf::EM_AVI),
@@ -340,6 +341,7 @@ SatGwHelper::Install (Ptr<Node> n, uint32_t gwId, uint32_t beamId, Ptr<SatChanne
 
   // Create a node info to all the protocol layers
   Ptr<SatNodeInfo> nodeInfo = Create <SatNodeInfo> (SatEnums::NT_GW, n->GetId (), addr);
+  nodeInfo->SetIdMapperHandle (Singleton<SatIdMapper>::Get ()->GetHandleWithMac (addr));
   dev->SetNodeInfo (nodeInfo);
   llc->SetNodeInfo (nodeInfo);
   mac->SetNodeInfo (nodeInfo);
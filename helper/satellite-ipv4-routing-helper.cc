@@ -0,0 +1,88 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2016 Magister Solutions Ltd
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: agent <agent@local>
+ */
+
+#include "ns3/log.h"
+#include "ns3/ipv4-list-routing.h"
+#include "satellite-ipv4-routing-helper.h"
+
+NS_LOG_COMPONENT_DEFINE ("SatIpv4RoutingHelper");
+
+namespace ns3 {
+
+SatIpv4RoutingHelper::SatIpv4RoutingHelper ()
+{
+  NS_LOG_FUNCTION (this);
+}
+
+SatIpv4RoutingHelper*
+SatIpv4RoutingHelper::Copy (void) const
+{
+  return new SatIpv4RoutingHelper (*this);
+}
+
+Ptr<Ipv4RoutingProtocol>
+SatIpv4RoutingHelper::Create (Ptr<Node> node) const
+{
+  NS_LOG_FUNCTION (this << node);
+
+  return CreateObject<SatIpv4Routing> ();
+}
+
+Ptr<SatIpv4Routing>
+SatIpv4RoutingHelper::GetSatRouting (Ptr<Ipv4> ipv4) const
+{
+  NS_LOG_FUNCTION (this << ipv4);
+
+  Ptr<Ipv4RoutingProtocol> protocol = ipv4->GetRoutingProtocol ();
+  NS_ASSERT_MSG (protocol, "No routing protocol associated with Ipv4");
+
+  Ptr<SatIpv4Routing> satRouting = DynamicCast<SatIpv4Routing> (protocol);
+
+  if (satRouting)
+    {
+      return satRouting;
+    }
+
+  Ptr<Ipv4ListRouting> listRouting = DynamicCast<Ipv4ListRouting> (protocol);
+
+  if (listRouting == 0)
+    {
+      NS_FATAL_ERROR ("SatIpv4RoutingHelper::GetSatRouting - Ipv4ListRouting expected as the routing protocol");
+    }
+
+  int16_t priority;
+
+  for (uint32_t i = 0; i < listRouting->GetNRoutingProtocols (); i++)
+    {
+      satRouting = DynamicCast<SatIpv4Routing> (listRouting->GetRoutingProtocol (i, priority));
+
+      if (satRouting)
+        {
+          return satRouting;
+        }
+    }
+
+  satRouting = CreateObject<SatIpv4Routing> ();
+  listRouting->AddRoutingProtocol (satRouting, ROUTING_PRIORITY);
+
+  return satRouting;
+}
+
+} // namespace ns3
@@ -0,0 +1,64 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2016 Magister Solutions Ltd
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: agent <agent@local>
+ */
+#ifndef SATELLITE_IPV4_ROUTING_HELPER_H
+#define SATELLITE_IPV4_ROUTING_HELPER_H
+
+#include "ns3/ptr.h"
+#include "ns3/ipv4.h"
+#include "ns3/ipv4-routing-helper.h"
+#include "ns3/satellite-ipv4-routing.h"
+
+namespace ns3 {
+
+/**
+ * \ingroup satellite
+ * \brief Helper to install and access the SatIpv4Routing of the GW and
+ * terrestrial router nodes.
+ */
+class SatIpv4RoutingHelper : public Ipv4RoutingHelper
+{
+public:
+  /**
+   * Priority of SatIpv4Routing in Ipv4ListRouting, higher than the
+   * priority of Ipv4StaticRouting (zero) set by InternetStackHelper.
+   */
+  static const int16_t ROUTING_PRIORITY = 10;
+
+  /**
+   * Default constructor
+   */
+  SatIpv4RoutingHelper ();
+
+  // Inherited from Ipv4RoutingHelper
+  virtual SatIpv4RoutingHelper* Copy (void) const;
+  virtual Ptr<Ipv4RoutingProtocol> Create (Ptr<Node> node) const;
+
+  /**
+   * \brief Get the SatIpv4Routing of a node. If the node does not have one
+   * yet, it is created and added to the Ipv4ListRouting of the node.
+   * \param ipv4 IPv4 protocol of the node
+   * \return SatIpv4Routing of the node
+   */
+  Ptr<SatIpv4Routing> GetSatRouting (Ptr<Ipv4> ipv4) const;
+};
+
+} // namespace ns3
+
+#endif /* SATELLITE_IPV4_ROUTING_HELPER_H */
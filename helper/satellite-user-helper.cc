@@ -26,6 +26,7 @@
 #include "ns3/csma-helper.h"
 #include "../model/satellite-simple-net-device.h"
 #include "satellite-user-helper.h"
+#include "satellite-ipv4-routing-helper.h"
 #include <ns3/singleton.h>
 #include <ns3/satellite-id-mapper.h>
 #include <ns3/satellite-typedefs.h>
@@ -374,6 +375,26 @@ SatUserHelper::InstallRouter (NodeContainer gw, Ptr<Node> router)
       routingGw->SetDefaultRoute (addresses.GetAddress (1), lastGwIf);
       NS_LOG_INFO ("SatUserHelper::InstallRouter  GW default route: " << addresses.GetAddress (1) );
 
+      // copy UT network routes from GW to router
+      SatIpv4RoutingHelper satRoutingHelper;
+      Ptr<SatIpv4Routing> satRoutingGw = satRoutingHelper.GetSatRouting (ipv4Gw);
+
+      if (satRoutingGw->GetNRoutes () > 0)
+        {
+          Ptr<Ipv4> ipv4Router = router->GetObject<Ipv4> ();
+          uint32_t lastRouterIf = ipv4Router->GetNInterfaces () - 1;
+          Ptr<SatIpv4Routing> satRoutingRouter = satRoutingHelper.GetSatRouting (ipv4Router);
+
+          for (uint32_t routeIndex = 0; routeIndex < satRoutingGw->GetNRoutes (); routeIndex++)
+            {
+              Ipv4RoutingTableEntry route = satRoutingGw->GetRoute (routeIndex);
+
+              satRoutingRouter->AddNetworkRouteTo (route.GetDest (), route.GetDestNetworkMask (), addresses.GetAddress (0), lastRouterIf);
+              NS_LOG_INFO ("SatUserHelper::InstallRouter, Router UT network route:" << route.GetDest ()
+                                                                                    << ", " << route.GetDestNetworkMask () << ", " << addresses.GetAddress (0));
+            }
+        }
+
       for (uint32_t  routeIndex = 0; routeIndex < routingGw->GetNRoutes (); routeIndex++)
         {
           // Get IPv4 protocol implementations
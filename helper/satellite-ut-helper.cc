@@ -77,7 +77,8 @@ SatUtHelper::GetTypeId (void)
                    MakeEnumAccessor (&SatUtHelper::m_daInterferenceModel),
                    MakeEnumChecker (SatPhyRxCarrierConf::IF_CONSTANT, "Constant",
                                     SatPhyRxCarrierConf::IF_TRACE, "Trace",
-                                    SatPhyRxCarrierConf::IF_PER_PACKET, "PerPacket"))
+                                    SatPhyRxCarrierConf::IF_PER_PACKET, "PerPacket",
+                                    SatPhyRxCarrierConf::IF_PER_PACKET_INDEXED, "PerPacketIndexed"))
     .AddAttribute ("FwdLinkErrorModel",
                    "Forward link error model",
                    EnumValue (SatPhyRxCarrierConf::EM_AVI),
@@ -395,6 +396,7 @@ SatUtHelper::Install (Ptr<Node> n, uint32_t beamId, Ptr<SatChannel> fCh, Ptr<Sat
 
   // Create a node info to all the protocol layers
   Ptr<SatNodeInfo> nodeInfo = Create <SatNodeInfo> (SatEnums::NT_UT, n->GetId (), addr);
+  nodeInfo->SetIdMapperHandle (Singleton<SatIdMapper>::Get ()->GetHandleWithMac (addr));
   dev->SetNodeInfo (nodeInfo);
   llc->SetNodeInfo (nodeInfo);
   mac->SetNodeInfo (nodeInfo);
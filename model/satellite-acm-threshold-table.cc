@@ -0,0 +1,76 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2016 Magister Solutions Ltd
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: agent <agent@local>
+ */
+
+#include <algorithm>
+#include <cmath>
+#include "ns3/log.h"
+#include "satellite-acm-threshold-table.h"
+
+NS_LOG_COMPONENT_DEFINE ("SatAcmThresholdTable");
+
+namespace ns3 {
+
+SatAcmThresholdTable::SatAcmThresholdTable ()
+  : m_entries (),
+    m_thresholds (),
+    m_bestIds ()
+{
+  NS_LOG_FUNCTION (this);
+}
+
+void
+SatAcmThresholdTable::Add (double cnoThreshold, uint32_t id)
+{
+  NS_LOG_FUNCTION (this << cnoThreshold << id);
+
+  if (!std::isnan (cnoThreshold))
+    {
+      m_entries.push_back (std::make_pair (cnoThreshold, id));
+    }
+}
+
+void
+SatAcmThresholdTable::Build ()
+{
+  NS_LOG_FUNCTION (this << m_entries.size ());
+
+  std::sort (m_entries.begin (), m_entries.end ());
+
+  m_thresholds.resize (m_entries.size ());
+  m_bestIds.resize (m_entries.size ());
+
+  for (uint32_t i = 0; i < m_entries.size (); ++i)
+    {
+      m_thresholds[i] = m_entries[i].first;
+      m_bestIds[i] = (i == 0) ? m_entries[i].second : std::max (m_bestIds[i - 1], m_entries[i].second);
+    }
+}
+
+void
+SatAcmThresholdTable::Clear ()
+{
+  NS_LOG_FUNCTION (this);
+
+  m_entries.clear ();
+  m_thresholds.clear ();
+  m_bestIds.clear ();
+}
+
+} // namespace ns3
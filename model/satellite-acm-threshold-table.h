@@ -0,0 +1,121 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2016 Magister Solutions Ltd
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: agent <agent@local>
+ */
+
+#ifndef SATELLITE_ACM_THRESHOLD_TABLE_H
+#define SATELLITE_ACM_THRESHOLD_TABLE_H
+
+#include <vector>
+#include <stdint.h>
+
+namespace ns3 {
+
+/**
+ * \ingroup satellite
+ *
+ * \brief Compiled C/No threshold table for ACM selection. The table answers
+ * the question "what is the best id, whose C/No threshold is met by a given
+ * C/No", where a bigger id is always better than a smaller one (as the MODCOD
+ * enums and the waveform ids are ordered by spectral efficiency).
+ *
+ * The thresholds are sorted once when the table is built, and for each sorted
+ * threshold the best id among the thresholds up to it is stored. Thus a query
+ * is a binary search over a flat array, and it gives the same result as
+ * scanning the ids from the best to the worst and picking the first one
+ * whose threshold is met.
+ */
+class SatAcmThresholdTable
+{
+public:
+  /**
+   * \brief Default constructor, creates an empty table
+   */
+  SatAcmThresholdTable ();
+
+  /**
+   * \brief Add an id to the table. Ids with NaN threshold are never selected.
+   * \param cnoThreshold C/No threshold of the id in linear format
+   * \param id Id to be selected when the threshold is met
+   */
+  void Add (double cnoThreshold, uint32_t id);
+
+  /**
+   * \brief Build the table after all the ids have been added
+   */
+  void Build ();
+
+  /**
+   * \brief Remove all the ids from the table
+   */
+  void Clear ();
+
+  /**
+   * \brief Get the best id whose threshold is met
+   * \param cno C/No in linear format
+   * \param id Variable for passing the best id to the client
+   * \return true if some threshold is met, otherwise false
+   */
+  inline bool GetBestId (double cno, uint32_t& id) const
+  {
+    // Binary search for the number of thresholds <= cno. NaN C/No never meets a threshold.
+    std::vector<double>::size_type low = 0;
+    std::vector<double>::size_type high = m_thresholds.size ();
+
+    while (low < high)
+      {
+        std::vector<double>::size_type mid = (low + high) / 2;
+        if (m_thresholds[mid] <= cno)
+          {
+            low = mid + 1;
+          }
+        else
+          {
+            high = mid;
+          }
+      }
+
+    if (low == 0)
+      {
+        return false;
+      }
+
+    id = m_bestIds[low - 1];
+    return true;
+  }
+
+private:
+  /**
+   * Added (threshold, id) pairs, sorted when the table is built
+   */
+  std::vector<std::pair<double, uint32_t> > m_entries;
+
+  /**
+   * Sorted C/No thresholds
+   */
+  std::vector<double> m_thresholds;
+
+  /**
+   * Best id among the thresholds up to the same index in m_thresholds
+   */
+  std::vector<uint32_t> m_bestIds;
+};
+
+} // namespace ns3
+
+#endif /* SATELLITE_ACM_THRESHOLD_TABLE_H */
@@ -19,6 +19,7 @@
  */
 
 #include <sstream>
+#include <algorithm>
 #include "ns3/log.h"
 #include "satellite-antenna-gain-pattern-container.h"
 #include "ns3/singleton.h"
@@ -67,6 +68,60 @@ SatAntennaGainPatternContainer::SatAntennaGainPatternContainer ()
           NS_FATAL_ERROR (this << " an antenna pattern for beam " << i << " already exists!");
         }
     }
+
+  SelectBestBeamCandidates ();
+}
+
+void
+SatAntennaGainPatternContainer::SelectBestBeamCandidates ()
+{
+  NS_LOG_FUNCTION (this);
+
+  Ptr<SatAntennaGainPattern> referencePattern = m_antennaPatternMap.at (1);
+
+  for (uint32_t i = 2; i <= NUMBER_OF_BEAMS; ++i)
+    {
+      if (!referencePattern->HasSameGrid (m_antennaPatternMap.at (i)))
+        {
+          NS_LOG_WARN (this << " antenna patterns do not use the same grid, best beam candidates not selected");
+          return;
+        }
+    }
+
+  uint32_t cellCount = referencePattern->GetGridCellCount ();
+  std::vector<double> maxGains (NUMBER_OF_BEAMS);
+
+  m_bestBeamCandidateIndices.reserve (cellCount + 1);
+  m_bestBeamCandidateIndices.push_back (0);
+
+  for (uint32_t cell = 0; cell < cellCount; ++cell)
+    {
+      // The cell is valid, only if the gains of all the beams are valid in it
+      bool valid (true);
+      double highestMinGain (0.0);
+
+      for (uint32_t i = 0; valid && i < NUMBER_OF_BEAMS; ++i)
+        {
+          double minGain (0.0);
+          valid = m_antennaPatternMap.at (i + 1)->GetGridCellGainRange_lin (cell, minGain, maxGains[i]);
+          highestMinGain = std::max (highestMinGain, minGain);
+        }
+
+      if (valid)
+        {
+          for (uint32_t i = 0; i < NUMBER_OF_BEAMS; ++i)
+            {
+              if (maxGains[i] >= highestMinGain)
+                {
+                  m_bestBeamCandidates.push_back (i + 1);
+                }
+            }
+        }
+
+      m_bestBeamCandidateIndices.push_back (m_bestBeamCandidates.size ());
+    }
+
+  NS_LOG_INFO (this << " selected " << m_bestBeamCandidates.size () << " best beam candidates for " << cellCount << " grid cells");
 }
 
 Ptr<SatAntennaGainPattern>
@@ -92,6 +147,34 @@ SatAntennaGainPatternContainer::GetBestBeamId (GeoCoordinate coord) const
   double bestGain (-100.0);
   uint32_t bestId (0);
 
+  // Check only the candidate beams of the grid cell, if they are selected
+  if (!m_bestBeamCandidateIndices.empty ())
+    {
+      uint32_t cell = m_antennaPatternMap.at (1)->GetGridCellIndex (coord);
+      uint32_t first = m_bestBeamCandidateIndices[cell];
+      uint32_t last = m_bestBeamCandidateIndices[cell + 1];
+
+      // No candidates means that some of the antenna patterns has a NAN
+      // gain value in this position.
+      if (first == last)
+        {
+          NS_FATAL_ERROR (this << " returned a NAN antenna gain value!");
+        }
+
+      for (uint32_t i = first; i < last; ++i)
+        {
+          double gain = m_antennaPatternMap.at (m_bestBeamCandidates[i])->GetAntennaGain_lin (coord);
+
+          if (gain > bestGain)
+            {
+              bestGain = gain;
+              bestId = m_bestBeamCandidates[i];
+            }
+        }
+
+      return bestId;
+    }
+
   for (uint32_t i = 1; i <= NUMBER_OF_BEAMS; ++i)
     {
       double gain = m_antennaPatternMap.at (i)->GetAntennaGain_lin (coord);
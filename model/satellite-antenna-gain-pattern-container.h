@@ -36,6 +36,13 @@ namespace ns3 {
  * Each antenna gain pattern is stored in a separate class
  * SatAntennaGainPattern. The best beam may be chosen based on
  * the antenna patterns by using GetBestBeamId for a given position.
+ *
+ * To speed up the best beam selection, the candidate beams for each grid
+ * cell of the antenna patterns are selected already in the construction.
+ * A beam is a candidate, if its maximum gain at the cell corners is at least
+ * the highest minimum gain of any beam at the cell corners. Thus, only the
+ * gains of the candidate beams (typically one or two) need to be interpolated
+ * when selecting the best beam.
  */
 class SatAntennaGainPatternContainer : public Object
 {
@@ -76,6 +83,13 @@ public:
   uint32_t GetBestBeamId (GeoCoordinate coord) const;
 
 private:
+  /**
+   * \brief Select the candidate best beams for each grid cell of the antenna
+   * patterns. If the antenna patterns do not use the same grid, the candidate
+   * beams are not selected and all the beams are checked in GetBestBeamId.
+   */
+  void SelectBestBeamCandidates ();
+
   /**
    * \brief Definition of number of beams (72-beam reference scenario).
    * Note: to change the reference system this has to be changed
@@ -88,6 +102,17 @@ private:
    */
   std::map< uint32_t, Ptr<SatAntennaGainPattern> > m_antennaPatternMap;
 
+  /**
+   * Candidate best beam ids of all the grid cells stored cell after cell
+   */
+  std::vector<uint32_t> m_bestBeamCandidates;
+
+  /**
+   * Index of the first candidate best beam of each grid cell in
+   * m_bestBeamCandidates. Holds one more element than there are grid cells.
+   */
+  std::vector<uint32_t> m_bestBeamCandidateIndices;
+
 };
 
 } // namespace ns3
@@ -58,6 +58,8 @@ SatAntennaGainPattern::GetInstanceTypeId (void) const
 
 SatAntennaGainPattern::SatAntennaGainPattern ()
   : m_antennaPattern (),
+    m_gains (0),
+    m_binaryFile (),
     m_validPositions (),
     m_minAcceptableAntennaGainInDb (40.0),
     m_uniformRandomVariable (),
@@ -75,14 +77,19 @@ SatAntennaGainPattern::SatAntennaGainPattern ()
 }
 
 SatAntennaGainPattern::SatAntennaGainPattern (std::string filePathName)
-  : m_nanStrings (m_nanStringArray, m_nanStringArray + (sizeof m_nanStringArray / sizeof m_nanStringArray[0]))
+  : m_gains (0),
+    m_nanStrings (m_nanStringArray, m_nanStringArray + (sizeof m_nanStringArray / sizeof m_nanStringArray[0]))
 {
   // Attributes are needed already in construction phase:
   // - ConstructSelf call in constructor
   // - GetInstanceTypeId is needed to be implemented
   ObjectBase::ConstructSelf (AttributeConstructionList ());
 
-  ReadAntennaPatternFromFile (filePathName);
+  if (!ReadAntennaPatternFromBinaryFile (filePathName))
+    {
+      ReadAntennaPatternFromFile (filePathName);
+    }
+
   m_uniformRandomVariable = CreateObject<UniformRandomVariable> ();
 }
 
@@ -107,7 +114,7 @@ void SatAntennaGainPattern::ReadAntennaPatternFromFile (std::string filePathName
         }
     }
 
-  // Row vector containing all the gain values for a certain latitude
+  // Row vector containing all the gain values (in linear format) for a certain latitude
   std::vector<double> rowVector;
 
   // Start conditions
@@ -175,17 +182,21 @@ void SatAntennaGainPattern::ReadAntennaPatternFromFile (std::string filePathName
           m_longitudes.push_back (lon);
         }
 
+      // Change the gain to linear value, because the interpolation is done in linear domain.
+      // Note, that NaN values are kept as NaN.
+      double gainLinear = SatUtils::DbToLinear (gainDouble);
+
       // If this is the first gain entry
       if (rowVector.empty ())
         {
           m_minLat = lat;
           m_minLon = lon;
-          rowVector.push_back (gainDouble);
+          rowVector.push_back (gainLinear);
         }
       // We are still in the same row (= latitude)
       else if (lat == m_maxLat)
         {
-          rowVector.push_back (gainDouble);
+          rowVector.push_back (gainLinear);
         }
       // Latitude changed
       // - Store the vector
@@ -193,9 +204,10 @@ void SatAntennaGainPattern::ReadAntennaPatternFromFile (std::string filePathName
       // - Start from another row
       else
         {
-          m_antennaPattern.push_back (rowVector);
+          NS_ASSERT ( rowVector.size () == m_longitudes.size ());
+          m_antennaPattern.insert (m_antennaPattern.end (), rowVector.begin (), rowVector.end ());
           rowVector.clear ();
-          rowVector.push_back (gainDouble);
+          rowVector.push_back (gainLinear);
         }
 
       // Update the maximum values
@@ -210,13 +222,84 @@ void SatAntennaGainPattern::ReadAntennaPatternFromFile (std::string filePathName
   // happens every time the row changes. I.e. the last row is stored here!
   NS_ASSERT ( rowVector.size () == m_longitudes.size ());
 
-  m_antennaPattern.push_back (rowVector);
+  m_antennaPattern.insert (m_antennaPattern.end (), rowVector.begin (), rowVector.end ());
   rowVector.clear ();
 
+  if (m_antennaPattern.size () != m_latitudes.size () * m_longitudes.size ())
+    {
+      NS_FATAL_ERROR ("SatAntennaGainPattern::ReadAntennaPatternFromFile - antenna pattern " << filePathName << " is not a full latitude-longitude grid!");
+    }
+
+  m_gains = &m_antennaPattern[0];
+
   ifs->close ();
   delete ifs;
 }
 
+bool
+SatAntennaGainPattern::ReadAntennaPatternFromBinaryFile (std::string filePathName)
+{
+  NS_LOG_FUNCTION (this << filePathName);
+
+  Ptr<SatBinaryDataFile> file = SatBinaryDataFile::OpenForTextFile (filePathName, SatBinaryDataFile::CONTENT_ANTENNA_PATTERN);
+
+  if (file == 0)
+    {
+      return false;
+    }
+
+  uint32_t latCount = file->GetRows ();
+  uint32_t lonCount = file->GetColumns ();
+
+  // Parameters are the latitudes followed by the longitudes of the grid
+  if (latCount < 2 || lonCount < 2 || file->GetParameterCount () != latCount + lonCount)
+    {
+      NS_LOG_WARN ("Invalid grid in binary antenna pattern of " << filePathName << ", using the text file");
+      return false;
+    }
+
+  const double * parameters = file->GetParameters ();
+  m_latitudes.assign (parameters, parameters + latCount);
+  m_longitudes.assign (parameters + latCount, parameters + latCount + lonCount);
+
+  m_minLat = m_latitudes.front ();
+  m_maxLat = m_latitudes.back ();
+  m_minLon = m_longitudes.front ();
+  m_maxLon = m_longitudes.back ();
+  m_latInterval = m_latitudes[latCount - 1] - m_latitudes[latCount - 2];
+  m_lonInterval = m_longitudes[lonCount - 1] - m_longitudes[lonCount - 2];
+
+  // The gains are used directly from the mapped file
+  m_binaryFile = file;
+  m_gains = file->GetData ();
+
+  double minAcceptableAntennaGain = SatUtils::DbToLinear (m_minAcceptableAntennaGainInDb);
+
+  for (uint32_t i = 0; i < latCount * lonCount; ++i)
+    {
+      if (!std::isnan (m_gains[i]) && m_gains[i] >= minAcceptableAntennaGain)
+        {
+          m_validPositions.push_back (std::make_pair (m_latitudes[i / lonCount], m_longitudes[i % lonCount]));
+        }
+    }
+
+  return true;
+}
+
+void
+SatAntennaGainPattern::WriteBinaryFile (std::string filePathName) const
+{
+  NS_LOG_FUNCTION (this << filePathName);
+
+  std::vector<double> parameters (m_latitudes);
+  parameters.insert (parameters.end (), m_longitudes.begin (), m_longitudes.end ());
+
+  std::vector<double> gains (m_gains, m_gains + GetGridCellCount ());
+
+  SatBinaryDataFile::Write (filePathName, SatBinaryDataFile::CONTENT_ANTENNA_PATTERN,
+                            parameters, m_latitudes.size (), m_longitudes.size (), gains);
+}
+
 
 GeoCoordinate SatAntennaGainPattern::GetValidRandomPosition () const
 {
@@ -272,7 +355,8 @@ GeoCoordinate SatAntennaGainPattern::GetValidRandomPosition () const
 }
 
 
-double SatAntennaGainPattern::GetAntennaGain_lin (GeoCoordinate coord) const
+uint32_t
+SatAntennaGainPattern::GetGridCellIndex (GeoCoordinate coord) const
 {
   NS_LOG_FUNCTION (this << coord.GetLatitude () << coord.GetLongitude ());
 
@@ -293,13 +377,89 @@ double SatAntennaGainPattern::GetAntennaGain_lin (GeoCoordinate coord) const
   uint32_t minLatIndex = (uint32_t)(std::floor (std::abs (latitude - m_minLat) / m_latInterval));
   uint32_t minLonIndex = (uint32_t)(std::floor (std::abs (longitude - m_minLon) / m_lonInterval));
 
+  return minLatIndex * m_longitudes.size () + minLonIndex;
+}
+
+uint32_t
+SatAntennaGainPattern::GetGridCellCount () const
+{
+  NS_LOG_FUNCTION (this);
+
+  return m_latitudes.size () * m_longitudes.size ();
+}
+
+bool
+SatAntennaGainPattern::GetGridCellGainRange_lin (uint32_t cellIndex, double& minGain, double& maxGain) const
+{
+  NS_LOG_FUNCTION (this << cellIndex);
+
+  uint32_t lonCount = m_longitudes.size ();
+
+  // Cells at the upper latitude or longitude edge of the grid cannot be interpolated
+  if (cellIndex >= GetGridCellCount () - lonCount
+      || (cellIndex % lonCount) == lonCount - 1)
+    {
+      return false;
+    }
+
+  double gains[4] = { m_gains[cellIndex],
+                      m_gains[cellIndex + 1],
+                      m_gains[cellIndex + lonCount],
+                      m_gains[cellIndex + lonCount + 1] };
+
+  minGain = gains[0];
+  maxGain = gains[0];
+
+  for (uint32_t i = 0; i < 4; ++i)
+    {
+      if (std::isnan (gains[i]))
+        {
+          return false;
+        }
+
+      minGain = std::min (minGain, gains[i]);
+      maxGain = std::max (maxGain, gains[i]);
+    }
+
+  return true;
+}
+
+bool
+SatAntennaGainPattern::HasSameGrid (Ptr<SatAntennaGainPattern> pattern) const
+{
+  NS_LOG_FUNCTION (this << pattern);
+
+  return m_latitudes == pattern->m_latitudes && m_longitudes == pattern->m_longitudes;
+}
+
+double SatAntennaGainPattern::GetAntennaGain_lin (GeoCoordinate coord) const
+{
+  NS_LOG_FUNCTION (this << coord.GetLatitude () << coord.GetLongitude ());
+
+  // Get the requested position {latitude, longitude}
+  double latitude = coord.GetLatitude ();
+  double longitude = coord.GetLongitude ();
+
+  // Get the minimum grid point {minLatIndex, minLonIndex} for the given {latitude, longitude} point
+  uint32_t lonCount = m_longitudes.size ();
+  uint32_t cellIndex = GetGridCellIndex (coord);
+  uint32_t minLatIndex = cellIndex / lonCount;
+  uint32_t minLonIndex = cellIndex % lonCount;
+
+  // Change the gains to linear values , because the interpolation is done in linear domain.
+  // Note, that the gains are stored already in linear format.
+  double G11 = m_gains[cellIndex];
+  double G12 = m_gains[cellIndex + 1];
+  double G21 = m_gains[cellIndex + lonCount];
+  double G22 = m_gains[cellIndex + lonCount + 1];
+
   // All the values within the grid box has to be valid! If UT is placed (or
   // is moving outside) the valid simulation area, the simulation will crash
   // to a fatal error.
-  if (std::isnan (m_antennaPattern[minLatIndex][minLonIndex])
-      || std::isnan (m_antennaPattern[minLatIndex][minLonIndex + 1])
-      || std::isnan (m_antennaPattern[minLatIndex + 1][minLonIndex])
-      || std::isnan (m_antennaPattern[minLatIndex + 1][minLonIndex + 1]))
+  if (std::isnan (G11)
+      || std::isnan (G12)
+      || std::isnan (G21)
+      || std::isnan (G22))
     {
       NS_FATAL_ERROR (this << ", some value(s) of the interpolated grid point(s) is/are NAN!");
     }
@@ -315,12 +475,6 @@ double SatAntennaGainPattern::GetAntennaGain_lin (GeoCoordinate coord) const
   double upperLonShare = (m_longitudes[minLonIndex + 1] - longitude) / m_lonInterval;
   double lowerLonShare = (longitude - m_longitudes[minLonIndex]) / m_lonInterval;
 
-  // Change the gains to linear values , because the interpolation is done in linear domain.
-  double G11 = SatUtils::DbToLinear ( m_antennaPattern[minLatIndex][minLonIndex] );
-  double G12 = SatUtils::DbToLinear ( m_antennaPattern[minLatIndex][minLonIndex + 1] );
-  double G21 = SatUtils::DbToLinear ( m_antennaPattern[minLatIndex + 1][minLonIndex] );
-  double G22 = SatUtils::DbToLinear ( m_antennaPattern[minLatIndex + 1][minLonIndex + 1] );
-
   // Longitude direction with latitude minLatIndex
   double valLatLower = upperLonShare * G11 + lowerLonShare * G12;
 
@@ -331,23 +485,6 @@ double SatAntennaGainPattern::GetAntennaGain_lin (GeoCoordinate coord) const
   double gain = ((m_latitudes[minLatIndex + 1] - latitude) / m_latInterval) * valLatLower +
     ((latitude - m_latitudes[minLatIndex]) / m_latInterval) * valLatUpper;
 
-  /*
-  std::cout << "minLonIndex = " << minLonIndex <<
-      ", minLatIndex = " << minLatIndex <<
-      ", m_lonInterval = " << m_lonInterval <<
-      ", m_LatInterval = " << m_latInterval <<
-      ", x1 = " << m_longitudes[minLonIndex] <<
-      ", y1 = " << m_latitudes[minLatIndex] <<
-      ", x2 = " << m_longitudes[minLonIndex+1] <<
-      ", y2 = " << m_latitudes[minLatIndex+1] <<
-      ", G(x1,y1) = " << m_antennaPattern[minLatIndex][minLonIndex] <<
-      ", G(x1,y2) = " << m_antennaPattern[minLatIndex+1][minLonIndex] <<
-      ", G(x2,y1) = " << m_antennaPattern[minLatIndex][minLonIndex+1] <<
-      ", G(x2,y2) = " << m_antennaPattern[minLatIndex+1][minLonIndex+1] <<
-      ", x = " << longitude <<
-      ", y = " << latitude <<
-      ", interpolated gain: " << gain << std::endl;
-   */
   return gain;
 }
 
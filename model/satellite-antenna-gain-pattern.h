@@ -25,6 +25,7 @@
 #include <fstream>
 #include "ns3/random-variable-stream.h"
 #include "ns3/object.h"
+#include "ns3/satellite-binary-data-file.h"
 #include "geo-coordinate.h"
 
 namespace ns3 {
@@ -36,7 +37,12 @@ namespace ns3 {
  * is read from a file to a container. Current implementation assumes
  * that the antenna pattern is using a constant longitude-latitude grid of
  * samples. This assumption is made to enable fast look-ups from the container
- * (= vector<vector<double>>).
+ * (= one contiguous vector<double> stored latitude by latitude). The gains are
+ * converted to linear format already when reading the file.
+ *
+ * If a binary data file generated from the text file by the
+ * sat-binary-data-converter example is found, the gains are used directly
+ * from the memory mapped binary file instead of parsing the text file.
  *
  * Antenna gain patter is used also for spot-beam selection. In initialization phase
  * a valid positions list is constructed based on a minimum accepted antenna gain set
@@ -87,6 +93,44 @@ public:
    */
   GeoCoordinate GetValidRandomPosition () const;
 
+  /**
+   * \brief Get the index of the grid cell containing a certain {latitude, longitude}
+   * point. The cell is identified by its lower left corner, i.e. the index is
+   * latitude index * number of longitudes + longitude index.
+   * \param coord Geo coordinate
+   * \return The grid cell index
+   */
+  uint32_t GetGridCellIndex (GeoCoordinate coord) const;
+
+  /**
+   * \brief Get the number of grid cell indices, i.e. the number of grid points.
+   * \return The number of grid cell indices
+   */
+  uint32_t GetGridCellCount () const;
+
+  /**
+   * \brief Get the minimum and maximum gain of the four corners of a grid cell.
+   * \param cellIndex Grid cell index
+   * \param minGain Minimum gain in linear format
+   * \param maxGain Maximum gain in linear format
+   * \return false, if the cell is not a valid interpolation cell, i.e. it is at
+   * the edge of the grid or some of the corners has a NaN gain, otherwise true
+   */
+  bool GetGridCellGainRange_lin (uint32_t cellIndex, double& minGain, double& maxGain) const;
+
+  /**
+   * \brief Check whether another antenna gain pattern uses the same grid of samples.
+   * \param pattern Another antenna gain pattern
+   * \return true, if the grids are the same, otherwise false
+   */
+  bool HasSameGrid (Ptr<SatAntennaGainPattern> pattern) const;
+
+  /**
+   * \brief Write the antenna gain pattern to a binary data file.
+   * \param filePathName Path and file name of the binary data file
+   */
+  void WriteBinaryFile (std::string filePathName) const;
+
 private:
   /**
    * \brief Read the antenna gain pattern from a file
@@ -95,11 +139,30 @@ private:
   void ReadAntennaPatternFromFile (std::string filePathName);
 
   /**
-   * Container for the antenna pattern from one spot-beam
-   * - Outer vector holds gain values for all latitudes
-   * - Inner vector holds gain values for all longitudes for a certain latitude
+   * \brief Read the antenna gain pattern from the binary data file of a text file
+   * \param filePathName Path and file name of the antenna pattern text file
+   * \return true, if the binary data file was used, otherwise false
+   */
+  bool ReadAntennaPatternFromBinaryFile (std::string filePathName);
+
+  /**
+   * Container for the antenna pattern from one spot-beam in linear format.
+   * Gain values for all longitudes for a certain latitude are stored
+   * contiguously, latitude after latitude, i.e. the gain of grid point
+   * {latIndex, lonIndex} is at latIndex * number of longitudes + lonIndex.
+   */
+  std::vector<double> m_antennaPattern;
+
+  /**
+   * Gain values of the antenna pattern in the layout of m_antennaPattern.
+   * Points either to m_antennaPattern or to the memory mapped binary data file.
+   */
+  const double * m_gains;
+
+  /**
+   * Binary data file containing the gains, if the pattern was read from it
    */
-  std::vector< std::vector <double> > m_antennaPattern;
+  Ptr<SatBinaryDataFile> m_binaryFile;
 
   /**
    * Container for valid positions
@@ -31,6 +31,10 @@ namespace ns3 {
  * the ARP cache entries are pre-filled by the helpers and n "infinite"
  * timeout is set for all ARP cache entries. Thus, ARP is enabled but the
  * ARP messages do not need to be actively sent.
+ *
+ * The entries are permanent and never refreshed, so an instance can be shared
+ * by several interfaces: SatBeamHelper creates one for all the satellite
+ * interfaces of a GW and one for all the UTs of a beam.
  */
 class SatArpCache : public ArpCache
 {
@@ -33,7 +33,7 @@ SatArqBufferContext::SatArqBufferContext ()
   : m_pdu (),
     m_seqNo (0),
     m_retransmissionCount (0),
-    m_waitingTimer (),
+    m_waitingTimerId (0),
     m_rxStatus (false)
 {
 
@@ -54,7 +54,6 @@ SatArqBufferContext::DoDispose ()
   NS_LOG_FUNCTION (this);
 
   m_pdu = 0;
-  m_waitingTimer.Cancel ();
 }
 
 }
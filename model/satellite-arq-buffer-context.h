@@ -24,7 +24,6 @@
 
 #include "ns3/object.h"
 #include "ns3/packet.h"
-#include "ns3/event-id.h"
 
 namespace ns3 {
 
@@ -62,7 +61,7 @@ public:
   Ptr<Packet> m_pdu;
   uint32_t    m_seqNo;
   uint32_t    m_retransmissionCount;
-  EventId     m_waitingTimer;
+  uint64_t    m_waitingTimerId;
   bool        m_rxStatus;
 };
 
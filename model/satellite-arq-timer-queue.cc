@@ -0,0 +1,176 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2016 Magister Solutions Ltd
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: agent <agent@local>
+ */
+
+#include <algorithm>
+#include "ns3/log.h"
+#include "ns3/simulator.h"
+#include "satellite-arq-timer-queue.h"
+
+NS_LOG_COMPONENT_DEFINE ("SatArqTimerQueue");
+
+namespace ns3 {
+
+SatArqTimerQueue::SatArqTimerQueue ()
+  : m_timers (),
+    m_head (0),
+    m_count (0),
+    m_headId (1),
+    m_event (),
+    m_expiryCallback ()
+{
+  NS_LOG_FUNCTION (this);
+}
+
+SatArqTimerQueue::~SatArqTimerQueue ()
+{
+  NS_LOG_FUNCTION (this);
+
+  Clear ();
+}
+
+void
+SatArqTimerQueue::SetExpiryCallback (ExpiryCallback cb)
+{
+  NS_LOG_FUNCTION (this << &cb);
+
+  m_expiryCallback = cb;
+}
+
+uint64_t
+SatArqTimerQueue::Start (Time delay, uint32_t seqNo)
+{
+  NS_LOG_FUNCTION (this << delay.GetSeconds () << seqNo);
+
+  Timer_t timer;
+  timer.expiryTime = Simulator::Now () + delay;
+  timer.seqNo = seqNo;
+  timer.running = true;
+
+  if (m_count > 0)
+    {
+      const Timer_t& last = m_timers[(m_head + m_count - 1) & (m_timers.size () - 1)];
+
+      if (timer.expiryTime < last.expiryTime)
+        {
+          NS_FATAL_ERROR ("ARQ timer started to expire before the previously started timer!");
+        }
+    }
+
+  if (m_count == m_timers.size ())
+    {
+      // Double the ring buffer, keeping the timers in the same order
+      std::vector<Timer_t> timers (std::max<size_t> (16, 2 * m_timers.size ()));
+
+      for (uint32_t i = 0; i < m_count; ++i)
+        {
+          timers[i] = m_timers[(m_head + i) & (m_timers.size () - 1)];
+        }
+
+      m_timers.swap (timers);
+      m_head = 0;
+    }
+
+  m_timers[(m_head + m_count) & (m_timers.size () - 1)] = timer;
+  ++m_count;
+
+  ScheduleExpiry ();
+
+  return m_headId + m_count - 1;
+}
+
+void
+SatArqTimerQueue::Stop (uint64_t timerId)
+{
+  NS_LOG_FUNCTION (this << timerId);
+
+  if (timerId >= m_headId && timerId < m_headId + m_count)
+    {
+      m_timers[(m_head + (timerId - m_headId)) & (m_timers.size () - 1)].running = false;
+    }
+}
+
+bool
+SatArqTimerQueue::IsRunning (uint64_t timerId) const
+{
+  if (timerId >= m_headId && timerId < m_headId + m_count)
+    {
+      return m_timers[(m_head + (timerId - m_headId)) & (m_timers.size () - 1)].running;
+    }
+
+  return false;
+}
+
+void
+SatArqTimerQueue::Clear ()
+{
+  NS_LOG_FUNCTION (this);
+
+  while (m_count > 0)
+    {
+      PopFront ();
+    }
+
+  m_event.Cancel ();
+}
+
+void
+SatArqTimerQueue::Expire ()
+{
+  NS_LOG_FUNCTION (this);
+
+  // The callback may start and stop timers, so the head is checked again after each call
+  while (m_count > 0 && m_timers[m_head].expiryTime <= Simulator::Now ())
+    {
+      Timer_t timer = m_timers[m_head];
+      PopFront ();
+
+      if (timer.running)
+        {
+          m_expiryCallback (timer.seqNo);
+        }
+    }
+
+  ScheduleExpiry ();
+}
+
+void
+SatArqTimerQueue::ScheduleExpiry ()
+{
+  // Stopped timers at the head do not need an event of their own
+  while (m_count > 0 && !m_timers[m_head].running)
+    {
+      PopFront ();
+    }
+
+  if (m_count > 0 && !m_event.IsRunning ())
+    {
+      m_event = Simulator::Schedule (m_timers[m_head].expiryTime - Simulator::Now (), &SatArqTimerQueue::Expire, this);
+    }
+}
+
+void
+SatArqTimerQueue::PopFront ()
+{
+  m_head = (m_head + 1) & (m_timers.size () - 1);
+  --m_count;
+  ++m_headId;
+}
+
+} // namespace ns3
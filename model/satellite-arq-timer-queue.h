@@ -0,0 +1,158 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2016 Magister Solutions Ltd
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: agent <agent@local>
+ */
+
+#ifndef SATELLITE_ARQ_TIMER_QUEUE_H_
+#define SATELLITE_ARQ_TIMER_QUEUE_H_
+
+#include <vector>
+#include <stdint.h>
+#include "ns3/nstime.h"
+#include "ns3/event-id.h"
+#include "ns3/callback.h"
+
+namespace ns3 {
+
+/**
+ * \ingroup satellite
+ * \brief SatArqTimerQueue holds the ARQ timers of one kind (retransmission
+ * or Rx waiting) of an ARQ encapsulator.
+ *
+ * All the timers of a queue have the same duration, thus they expire in the
+ * order they were started. The timers are kept in a ring buffer in that
+ * order, and only one simulator event is scheduled per queue, at the expiry
+ * of the first running timer. A stopped timer is only marked stopped and
+ * skipped when it reaches the head of the queue, so no simulator event is
+ * cancelled for it.
+ */
+class SatArqTimerQueue
+{
+public:
+  /**
+   * Callback for an expired timer, the parameter is the sequence number
+   * given when starting the timer.
+   */
+  typedef Callback<void, uint32_t> ExpiryCallback;
+
+  /**
+   * Default constructor
+   */
+  SatArqTimerQueue ();
+
+  /**
+   * Destructor for SatArqTimerQueue
+   */
+  ~SatArqTimerQueue ();
+
+  /**
+   * \brief Set the callback called for an expired timer
+   * \param cb Expiry callback
+   */
+  void SetExpiryCallback (ExpiryCallback cb);
+
+  /**
+   * \brief Start a timer
+   * \param delay Duration of the timer. The timers of a queue shall expire
+   * in the order they are started.
+   * \param seqNo Sequence number passed to the expiry callback
+   * \return Id of the timer, never zero
+   */
+  uint64_t Start (Time delay, uint32_t seqNo);
+
+  /**
+   * \brief Stop a timer. Stopping an expired or already stopped timer has
+   * no effect.
+   * \param timerId Id of the timer
+   */
+  void Stop (uint64_t timerId);
+
+  /**
+   * \brief Check whether a timer is running
+   * \param timerId Id of the timer
+   * \return true if the timer is neither expired nor stopped
+   */
+  bool IsRunning (uint64_t timerId) const;
+
+  /**
+   * \brief Stop all the timers and cancel the simulator event of the queue
+   */
+  void Clear ();
+
+private:
+  /**
+   * Timer in the queue
+   */
+  typedef struct
+  {
+    Time      expiryTime;
+    uint32_t  seqNo;
+    bool      running;
+  } Timer_t;
+
+  /**
+   * \brief Handle the expiry of the timers at the head of the queue
+   */
+  void Expire ();
+
+  /**
+   * \brief Schedule the simulator event to the expiry of the first timer,
+   * if there are timers and the event is not scheduled already.
+   */
+  void ScheduleExpiry ();
+
+  /**
+   * \brief Remove the timer at the head of the queue
+   */
+  void PopFront ();
+
+  /**
+   * Timers in a ring buffer of power of two size
+   */
+  std::vector<Timer_t> m_timers;
+
+  /**
+   * Position of the first timer in m_timers
+   */
+  uint32_t m_head;
+
+  /**
+   * Number of timers in the queue
+   */
+  uint32_t m_count;
+
+  /**
+   * Id of the first timer, the ids of the following timers being consecutive.
+   * The ids start from one, so zero may be used for no timer.
+   */
+  uint64_t m_headId;
+
+  /**
+   * Simulator event scheduled to the expiry of the first timer
+   */
+  EventId m_event;
+
+  /**
+   * Callback called for an expired timer
+   */
+  ExpiryCallback m_expiryCallback;
+};
+
+} // namespace ns3
+
+#endif /* SATELLITE_ARQ_TIMER_QUEUE_H_ */
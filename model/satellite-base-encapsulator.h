@@ -96,6 +96,15 @@ public:
    */
   typedef Callback<bool, Ptr<SatControlMessage>, const Address& > SendCtrlCallback;
 
+  /**
+   * Callback to indicate that the encapsulator has (again) data to be
+   * transmitted without a new PDU being enqueued, e.g. due to an ARQ
+   * retransmission.
+   * \param Mac48Address Destination MAC address of the encapsulator
+   * \param uint8_t Flow identifier of the encapsulator
+   */
+  typedef Callback<void, Mac48Address, uint8_t> BacklogCallback;
+
   /**
    * Set the used queue from outside
    * \param queue Transmission queue
@@ -120,6 +129,12 @@ public:
    */
   void SetCtrlMsgCallback (SatBaseEncapsulator::SendCtrlCallback cb);
 
+  /**
+   * \param cb callback to indicate that the encapsulator has data to be
+   *        transmitted without a new PDU being enqueued.
+   */
+  void SetBacklogCallback (SatBaseEncapsulator::BacklogCallback cb);
+
   /**
    * Enqueue a packet to txBuffer.
    * \param p To be buffered packet
@@ -200,6 +215,11 @@ protected:
   */
   SendCtrlCallback m_ctrlCallback;
 
+  /**
+   * Callback to indicate that there is data to be transmitted.
+   */
+  BacklogCallback m_backlogCallback;
+
 };
 
 
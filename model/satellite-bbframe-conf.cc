@@ -145,6 +145,7 @@ SatBbFrameConf::SatBbFrameConf ()
     m_shortFramePayloadInSlots (),
     m_normalFramePayloadInSlots (),
     m_waveforms (),
+    m_acmTables (),
     m_bbFrameUsageMode (NORMAL_FRAMES),
     m_mostRobustShortFrameModcod (SatEnums::SAT_NONVALID_MODCOD),
     m_mostRobustNormalFrameModcod (SatEnums::SAT_NONVALID_MODCOD)
@@ -169,6 +170,7 @@ SatBbFrameConf::SatBbFrameConf (double symbolRate)
     m_shortFramePayloadInSlots (),
     m_normalFramePayloadInSlots (),
     m_waveforms (),
+    m_acmTables (),
     m_bbFrameUsageMode (NORMAL_FRAMES),
     m_mostRobustShortFrameModcod (SatEnums::SAT_NONVALID_MODCOD),
     m_mostRobustNormalFrameModcod (SatEnums::SAT_NONVALID_MODCOD)
@@ -249,6 +251,8 @@ SatBbFrameConf::SatBbFrameConf (double symbolRate)
       // currently is assumed that the most robust MODCODs are same for both short and normal frames
       NS_FATAL_ERROR ("The most robust MODCODs are different for short and normal frames!!!");
     }
+
+  BuildAcmTables ();
 }
 
 TypeId
@@ -379,6 +383,31 @@ SatBbFrameConf::InitializeCNoRequirements ( Ptr<SatLinkResultsDvbS2> linkResults
       */
       it->second->SetCNoRequirement (SatUtils::DbToLinear (esnoRequirementDb) * m_symbolRate);
     }
+
+  BuildAcmTables ();
+}
+
+void
+SatBbFrameConf::BuildAcmTables ()
+{
+  NS_LOG_FUNCTION (this);
+
+  m_acmTables.clear ();
+  m_acmTables.resize (SatEnums::DUMMY_FRAME + 1);
+
+  for (waveformMap_t::const_iterator it = m_waveforms.begin ();
+       it != m_waveforms.end ();
+       ++it)
+    {
+      m_acmTables.at (it->second->GetBbFrameType ()).Add (it->second->GetCNoRequirement (), it->second->GetModcod ());
+    }
+
+  for (std::vector<SatAcmThresholdTable>::iterator it = m_acmTables.begin ();
+       it != m_acmTables.end ();
+       ++it)
+    {
+      it->Build ();
+    }
 }
 
 void
@@ -495,22 +524,43 @@ SatBbFrameConf::GetBestModcod (double cNo, SatEnums::SatBbFrameType_t frameType)
       return m_defaultModCod;
     }
 
-  // Return the waveform with best spectral efficiency
-  for ( waveformMap_t::const_reverse_iterator rit = m_waveforms.rbegin ();
-        rit != m_waveforms.rend ();
-        ++rit )
+  // Return the waveform with best spectral efficiency, whose threshold is met
+  uint32_t modcod;
+
+  if ((uint32_t) frameType < m_acmTables.size ()
+      && m_acmTables[frameType].GetBestId (cNo, modcod))
+    {
+      return (SatEnums::SatModcod_t) modcod;
+    }
+
+  return m_defaultModCod;
+}
+
+void
+SatBbFrameConf::GetBestModcods (const std::vector<double>& cNos,
+                                SatEnums::SatBbFrameType_t frameType,
+                                std::vector<SatEnums::SatModcod_t>& modcods) const
+{
+  NS_LOG_FUNCTION (this << cNos.size () << frameType);
+
+  modcods.assign (cNos.size (), m_defaultModCod);
+
+  // If ACM is disabled, return the default MODCOD
+  if (!m_acmEnabled || (uint32_t) frameType >= m_acmTables.size ())
+    {
+      return;
+    }
+
+  const SatAcmThresholdTable& table = m_acmTables[frameType];
+  uint32_t modcod;
+
+  for (uint32_t i = 0; i < cNos.size (); ++i)
     {
-      if (rit->second->GetBbFrameType () == frameType)
+      if (table.GetBestId (cNos[i], modcod))
         {
-          double cnoReq = rit->second->GetCNoRequirement ();
-          // The first waveform over the threshold
-          if (cnoReq <= cNo)
-            {
-              return rit->second->GetModcod ();
-            }
+          modcods[i] = (SatEnums::SatModcod_t) modcod;
         }
     }
-  return m_defaultModCod;
 }
 
 SatEnums::SatModcod_t
@@ -22,11 +22,13 @@
 #define SATELLITE_BBFRAME_CONF_H
 
 #include <map>
+#include <vector>
 #include <ns3/ptr.h>
 #include <ns3/object.h>
 #include <ns3/simple-ref-count.h>
 #include <ns3/nstime.h>
 #include <ns3/satellite-enums.h>
+#include <ns3/satellite-acm-threshold-table.h>
 
 namespace ns3 {
 
@@ -257,6 +259,16 @@ public:
    */
   SatEnums::SatModcod_t GetBestModcod (double cNo, SatEnums::SatBbFrameType_t frameType) const;
 
+  /**
+   * \brief Get the best MODCODs with a given BB frame type for a set of C/No values.
+   * \param cNos C/No values of the UTs to be scheduled
+   * \param frameType Used BBFrame type (short OR normal)
+   * \param modcods Container for passing the best MODCOD of each C/No value to the client
+   */
+  void GetBestModcods (const std::vector<double>& cNos,
+                       SatEnums::SatBbFrameType_t frameType,
+                       std::vector<SatEnums::SatModcod_t>& modcods) const;
+
   /**
    * Get the default MODCOD
    * \return SatModcod_t The default MODCOD
@@ -293,6 +305,12 @@ private:
    */
   Time CalculateBbFrameDuration (SatEnums::SatModcod_t modcod, SatEnums::SatBbFrameType_t frameType) const;
 
+  /**
+   * \brief Build the ACM threshold tables of the BB frame types from the
+   * C/No requirements of the waveforms.
+   */
+  void BuildAcmTables ();
+
   /**
    * Symbol rate in baud
    */
@@ -369,6 +387,11 @@ private:
    */
   waveformMap_t m_waveforms;
 
+  /**
+   * ACM threshold tables of the MODCODs indexed by BB frame type
+   */
+  std::vector<SatAcmThresholdTable> m_acmTables;
+
   /**
    * BBFrame usage mode.
    */
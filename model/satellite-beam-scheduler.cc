@@ -180,12 +180,19 @@ SatBeamScheduler::GetTypeId (void)
                    MakeEnumAccessor (&SatBeamScheduler::m_cnoEstimatorMode),
                    MakeEnumChecker (SatCnoEstimator::LAST, "LastValueInWindow",
                                     SatCnoEstimator::MINIMUM, "MinimumValueInWindow",
-                                    SatCnoEstimator::AVERAGE, "AverageValueInWindow"))
+                                    SatCnoEstimator::AVERAGE, "AverageValueInWindow",
+                                    SatCnoEstimator::EWMA, "ExponentialAverage",
+                                    SatCnoEstimator::PERCENTILE, "PercentileInWindow"))
     .AddAttribute ( "CnoEstimationWindow",
                     "Time window for C/N0 estimation.",
                     TimeValue (MilliSeconds (1000)),
                     MakeTimeAccessor (&SatBeamScheduler::m_cnoEstimationWindow),
                     MakeTimeChecker ())
+    .AddAttribute ( "CnoEstimationPercentile",
+                    "Percentile of the C/N0 samples in the window used in PercentileInWindow mode.",
+                    DoubleValue (10.0),
+                    MakeDoubleAccessor (&SatBeamScheduler::m_cnoEstimationPercentile),
+                    MakeDoubleChecker<double> (0.0, 100.0))
     .AddAttribute ( "MaxTwoWayPropagationDelay",
                     "Maximum two way propagation delay between GW and UT.",
                     TimeValue (MilliSeconds (560)),
@@ -244,8 +251,10 @@ SatBeamScheduler::SatBeamScheduler ()
     m_superFrameCounter (0),
     m_txCallback (0),
     m_cnoEstimatorMode (SatCnoEstimator::LAST),
+    m_cnoEstimationPercentile (10.0),
     m_maxBbFrameSize (0),
-    m_controlSlotsEnabled (false)
+    m_controlSlotsEnabled (false),
+    m_tbtpPool (Create<SatTbtpMessagePool> ())
 {
   NS_LOG_FUNCTION (this);
 }
@@ -260,6 +269,7 @@ SatBeamScheduler::DoDispose ()
 {
   NS_LOG_FUNCTION (this);
   m_txCallback.Nullify ();
+  m_tbtpPool->Clear ();
   Object::DoDispose ();
 }
 
@@ -355,7 +365,8 @@ SatBeamScheduler::AddUt (Address utId, Ptr<SatLowerLayerServiceConf> llsConf)
   Ptr<SatCnoEstimator> cnoEstimator = CreateCnoEstimator ();
   Ptr<SatUtInfo> utInfo = Create<SatUtInfo> (damaEntry, cnoEstimator, firstCtrlSlotInterval, m_controlSlotsEnabled);
 
-  std::pair<UtInfoMap_t::iterator, bool > result = m_utInfos.insert (std::make_pair (utId, utInfo));
+  uint32_t utIndex = m_utInfos.size ();
+  std::pair<std::map<Address, uint32_t>::iterator, bool > result = m_utIndices.insert (std::make_pair (utId, utIndex));
 
   if (result.second)
     {
@@ -364,7 +375,9 @@ SatBeamScheduler::AddUt (Address utId, Ptr<SatLowerLayerServiceConf> llsConf)
       allocReq.m_cno = NAN;
       allocReq.m_address = utId;
 
-      m_utRequestInfos.push_back (std::make_pair (utId, allocReq));
+      m_utInfos.push_back (utInfo);
+      m_utRequestInfos.push_back (allocReq);
+      m_utOrder.push_back (utIndex);
     }
   else
     {
@@ -383,10 +396,10 @@ SatBeamScheduler::UpdateUtCno (Address utId, double cno)
   NS_LOG_FUNCTION (this << utId << cno);
 
   // check that UT is added to this scheduler.
-  UtInfoMap_t::iterator result = m_utInfos.find (utId);
-  NS_ASSERT (result != m_utInfos.end ());
+  std::map<Address, uint32_t>::const_iterator result = m_utIndices.find (utId);
+  NS_ASSERT (result != m_utIndices.end ());
 
-  m_utInfos[utId]->AddCnoSample (cno);
+  m_utInfos[result->second]->AddCnoSample (cno);
 }
 
 void
@@ -395,12 +408,12 @@ SatBeamScheduler::UtCrReceived (Address utId, Ptr<SatCrMessage> crMsg)
   NS_LOG_FUNCTION (this << utId << crMsg);
 
   // check that UT is added to this scheduler.
-  UtInfoMap_t::iterator result = m_utInfos.find (utId);
-  NS_ASSERT (result != m_utInfos.end ());
+  std::map<Address, uint32_t>::const_iterator result = m_utIndices.find (utId);
+  NS_ASSERT (result != m_utIndices.end ());
 
   NS_LOG_INFO ("SatBeamScheduler::UtCrReceived - UT: " << utId << " @ " << Now ().GetSeconds ());
 
-  m_utInfos[utId]->AddCrMsg (crMsg);
+  m_utInfos[result->second]->AddCrMsg (crMsg);
 }
 
 Ptr<SatCnoEstimator>
@@ -418,6 +431,14 @@ SatBeamScheduler::CreateCnoEstimator ()
       estimator = Create<SatBasicCnoEstimator> (m_cnoEstimatorMode, m_cnoEstimationWindow);
       break;
 
+    case SatCnoEstimator::EWMA:
+      estimator = Create<SatEwmaCnoEstimator> (m_cnoEstimationWindow);
+      break;
+
+    case SatCnoEstimator::PERCENTILE:
+      estimator = Create<SatPercentileCnoEstimator> (m_cnoEstimationWindow, m_cnoEstimationPercentile);
+      break;
+
     default:
       NS_FATAL_ERROR ("Not supported C/N0 estimation mode!!!");
       break;
@@ -443,8 +464,7 @@ SatBeamScheduler::Schedule ()
       DoPreResourceAllocation ();
 
       // generate time slots
-      Ptr<SatTbtpMessage> firstTbtp = CreateObject<SatTbtpMessage> (SatConstVariables::SUPERFRAME_SEQUENCE);
-      firstTbtp->SetSuperframeCounter (m_superFrameCounter++);
+      Ptr<SatTbtpMessage> firstTbtp = m_tbtpPool->Get (SatConstVariables::SUPERFRAME_SEQUENCE, m_superFrameCounter++);
 
       std::vector<Ptr<SatTbtpMessage> > tbtps;
       tbtps.push_back (firstTbtp);
@@ -455,7 +475,7 @@ SatBeamScheduler::Schedule ()
       SatFrameAllocator::UtAllocInfoContainer_t utAllocs;
 
       // Add DA slots to TBTP(s)
-      m_superframeAllocator->GenerateTimeSlots (tbtps, m_maxBbFrameSize, utAllocs, m_waveformTrace, m_frameUtLoadTrace, m_frameLoadTrace);
+      m_superframeAllocator->GenerateTimeSlots (tbtps, m_tbtpPool, m_maxBbFrameSize, utAllocs, m_waveformTrace, m_frameUtLoadTrace, m_frameLoadTrace);
 
       // update VBDC counter of the UT/RCs
       offeredKbpsSum += UpdateDamaEntriesWithAllocs (utAllocs);
@@ -521,8 +541,7 @@ SatBeamScheduler::AddRaChannels (std::vector <Ptr<SatTbtpMessage> >& tbtpContain
         {
           if ( (tbtpToFill->GetSizeInBytes () + (tbtpToFill->GetTimeSlotInfoSizeInBytes () * timeSlotCount) + frameInfoSize) > m_maxBbFrameSize )
             {
-              Ptr<SatTbtpMessage> newTbtp = CreateObject<SatTbtpMessage> (tbtpToFill->GetSuperframeSeqId ());
-              newTbtp->SetSuperframeCounter ( tbtpToFill->GetSuperframeCounter ());
+              Ptr<SatTbtpMessage> newTbtp = m_tbtpPool->Get (tbtpToFill->GetSuperframeSeqId (), tbtpToFill->GetSuperframeCounter ());
 
               tbtpContainer.push_back (newTbtp);
 
@@ -541,52 +560,54 @@ SatBeamScheduler::UpdateDamaEntriesWithReqs ()
 
   uint32_t requestedCraRbdcKbps (0);
 
-  for (UtReqInfoContainer_t::iterator it = m_utRequestInfos.begin (); it != m_utRequestInfos.end (); it++)
+  for (std::vector<uint32_t>::const_iterator utIndex = m_utOrder.begin (); utIndex != m_utOrder.end (); utIndex++)
     {
       // estimation of the C/N0 is done when scheduling UT
 
-      Ptr<SatDamaEntry> damaEntry = m_utInfos.at (it->first)->GetDamaEntry ();
+      Ptr<SatUtInfo> utInfo = m_utInfos[*utIndex];
+      SatFrameAllocator::SatFrameAllocReq* allocReq = &m_utRequestInfos[*utIndex];
+      Ptr<SatDamaEntry> damaEntry = utInfo->GetDamaEntry ();
 
       // process received CRs
-      m_utInfos.at (it->first)->UpdateDamaEntryFromCrs ();
+      utInfo->UpdateDamaEntryFromCrs ();
 
       // update allocation request information to be used later to request capacity from frame allocator
-      it->second.m_cno = m_utInfos.at (it->first)->GetCnoEstimation ();
+      allocReq->m_cno = utInfo->GetCnoEstimation ();
 
       // set control slot generation on or off
-      it->second.m_generateCtrlSlot = m_utInfos.at (it->first)->IsControlSlotGenerationTime ();
+      allocReq->m_generateCtrlSlot = utInfo->IsControlSlotGenerationTime ();
 
       for (uint8_t i = 0; i < damaEntry->GetRcCount (); i++ )
         {
           double superFrameDurationInSeconds = m_superframeSeq->GetSuperframeConf (SatConstVariables::SUPERFRAME_SEQUENCE)->GetDuration ().GetSeconds ();
 
-          it->second.m_reqPerRc[i].m_craBytes = (SatConstVariables::BITS_IN_KBIT * damaEntry->GetCraInKbps (i) * superFrameDurationInSeconds ) / (double)(SatConstVariables::BITS_PER_BYTE);
-          it->second.m_reqPerRc[i].m_rbdcBytes = (SatConstVariables::BITS_IN_KBIT * damaEntry->GetRbdcInKbps (i) * superFrameDurationInSeconds ) / (double)(SatConstVariables::BITS_PER_BYTE);
-          it->second.m_reqPerRc[i].m_vbdcBytes = damaEntry->GetVbdcInBytes (i);
+          allocReq->m_reqPerRc[i].m_craBytes = (SatConstVariables::BITS_IN_KBIT * damaEntry->GetCraInKbps (i) * superFrameDurationInSeconds ) / (double)(SatConstVariables::BITS_PER_BYTE);
+          allocReq->m_reqPerRc[i].m_rbdcBytes = (SatConstVariables::BITS_IN_KBIT * damaEntry->GetRbdcInKbps (i) * superFrameDurationInSeconds ) / (double)(SatConstVariables::BITS_PER_BYTE);
+          allocReq->m_reqPerRc[i].m_vbdcBytes = damaEntry->GetVbdcInBytes (i);
 
           // Collect the requested rate for all UTs per beam
           requestedCraRbdcKbps += damaEntry->GetCraInKbps (i);
           requestedCraRbdcKbps += damaEntry->GetRbdcInKbps (i);
 
           uint16_t minRbdcCraDeltaRateInKbps = std::max (0, damaEntry->GetMinRbdcInKbps (i) - damaEntry->GetCraInKbps (i));
-          it->second.m_reqPerRc[i].m_minRbdcBytes = (SatConstVariables::BITS_IN_KBIT * minRbdcCraDeltaRateInKbps  * superFrameDurationInSeconds ) / (double)(SatConstVariables::BITS_PER_BYTE);
+          allocReq->m_reqPerRc[i].m_minRbdcBytes = (SatConstVariables::BITS_IN_KBIT * minRbdcCraDeltaRateInKbps  * superFrameDurationInSeconds ) / (double)(SatConstVariables::BITS_PER_BYTE);
 
           // if UT is not requesting any RBDC for this RC then set minimum RBDC 0
           // This means that no RBDC is actively requested for this RC
-          if (it->second.m_reqPerRc[i].m_rbdcBytes == 0)
+          if (allocReq->m_reqPerRc[i].m_rbdcBytes == 0)
             {
-              it->second.m_reqPerRc[i].m_minRbdcBytes = 0;
+              allocReq->m_reqPerRc[i].m_minRbdcBytes = 0;
             }
 
-          NS_ASSERT ((it->second.m_reqPerRc[i].m_minRbdcBytes <= it->second.m_reqPerRc[i].m_rbdcBytes));
+          NS_ASSERT ((allocReq->m_reqPerRc[i].m_minRbdcBytes <= allocReq->m_reqPerRc[i].m_rbdcBytes));
 
-          //it->second.m_reqPerRc[i].m_rbdcBytes = std::max(it->second.m_reqPerRc[i].m_minRbdcBytes, it->second.m_reqPerRc[i].m_rbdcBytes);
+          //allocReq->m_reqPerRc[i].m_rbdcBytes = std::max(allocReq->m_reqPerRc[i].m_minRbdcBytes, allocReq->m_reqPerRc[i].m_rbdcBytes);
 
           // write backlog requests traces starts ...
           std::stringstream head;
           head << Now ().GetSeconds () << ", ";
           head << m_beamId << ", ";
-          head << Singleton<SatIdMapper>::Get ()->GetUtIdWithMac (it->first) << ", ";
+          head << Singleton<SatIdMapper>::Get ()->GetUtIdWithMac (allocReq->m_address) << ", ";
 
           std::stringstream rbdcTail;
           rbdcTail << SatEnums::DA_RBDC << ", ";
@@ -612,14 +633,24 @@ void SatBeamScheduler::DoPreResourceAllocation ()
 
   if ( m_utInfos.size () > 0 )
     {
-      // sort UT requests according to C/N0 of the UTs
-      m_utRequestInfos.sort (CnoCompare (m_utInfos));
+      // sort UT requests according to C/N0 of the UTs, estimated already in UpdateDamaEntriesWithReqs
+      m_cnoSortKeys.resize (m_utOrder.size ());
+
+      for (uint32_t i = 0; i < m_utOrder.size (); i++)
+        {
+          m_cnoSortKeys[i].cno = m_utRequestInfos[m_utOrder[i]].m_cno;
+          m_cnoSortKeys[i].utIndex = m_utOrder[i];
+        }
+
+      std::stable_sort (m_cnoSortKeys.begin (), m_cnoSortKeys.end (), &SatBeamScheduler::CompareCnoSortKeys);
 
       SatFrameAllocator::SatFrameAllocContainer_t allocReqs;
+      allocReqs.reserve (m_cnoSortKeys.size ());
 
-      for (UtReqInfoContainer_t::iterator it = m_utRequestInfos.begin (); it != m_utRequestInfos.end (); it++)
+      for (uint32_t i = 0; i < m_cnoSortKeys.size (); i++)
         {
-          allocReqs.push_back (&(it->second));
+          m_utOrder[i] = m_cnoSortKeys[i].utIndex;
+          allocReqs.push_back (&m_utRequestInfos[m_utOrder[i]]);
         }
 
       // request capacity for UTs from frame allocator
@@ -634,17 +665,17 @@ SatBeamScheduler::UpdateDamaEntriesWithAllocs (SatFrameAllocator::UtAllocInfoCon
 
   uint32_t offeredCraRbdcKbps (0);
 
-  for (UtReqInfoContainer_t::iterator it = m_utRequestInfos.begin (); it != m_utRequestInfos.end (); it++)
+  for (std::vector<uint32_t>::const_iterator utIndex = m_utOrder.begin (); utIndex != m_utOrder.end (); utIndex++)
     {
-      Ptr<SatDamaEntry> damaEntry = m_utInfos.at (it->first)->GetDamaEntry ();
-      SatFrameAllocator::UtAllocInfoContainer_t::const_iterator allocInfo = utAllocContainer.find (it->first);
+      Ptr<SatDamaEntry> damaEntry = m_utInfos[*utIndex]->GetDamaEntry ();
+      SatFrameAllocator::UtAllocInfoContainer_t::const_iterator allocInfo = utAllocContainer.find (m_utRequestInfos[*utIndex].m_address);
 
       if ( allocInfo != utAllocContainer.end ())
         {
           // update time to send next control slot, if control slot is allocated
           if ( allocInfo->second.second )
             {
-              m_utInfos.at (allocInfo->first)->SetControlSlotGenerationTime (m_controlSlotInterval);
+              m_utInfos[*utIndex]->SetControlSlotGenerationTime (m_controlSlotInterval);
             }
 
           double superFrameDurationInSeconds = m_superframeSeq->GetSuperframeConf (SatConstVariables::SUPERFRAME_SEQUENCE)->GetDuration ().GetSeconds ();
@@ -21,8 +21,8 @@
 #ifndef SAT_BEAM_SCHEDULER_H
 #define SAT_BEAM_SCHEDULER_H
 
+#include <cmath>
 #include <vector>
-#include <list>
 #include <map>
 #include <ns3/object.h>
 #include <ns3/simple-ref-count.h>
@@ -285,70 +285,32 @@ private:
   };
 
   /**
-   * Pair to store capacity request information for the UT
+   * C/N0 sort key of a UT, i.e. the C/N0 estimation of the UT taken once
+   * per superframe and the index of the UT.
    */
-  typedef std::pair<Address, SatFrameAllocator::SatFrameAllocReq >   UtReqInfoItem_t;
-
-  /**
-   * Map container to store UT information.
-   */
-  typedef std::map<Address, Ptr<SatUtInfo> >                         UtInfoMap_t;
-
-  /**
-   * Container to store capacity request information for the UTs.
-   */
-  typedef std::list<UtReqInfoItem_t>                                 UtReqInfoContainer_t;
+  typedef struct
+  {
+    double    cno;
+    uint32_t  utIndex;
+  } CnoSortKey_t;
 
   /**
-   * \brief CnoCompare class to sort UT request according to C/N0 information
+   * Compare the C/N0 sort keys of two UTs. The UTs are sorted in ascending
+   * order of C/N0, the UTs without C/N0 estimation being the last ones.
+   *
+   * \param key1 Sort key of UT 1
+   * \param key2 Sort key of UT 2
+   * \return true if UT 1 is sorted before UT 2
    */
-  class CnoCompare
+  static inline bool CompareCnoSortKeys (const CnoSortKey_t& key1, const CnoSortKey_t& key2)
   {
-public:
-    /**
-     * Construct CnoCompare object
-     *
-     * \param utInfoMap Reference to map container for the UT information
-     */
-    CnoCompare (const UtInfoMap_t& utInfoMap)
-      : m_utInfoMap (utInfoMap)
-    {
-    }
+    if ( std::isnan (key1.cno) )
+      {
+        return false;
+      }
 
-    /**
-     * Compare operator to compare request information of the two UTs.
-     *
-     * \param utReqInfo1 Request information for UT 1
-     * \param utReqInfo2 Request information for UT 2
-     * \return true if first UT's C/N0 is more robust than second UT's
-     */
-    bool operator() (UtReqInfoItem_t utReqInfo1, UtReqInfoItem_t utReqInfo2)
-    {
-      double result = false;
-
-      double cnoFirst = m_utInfoMap.at (utReqInfo1.first)->GetCnoEstimation ();
-      double cnoSecond = m_utInfoMap.at (utReqInfo2.first)->GetCnoEstimation ();
-
-      if ( !std::isnan (cnoFirst) )
-        {
-          if ( std::isnan (cnoSecond) )
-            {
-              result = false;
-            }
-          else
-            {
-              result = (cnoFirst < cnoSecond);
-            }
-        }
-
-      return result;
-    }
-private:
-    /**
-     * Reference to map container for the UT information
-     */
-    const UtInfoMap_t&  m_utInfoMap;
-  };
+    return ( std::isnan (key2.cno) || key1.cno < key2.cno );
+  }
 
   /**
    * ID of the beam
@@ -371,14 +333,31 @@ private:
   SatBeamScheduler::SendCtrlMsgCallback m_txCallback;
 
   /**
-   * Map to store UT information in beam for updating purposes.
+   * Indices of the UTs in beam by UT address. The index of a UT is the
+   * order in which the UT was added to the scheduler.
+   */
+  std::map<Address, uint32_t> m_utIndices;
+
+  /**
+   * UT information in beam for updating purposes, by UT index.
    */
-  UtInfoMap_t m_utInfos;
+  std::vector<Ptr<SatUtInfo> > m_utInfos;
 
   /**
-   * Container including every UT's allocation requests.
+   * Every UT's allocation requests, by UT index.
    */
-  UtReqInfoContainer_t  m_utRequestInfos;
+  std::vector<SatFrameAllocator::SatFrameAllocReq> m_utRequestInfos;
+
+  /**
+   * Indices of the UTs in the order of scheduling, i.e. sorted by C/N0
+   * in the latest superframe.
+   */
+  std::vector<uint32_t> m_utOrder;
+
+  /**
+   * C/N0 sort keys of the UTs, reused from superframe to superframe.
+   */
+  std::vector<CnoSortKey_t> m_cnoSortKeys;
 
   /**
    * Random variable stream to select RA channel for a UT.
@@ -395,6 +374,11 @@ private:
    */
   Time m_cnoEstimationWindow;
 
+  /**
+   * Percentile used in PERCENTILE mode of C/N0 estimation.
+   */
+  double m_cnoEstimationPercentile;
+
   /**
    * Superframe allocator to maintain load information of the frames and their configurations.
    */
@@ -429,6 +413,11 @@ private:
    */
   bool  m_controlSlotsEnabled;
 
+  /**
+   * Pool of the TBTP messages reused from superframe to superframe.
+   */
+  Ptr<SatTbtpMessagePool>  m_tbtpPool;
+
   /**
    * Trace for backlog requests done to beam scheduler.
    */
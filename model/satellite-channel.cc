@@ -34,6 +34,7 @@
 #include "satellite-mac-tag.h"
 #include "ns3/singleton.h"
 #include "ns3/boolean.h"
+#include "ns3/double.h"
 #include "satellite-rx-power-output-trace-container.h"
 #include "satellite-rx-power-input-trace-container.h"
 #include "satellite-fading-output-trace-container.h"
@@ -50,6 +51,8 @@ NS_OBJECT_ENSURE_REGISTERED (SatChannel);
 SatChannel::SatChannel ()
   : m_fwdMode (SatChannel::ALL_BEAMS),
     m_phyRxContainer (),
+    m_culledPhyRxContainers (),
+    m_cullingThresholdDb (-30.0),
     m_channelType (SatEnums::UNKNOWN_CH),
     m_carrierFreqConverter (),
     m_freqId (),
@@ -80,6 +83,7 @@ SatChannel::DoDispose ()
 {
   NS_LOG_FUNCTION (this);
   m_phyRxContainer.clear ();
+  m_culledPhyRxContainers.clear ();
   m_propagationDelay = 0;
   Channel::DoDispose ();
 }
@@ -117,7 +121,15 @@ SatChannel::GetTypeId (void)
                    MakeEnumAccessor (&SatChannel::m_fwdMode),
                    MakeEnumChecker (SatChannel::ONLY_DEST_NODE, "OnlyDestNode",
                                     SatChannel::ONLY_DEST_BEAM, "OnlyDestBeam",
-                                    SatChannel::ALL_BEAMS, "AllBeams"))
+                                    SatChannel::ALL_BEAMS, "AllBeams",
+                                    SatChannel::ALL_BEAMS_CULLED, "AllBeamsCulled"))
+    .AddAttribute ("CullingThreshold",
+                   "Culling threshold in dB used in AllBeamsCulled forwarding mode. "
+                   "Receivers whose combined antenna gain is below the best combined "
+                   "antenna gain of the transmitter by more than this are ignored.",
+                   DoubleValue (-30.0),
+                   MakeDoubleAccessor (&SatChannel::m_cullingThresholdDb),
+                   MakeDoubleChecker<double> ())
   ;
   return tid;
 }
@@ -127,6 +139,7 @@ SatChannel::AddRx (Ptr<SatPhyRx> phyRx)
 {
   NS_LOG_FUNCTION (this << phyRx);
   m_phyRxContainer.push_back (phyRx);
+  m_culledPhyRxContainers.clear ();
 }
 
 void
@@ -139,14 +152,23 @@ SatChannel::RemoveRx (Ptr<SatPhyRx> phyRx)
   if (phyIter != m_phyRxContainer.end ()) // == vector.end() means the element was not found
     {
       m_phyRxContainer.erase (phyIter);
+      m_culledPhyRxContainers.clear ();
     }
 }
 
 void
-SatChannel::StartTx (Ptr<SatSignalParameters> txParams)
+SatChannel::StartTx (Ptr<SatSignalParameters> params)
 {
-  NS_LOG_FUNCTION (this << txParams);
-  NS_ASSERT_MSG (txParams->m_phyTx, "NULL phyTx");
+  NS_LOG_FUNCTION (this << params);
+  NS_ASSERT_MSG (params->m_phyTx, "NULL phyTx");
+
+  /**
+   * Take one private snapshot of the transmitted packets, so that the transmitter
+   * may continue modifying its own packets. The snapshot is shared by all the
+   * receivers, which copy the packets only if they need to modify them.
+   */
+  Ptr<SatSignalParameters> txParams = params->Copy ();
+  txParams->MaterializePackets ();
 
   switch (m_fwdMode)
     {
@@ -250,6 +272,23 @@ SatChannel::StartTx (Ptr<SatSignalParameters> txParams)
           }
         break;
       }
+    /**
+     * The packet shall be received by all the receivers in the channel, to which
+     * the transmission causes non-negligible co-channel interference. Receivers
+     * of the own beam of the transmitter receive the packet always.
+    */
+    case SatChannel::ALL_BEAMS_CULLED:
+      {
+        const PhyRxContainer & receivers = GetCulledReceivers (txParams->m_phyTx, txParams->m_beamId);
+
+        for (PhyRxContainer::const_iterator rxPhyIterator = receivers.begin ();
+             rxPhyIterator != receivers.end ();
+             ++rxPhyIterator)
+          {
+            ScheduleRx (txParams, *rxPhyIterator);
+          }
+        break;
+      }
     default:
       {
         NS_FATAL_ERROR ("Unsupported SatChannel FwdMode!");
@@ -258,6 +297,72 @@ SatChannel::StartTx (Ptr<SatSignalParameters> txParams)
     }
 }
 
+const SatChannel::PhyRxContainer &
+SatChannel::GetCulledReceivers (Ptr<SatPhyTx> phyTx, uint32_t beamId)
+{
+  NS_LOG_FUNCTION (this << phyTx << beamId);
+
+  std::map<Ptr<SatPhyTx>, PhyRxContainer>::const_iterator it = m_culledPhyRxContainers.find (phyTx);
+
+  if (it != m_culledPhyRxContainers.end ())
+    {
+      return it->second;
+    }
+
+  std::vector<double> gains;
+  gains.reserve (m_phyRxContainer.size ());
+  double maxGain = 0.0;
+
+  // use always UT's or GW's position when getting antenna gain
+  for (PhyRxContainer::const_iterator rxPhyIterator = m_phyRxContainer.begin ();
+       rxPhyIterator != m_phyRxContainer.end ();
+       ++rxPhyIterator)
+    {
+      Ptr<MobilityModel> mobility;
+
+      switch (m_channelType)
+        {
+        case SatEnums::RETURN_FEEDER_CH:
+        case SatEnums::FORWARD_USER_CH:
+          {
+            mobility = (*rxPhyIterator)->GetMobility ();
+            break;
+          }
+        case SatEnums::RETURN_USER_CH:
+        case SatEnums::FORWARD_FEEDER_CH:
+          {
+            mobility = phyTx->GetMobility ();
+            break;
+          }
+        default:
+          {
+            NS_FATAL_ERROR ("SatChannel::GetCulledReceivers - Invalid channel type");
+            break;
+          }
+        }
+
+      double gain = phyTx->GetAntennaGain (mobility) * (*rxPhyIterator)->GetAntennaGain (mobility);
+      gains.push_back (gain);
+      maxGain = std::max (maxGain, gain);
+    }
+
+  double minGain = maxGain * SatUtils::DbToLinear (m_cullingThresholdDb);
+  PhyRxContainer & receivers = m_culledPhyRxContainers[phyTx];
+
+  for (uint32_t i = 0; i < m_phyRxContainer.size (); ++i)
+    {
+      if (m_phyRxContainer[i]->GetBeamId () == beamId || gains[i] >= minGain)
+        {
+          receivers.push_back (m_phyRxContainer[i]);
+        }
+    }
+
+  NS_LOG_INFO ("SatChannel::GetCulledReceivers - " << receivers.size () << " out of " <<
+               m_phyRxContainer.size () << " receivers selected for transmitter of beam " << beamId);
+
+  return receivers;
+}
+
 void
 SatChannel::ScheduleRx (Ptr<SatSignalParameters> txParams, Ptr<SatPhyRx> receiver)
 {
@@ -386,7 +491,8 @@ SatChannel::DoRxPowerOutputTrace (Ptr<SatSignalParameters> rxParams, Ptr<SatPhyR
     case SatEnums::RETURN_FEEDER_CH:
     case SatEnums::FORWARD_USER_CH:
       {
-        Singleton<SatRxPowerOutputTraceContainer>::Get ()->AddToContainer (std::make_pair (phyRx->GetDevice ()->GetAddress (), m_channelType), tempVector);
+        Singleton<SatRxPowerOutputTraceContainer>::Get ()->AddToContainer (std::make_pair (phyRx->GetDevice ()->GetAddress (), m_channelType), tempVector,
+                                                                           phyRx->GetIdMapperHandle ());
         break;
       }
     case SatEnums::FORWARD_FEEDER_CH:
@@ -461,7 +567,8 @@ SatChannel::DoFadingOutputTrace (Ptr<SatSignalParameters> rxParams, Ptr<SatPhyRx
     case SatEnums::RETURN_FEEDER_CH:
     case SatEnums::FORWARD_USER_CH:
       {
-        Singleton<SatFadingOutputTraceContainer>::Get ()->AddToContainer (std::make_pair (phyRx->GetDevice ()->GetAddress (), m_channelType), tempVector);
+        Singleton<SatFadingOutputTraceContainer>::Get ()->AddToContainer (std::make_pair (phyRx->GetDevice ()->GetAddress (), m_channelType), tempVector,
+                                                                          phyRx->GetIdMapperHandle ());
         break;
       }
     case SatEnums::FORWARD_FEEDER_CH:
@@ -555,13 +662,13 @@ SatChannel::GetExternalFadingTrace (Ptr<SatSignalParameters> rxParams, Ptr<SatPh
     {
     case SatEnums::RETURN_FEEDER_CH:
       {
-        nodeId = Singleton<SatIdMapper>::Get ()->GetGwIdWithMac (phyRx->GetDevice ()->GetAddress ());
+        nodeId = Singleton<SatIdMapper>::Get ()->GetGwIdWithHandle (phyRx->GetIdMapperHandle ());
         mobility = phyRx->GetMobility ();
         break;
       }
     case SatEnums::FORWARD_USER_CH:
       {
-        nodeId = Singleton<SatIdMapper>::Get ()->GetUtIdWithMac (phyRx->GetDevice ()->GetAddress ());
+        nodeId = Singleton<SatIdMapper>::Get ()->GetUtIdWithHandle (phyRx->GetIdMapperHandle ());
         mobility = phyRx->GetMobility ();
         break;
       }
@@ -22,6 +22,7 @@
 #ifndef SATELLITE_CHANNEL_H
 #define SATELLITE_CHANNEL_H
 
+#include <map>
 #include "ns3/object.h"
 #include "ns3/nstime.h"
 #include "ns3/channel.h"
@@ -76,12 +77,15 @@ public:
    * ONLY_DEST_NODE = only the receivers to which this transmission is intended to shall receive the packet
    * ONLY_DEST_BEAM = only the receivers within the proper spot-beam shall receive the packet
    * ALL_BEAMS = all receivers in the channel shall receive the packet
+   * ALL_BEAMS_CULLED = all receivers in the channel, whose antenna gain towards
+   * the transmitter is above the culling threshold, shall receive the packet
    */
   enum SatChannelFwdMode_e
   {
     ONLY_DEST_NODE,
     ONLY_DEST_BEAM,
-    ALL_BEAMS
+    ALL_BEAMS,
+    ALL_BEAMS_CULLED
   };
 
   /**
@@ -199,6 +203,19 @@ private:
    */
   PhyRxContainer m_phyRxContainer;
 
+  /**
+   * \brief Receivers of the channel which are not culled away in
+   * ALL_BEAMS_CULLED mode, stored separately for each transmitter.
+   */
+  std::map<Ptr<SatPhyTx>, PhyRxContainer> m_culledPhyRxContainers;
+
+  /**
+   * \brief Culling threshold in dB used in ALL_BEAMS_CULLED mode. Receivers
+   * whose combined Tx and Rx antenna gain is below the best combined gain of
+   * the transmitter by more than this are not passed the transmission.
+   */
+  double m_cullingThresholdDb;
+
   /**
    * \brief Type of the channel
    */
@@ -261,6 +278,19 @@ private:
    */
   void ScheduleRx (Ptr<SatSignalParameters> txParams, Ptr<SatPhyRx> phyRx);
 
+  /**
+   * \brief Get the receivers to which a transmission of a given transmitter
+   * is passed in ALL_BEAMS_CULLED mode. The receivers are selected based on the
+   * combined Tx and Rx antenna gain at the terrestrial node position, and
+   * receivers of the transmitter's own beam are always selected. The result is
+   * calculated once for each transmitter and flushed when receivers are added
+   * or removed. Thus, the culling assumes static terminal positions.
+   * \param phyTx The transmitter SatPhyTx entity
+   * \param beamId The beam id of the transmitter
+   * \return Container of the selected receivers
+   */
+  const PhyRxContainer & GetCulledReceivers (Ptr<SatPhyTx> phyTx, uint32_t beamId);
+
   /**
    * \brief Used internally to start the packet reception of at the phyRx.
    *
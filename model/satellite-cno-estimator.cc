@@ -18,7 +18,7 @@
  * Author: Sami Rantanen <sami.rantanen@magister.fi>
  */
 
-#include <numeric>
+#include <algorithm>
 #include <math.h>
 #include "ns3/log.h"
 #include "ns3/simulator.h"
@@ -61,16 +61,81 @@ SatCnoEstimator::GetCnoEstimation ()
   return DoGetCnoEstimation ();
 }
 
+// ring buffer for C/N0 samples
+
+SatCnoSampleBuffer::SatCnoSampleBuffer ()
+  : m_samples (),
+    m_first (0),
+    m_size (0)
+{
+  NS_LOG_FUNCTION (this);
+}
+
+void
+SatCnoSampleBuffer::PushBack (Time time, double cno)
+{
+  NS_LOG_FUNCTION (this << time << cno);
+
+  if (m_size == m_samples.size ())
+    {
+      // Grow to the next power of two and unwrap the samples to the beginning
+      std::vector<Sample_t> samples (std::max<size_t> (8, 2 * m_samples.size ()));
+
+      for (uint32_t i = 0; i < m_size; i++)
+        {
+          samples[i] = At (i);
+        }
+
+      m_samples.swap (samples);
+      m_first = 0;
+    }
+
+  Sample_t& sample = m_samples[(m_first + m_size) & (m_samples.size () - 1)];
+  sample.time = time;
+  sample.cno = cno;
+  m_size++;
+}
+
+void
+SatCnoSampleBuffer::PopFront ()
+{
+  NS_LOG_FUNCTION (this);
+  NS_ASSERT (m_size > 0);
+
+  m_first = (m_first + 1) & (m_samples.size () - 1);
+  m_size--;
+}
+
+void
+SatCnoSampleBuffer::PopBack ()
+{
+  NS_LOG_FUNCTION (this);
+  NS_ASSERT (m_size > 0);
+
+  m_size--;
+}
+
+void
+SatCnoSampleBuffer::Clear ()
+{
+  NS_LOG_FUNCTION (this);
+
+  m_first = 0;
+  m_size = 0;
+}
+
 // class for Basic C/N0 estimator
 
 SatBasicCnoEstimator::SatBasicCnoEstimator ()
-  : m_mode (LAST)
+  : m_sum (0.0),
+    m_mode (LAST)
 {
   NS_LOG_FUNCTION (this);
 }
 
 SatBasicCnoEstimator::SatBasicCnoEstimator (SatCnoEstimator::EstimationMode_t mode, Time window)
-  : m_window (window),
+  : m_sum (0.0),
+    m_window (window),
     m_mode (mode)
 
 {
@@ -87,21 +152,49 @@ SatBasicCnoEstimator::DoAddSample (double sample)
 {
   NS_LOG_FUNCTION (this << sample);
 
+  Time now = Simulator::Now ();
+
   switch (m_mode)
     {
     case LAST:
-      m_samples.clear ();
-      m_samples.insert (std::make_pair (Simulator::Now (), sample) );
+      m_samples.Clear ();
+      m_samples.PushBack (now, sample);
       break;
 
     case MINIMUM:
       ClearOutdatedSamples ();
-      m_samples.insert (std::make_pair (Simulator::Now (), sample) );
+
+      // only the first sample of a time instant is taken into account
+      if ( m_samples.IsEmpty () || m_samples.Back ().time != now )
+        {
+          m_samples.PushBack (now, sample);
+
+          if ( !std::isnan (sample) )
+            {
+              // samples greater than the new one cannot be the minimum anymore
+              while ( !m_minimumCandidates.IsEmpty () && m_minimumCandidates.Back ().cno > sample )
+                {
+                  m_minimumCandidates.PopBack ();
+                }
+
+              m_minimumCandidates.PushBack (now, sample);
+            }
+        }
       break;
 
     case AVERAGE:
       ClearOutdatedSamples ();
-      m_samples.insert (std::make_pair (Simulator::Now (), sample) );
+
+      // only the first sample of a time instant is taken into account
+      if ( m_samples.IsEmpty () || m_samples.Back ().time != now )
+        {
+          m_samples.PushBack (now, sample);
+
+          if ( !std::isnan (sample) )
+            {
+              m_sum += sample;
+            }
+        }
       break;
 
     default:
@@ -119,26 +212,23 @@ SatBasicCnoEstimator::DoGetCnoEstimation ()
 
   ClearOutdatedSamples ();
 
-  if (  m_samples.empty () == false )
+  if (  m_samples.IsEmpty () == false )
     {
       switch (m_mode)
         {
         case LAST:
-          estimatedCno = m_samples.begin ()->second;
+          estimatedCno = m_samples.Back ().cno;
           break;
 
         case MINIMUM:
-          for ( SampleMap_t::const_iterator it = m_samples.begin (); it != m_samples.end (); it++ )
+          if ( m_minimumCandidates.IsEmpty () == false )
             {
-              if ( std::isnan (estimatedCno) || (( !std::isnan (it->second)) && (it->second < estimatedCno)) )
-                {
-                  estimatedCno = it->second;
-                }
+              estimatedCno = m_minimumCandidates.Front ().cno;
             }
           break;
 
         case AVERAGE:
-          estimatedCno = std::accumulate (m_samples.begin (), m_samples.end (), 0.0, SatBasicCnoEstimator::AddToSum ) / m_samples.size ();
+          estimatedCno = m_sum / m_samples.GetSize ();
           break;
 
         default:
@@ -154,9 +244,155 @@ void
 SatBasicCnoEstimator::ClearOutdatedSamples ()
 {
   NS_LOG_FUNCTION (this);
-  SampleMap_t::iterator itLastValid = m_samples.lower_bound (Simulator::Now () - m_window );
 
-  m_samples.erase (m_samples.begin (), itLastValid );
+  Time firstValidTime = Simulator::Now () - m_window;
+
+  while ( !m_samples.IsEmpty () && m_samples.Front ().time < firstValidTime )
+    {
+      if ( m_mode == AVERAGE && !std::isnan (m_samples.Front ().cno) )
+        {
+          m_sum -= m_samples.Front ().cno;
+        }
+
+      m_samples.PopFront ();
+    }
+
+  while ( !m_minimumCandidates.IsEmpty () && m_minimumCandidates.Front ().time < firstValidTime )
+    {
+      m_minimumCandidates.PopFront ();
+    }
+
+  // start the running sum again from zero to avoid accumulating rounding errors
+  if ( m_samples.IsEmpty () )
+    {
+      m_sum = 0.0;
+    }
+}
+
+// class for EWMA C/N0 estimator
+
+SatEwmaCnoEstimator::SatEwmaCnoEstimator (Time window)
+  : m_window (window),
+    m_lastSampleTime (),
+    m_average (NAN)
+{
+  NS_LOG_FUNCTION (this << window);
+}
+
+SatEwmaCnoEstimator::~SatEwmaCnoEstimator ()
+{
+  NS_LOG_FUNCTION (this);
+}
+
+void
+SatEwmaCnoEstimator::DoAddSample (double sample)
+{
+  NS_LOG_FUNCTION (this << sample);
+
+  if ( std::isnan (sample) )
+    {
+      return;
+    }
+
+  Time now = Simulator::Now ();
+
+  if ( std::isnan (m_average) || m_window.IsZero () )
+    {
+      m_average = sample;
+    }
+  else
+    {
+      double weight = exp (-(now - m_lastSampleTime).GetSeconds () / m_window.GetSeconds ());
+      m_average = weight * m_average + (1.0 - weight) * sample;
+    }
+
+  m_lastSampleTime = now;
+}
+
+double
+SatEwmaCnoEstimator::DoGetCnoEstimation ()
+{
+  NS_LOG_FUNCTION (this);
+
+  if ( std::isnan (m_average) || Simulator::Now () - m_lastSampleTime > m_window )
+    {
+      return NAN;
+    }
+
+  return m_average;
+}
+
+// class for percentile C/N0 estimator
+
+SatPercentileCnoEstimator::SatPercentileCnoEstimator (Time window, double percentile)
+  : m_window (window),
+    m_percentile (percentile)
+{
+  NS_LOG_FUNCTION (this << window << percentile);
+
+  if ( percentile < 0.0 || percentile > 100.0 )
+    {
+      NS_FATAL_ERROR ("Percentile " << percentile << " out of range [0, 100]!!!");
+    }
+}
+
+SatPercentileCnoEstimator::~SatPercentileCnoEstimator ()
+{
+  NS_LOG_FUNCTION (this);
+}
+
+void
+SatPercentileCnoEstimator::DoAddSample (double sample)
+{
+  NS_LOG_FUNCTION (this << sample);
+
+  ClearOutdatedSamples ();
+
+  if ( !std::isnan (sample) )
+    {
+      m_samples.PushBack (Simulator::Now (), sample);
+    }
+}
+
+double
+SatPercentileCnoEstimator::DoGetCnoEstimation ()
+{
+  NS_LOG_FUNCTION (this);
+
+  ClearOutdatedSamples ();
+
+  if ( m_samples.IsEmpty () )
+    {
+      return NAN;
+    }
+
+  // m_values keeps its capacity, so it is reallocated only when the window grows
+  m_values.resize (m_samples.GetSize ());
+
+  for (uint32_t i = 0; i < m_samples.GetSize (); i++)
+    {
+      m_values[i] = m_samples.At (i).cno;
+    }
+
+  uint32_t rank = (uint32_t) ceil (m_percentile / 100.0 * m_values.size ());
+  uint32_t index = (rank > 0) ? rank - 1 : 0;
+
+  std::nth_element (m_values.begin (), m_values.begin () + index, m_values.end ());
+
+  return m_values[index];
+}
+
+void
+SatPercentileCnoEstimator::ClearOutdatedSamples ()
+{
+  NS_LOG_FUNCTION (this);
+
+  Time firstValidTime = Simulator::Now () - m_window;
+
+  while ( !m_samples.IsEmpty () && m_samples.Front ().time < firstValidTime )
+    {
+      m_samples.PopFront ();
+    }
 }
 
 } // namespace ns3
@@ -21,7 +21,7 @@
 #ifndef SAT_CNO_ESTIMATOR
 #define SAT_CNO_ESTIMATOR
 
-#include <map>
+#include <vector>
 
 #include "ns3/nstime.h"
 #include "ns3/simple-ref-count.h"
@@ -45,7 +45,9 @@ public:
   {
     LAST,   //!< Last value in the given window returned
     MINIMUM, //!< Minimum value in the given window returned
-    AVERAGE //!< Average value in the given window returned
+    AVERAGE, //!< Average value in the given window returned
+    EWMA, //!< Exponentially weighted moving average with the given window as time constant returned
+    PERCENTILE //!< Percentile of the values in the given window returned
   } EstimationMode_t;
 
   /**
@@ -96,6 +98,101 @@ private:
   virtual double DoGetCnoEstimation () = 0;
 };
 
+/**
+ * \ingroup satellite
+ * \brief SatCnoSampleBuffer is a ring buffer of time stamped C/N0 samples
+ * used by the windowed C/N0 estimators. Samples are added to the back and
+ * removed from either end. The storage grows by doubling when the buffer is
+ * full and it is never shrunk, so after the largest window has been filled
+ * once, adding and removing samples does not allocate memory.
+ */
+class SatCnoSampleBuffer
+{
+public:
+  /**
+   * Time stamped C/N0 sample
+   */
+  typedef struct
+  {
+    Time    time;
+    double  cno;
+  } Sample_t;
+
+  /**
+   * Default construct an empty SatCnoSampleBuffer.
+   */
+  SatCnoSampleBuffer ();
+
+  /**
+   * \return true if there are no samples in the buffer
+   */
+  inline bool IsEmpty () const
+  {
+    return m_size == 0;
+  }
+
+  /**
+   * \return Number of samples in the buffer
+   */
+  inline uint32_t GetSize () const
+  {
+    return m_size;
+  }
+
+  /**
+   * \param index Index of the sample, zero being the oldest sample
+   * \return The sample
+   */
+  inline const Sample_t& At (uint32_t index) const
+  {
+    return m_samples[(m_first + index) & (m_samples.size () - 1)];
+  }
+
+  /**
+   * \return The oldest sample
+   */
+  inline const Sample_t& Front () const
+  {
+    return At (0);
+  }
+
+  /**
+   * \return The newest sample
+   */
+  inline const Sample_t& Back () const
+  {
+    return At (m_size - 1);
+  }
+
+  /**
+   * Add a sample as the newest one.
+   *
+   * \param time Time of the sample
+   * \param cno C/N0 sample value
+   */
+  void PushBack (Time time, double cno);
+
+  /**
+   * Remove the oldest sample.
+   */
+  void PopFront ();
+
+  /**
+   * Remove the newest sample.
+   */
+  void PopBack ();
+
+  /**
+   * Remove all the samples.
+   */
+  void Clear ();
+
+private:
+  std::vector<Sample_t> m_samples;
+  uint32_t              m_first;
+  uint32_t              m_size;
+};
+
 /**
  * \ingroup satellite
  * \brief class for module SatCnoEstimator.
@@ -108,29 +205,15 @@ private:
  *  - MINIMUM: The minimum value in the window given when requested.
  *  - AVERAGE: The average of the samples in window given when requested.
  *
+ * The samples in the window are kept in a ring buffer. The minimum is kept
+ * up to date with a monotonic queue of the samples, which can still be the
+ * minimum of the window, and the average with a running sum of the samples.
+ * Thus, both adding a sample and getting the estimation take amortized
+ * constant time.
  */
 class SatBasicCnoEstimator : public SatCnoEstimator
 {
 public:
-  /**
-   * Method to add a sample value to current sum.
-   *
-   * \param currentSum
-   * \param sample
-   * \return New sum after addition.
-   */
-  static inline double AddToSum (double currentSum, const std::pair<Time, double>& sample)
-  {
-    double newSum = currentSum;
-
-    if ( !std::isnan (sample.second) )
-      {
-        newSum += sample.second;
-      }
-
-    return newSum;
-  }
-
   /**
    * Default construct a SatCnoEstimator.
    */
@@ -149,11 +232,104 @@ public:
   ~SatBasicCnoEstimator ();
 
 private:
-  typedef std::map<Time, double> SampleMap_t;
+  SatCnoSampleBuffer  m_samples;
+  SatCnoSampleBuffer  m_minimumCandidates;
+  double              m_sum;
+  Time                m_window;
+  EstimationMode_t    m_mode;
+
+  /**
+   * Add a C/N0 sample to estimator.
+   *
+   * \param cno C/N0 sample value
+   */
+  virtual void DoAddSample (double cno);
+
+  /**
+   * Estimate C/N0 value of the samples in window.
+   *
+   * \return Estimated value of the C/N0,
+   * in case that estimation cannot be done (e.g. no samples) NAN is returned.
+   */
+  virtual double DoGetCnoEstimation ();
+
+  /**
+   * Clear outdated samples from storage.
+   */
+  void ClearOutdatedSamples ();
+};
+
+/**
+ * \ingroup satellite
+ * \brief SatEwmaCnoEstimator estimates C/N0 as an exponentially weighted
+ * moving average of the samples. The weight of the previous average decays
+ * with the time since the previous sample, the given window being the time
+ * constant of the decay. NAN is returned, if no sample has been added
+ * during the window.
+ */
+class SatEwmaCnoEstimator : public SatCnoEstimator
+{
+public:
+  /**
+   * Construct a SatEwmaCnoEstimator with given time constant.
+   *
+   * \param window Time constant of the average
+   */
+  SatEwmaCnoEstimator (Time window);
+
+  /**
+   * Destroy a SatEwmaCnoEstimator
+   */
+  ~SatEwmaCnoEstimator ();
+
+private:
+  Time    m_window;
+  Time    m_lastSampleTime;
+  double  m_average;
+
+  /**
+   * Add a C/N0 sample to estimator.
+   *
+   * \param cno C/N0 sample value
+   */
+  virtual void DoAddSample (double cno);
 
-  SampleMap_t       m_samples;
-  Time              m_window;
-  EstimationMode_t  m_mode;
+  /**
+   * Estimate C/N0 value of the samples.
+   *
+   * \return Estimated value of the C/N0,
+   * in case that estimation cannot be done (e.g. no samples) NAN is returned.
+   */
+  virtual double DoGetCnoEstimation ();
+};
+
+/**
+ * \ingroup satellite
+ * \brief SatPercentileCnoEstimator estimates C/N0 as the given percentile
+ * (nearest rank) of the samples in the window. The zero percentile is the
+ * minimum and the 100th percentile the maximum of the samples.
+ */
+class SatPercentileCnoEstimator : public SatCnoEstimator
+{
+public:
+  /**
+   * Construct a SatPercentileCnoEstimator with given window and percentile.
+   *
+   * \param window Time window of the samples
+   * \param percentile Percentile in range [0, 100]
+   */
+  SatPercentileCnoEstimator (Time window, double percentile);
+
+  /**
+   * Destroy a SatPercentileCnoEstimator
+   */
+  ~SatPercentileCnoEstimator ();
+
+private:
+  SatCnoSampleBuffer  m_samples;
+  std::vector<double> m_values;
+  Time                m_window;
+  double              m_percentile;
 
   /**
    * Add a C/N0 sample to estimator.
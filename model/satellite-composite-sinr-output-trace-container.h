@@ -24,6 +24,7 @@
 #include "ns3/satellite-output-fstream-double-container.h"
 #include "satellite-enums.h"
 #include "ns3/mac48-address.h"
+#include "satellite-id-mapper.h"
 
 namespace ns3 {
 
@@ -77,8 +78,11 @@ public:
    * \brief Add the vector containing the values to container matching the key
    * \param key key
    * \param newItem vector of values
+   * \param idMapperHandle SatIdMapper handle of the MAC address of the key,
+   * e.g. SatNodeInfo::GetIdMapperHandle, or INVALID_HANDLE to look it up
    */
-  void AddToContainer (key_t key, std::vector<double> newItem);
+  void AddToContainer (key_t key, std::vector<double> newItem,
+                       uint32_t idMapperHandle = SatIdMapper::INVALID_HANDLE);
 
   /**
    * Function for enabling / disabling figure output
@@ -98,16 +102,18 @@ private:
   /**
    * \brief Function for adding the node to the map
    * \param key key
+   * \param idMapperHandle SatIdMapper handle of the MAC address of the key
    * \return pointer to the added container
    */
-  Ptr<SatOutputFileStreamDoubleContainer> AddNode (std::pair<Address,SatEnums::ChannelType_t> key);
+  Ptr<SatOutputFileStreamDoubleContainer> AddNode (std::pair<Address,SatEnums::ChannelType_t> key, uint32_t idMapperHandle);
 
   /**
    * \brief Function for finding the container matching the key
    * \param key key
+   * \param idMapperHandle SatIdMapper handle of the MAC address of the key
    * \return matching container
    */
-  Ptr<SatOutputFileStreamDoubleContainer> FindNode (key_t key);
+  Ptr<SatOutputFileStreamDoubleContainer> FindNode (key_t key, uint32_t idMapperHandle);
 
   /**
    * \brief Write the contents of a container matching to the key into a file
@@ -145,7 +145,8 @@ NS_OBJECT_ENSURE_REGISTERED (SatTbtpMessage);
 SatTbtpMessage::SatTbtpMessage ( )
   : m_superframeCounter (0),
     m_superframeSeqId (0),
-    m_assignmentFormat (0)
+    m_assignmentFormat (0),
+    m_emptyDaSlotContainer ()
 {
   NS_LOG_FUNCTION (this);
 }
@@ -153,7 +154,8 @@ SatTbtpMessage::SatTbtpMessage ( )
 SatTbtpMessage::SatTbtpMessage ( uint8_t seqId )
   : m_superframeCounter (0),
     m_superframeSeqId (seqId),
-    m_assignmentFormat (0)
+    m_assignmentFormat (0),
+    m_emptyDaSlotContainer ()
 {
   NS_LOG_FUNCTION (this << (uint32_t) seqId);
 }
@@ -164,6 +166,7 @@ SatTbtpMessage::~SatTbtpMessage ()
 
   m_frameIds.clear ();
   m_daTimeSlots.clear ();
+  m_daTimeSlotUts.Clear ();
 }
 
 TypeId
@@ -190,53 +193,70 @@ SatTbtpMessage::GetInstanceTypeId (void) const
 }
 
 const SatTbtpMessage::DaTimeSlotInfoItem_t&
-SatTbtpMessage::GetDaTimeslots (Address utId)
+SatTbtpMessage::GetDaTimeslots (Address utId) const
 {
   NS_LOG_FUNCTION (this << utId);
 
-  DaTimeSlotMap_t::const_iterator it = m_daTimeSlots.find (utId);
+  uint32_t index = m_daTimeSlotUts.Find (GetMacKey (utId));
 
-  if ( it != m_daTimeSlots.end () )
+  if ( index != m_daTimeSlotUts.NOT_FOUND )
     {
-      return it->second;
+      return m_daTimeSlotUts.GetValue (index);
     }
 
   return m_emptyDaSlotContainer;
 }
 
 void
-SatTbtpMessage::SetDaTimeslot (Mac48Address utId, uint8_t frameId, Ptr<SatTimeSlotConf> conf)
+SatTbtpMessage::SetDaTimeslot (Mac48Address utId, uint8_t frameId, const DaTimeSlot_t& timeSlot)
 {
-  NS_LOG_FUNCTION (this << utId << frameId << conf);
+  NS_LOG_FUNCTION (this << utId << (uint32_t) frameId << (uint32_t) timeSlot.rcIndex);
 
-  // find container for the UT from map
-  DaTimeSlotMap_t::iterator it = m_daTimeSlots.find (utId);
+  // If not found, add new UT item after the time slots of the previous UTs
+  DaTimeSlotInfoItem_t newInfo;
+  newInfo.frameId = frameId;
+  newInfo.first = m_daTimeSlots.size ();
+  newInfo.count = 0;
 
-  // If not found, add new UT container to map,
-  // otherwise use container found from map
-  if ( it == m_daTimeSlots.end () )
-    {
-      std::pair<DaTimeSlotMap_t::iterator, bool> result = m_daTimeSlots.insert (std::make_pair (utId, DaTimeSlotInfoItem_t ()));
+  uint32_t index = m_daTimeSlotUts.Insert (GetMacKey (utId), newInfo).first;
 
-      if ( result.second )
-        {
-          it = result.first;
-        }
-      else
-        {
-          // container creation for UT has failed, so we need to crash
-          NS_FATAL_ERROR ("Cannot insert slot to container!!!");
-        }
+  // The time slots of a UT are one after another, so only the UT added last
+  // can get more time slots without moving the time slots of the later UTs
+  if ( index + 1 != m_daTimeSlotUts.GetSize () )
+    {
+      NS_FATAL_ERROR ("Time slots of UT " << utId << " not set one after another!!!");
     }
 
-  // store time slot info to user specific container
-  it->second.first = frameId;
-  it->second.second.push_back ( conf  );
+  // store time slot info after the previous time slots of the UT
+  DaTimeSlotInfoItem_t& info = m_daTimeSlotUts.GetValue (index);
+  info.frameId = frameId;
+  info.count++;
+
+  m_daTimeSlots.push_back (timeSlot);
 
   // store frame ID to keep track of the used frames count
   m_frameIds.insert (frameId);
 }
 
+uint64_t
+SatTbtpMessage::GetMacKey (Address utId)
+{
+  uint64_t key = 0;
+
+  if (Mac48Address::IsMatchingType (utId))
+    {
+      uint8_t buffer[6];
+      Mac48Address::ConvertFrom (utId).CopyTo (buffer);
+
+      for (uint32_t i = 0; i < 6; ++i)
+        {
+          key = (key << 8) | buffer[i];
+        }
+    }
+
+  return key;
+}
+
 const SatTbtpMessage::RaChannelInfoContainer_t
 SatTbtpMessage::GetRaChannels () const
 {
@@ -340,10 +360,7 @@ uint32_t SatTbtpMessage::GetSizeInBytes () const
   uint32_t assignmentIdSizeInBytes = GetTimeSlotInfoSizeInBytes ();
 
   // add size of DA time slots
-  for (DaTimeSlotMap_t::const_iterator it = m_daTimeSlots.begin (); it != m_daTimeSlots.end (); it++ )
-    {
-      sizeInBytes += (it->second.second.size () * assignmentIdSizeInBytes);
-    }
+  sizeInBytes += (m_daTimeSlots.size () * assignmentIdSizeInBytes);
 
   // add size of RA time slots
   for (RaChannelMap_t::const_iterator it = m_raChannels.begin (); it != m_raChannels.end (); it++ )
@@ -361,18 +378,91 @@ void SatTbtpMessage::Dump () const
   ", superframe sequence id: " << m_superframeSeqId <<
   ", assignment format: " << m_assignmentFormat << std::endl;
 
-  for (DaTimeSlotMap_t::const_iterator mit = m_daTimeSlots.begin ();
-       mit != m_daTimeSlots.end ();
-       ++mit)
+  for (uint32_t index = 0; index < m_daTimeSlotUts.GetSize (); ++index)
     {
-      std::cout << "UT: " << mit->first << ": ";
-      std::cout << "Frame ID: " << mit->second.first << ": ";
-      std::cout << mit->second.second.size () << " ";
+      uint64_t key = m_daTimeSlotUts.GetKey (index);
+      const DaTimeSlotInfoItem_t& info = m_daTimeSlotUts.GetValue (index);
+      uint8_t buffer[6];
+
+      for (uint32_t i = 0; i < 6; ++i)
+        {
+          buffer[i] = (key >> (8 * (5 - i))) & 0xFF;
+        }
+
+      Mac48Address address;
+      address.CopyFrom (buffer);
+
+      std::cout << "UT: " << address << ": ";
+      std::cout << "Frame ID: " << info.frameId << ": ";
+      std::cout << info.count << " ";
       std::cout << std::endl;
     }
 
 }
 
+void
+SatTbtpMessage::Reset (uint8_t seqId)
+{
+  NS_LOG_FUNCTION (this << (uint32_t) seqId);
+
+  m_daTimeSlots.clear ();
+  m_daTimeSlotUts.Clear ();
+  m_raChannels.clear ();
+  m_frameIds.clear ();
+  m_superframeCounter = 0;
+  m_superframeSeqId = seqId;
+}
+
+// TBTP message pool
+
+SatTbtpMessagePool::SatTbtpMessagePool ()
+  : m_messages (),
+    m_next (0)
+{
+  NS_LOG_FUNCTION (this);
+}
+
+Ptr<SatTbtpMessage>
+SatTbtpMessagePool::Get (uint8_t seqId, uint32_t superframeCounter)
+{
+  NS_LOG_FUNCTION (this << (uint32_t) seqId << superframeCounter);
+
+  Ptr<SatTbtpMessage> tbtp = NULL;
+
+  for (uint32_t i = 0; i < m_messages.size (); i++)
+    {
+      uint32_t index = (m_next + i) % m_messages.size ();
+
+      // the only reference is the one in the pool
+      if ( m_messages[index]->GetReferenceCount () == 1 )
+        {
+          tbtp = m_messages[index];
+          tbtp->Reset (seqId);
+          m_next = (index + 1) % m_messages.size ();
+          break;
+        }
+    }
+
+  if ( tbtp == NULL )
+    {
+      tbtp = CreateObject<SatTbtpMessage> (seqId);
+      m_messages.push_back (tbtp);
+    }
+
+  tbtp->SetSuperframeCounter (superframeCounter);
+
+  return tbtp;
+}
+
+void
+SatTbtpMessagePool::Clear ()
+{
+  NS_LOG_FUNCTION (this);
+
+  m_messages.clear ();
+  m_next = 0;
+}
+
 NS_OBJECT_ENSURE_REGISTERED (SatCrMessage);
 
 TypeId
@@ -26,6 +26,7 @@
 #include <set>
 #include "ns3/header.h"
 #include "ns3/object.h"
+#include "ns3/simple-ref-count.h"
 #include "ns3/nstime.h"
 #include "ns3/simulator.h"
 #include "ns3/mac48-address.h"
@@ -33,6 +34,7 @@
 #include "satellite-mac-tag.h"
 #include "satellite-enums.h"
 #include "ns3/satellite-frame-conf.h"
+#include "ns3/satellite-flat-hash-map.h"
 
 namespace ns3 {
 
@@ -194,17 +196,31 @@ class SatTbtpMessage : public SatControlMessage
 {
 public:
   /**
-   * Container for time slot configurations in time slot map item DaTimeSlotMapItem_t.
+   * DA time slot assigned to a UT. The time slot is stored as a value in
+   * the TBTP instead of as a time slot configuration object.
    */
-  typedef std::vector< Ptr<SatTimeSlotConf> >  DaTimeSlotConfContainer_t;
+  typedef struct
+  {
+    Time      startTime;    // Start time of the time slot inside the frame
+    uint32_t  waveFormId;   // Wave form id of the time slot
+    uint16_t  carrierId;    // Carrier id of the time slot inside the frame
+    uint8_t   rcIndex;      // RC index of the time slot
+    SatTimeSlotConf::SatTimeSlotType_t slotType;  // Type of the time slot
+  } DaTimeSlot_t;
 
   /**
-   * Item for DA time slot information.
+   * Item for DA time slot information of a UT.
    *
-   * Stored information is pair, which member first holds frame id
-   * of the time slots and member second holds container of time slot configurations.
+   * Stored information is frame id of the time slots, and the index of the
+   * first time slot and the number of the time slots of the UT in the time
+   * slot array of the TBTP (see GetDaTimeslot).
    */
-  typedef std::pair<uint8_t, DaTimeSlotConfContainer_t>  DaTimeSlotInfoItem_t;
+  typedef struct
+  {
+    uint8_t   frameId;
+    uint32_t  first;
+    uint32_t  count;
+  } DaTimeSlotInfoItem_t;
 
   /**
    * Container for RA channel information
@@ -320,18 +336,32 @@ public:
    * Get the information of the DA time slots.
    *
    * \param utId  id of the UT which time slot information is requested
-   * \return vector containing DA time slot info
+   * \return DA time slot info of the UT, with zero count if there are no time slots
+   */
+  const DaTimeSlotInfoItem_t& GetDaTimeslots (Address utId) const;
+
+  /**
+   * Get a DA time slot
+   *
+   * \param index Index of the time slot in the time slot array
+   * \return DA time slot
    */
-  const DaTimeSlotInfoItem_t& GetDaTimeslots (Address utId);
+  inline const DaTimeSlot_t& GetDaTimeslot (uint32_t index) const
+  {
+    return m_daTimeSlots[index];
+  }
 
   /**
-   * Set a DA time slot information
+   * Set a DA time slot information. The time slots of a UT are stored one
+   * after another, so all the time slots of a UT must be set before the
+   * time slots of the next UT, as the frame allocator does. Setting a time
+   * slot to an earlier UT is a fatal error.
    *
    * \param utId id of the UT which time slot information is set
    * \param frameId Frame ID of the time slot
-   * \param conf Pointer to time slot configuration
+   * \param timeSlot Time slot
    */
-  void SetDaTimeslot (Mac48Address utId, uint8_t frameId, Ptr<SatTimeSlotConf> conf);
+  void SetDaTimeslot (Mac48Address utId, uint8_t frameId, const DaTimeSlot_t& timeSlot);
 
   /**
    * Get the information of the RA channels.
@@ -368,11 +398,35 @@ public:
    */
   void Dump () const;
 
+  /**
+   * Clear the time slots and the RA channels of the TBTP to reuse the
+   * message for another superframe. The capacity of the containers is kept.
+   *
+   * \param seqId sequence id
+   */
+  void Reset (uint8_t seqId);
+
 private:
   typedef std::map <uint8_t, uint16_t >  RaChannelMap_t;
-  typedef std::map<Address, DaTimeSlotInfoItem_t > DaTimeSlotMap_t;
 
-  DaTimeSlotMap_t   m_daTimeSlots;
+  /**
+   * \brief Convert an UT address to a 48-bit integer
+   * \param utId Address of the UT
+   * \return Address as an integer
+   */
+  static uint64_t GetMacKey (Address utId);
+
+  /**
+   * DA time slots of the TBTP, the time slots of a UT one after another
+   */
+  std::vector<DaTimeSlot_t> m_daTimeSlots;
+
+  /**
+   * DA time slot information of the UTs by the UT addresses as 48-bit
+   * integers, in the order of addition
+   */
+  SatFlatHashMap<uint64_t, DaTimeSlotInfoItem_t> m_daTimeSlotUts;
+
   RaChannelMap_t    m_raChannels;
   uint32_t          m_superframeCounter;
   uint8_t           m_superframeSeqId;
@@ -380,11 +434,53 @@ private:
   std::set<uint8_t> m_frameIds;
 
   /**
-   * Empty DA slot container to be returned if there are not DA time slots
+   * Empty DA slot info to be returned if there are not DA time slots
    */
   const DaTimeSlotInfoItem_t m_emptyDaSlotContainer;
 };
 
+/**
+ * \ingroup satellite
+ * \brief Pool of TBTP messages reused from superframe to superframe.
+ *
+ * The pool hands out a TBTP again once the pool holds the only reference
+ * to it, i.e. the message is no more stored by the control message
+ * containers or by the TBTP containers of the UTs.
+ */
+class SatTbtpMessagePool : public SimpleRefCount<SatTbtpMessagePool>
+{
+public:
+  /**
+   * Default constructor for SatTbtpMessagePool
+   */
+  SatTbtpMessagePool ();
+
+  /**
+   * \brief Get an empty TBTP message from the pool
+   * \param seqId sequence id
+   * \param superframeCounter super frame counter
+   * \return TBTP message
+   */
+  Ptr<SatTbtpMessage> Get (uint8_t seqId, uint32_t superframeCounter);
+
+  /**
+   * \brief Release all the TBTP messages of the pool
+   */
+  void Clear ();
+
+private:
+  /**
+   * TBTP messages of the pool
+   */
+  std::vector<Ptr<SatTbtpMessage> > m_messages;
+
+  /**
+   * Index of the message to check first in the next Get call. The messages
+   * are handed out round robin, the least recently used one checked first.
+   */
+  uint32_t m_next;
+};
+
 /**
  * \ingroup satellite
  * \brief The packet for the Capacity Request (CR) messages.
@@ -0,0 +1,140 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2016 Magister Solutions Ltd
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: agent <agent@local>
+ */
+
+#include <algorithm>
+#include "ns3/log.h"
+#include "ns3/simulator.h"
+#include "satellite-da-tx-opportunity-queue.h"
+
+NS_LOG_COMPONENT_DEFINE ("SatDaTxOpportunityQueue");
+
+namespace ns3 {
+
+SatDaTxOpportunityQueue::SatDaTxOpportunityQueue ()
+  : m_txOpportunities (),
+    m_event (),
+    m_txCallback ()
+{
+  NS_LOG_FUNCTION (this);
+}
+
+SatDaTxOpportunityQueue::~SatDaTxOpportunityQueue ()
+{
+  NS_LOG_FUNCTION (this);
+
+  Clear ();
+}
+
+void
+SatDaTxOpportunityQueue::SetTxCallback (TxCallback cb)
+{
+  NS_LOG_FUNCTION (this << &cb);
+
+  m_txCallback = cb;
+}
+
+void
+SatDaTxOpportunityQueue::Schedule (std::vector<DaTxOpportunity_t>& txOpportunities)
+{
+  NS_LOG_FUNCTION (this << txOpportunities.size ());
+
+  if (txOpportunities.empty ())
+    {
+      return;
+    }
+
+  // Time slots at the same time keep their TBTP order
+  std::stable_sort (txOpportunities.begin (), txOpportunities.end (), CompareTxTimes);
+
+  for (std::vector<DaTxOpportunity_t>::const_iterator it = txOpportunities.begin (); it != txOpportunities.end (); ++it)
+    {
+      NS_LOG_INFO ("SatDaTxOpportunityQueue::Schedule - at: " << it->txTime.GetSeconds () << " duration: " << it->duration.GetSeconds () << ", rcIndex: " << (uint32_t)(it->rcIndex) << ", carrier: " << it->carrierId);
+    }
+
+  uint32_t pendingCount = m_txOpportunities.size ();
+  m_txOpportunities.insert (m_txOpportunities.end (), txOpportunities.begin (), txOpportunities.end ());
+
+  // The new superframe normally starts after the pending time slots, otherwise
+  // merge keeping the pending ones first at the same time
+  if (pendingCount > 0 && txOpportunities.front ().txTime < m_txOpportunities[pendingCount - 1].txTime)
+    {
+      std::inplace_merge (m_txOpportunities.begin (), m_txOpportunities.begin () + pendingCount, m_txOpportunities.end (), CompareTxTimes);
+    }
+
+  ScheduleNextEvent ();
+}
+
+uint32_t
+SatDaTxOpportunityQueue::GetSize () const
+{
+  return m_txOpportunities.size ();
+}
+
+void
+SatDaTxOpportunityQueue::Clear ()
+{
+  NS_LOG_FUNCTION (this);
+
+  m_txOpportunities.clear ();
+  m_event.Cancel ();
+}
+
+void
+SatDaTxOpportunityQueue::ScheduleNextEvent ()
+{
+  NS_LOG_FUNCTION (this);
+
+  if (m_txOpportunities.empty ())
+    {
+      return;
+    }
+
+  Time delay = m_txOpportunities.front ().txTime - Simulator::Now ();
+
+  if (m_event.IsRunning ())
+    {
+      if (Simulator::GetDelayLeft (m_event) <= delay)
+        {
+          return;
+        }
+
+      m_event.Cancel ();
+    }
+
+  m_event = Simulator::Schedule (delay, &SatDaTxOpportunityQueue::DoTxOpportunities, this);
+}
+
+void
+SatDaTxOpportunityQueue::DoTxOpportunities ()
+{
+  NS_LOG_FUNCTION (this);
+
+  while (!m_txOpportunities.empty () && m_txOpportunities.front ().txTime <= Simulator::Now ())
+    {
+      DaTxOpportunity_t txOpportunity = m_txOpportunities.front ();
+      m_txOpportunities.pop_front ();
+
+      m_txCallback (txOpportunity);
+    }
+
+  ScheduleNextEvent ();
+}
+
+} // namespace ns3
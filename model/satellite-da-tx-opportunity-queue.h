@@ -0,0 +1,147 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2016 Magister Solutions Ltd
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: agent <agent@local>
+ */
+
+#ifndef SATELLITE_DA_TX_OPPORTUNITY_QUEUE_H_
+#define SATELLITE_DA_TX_OPPORTUNITY_QUEUE_H_
+
+#include <vector>
+#include <deque>
+#include <stdint.h>
+#include "ns3/ptr.h"
+#include "ns3/nstime.h"
+#include "ns3/event-id.h"
+#include "ns3/callback.h"
+#include "ns3/satellite-frame-conf.h"
+
+namespace ns3 {
+
+class SatWaveform;
+
+/**
+ * \ingroup satellite
+ * \brief SatDaTxOpportunityQueue holds the pending DA Tx opportunities,
+ * i.e. time slots, of a UT in the order of their transmission time.
+ *
+ * Only one simulator event is scheduled per queue, at the transmission time
+ * of the first pending Tx opportunity. The event passes all the Tx
+ * opportunities due at its time to the Tx callback and is scheduled again
+ * for the next one.
+ */
+class SatDaTxOpportunityQueue
+{
+public:
+  /**
+   * DA Tx opportunity, i.e. time slot, waiting for its transmission time.
+   */
+  typedef struct
+  {
+    Time                                txTime;
+    Time                                duration;
+    Ptr<SatWaveform>                    waveform;
+    SatTimeSlotConf::SatTimeSlotType_t  slotType;
+    uint8_t                             rcIndex;
+    uint32_t                            carrierId;
+  } DaTxOpportunity_t;
+
+  /**
+   * Callback for a Tx opportunity whose transmission time has been reached
+   */
+  typedef Callback<void, const DaTxOpportunity_t&> TxCallback;
+
+  /**
+   * Default constructor
+   */
+  SatDaTxOpportunityQueue ();
+
+  /**
+   * Destructor for SatDaTxOpportunityQueue
+   */
+  ~SatDaTxOpportunityQueue ();
+
+  /**
+   * \brief Set the callback called for a Tx opportunity at its transmission time
+   * \param cb Tx callback
+   */
+  void SetTxCallback (TxCallback cb);
+
+  /**
+   * \brief Schedule the Tx opportunities of one TBTP. The Tx opportunities
+   * are merged into the pending ones in the order of the transmission time.
+   * The Tx opportunities at the same time keep their TBTP order, after the
+   * pending ones at that time.
+   * \param txOpportunities Tx opportunities in any order, sorted by the call
+   */
+  void Schedule (std::vector<DaTxOpportunity_t>& txOpportunities);
+
+  /**
+   * \brief Get the number of pending Tx opportunities
+   * \return Number of pending Tx opportunities
+   */
+  uint32_t GetSize () const;
+
+  /**
+   * \brief Remove all the pending Tx opportunities and cancel the simulator
+   * event of the queue
+   */
+  void Clear ();
+
+private:
+  /**
+   * \brief Compare the transmission times of two DA Tx opportunities
+   * \param a First Tx opportunity
+   * \param b Second Tx opportunity
+   * \return true if a is transmitted before b
+   */
+  static inline bool CompareTxTimes (const DaTxOpportunity_t& a, const DaTxOpportunity_t& b)
+  {
+    return a.txTime < b.txTime;
+  }
+
+  /**
+   * \brief Schedule the simulator event to the first pending Tx opportunity,
+   * unless the event is already scheduled earlier.
+   */
+  void ScheduleNextEvent ();
+
+  /**
+   * \brief Pass the pending Tx opportunities whose transmission time has
+   * been reached to the Tx callback and schedule the event for the next ones.
+   */
+  void DoTxOpportunities ();
+
+  /**
+   * Pending Tx opportunities in the order of the transmission time
+   */
+  std::deque<DaTxOpportunity_t> m_txOpportunities;
+
+  /**
+   * Simulator event scheduled to the first pending Tx opportunity
+   */
+  EventId m_event;
+
+  /**
+   * Callback called for a Tx opportunity at its transmission time
+   */
+  TxCallback m_txCallback;
+};
+
+} // namespace ns3
+
+#endif /* SATELLITE_DA_TX_OPPORTUNITY_QUEUE_H_ */
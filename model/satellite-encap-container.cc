@@ -0,0 +1,206 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2016 Magister Solutions Ltd
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: agent <agent@local>
+ */
+
+#include "ns3/log.h"
+#include "satellite-encap-container.h"
+
+NS_LOG_COMPONENT_DEFINE ("SatEncapContainer");
+
+namespace ns3 {
+
+SatEncapContainer::SatEncapContainer ()
+  : m_values (),
+    m_order (),
+    m_positions ()
+{
+  NS_LOG_FUNCTION (this);
+}
+
+SatEncapContainer::iterator
+SatEncapContainer::begin ()
+{
+  return iterator (GetValues (), GetOrder (), 0);
+}
+
+SatEncapContainer::iterator
+SatEncapContainer::end ()
+{
+  return iterator (GetValues (), GetOrder (), m_order.size ());
+}
+
+SatEncapContainer::const_iterator
+SatEncapContainer::begin () const
+{
+  return const_iterator (GetValues (), GetOrder (), 0);
+}
+
+SatEncapContainer::const_iterator
+SatEncapContainer::end () const
+{
+  return const_iterator (GetValues (), GetOrder (), m_order.size ());
+}
+
+uint32_t
+SatEncapContainer::size () const
+{
+  return m_values.GetSize ();
+}
+
+bool
+SatEncapContainer::empty () const
+{
+  return m_values.IsEmpty ();
+}
+
+void
+SatEncapContainer::clear ()
+{
+  NS_LOG_FUNCTION (this);
+
+  m_values.Clear ();
+  m_order.clear ();
+  m_positions.clear ();
+}
+
+SatEncapContainer::iterator
+SatEncapContainer::find (Mac48Address source, Mac48Address dest, uint8_t flowId)
+{
+  uint32_t index = m_values.Find (Pack (source, dest, flowId));
+
+  if (index == m_values.NOT_FOUND)
+    {
+      return end ();
+    }
+
+  return iterator (GetValues (), GetOrder (), m_positions[index]);
+}
+
+SatEncapContainer::const_iterator
+SatEncapContainer::find (Mac48Address source, Mac48Address dest, uint8_t flowId) const
+{
+  uint32_t index = m_values.Find (Pack (source, dest, flowId));
+
+  if (index == m_values.NOT_FOUND)
+    {
+      return end ();
+    }
+
+  return const_iterator (GetValues (), GetOrder (), m_positions[index]);
+}
+
+SatEncapContainer::iterator
+SatEncapContainer::find (Ptr<EncapKey> key)
+{
+  return find (key->m_source, key->m_destination, key->m_flowId);
+}
+
+std::pair<SatEncapContainer::iterator, bool>
+SatEncapContainer::insert (const value_type& value)
+{
+  NS_LOG_FUNCTION (this << value.first->m_source << value.first->m_destination << (uint32_t) value.first->m_flowId);
+
+  PackedKey_t key = Pack (value.first->m_source, value.first->m_destination, value.first->m_flowId);
+  std::pair<uint32_t, bool> result = m_values.Insert (key, value);
+  uint32_t index = result.first;
+
+  if (!result.second)
+    {
+      return std::make_pair (iterator (GetValues (), GetOrder (), m_positions[index]), false);
+    }
+
+  m_positions.push_back (0);
+
+  // Insert to the key order and update the positions after it
+  uint32_t position = 0;
+  uint32_t count = m_order.size ();
+
+  while (count > 0)
+    {
+      uint32_t step = count / 2;
+      if (IsLess (m_values.GetKey (m_order[position + step]), key))
+        {
+          position += step + 1;
+          count -= step + 1;
+        }
+      else
+        {
+          count = step;
+        }
+    }
+
+  m_order.insert (m_order.begin () + position, index);
+
+  for (uint32_t i = position; i < m_order.size (); ++i)
+    {
+      m_positions[m_order[i]] = i;
+    }
+
+  return std::make_pair (iterator (GetValues (), GetOrder (), position), true);
+}
+
+SatEncapContainer::value_type*
+SatEncapContainer::GetValues ()
+{
+  return m_values.IsEmpty () ? 0 : &m_values.GetValue (0);
+}
+
+const SatEncapContainer::value_type*
+SatEncapContainer::GetValues () const
+{
+  return m_values.IsEmpty () ? 0 : &m_values.GetValue (0);
+}
+
+const uint32_t*
+SatEncapContainer::GetOrder () const
+{
+  return m_order.empty () ? 0 : &m_order[0];
+}
+
+SatEncapContainer::PackedKey_t
+SatEncapContainer::Pack (Mac48Address source, Mac48Address dest, uint8_t flowId)
+{
+  uint8_t s[6];
+  uint8_t d[6];
+  source.CopyTo (s);
+  dest.CopyTo (d);
+
+  PackedKey_t key;
+  key.high = 0;
+  key.low = 0;
+
+  for (uint32_t i = 0; i < 6; ++i)
+    {
+      key.high = (key.high << 8) | s[i];
+    }
+
+  key.high = (key.high << 16) | ((uint64_t) d[0] << 8) | d[1];
+
+  for (uint32_t i = 2; i < 6; ++i)
+    {
+      key.low = (key.low << 8) | d[i];
+    }
+
+  // flip the sign bit to order the flow ids as signed, like EncapKeyCompare
+  key.low = (key.low << 8) | (uint8_t) (flowId ^ 0x80);
+
+  return key;
+}
+
+} // namespace ns3
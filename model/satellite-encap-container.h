@@ -0,0 +1,332 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2016 Magister Solutions Ltd
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: agent <agent@local>
+ */
+
+#ifndef SATELLITE_ENCAP_CONTAINER_H_
+#define SATELLITE_ENCAP_CONTAINER_H_
+
+#include <vector>
+#include <utility>
+#include <stdint.h>
+#include <ns3/ptr.h>
+#include <ns3/simple-ref-count.h>
+#include <ns3/mac48-address.h>
+#include <ns3/satellite-base-encapsulator.h>
+#include <ns3/satellite-flat-hash-map.h>
+
+namespace ns3 {
+
+/**
+ * \ingroup satellite
+ * \brief EncapKey class is used as a key in the encapsulator/decapsulator container. It
+ * will hold the flow information related to one single encapsulator/decapsulator.
+ */
+class EncapKey : public SimpleRefCount <EncapKey>
+{
+public:
+  Mac48Address  m_source;
+  Mac48Address  m_destination;
+  int8_t        m_flowId;
+
+  EncapKey (const Mac48Address source, const Mac48Address dest, const uint8_t flowId)
+    : m_source (source),
+      m_destination (dest),
+      m_flowId (flowId)
+  {
+  }
+};
+
+/**
+ * \ingroup satellite
+ * \brief EncapKeyCompare is used as a custom compare method within
+ * EncapContainer map. Encap key has three member variables (source
+ * address, dest address and flow id) and to be able to store them in
+ * a map container, a custom compare method needs to be implemented.
+ */
+class EncapKeyCompare
+{
+public:
+  bool operator() (Ptr<EncapKey> key1, Ptr<EncapKey> key2) const
+  {
+    if ( key1->m_source == key2->m_source )
+      {
+        if ( key1->m_destination == key2->m_destination )
+          {
+            return key1->m_flowId < key2->m_flowId;
+          }
+        else
+          {
+            return key1->m_destination < key2->m_destination;
+          }
+      }
+    else
+      {
+        return key1->m_source < key2->m_source;
+      }
+  }
+};
+
+/**
+ * \ingroup satellite
+ * \brief SatEncapContainer holds the encapsulators/decapsulators of the LLC
+ * by their flow (source address, destination address, flow id).
+ *
+ * The flow is packed into a 128-bit key, which is used for looking up the
+ * encapsulators from a SatFlatHashMap without creating an EncapKey object.
+ * The container is iterated in the order of EncapKeyCompare, i.e. in the
+ * same deterministic order as an ordered map of the keys.
+ *
+ * Inserting an encapsulator invalidates the iterators of the container.
+ */
+class SatEncapContainer
+{
+public:
+  /**
+   * Value of the container: flow key and encapsulator
+   */
+  typedef std::pair<Ptr<EncapKey>, Ptr<SatBaseEncapsulator> > value_type;
+
+  /**
+   * \brief Iterator of the container in the key order
+   */
+  template <typename V>
+  class IteratorBase
+  {
+public:
+    IteratorBase ()
+      : m_values (0),
+        m_order (0),
+        m_position (0)
+    {
+    }
+
+    /**
+     * \brief Conversion from iterator to const_iterator
+     * \param it Iterator
+     */
+    template <typename U>
+    IteratorBase (const IteratorBase<U>& it)
+      : m_values (it.m_values),
+        m_order (it.m_order),
+        m_position (it.m_position)
+    {
+    }
+
+    V& operator* () const
+    {
+      return m_values[m_order[m_position]];
+    }
+
+    V* operator-> () const
+    {
+      return &m_values[m_order[m_position]];
+    }
+
+    IteratorBase& operator++ ()
+    {
+      ++m_position;
+      return *this;
+    }
+
+    IteratorBase operator++ (int)
+    {
+      IteratorBase it (*this);
+      ++m_position;
+      return it;
+    }
+
+    bool operator== (const IteratorBase& it) const
+    {
+      return m_position == it.m_position;
+    }
+
+    bool operator!= (const IteratorBase& it) const
+    {
+      return m_position != it.m_position;
+    }
+
+private:
+    friend class SatEncapContainer;
+    template <typename U> friend class IteratorBase;
+
+    IteratorBase (V* values, const uint32_t* order, uint32_t position)
+      : m_values (values),
+        m_order (order),
+        m_position (position)
+    {
+    }
+
+    V* m_values;
+    const uint32_t* m_order;
+    uint32_t m_position;
+  };
+
+  typedef IteratorBase<value_type> iterator;
+  typedef IteratorBase<const value_type> const_iterator;
+
+  /**
+   * \brief Default constructor, creates an empty container
+   */
+  SatEncapContainer ();
+
+  iterator begin ();
+  iterator end ();
+  const_iterator begin () const;
+  const_iterator end () const;
+
+  /**
+   * \brief Get the number of encapsulators
+   * \return Number of encapsulators
+   */
+  uint32_t size () const;
+
+  /**
+   * \brief Check whether the container is empty
+   * \return true if there are no encapsulators
+   */
+  bool empty () const;
+
+  /**
+   * \brief Remove all the encapsulators
+   */
+  void clear ();
+
+  /**
+   * \brief Find the encapsulator of a flow
+   * \param source Source MAC address
+   * \param dest Destination MAC address
+   * \param flowId Flow id
+   * \return Iterator to the encapsulator or end (), if not found
+   */
+  iterator find (Mac48Address source, Mac48Address dest, uint8_t flowId);
+
+  /**
+   * \brief Find the encapsulator of a flow
+   * \param source Source MAC address
+   * \param dest Destination MAC address
+   * \param flowId Flow id
+   * \return Iterator to the encapsulator or end (), if not found
+   */
+  const_iterator find (Mac48Address source, Mac48Address dest, uint8_t flowId) const;
+
+  /**
+   * \brief Find the encapsulator of a flow
+   * \param key Flow key
+   * \return Iterator to the encapsulator or end (), if not found
+   */
+  iterator find (Ptr<EncapKey> key);
+
+  /**
+   * \brief Insert an encapsulator
+   * \param value Flow key and encapsulator
+   * \return Iterator to the encapsulator of the flow and true, if the
+   * encapsulator was inserted, or false if the flow already had one
+   */
+  std::pair<iterator, bool> insert (const value_type& value);
+
+private:
+  /**
+   * \brief Flow key packed to two 64-bit integers, in which the order of
+   * the keys is the same as with EncapKeyCompare.
+   * - high: source address (48 bits), first 16 bits of destination address
+   * - low: last 32 bits of destination address, flow id (8 bits)
+   *
+   * EncapKeyCompare compares the flow ids as signed (int8_t), thus the sign
+   * bit of the flow id is flipped in the packed key.
+   */
+  struct PackedKey_t
+  {
+    uint64_t high;
+    uint64_t low;
+
+    inline bool operator== (const PackedKey_t& key) const
+    {
+      return high == key.high && low == key.low;
+    }
+  };
+
+  /**
+   * \brief Hash function of the packed keys
+   */
+  class PackedKeyHash
+  {
+public:
+    inline uint64_t operator() (const PackedKey_t& key) const
+    {
+      return SatFlatHashMapHash::Mix (key.high * 0x9E3779B97F4A7C15ULL ^ key.low);
+    }
+  };
+
+  /**
+   * \brief Pack a flow key
+   * \param source Source MAC address
+   * \param dest Destination MAC address
+   * \param flowId Flow id
+   * \return Packed key
+   */
+  static PackedKey_t Pack (Mac48Address source, Mac48Address dest, uint8_t flowId);
+
+  /**
+   * \brief Compare the order of two packed keys
+   * \param key1 First key
+   * \param key2 Second key
+   * \return true if key1 is before key2
+   */
+  static inline bool IsLess (const PackedKey_t& key1, const PackedKey_t& key2)
+  {
+    return key1.high < key2.high || (key1.high == key2.high && key1.low < key2.low);
+  }
+
+  /**
+   * \brief Get the first encapsulator in the storage order for the iterators
+   * \return Pointer to the first encapsulator or zero, if the container is empty
+   */
+  value_type* GetValues ();
+
+  /**
+   * \brief Get the first encapsulator in the storage order for the iterators
+   * \return Pointer to the first encapsulator or zero, if the container is empty
+   */
+  const value_type* GetValues () const;
+
+  /**
+   * \brief Get the first storage index in the key order for the iterators
+   * \return Pointer to the first storage index or zero, if the container is empty
+   */
+  const uint32_t* GetOrder () const;
+
+  /**
+   * Encapsulators by their packed keys in the insertion order
+   */
+  SatFlatHashMap<PackedKey_t, value_type, PackedKeyHash> m_values;
+
+  /**
+   * Storage indices in the key order
+   */
+  std::vector<uint32_t> m_order;
+
+  /**
+   * Positions of the storage indices in m_order
+   */
+  std::vector<uint32_t> m_positions;
+};
+
+} // namespace ns3
+
+#endif /* SATELLITE_ENCAP_CONTAINER_H_ */
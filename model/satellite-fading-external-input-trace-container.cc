@@ -96,6 +96,7 @@ SatFadingExternalInputTraceContainer::~SatFadingExternalInputTraceContainer ()
 
   m_utFadingMap.clear ();
   m_gwFadingMap.clear ();
+  m_loadedTraces.clear ();
 }
 
 void
@@ -379,7 +380,7 @@ SatFadingExternalInputTraceContainer::CreateFadingTrace (SatFadingExternalInputT
 
   NS_LOG_INFO ("SatFadingExternalInputTraceContainer -> Creation info: Mode=" << m_utInputMode << ", ID (GW/UT)=" << id << ", FileName=" << fileName);
 
-  // find from loaded list
+  // find from loaded list, the same file is shared by all the nodes using it
 
   TraceInputContainer_t::iterator it = m_loadedTraces.find (fileName);
 
@@ -387,6 +388,7 @@ SatFadingExternalInputTraceContainer::CreateFadingTrace (SatFadingExternalInputT
     {
       // create if not found
       trace = Create<SatFadingExternalInputTrace> (fileType, m_dataPath + fileName);
+      m_loadedTraces.insert (std::make_pair (fileName, trace));
     }
   else
     {
@@ -60,64 +60,65 @@ void SatFadingExternalInputTrace::ReadTrace (std::string filePathName)
   NS_LOG_FUNCTION (this << filePathName);
 
   // READ FROM THE SPECIFIED INPUT FILE
-  std::ifstream *ifs = new std::ifstream (filePathName.c_str (), std::ios::in | std::ios::binary);
+  std::ifstream ifs (filePathName.c_str (), std::ios::in | std::ios::binary);
 
-  if (!ifs->is_open ())
+  if (!ifs.is_open ())
     {
       // script might be launched by test.py, try a different base path
-      delete ifs;
       filePathName = "../../" + filePathName;
-      ifs = new std::ifstream (filePathName.c_str (), std::ifstream::in);
+      ifs.open (filePathName.c_str (), std::ios::in | std::ios::binary);
 
-      if (!ifs->is_open ())
+      if (!ifs.is_open ())
         {
           NS_FATAL_ERROR ("The file " << filePathName << " is not found.");
         }
     }
 
-  // Currently supports two or three column formats
-  uint32_t columns = (m_traceFileType == FT_TWO_COLUMN) ? 2 : 3;
+  // Read the whole file at once
+  ifs.seekg (0, std::ios::end);
+  std::streamoff fileSize = ifs.tellg ();
+  ifs.seekg (0, std::ios::beg);
 
-  float temp;
-  int32_t count (0);
-  std::vector<float> values;
-  ifs->read ((char*)&temp, sizeof(float));
-  m_startTime = temp;
+  std::vector<float> values (fileSize / sizeof (float));
 
-  // While state is good
-  while (ifs->good ())
+  if (!values.empty ())
     {
-      // Store previous value
-      values.push_back (temp);
+      ifs.read ((char*) &values[0], values.size () * sizeof (float));
+    }
 
-      // Read the new value
-      ++count;
-      ifs->read ((char*)&temp, sizeof(float));
+  ifs.close ();
 
-      // Handle previous value
-      if (count % columns == 0)
-        {
-          NS_ASSERT (values.size () == columns);
+  // Currently supports two or three column formats
+  uint32_t columns = (m_traceFileType == FT_TWO_COLUMN) ? 2 : 3;
+  uint32_t rows = values.size () / columns;
 
-          m_traceVector.push_back (values);
-          values.clear ();
+  m_times.reserve (rows);
+  m_fadings.reserve (rows);
 
-          // Calculate the sampling interval
-          if (m_timeInterval < 0.0)
-            {
-              m_timeInterval = temp - m_startTime;
-            }
-        }
+  // Columns: time, fading in dB and (optionally) scintillation in dB
+  for (uint32_t i = 0; i < rows; ++i)
+    {
+      m_times.push_back (values[i * columns]);
+      m_fadings.push_back (SatUtils::DbToLinear (values[i * columns + 1]));
+    }
+
+  if (!values.empty ())
+    {
+      m_startTime = values[0];
+    }
+
+  // Calculate the sampling interval
+  if (rows > 1)
+    {
+      m_timeInterval = m_times[1] - m_startTime;
     }
-  ifs->close ();
-  delete ifs;
 }
 
 double
 SatFadingExternalInputTrace::GetFading () const
 {
   NS_LOG_FUNCTION (this);
-  NS_ASSERT (!m_traceVector.empty ());
+  NS_ASSERT (!m_times.empty ());
 
   float simTime = Simulator::Now ().GetSeconds ();
 
@@ -129,31 +130,22 @@ SatFadingExternalInputTrace::GetFading () const
   // Calculate the index to the time sample just before current time
   uint32_t lowerIndex = (uint32_t)(std::floor (std::abs (simTime - m_startTime) / m_timeInterval));
 
-  if (lowerIndex >= m_traceVector.size ())
+  if (lowerIndex + 1 >= m_times.size ())
     {
-      NS_LOG_ERROR (this << " calculated index exceeds trace file size!");
+      NS_FATAL_ERROR (this << " calculated index exceeds trace file size!");
     }
 
-  float lowerKey = m_traceVector.at (lowerIndex).at (TIME_INDEX);
-  float upperKey = m_traceVector.at (lowerIndex + 1).at (TIME_INDEX);
+  float lowerKey = m_times[lowerIndex];
+  float upperKey = m_times[lowerIndex + 1];
 
   // Interpolation in linear domain
-  float lowerVal = SatUtils::DbToLinear (m_traceVector.at (lowerIndex).at (FADING_INDEX));
-  float upperVal = SatUtils::DbToLinear (m_traceVector.at (lowerIndex + 1).at (FADING_INDEX));
+  float lowerVal = m_fadings[lowerIndex];
+  float upperVal = m_fadings[lowerIndex + 1];
 
   // y = y0 + (y1 - y0) * (x - x0) / (x1 - x0)
   double fading = lowerVal + (upperVal - lowerVal)
     * (simTime - lowerKey) / (upperKey - lowerKey);
 
-  /*
-  std::cout << "Now: " << simTime <<
-      ", interpolated fading: " << fading_dB <<
-      ", interpolated fading: " << SatUtils::DbToLinear (fading_dB) <<
-      ", Lower time: " << lowerKey <<
-      ", Upper time: " << upperKey <<
-      ", Lower fading: " << lowerVal <<
-      ", Upper fading: " << upperVal << std::endl;
-  */
   return fading;
 }
 
@@ -161,17 +153,16 @@ bool
 SatFadingExternalInputTrace::TestFadingTrace () const
 {
   NS_LOG_FUNCTION (this);
-  NS_ASSERT (!m_traceVector.empty ());
+  NS_ASSERT (!m_times.empty ());
 
-  std::vector<std::vector<float> >::const_iterator cit;
   float prevTime (-1.0);
   float currTime (-1.0);
 
-  for (cit = m_traceVector.begin (); cit != m_traceVector.end (); ++cit)
+  for (std::vector<float>::const_iterator cit = m_times.begin (); cit != m_times.end (); ++cit)
     {
       if (prevTime > 0)
         {
-          currTime = cit->at (TIME_INDEX);
+          currTime = *cit;
           double diff = std::abs ( std::abs (currTime - prevTime) - m_timeInterval);
 
           // Test that the the time samples are from constant interval and
@@ -181,7 +172,7 @@ SatFadingExternalInputTrace::TestFadingTrace () const
               return false;
             }
         }
-      prevTime = cit->at (TIME_INDEX);
+      prevTime = *cit;
     }
 
   // Succeeded
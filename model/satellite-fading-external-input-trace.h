@@ -90,12 +90,6 @@ private:
    */
   TraceFileType_e m_traceFileType;
 
-  /**
-   * Constant indices used in the fading container
-   */
-  static const uint32_t TIME_INDEX = 0;
-  static const uint32_t FADING_INDEX = 1;
-  static const uint32_t SCINTILLATION_INDEX = 2;
 
   /**
    * Fading start time and interval calculated from the actual trace file.
@@ -107,9 +101,15 @@ private:
   float m_timeInterval;
 
   /**
-   * Container for the fading trace.
+   * Time samples of the fading trace in seconds.
+   */
+  std::vector<float> m_times;
+
+  /**
+   * Fading samples of the fading trace, converted to linear format
+   * when the trace is read.
    */
-  std::vector<std::vector<float> > m_traceVector;
+  std::vector<float> m_fadings;
 };
 
 } // namespace ns3
@@ -141,7 +141,7 @@ SatFadingInputTraceContainer::GetFadingValue (key_t key)
 {
   NS_LOG_FUNCTION (this);
 
-  return FindNode (key)->ProceedToNextClosestTimeSample ().at (SatBaseTraceContainer::FADING_TRACE_DEFAULT_FADING_VALUE_INDEX);
+  return FindNode (key)->ProceedToNextClosestTimeSample (SatBaseTraceContainer::FADING_TRACE_DEFAULT_FADING_VALUE_INDEX);
 }
 
 } // namespace ns3
@@ -0,0 +1,124 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2016 Magister Solutions Ltd
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: agent <agent@local>
+ */
+
+#include <cmath>
+#include "ns3/log.h"
+#include "satellite-fading-oscillator-bank.h"
+
+NS_LOG_COMPONENT_DEFINE ("SatFadingOscillatorBank");
+
+namespace ns3 {
+
+SatFadingOscillatorBank::SatFadingOscillatorBank ()
+  : m_amplitudeReal (),
+    m_amplitudeImag (),
+    m_phase (),
+    m_omega ()
+{
+  NS_LOG_FUNCTION (this);
+}
+
+void
+SatFadingOscillatorBank::Add (std::complex<double> amplitude, double initialPhase, double omega)
+{
+  NS_LOG_FUNCTION (this << amplitude << initialPhase << omega);
+
+  m_amplitudeReal.push_back (amplitude.real ());
+  m_amplitudeImag.push_back (amplitude.imag ());
+  m_phase.push_back (initialPhase);
+  m_omega.push_back (omega);
+}
+
+void
+SatFadingOscillatorBank::Add (double amplitude, double initialPhase, double omega)
+{
+  NS_LOG_FUNCTION (this << amplitude << initialPhase << omega);
+
+  Add (std::complex<double> (amplitude, 0.0), initialPhase, omega);
+}
+
+uint32_t
+SatFadingOscillatorBank::GetN () const
+{
+  return m_omega.size ();
+}
+
+void
+SatFadingOscillatorBank::Clear ()
+{
+  NS_LOG_FUNCTION (this);
+
+  m_amplitudeReal.clear ();
+  m_amplitudeImag.clear ();
+  m_phase.clear ();
+  m_omega.clear ();
+}
+
+std::complex<double>
+SatFadingOscillatorBank::GetComplexSum (double timeInSeconds) const
+{
+  NS_LOG_FUNCTION (this << timeInSeconds);
+
+  const uint32_t n = m_omega.size ();
+  const double* amplitudeReal = m_amplitudeReal.data ();
+  const double* amplitudeImag = m_amplitudeImag.data ();
+  const double* phase = m_phase.data ();
+  const double* omega = m_omega.data ();
+
+  double sumReal = 0.0;
+  double sumImag = 0.0;
+
+  for (uint32_t i = 0; i < n; i++)
+    {
+      double c = std::cos (timeInSeconds * omega[i] + phase[i]);
+      sumReal += amplitudeReal[i] * c;
+      sumImag += amplitudeImag[i] * c;
+    }
+
+  return std::complex<double> (sumReal, sumImag);
+}
+
+std::complex<double>
+SatFadingOscillatorBank::GetCosineWaveSum (double timeInSeconds) const
+{
+  NS_LOG_FUNCTION (this << timeInSeconds);
+
+  const uint32_t n = m_omega.size ();
+  const double* amplitude = m_amplitudeReal.data ();
+  const double* phase = m_phase.data ();
+  const double* omega = m_omega.data ();
+
+  double sumReal = 0.0;
+  double sumImag = 0.0;
+
+  // exp (cos x + i sin x) = exp (cos x) * (cos (sin x) + i sin (sin x))
+  for (uint32_t i = 0; i < n; i++)
+    {
+      double angle = timeInSeconds * omega[i] + phase[i];
+      double s = std::sin (angle);
+      double magnitude = amplitude[i] * std::exp (std::cos (angle));
+      sumReal += magnitude * std::cos (s);
+      sumImag += magnitude * std::sin (s);
+    }
+
+  return std::complex<double> (sumReal, sumImag);
+}
+
+} // namespace ns3
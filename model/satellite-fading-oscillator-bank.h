@@ -0,0 +1,126 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2016 Magister Solutions Ltd
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: agent <agent@local>
+ */
+
+#ifndef SATELLITE_FADING_OSCILLATOR_BANK_H
+#define SATELLITE_FADING_OSCILLATOR_BANK_H
+
+#include <vector>
+#include <complex>
+#include <stdint.h>
+
+namespace ns3 {
+
+/**
+ * \ingroup satellite
+ *
+ * \brief Bank of fading oscillators of one fader state. The amplitudes,
+ * initial phases and rotation speeds of the oscillators are stored as
+ * separate contiguous arrays instead of one SatFadingOscillator object per
+ * oscillator, and the sums over all the oscillators are evaluated in one
+ * loop over the arrays. The sums are the same as summing
+ * SatFadingOscillator::GetComplexValueAt or
+ * SatFadingOscillator::GetCosineWaveValueAt over the oscillators.
+ *
+ * A bank holds either complex amplitude oscillators (evaluated with
+ * GetComplexSum) or real amplitude oscillators (evaluated with
+ * GetCosineWaveSum).
+ *
+ * The banks are evaluated one fader at a time. The fading of a UT is
+ * evaluated by its Markov container when a packet is received, i.e. at the
+ * propagation delay of the UT, and only after the cooldown period of the
+ * container, so the faders of several UTs are not evaluated at the same
+ * time.
+ */
+class SatFadingOscillatorBank
+{
+public:
+  /**
+   * \brief Constructor, creates an empty bank
+   */
+  SatFadingOscillatorBank ();
+
+  /**
+   * \brief Add a complex amplitude oscillator
+   * \param amplitude amplitude
+   * \param initialPhase initial phase
+   * \param omega rotation speed
+   */
+  void Add (std::complex<double> amplitude, double initialPhase, double omega);
+
+  /**
+   * \brief Add a real amplitude oscillator
+   * \param amplitude amplitude
+   * \param initialPhase initial phase
+   * \param omega rotation speed
+   */
+  void Add (double amplitude, double initialPhase, double omega);
+
+  /**
+   * \brief Get the number of oscillators
+   * \return number of oscillators
+   */
+  uint32_t GetN () const;
+
+  /**
+   * \brief Remove all the oscillators
+   */
+  void Clear ();
+
+  /**
+   * \brief Sum of the complex amplitude oscillators at time t:
+   * \f[ \sum_n A_n \cos(\omega_n t + \phi_n) \f]
+   * \param timeInSeconds current time in seconds
+   * \return complex sum
+   */
+  std::complex<double> GetComplexSum (double timeInSeconds) const;
+
+  /**
+   * \brief Sum of the real amplitude cosine wave oscillators at time t:
+   * \f[ \sum_n a_n \exp(e^{i(\omega_n t + \phi_n)}) \f]
+   * \param timeInSeconds current time in seconds
+   * \return complex sum
+   */
+  std::complex<double> GetCosineWaveSum (double timeInSeconds) const;
+
+private:
+  /**
+   * \brief Real parts of the amplitudes
+   */
+  std::vector<double> m_amplitudeReal;
+
+  /**
+   * \brief Imaginary parts of the amplitudes
+   */
+  std::vector<double> m_amplitudeImag;
+
+  /**
+   * \brief Initial phases
+   */
+  std::vector<double> m_phase;
+
+  /**
+   * \brief Rotation speeds
+   */
+  std::vector<double> m_omega;
+};
+
+} // namespace ns3
+
+#endif /* SATELLITE_FADING_OSCILLATOR_BANK_H */
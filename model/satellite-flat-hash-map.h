@@ -0,0 +1,267 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2016 Magister Solutions Ltd
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: agent <agent@local>
+ */
+
+#ifndef SATELLITE_FLAT_HASH_MAP_H_
+#define SATELLITE_FLAT_HASH_MAP_H_
+
+#include <vector>
+#include <utility>
+#include <algorithm>
+#include <stdint.h>
+
+namespace ns3 {
+
+/**
+ * \ingroup satellite
+ * \brief Default hash function of SatFlatHashMap for 64-bit integer keys,
+ * e.g. MAC addresses packed to an integer.
+ */
+class SatFlatHashMapHash
+{
+public:
+  /**
+   * \brief Hash of a key
+   * \param key Key
+   * \return Hash value
+   */
+  inline uint64_t operator() (uint64_t key) const
+  {
+    return Mix (key * 0x9E3779B97F4A7C15ULL);
+  }
+
+  /**
+   * \brief Spread the bits of a value, so that its low bits can be used
+   * as a slot of the hash table. Used also by the hash functions of
+   * compound keys.
+   * \param value Value to mix
+   * \return Mixed value
+   */
+  static inline uint64_t Mix (uint64_t value)
+  {
+    value ^= value >> 29;
+    value *= 0xBF58476D1CE4E5B9ULL;
+    value ^= value >> 32;
+    return value;
+  }
+};
+
+/**
+ * \ingroup satellite
+ * \brief SatFlatHashMap is a map storing its keys and values in vectors
+ * in the insertion order, and looking them up from an open addressing hash
+ * table with linear probing.
+ *
+ * The entries are referred by their index in the insertion order, which
+ * stays valid until Clear is called. The entries cannot be removed one by
+ * one. The key type needs operator==, and the hash function H is a functor
+ * returning a 64-bit hash of a key.
+ */
+template <typename K, typename V, typename H = SatFlatHashMapHash>
+class SatFlatHashMap
+{
+public:
+  /**
+   * Index returned when a key is not found
+   */
+  static const uint32_t NOT_FOUND = 0xFFFFFFFF;
+
+  /**
+   * \brief Default constructor, creates an empty map
+   */
+  SatFlatHashMap ()
+    : m_keys (),
+      m_values (),
+      m_slots ()
+  {
+  }
+
+  /**
+   * \brief Get the number of entries
+   * \return Number of entries
+   */
+  inline uint32_t GetSize () const
+  {
+    return m_values.size ();
+  }
+
+  /**
+   * \brief Check whether the map is empty
+   * \return true if there are no entries
+   */
+  inline bool IsEmpty () const
+  {
+    return m_values.empty ();
+  }
+
+  /**
+   * \brief Remove all the entries. The allocated memory is kept for reuse.
+   */
+  void Clear ()
+  {
+    m_keys.clear ();
+    m_values.clear ();
+    m_slots.assign (m_slots.size (), 0);
+  }
+
+  /**
+   * \brief Find the index of a key
+   * \param key Key
+   * \return Index of the key or NOT_FOUND
+   */
+  uint32_t Find (const K& key) const
+  {
+    if (m_values.empty ())
+      {
+        return NOT_FOUND;
+      }
+
+    uint64_t mask = m_slots.size () - 1;
+    uint64_t slot = H () (key) & mask;
+
+    while (m_slots[slot] != 0)
+      {
+        if (m_keys[m_slots[slot] - 1] == key)
+          {
+            return m_slots[slot] - 1;
+          }
+
+        slot = (slot + 1) & mask;
+      }
+
+    return NOT_FOUND;
+  }
+
+  /**
+   * \brief Insert an entry, if the key is not in the map yet
+   * \param key Key
+   * \param value Value
+   * \return Index of the key and true, if the entry was inserted, or false
+   * if the key already was in the map
+   */
+  std::pair<uint32_t, bool> Insert (const K& key, const V& value)
+  {
+    uint32_t index = Find (key);
+
+    if (index != NOT_FOUND)
+      {
+        return std::make_pair (index, false);
+      }
+
+    index = m_values.size ();
+    m_keys.push_back (key);
+    m_values.push_back (value);
+
+    // Keep the load factor of the hash table at most 0.5
+    if (2 * m_values.size () > m_slots.size ())
+      {
+        m_slots.assign (std::max<size_t> (MIN_SLOTS, 2 * m_slots.size ()), 0);
+
+        for (uint32_t i = 0; i < m_values.size (); ++i)
+          {
+            AddToHashTable (i);
+          }
+      }
+    else
+      {
+        AddToHashTable (index);
+      }
+
+    return std::make_pair (index, true);
+  }
+
+  /**
+   * \brief Get the key of an entry
+   * \param index Index of the entry
+   * \return Key
+   */
+  inline const K& GetKey (uint32_t index) const
+  {
+    return m_keys[index];
+  }
+
+  /**
+   * \brief Get the value of an entry
+   * \param index Index of the entry
+   * \return Value
+   */
+  inline V& GetValue (uint32_t index)
+  {
+    return m_values[index];
+  }
+
+  /**
+   * \brief Get the value of an entry
+   * \param index Index of the entry
+   * \return Value
+   */
+  inline const V& GetValue (uint32_t index) const
+  {
+    return m_values[index];
+  }
+
+private:
+  /**
+   * Minimum size of the hash table
+   */
+  static const uint32_t MIN_SLOTS = 16;
+
+  /**
+   * \brief Add an entry to the hash table
+   * \param index Index of the entry
+   */
+  void AddToHashTable (uint32_t index)
+  {
+    uint64_t mask = m_slots.size () - 1;
+    uint64_t slot = H () (m_keys[index]) & mask;
+
+    while (m_slots[slot] != 0)
+      {
+        slot = (slot + 1) & mask;
+      }
+
+    m_slots[slot] = index + 1;
+  }
+
+  /**
+   * Keys in the insertion order
+   */
+  std::vector<K> m_keys;
+
+  /**
+   * Values in the insertion order
+   */
+  std::vector<V> m_values;
+
+  /**
+   * Open addressing hash table with linear probing. A slot holds
+   * the index of an entry + 1, zero meaning an empty slot.
+   */
+  std::vector<uint32_t> m_slots;
+};
+
+template <typename K, typename V, typename H>
+const uint32_t SatFlatHashMap<K, V, H>::NOT_FOUND;
+
+template <typename K, typename V, typename H>
+const uint32_t SatFlatHashMap<K, V, H>::MIN_SLOTS;
+
+} // namespace ns3
+
+#endif /* SATELLITE_FLAT_HASH_MAP_H_ */
@@ -475,7 +475,7 @@ SatFrameAllocator::PreAllocateSymbols (double targetLoad, bool fcaEnabled)
 }
 
 void
-SatFrameAllocator::GenerateTimeSlots (SatFrameAllocator::TbtpMsgContainer_t& tbtpContainer, uint32_t maxSizeInBytes, UtAllocInfoContainer_t& utAllocContainer,
+SatFrameAllocator::GenerateTimeSlots (SatFrameAllocator::TbtpMsgContainer_t& tbtpContainer, Ptr<SatTbtpMessagePool> tbtpPool, uint32_t maxSizeInBytes, UtAllocInfoContainer_t& utAllocContainer,
                                       bool rcBasedAllocationEnabled, TracedCallback<uint32_t> waveformTrace, TracedCallback<uint32_t, uint32_t> utLoadTrace, TracedCallback<uint32_t, double> loadTrace)
 {
   NS_LOG_FUNCTION (this);
@@ -508,7 +508,7 @@ SatFrameAllocator::GenerateTimeSlots (SatFrameAllocator::TbtpMsgContainer_t& tbt
       // check before the first slot addition that frame info fit in TBTP in addition to time slot
       if ( (tbtpToFill->GetSizeInBytes () + tbtpToFill->GetTimeSlotInfoSizeInBytes () + tbtpToFill->GetFrameInfoSize ()) > maxSizeInBytes )
         {
-          tbtpToFill = CreateNewTbtp (tbtpContainer);
+          tbtpToFill = CreateNewTbtp (tbtpContainer, tbtpPool);
         }
 
       // sort RCs in UT using random method.
@@ -526,48 +526,49 @@ SatFrameAllocator::GenerateTimeSlots (SatFrameAllocator::TbtpMsgContainer_t& tbt
 
       while ( utSymbolsLeft > 0 )
         {
-          Ptr<SatTimeSlotConf> timeSlot = NULL;
+          SatTbtpMessage::DaTimeSlot_t timeSlot;
+          bool timeSlotCreated = false;
 
           // try to first create Control slot if present in request and is not already created
           // otherwise create TRC slot
           if ( (currentRcIndex == rcIndices.begin ()) && m_utAllocs[*it].m_request.m_ctrlSlotPresent
                && (m_utAllocs[*it].m_allocation.m_ctrlSlotPresent == false ))
             {
-              timeSlot = CreateCtrlTimeSlot (*currentCarrier, utSymbolsToUse, carrierSymbolsToUse, utSymbolsLeft, rcSymbolsLeft, rcBasedAllocationEnabled );
+              timeSlotCreated = CreateCtrlTimeSlot (*currentCarrier, utSymbolsToUse, carrierSymbolsToUse, utSymbolsLeft, rcSymbolsLeft, rcBasedAllocationEnabled, timeSlot );
 
               // if control slot creation fails try to allocate TRC slot,
               // this i because control and TRC slot may use different waveforms (different amount of symbols)
-              if ( timeSlot )
+              if ( timeSlotCreated )
                 {
                   m_utAllocs[*it].m_allocation.m_ctrlSlotPresent = true;
                 }
               else
                 {
-                  timeSlot = CreateTimeSlot (*currentCarrier, utSymbolsToUse, carrierSymbolsToUse, utSymbolsLeft, rcSymbolsLeft, m_utAllocs[*it].m_cno, rcBasedAllocationEnabled );
+                  timeSlotCreated = CreateTimeSlot (*currentCarrier, utSymbolsToUse, carrierSymbolsToUse, utSymbolsLeft, rcSymbolsLeft, m_utAllocs[*it].m_cno, rcBasedAllocationEnabled, timeSlot );
                 }
             }
           else
             {
-              timeSlot = CreateTimeSlot (*currentCarrier, utSymbolsToUse, carrierSymbolsToUse, utSymbolsLeft, rcSymbolsLeft, m_utAllocs[*it].m_cno, rcBasedAllocationEnabled );
+              timeSlotCreated = CreateTimeSlot (*currentCarrier, utSymbolsToUse, carrierSymbolsToUse, utSymbolsLeft, rcSymbolsLeft, m_utAllocs[*it].m_cno, rcBasedAllocationEnabled, timeSlot );
             }
 
           // if creation succeeded, add slot to TBTP and update allocation info container
-          if ( timeSlot )
+          if ( timeSlotCreated )
             {
               // trace first used wave form per UT
               if ( !waveformIdTraced )
                 {
                   waveformIdTraced = true;
-                  waveformTrace (timeSlot->GetWaveFormId ());
+                  waveformTrace (timeSlot.waveFormId);
                   utCount++;
                 }
 
               if ( (tbtpToFill->GetSizeInBytes () + tbtpToFill->GetTimeSlotInfoSizeInBytes () ) > maxSizeInBytes )
                 {
-                  tbtpToFill = CreateNewTbtp (tbtpContainer);
+                  tbtpToFill = CreateNewTbtp (tbtpContainer, tbtpPool);
                 }
 
-              timeSlot->SetRcIndex (*currentRcIndex);
+              timeSlot.rcIndex = *currentRcIndex;
 
               if (timeslotCount > SatFrameConf::m_maxTimeSlotCount)
                 {
@@ -578,7 +579,7 @@ SatFrameAllocator::GenerateTimeSlots (SatFrameAllocator::TbtpMsgContainer_t& tbt
               timeslotCount++;
 
               // store needed information to UT allocation container
-              Ptr<SatWaveform> waveform = m_waveformConf->GetWaveform (timeSlot->GetWaveFormId ());
+              Ptr<SatWaveform> waveform = m_waveformConf->GetWaveform (timeSlot.waveFormId);
 
               UtAllocInfoContainer_t::iterator utAlloc = GetUtAllocItem (utAllocContainer, *it);
               utAlloc->second.first.at (*currentRcIndex) += waveform->GetPayloadInBytes ();
@@ -790,13 +791,14 @@ void SatFrameAllocator::ShareSymbols (bool fcaEnabled)
     }
 }
 
-Ptr<SatTimeSlotConf>
+bool
 SatFrameAllocator::CreateTimeSlot (uint16_t carrierId, int64_t& utSymbolsToUse, int64_t& carrierSymbolsToUse,
-                                   int64_t& utSymbolsLeft, int64_t& rcSymbolsLeft, double cno, bool rcBasedAllocationEnabled)
+                                   int64_t& utSymbolsLeft, int64_t& rcSymbolsLeft, double cno, bool rcBasedAllocationEnabled,
+                                   SatTbtpMessage::DaTimeSlot_t& timeSlot)
 {
   NS_LOG_FUNCTION (this);
 
-  Ptr<SatTimeSlotConf> timeSlotConf = NULL;
+  bool timeSlotCreated = false;
   int64_t symbolsToUse = std::min<int64_t> (carrierSymbolsToUse, utSymbolsToUse);
   uint32_t waveformId = 0;
   int64_t timeSlotSymbols = 0;
@@ -829,15 +831,26 @@ SatFrameAllocator::CreateTimeSlot (uint16_t carrierId, int64_t& utSymbolsToUse,
         case SatSuperframeConf::CONFIG_TYPE_0:
           {
             uint16_t index = (m_maxSymbolsPerCarrier - carrierSymbolsToUse) / timeSlotSymbols;
-            timeSlotConf = m_frameConf->GetTimeSlotConf (carrierId, index);
+            Ptr<SatTimeSlotConf> timeSlotConf = m_frameConf->GetTimeSlotConf (carrierId, index);
+
+            timeSlot.startTime = timeSlotConf->GetStartTime ();
+            timeSlot.waveFormId = timeSlotConf->GetWaveFormId ();
+            timeSlot.carrierId = timeSlotConf->GetCarrierId ();
+            timeSlot.rcIndex = timeSlotConf->GetRcIndex ();
+            timeSlot.slotType = timeSlotConf->GetSlotType ();
+            timeSlotCreated = true;
           }
           break;
 
         case SatSuperframeConf::CONFIG_TYPE_1:
         case SatSuperframeConf::CONFIG_TYPE_2:
           {
-            Time startTime = Seconds ( (m_maxSymbolsPerCarrier - carrierSymbolsToUse) / m_frameConf->GetBtuConf ()->GetSymbolRateInBauds ());
-            timeSlotConf = Create<SatTimeSlotConf> (startTime, waveformId, carrierId, SatTimeSlotConf::SLOT_TYPE_TRC);
+            timeSlot.startTime = Seconds ( (m_maxSymbolsPerCarrier - carrierSymbolsToUse) / m_frameConf->GetBtuConf ()->GetSymbolRateInBauds ());
+            timeSlot.waveFormId = waveformId;
+            timeSlot.carrierId = carrierId;
+            timeSlot.rcIndex = 0;
+            timeSlot.slotType = SatTimeSlotConf::SLOT_TYPE_TRC;
+            timeSlotCreated = true;
           }
           break;
 
@@ -847,7 +860,7 @@ SatFrameAllocator::CreateTimeSlot (uint16_t carrierId, int64_t& utSymbolsToUse,
           break;
         }
 
-      if (timeSlotConf)
+      if (timeSlotCreated)
         {
           carrierSymbolsToUse -= timeSlotSymbols;
           utSymbolsToUse -= timeSlotSymbols;
@@ -865,24 +878,29 @@ SatFrameAllocator::CreateTimeSlot (uint16_t carrierId, int64_t& utSymbolsToUse,
         }
     }
 
-  return timeSlotConf;
+  return timeSlotCreated;
 }
 
-Ptr<SatTimeSlotConf>
+bool
 SatFrameAllocator::CreateCtrlTimeSlot (uint16_t carrierId, int64_t& utSymbolsToUse, int64_t& carrierSymbolsToUse,
-                                       int64_t& utSymbolsLeft, int64_t& rcSymbolsLeft, bool rcBasedAllocationEnabled)
+                                       int64_t& utSymbolsLeft, int64_t& rcSymbolsLeft, bool rcBasedAllocationEnabled,
+                                       SatTbtpMessage::DaTimeSlot_t& timeSlot)
 {
   NS_LOG_FUNCTION (this);
 
-  Ptr<SatTimeSlotConf> timeSlotConf = NULL;
+  bool timeSlotCreated = false;
   int64_t symbolsToUse = std::min<int64_t> (carrierSymbolsToUse, utSymbolsToUse);
 
   int64_t timeSlotSymbols = m_mostRobustWaveform->GetBurstLengthInSymbols ();
 
   if ( timeSlotSymbols <= symbolsToUse )
     {
-      Time startTime = Seconds ( (m_maxSymbolsPerCarrier - carrierSymbolsToUse) / m_frameConf->GetBtuConf ()->GetSymbolRateInBauds ());
-      timeSlotConf = Create<SatTimeSlotConf> (startTime, m_mostRobustWaveform->GetWaveformId (), carrierId, SatTimeSlotConf::SLOT_TYPE_C);
+      timeSlot.startTime = Seconds ( (m_maxSymbolsPerCarrier - carrierSymbolsToUse) / m_frameConf->GetBtuConf ()->GetSymbolRateInBauds ());
+      timeSlot.waveFormId = m_mostRobustWaveform->GetWaveformId ();
+      timeSlot.carrierId = carrierId;
+      timeSlot.rcIndex = 0;
+      timeSlot.slotType = SatTimeSlotConf::SLOT_TYPE_C;
+      timeSlotCreated = true;
 
       carrierSymbolsToUse -= timeSlotSymbols;
       utSymbolsToUse -= timeSlotSymbols;
@@ -899,7 +917,7 @@ SatFrameAllocator::CreateCtrlTimeSlot (uint16_t carrierId, int64_t& utSymbolsToU
       rcSymbolsLeft -= timeSlotSymbols;
     }
 
-  return timeSlotConf;
+  return timeSlotCreated;
 }
 
 uint32_t
@@ -1196,7 +1214,7 @@ SatFrameAllocator::GetUtAllocItem (UtAllocInfoContainer_t& allocContainer, Addre
 }
 
 Ptr<SatTbtpMessage>
-SatFrameAllocator::CreateNewTbtp (TbtpMsgContainer_t& tbtpContainer)
+SatFrameAllocator::CreateNewTbtp (TbtpMsgContainer_t& tbtpContainer, Ptr<SatTbtpMessagePool> tbtpPool)
 {
   NS_LOG_FUNCTION (this);
 
@@ -1205,8 +1223,7 @@ SatFrameAllocator::CreateNewTbtp (TbtpMsgContainer_t& tbtpContainer)
       NS_FATAL_ERROR ("TBTP container is empty");
     }
 
-  Ptr<SatTbtpMessage> newTbtp = CreateObject<SatTbtpMessage> (tbtpContainer.back ()->GetSuperframeSeqId ());
-  newTbtp->SetSuperframeCounter ( tbtpContainer.back ()->GetSuperframeCounter ());
+  Ptr<SatTbtpMessage> newTbtp = tbtpPool->Get (tbtpContainer.back ()->GetSuperframeSeqId (), tbtpContainer.back ()->GetSuperframeCounter ());
 
   tbtpContainer.push_back (newTbtp);
 
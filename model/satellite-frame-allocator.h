@@ -221,6 +221,7 @@ public:
    * Generate time slots for UT/RCs i.e. do actual allocation based on preallocation.
    *
    * \param tbtpContainer TBTP message container to add/fill TBTPs.
+   * \param tbtpPool Pool to take the new TBTPs from.
    * \param maxSizeInBytes Maximum size for a TBTP message.
    * \param utAllocContainer Reference to UT allocation container to fill in info of the allocation
    * \param rcBasedAllocationEnabled If time slot generated per RC
@@ -228,7 +229,7 @@ public:
    * \param utLoadTrace UT load per the frame trace callback
    * \param loadTrace Load per the frame trace callback
    */
-  void GenerateTimeSlots ( SatFrameAllocator::TbtpMsgContainer_t& tbtpContainer, uint32_t maxSizeInBytes, UtAllocInfoContainer_t& utAllocContainer,
+  void GenerateTimeSlots ( SatFrameAllocator::TbtpMsgContainer_t& tbtpContainer, Ptr<SatTbtpMessagePool> tbtpPool, uint32_t maxSizeInBytes, UtAllocInfoContainer_t& utAllocContainer,
                            bool rcBasedAllocationEnabled, TracedCallback<uint32_t> waveformTrace, TracedCallback<uint32_t, uint32_t> utLoadTrace, TracedCallback<uint32_t, double> loadTrace);
 
 
@@ -470,10 +471,11 @@ private:
    * \param rcSymbolsLeft Symbols left for RC
    * \param cno Estimated C/N0 of the UT.
    * \param rcBasedAllocationEnabled If time slot generated per RC
-   * \return Create time slot configuration
+   * \param timeSlot Created time slot
+   * \return true if time slot was created
    */
-  Ptr<SatTimeSlotConf> CreateTimeSlot (uint16_t carrierId, int64_t& utSymbolsToUse, int64_t& carrierSymbolsToUse, int64_t& utSymbolsLeft,
-                                       int64_t& rcSymbolsLeft, double cno, bool rcBasedAllocationEnabled);
+  bool CreateTimeSlot (uint16_t carrierId, int64_t& utSymbolsToUse, int64_t& carrierSymbolsToUse, int64_t& utSymbolsLeft,
+                       int64_t& rcSymbolsLeft, double cno, bool rcBasedAllocationEnabled, SatTbtpMessage::DaTimeSlot_t& timeSlot);
 
   /**
    * Create control time slot.
@@ -484,10 +486,11 @@ private:
    * \param utSymbolsLeft Symbols left for the UT
    * \param rcSymbolsLeft Symbols left for RC
    * \param rcBasedAllocationEnabled If time slot generated per RC
-   * \return Create time slot configuration
+   * \param timeSlot Created time slot
+   * \return true if time slot was created
    */
-  Ptr<SatTimeSlotConf> CreateCtrlTimeSlot (uint16_t carrierId, int64_t& utSymbolsToUse, int64_t& carrierSymbolsToUse, int64_t& utSymbolsLeft,
-                                           int64_t& rcSymbolsLeft, bool rcBasedAllocationEnabled);
+  bool CreateCtrlTimeSlot (uint16_t carrierId, int64_t& utSymbolsToUse, int64_t& carrierSymbolsToUse, int64_t& utSymbolsLeft,
+                           int64_t& rcSymbolsLeft, bool rcBasedAllocationEnabled, SatTbtpMessage::DaTimeSlot_t& timeSlot);
 
   /**
    * Update RC/CC requested according to carrier limit
@@ -541,9 +544,10 @@ private:
    *  last TBTP in container.
    *
    * \param tbtpContainer TBTP container
+   * \param tbtpPool Pool to take the TBTP from
    * \return Pointer to created TBTP
    */
-  Ptr<SatTbtpMessage> CreateNewTbtp (TbtpMsgContainer_t& tbtpContainer);
+  Ptr<SatTbtpMessage> CreateNewTbtp (TbtpMsgContainer_t& tbtpContainer, Ptr<SatTbtpMessagePool> tbtpPool);
 };
 
 } // namespace ns3
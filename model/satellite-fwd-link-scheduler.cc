@@ -139,12 +139,19 @@ SatFwdLinkScheduler::GetTypeId (void)
                    MakeEnumAccessor (&SatFwdLinkScheduler::m_cnoEstimatorMode),
                    MakeEnumChecker (SatCnoEstimator::LAST, "LastValueInWindow",
                                     SatCnoEstimator::MINIMUM, "MinValueInWindow",
-                                    SatCnoEstimator::AVERAGE, "AverageValueInWindow"))
+                                    SatCnoEstimator::AVERAGE, "AverageValueInWindow",
+                                    SatCnoEstimator::EWMA, "ExponentialAverage",
+                                    SatCnoEstimator::PERCENTILE, "PercentileInWindow"))
     .AddAttribute ( "CnoEstimationWindow",
                     "Time window for C/N0 estimation.",
                     TimeValue (Seconds (5000)),
                     MakeTimeAccessor (&SatFwdLinkScheduler::m_cnoEstimationWindow),
                     MakeTimeChecker ())
+    .AddAttribute ( "CnoEstimationPercentile",
+                    "Percentile of the C/N0 samples in the window used in PercentileInWindow mode.",
+                    DoubleValue (10.0),
+                    MakeDoubleAccessor (&SatFwdLinkScheduler::m_cnoEstimationPercentile),
+                    MakeDoubleChecker<double> (0.0, 100.0))
     .AddAttribute ( "BBFrameContainer",
                     "BB frame container of this scheduler.",
                     PointerValue (),
@@ -157,6 +164,7 @@ SatFwdLinkScheduler::GetTypeId (void)
 SatFwdLinkScheduler::SatFwdLinkScheduler ()
   : m_additionalSortCriteria (SatFwdLinkScheduler::NO_SORT),
     m_cnoEstimatorMode (SatCnoEstimator::LAST),
+    m_cnoEstimationPercentile (10.0),
     m_carrierBandwidthInHz (0.0)
 {
   NS_LOG_FUNCTION (this);
@@ -168,6 +176,7 @@ SatFwdLinkScheduler::SatFwdLinkScheduler (Ptr<SatBbFrameConf> conf, Mac48Address
     m_bbFrameConf (conf),
     m_additionalSortCriteria (SatFwdLinkScheduler::NO_SORT),
     m_cnoEstimatorMode (SatCnoEstimator::LAST),
+    m_cnoEstimationPercentile (10.0),
     m_carrierBandwidthInHz (carrierBandwidthInHz)
 {
   NS_LOG_FUNCTION (this);
@@ -383,16 +392,21 @@ SatFwdLinkScheduler::SortSchedulingObjects (std::vector< Ptr<SatSchedulingObject
 
       switch (m_additionalSortCriteria)
         {
+        /**
+         * The scheduling contexts are already in flow id order. The objects
+         * of the same flow id keep their order in the other sorting criteria,
+         * thus the result does not depend on the sorting algorithm.
+         */
         case SatFwdLinkScheduler::NO_SORT:
-          std::sort (so.begin (), so.end (), CompareSoFlowId);
+          NS_ASSERT (std::is_sorted (so.begin (), so.end (), CompareSoFlowId));
           break;
 
         case SatFwdLinkScheduler::BUFFERING_DELAY_SORT:
-          std::sort (so.begin (), so.end (), CompareSoPriorityHol);
+          std::stable_sort (so.begin (), so.end (), CompareSoPriorityHol);
           break;
 
         case SatFwdLinkScheduler::BUFFERING_LOAD_SORT:
-          std::sort (so.begin (), so.end (), CompareSoPriorityLoad);
+          std::stable_sort (so.begin (), so.end (), CompareSoPriorityLoad);
           break;
 
         default:
@@ -455,6 +469,14 @@ SatFwdLinkScheduler::CreateCnoEstimator ()
       estimator = Create<SatBasicCnoEstimator> (m_cnoEstimatorMode, m_cnoEstimationWindow);
       break;
 
+    case SatCnoEstimator::EWMA:
+      estimator = Create<SatEwmaCnoEstimator> (m_cnoEstimationWindow);
+      break;
+
+    case SatCnoEstimator::PERCENTILE:
+      estimator = Create<SatPercentileCnoEstimator> (m_cnoEstimationWindow, m_cnoEstimationPercentile);
+      break;
+
     default:
       NS_FATAL_ERROR ("Not supported C/N0 estimation mode!!!");
       break;
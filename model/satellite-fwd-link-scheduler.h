@@ -141,7 +141,8 @@ public:
   virtual std::pair<Ptr<SatBbFrame>, const Time> GetNextFrame ();
 
   /**
-   * Callback to get scheduling contexts from upper layer
+   * Callback to get scheduling contexts from upper layer. The contexts are
+   * expected in flow id order.
    * \param vector of scheduling contexts
    */
   typedef Callback<void, std::vector< Ptr<SatSchedulingObject> > &> SchedContextCallback;
@@ -319,6 +320,11 @@ private:
    */
   Time m_cnoEstimationWindow;
 
+  /**
+   * Percentile used in PERCENTILE mode of C/N0 estimation.
+   */
+  double m_cnoEstimationPercentile;
+
   /**
    * Carrier bandwidth in hertz where scheduler is associated to.
    */
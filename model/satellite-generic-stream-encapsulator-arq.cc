@@ -42,15 +42,19 @@ NS_OBJECT_ENSURE_REGISTERED (SatGenericStreamEncapsulatorArq);
 
 SatGenericStreamEncapsulatorArq::SatGenericStreamEncapsulatorArq ()
   : m_seqNo (),
-    m_txedBuffer (),
+    m_txedBuffer (std::numeric_limits<uint8_t>::max () + 1),
     m_retxBuffer (),
     m_retxBufferSize (0),
     m_txedBufferSize (0),
+    m_retxTimers (),
     m_maxNoOfRetransmissions (2),
     m_retransmissionTimer (Seconds (0.6)),
     m_arqWindowSize (10),
     m_arqHeaderSize (1),
-    m_nextExpectedSeqNo (0)
+    m_nextExpectedSeqNo (0),
+    m_reorderingBuffer (),
+    m_reorderingBufferEnd (0),
+    m_rxWaitingTimers ()
 {
   NS_LOG_FUNCTION (this);
   NS_ASSERT (false);
@@ -64,15 +68,19 @@ SatGenericStreamEncapsulatorArq::SatGenericStreamEncapsulatorArq ()
 SatGenericStreamEncapsulatorArq::SatGenericStreamEncapsulatorArq (Mac48Address source, Mac48Address dest, uint8_t flowId)
   : SatGenericStreamEncapsulator (source, dest, flowId),
     m_seqNo (),
-    m_txedBuffer (),
+    m_txedBuffer (std::numeric_limits<uint8_t>::max () + 1),
     m_retxBuffer (),
     m_retxBufferSize (0),
     m_txedBufferSize (0),
+    m_retxTimers (),
     m_maxNoOfRetransmissions (2),
     m_retransmissionTimer (Seconds (0.6)),
     m_arqWindowSize (10),
     m_arqHeaderSize (1),
-    m_nextExpectedSeqNo (0)
+    m_nextExpectedSeqNo (0),
+    m_reorderingBuffer (),
+    m_reorderingBufferEnd (0),
+    m_rxWaitingTimers ()
 {
   NS_LOG_FUNCTION (this);
 
@@ -81,6 +89,9 @@ SatGenericStreamEncapsulatorArq::SatGenericStreamEncapsulatorArq (Mac48Address s
   // ARQ sequence number generator
   m_seqNo = Create<SatArqSequenceNumber> (m_arqWindowSize);
 
+  m_retxTimers.SetExpiryCallback (MakeCallback (&SatGenericStreamEncapsulatorArq::ArqReTxTimerExpired, this));
+  m_rxWaitingTimers.SetExpiryCallback (MakeCallback (&SatGenericStreamEncapsulatorArq::RxWaitingTimerExpired, this));
+
 }
 
 SatGenericStreamEncapsulatorArq::~SatGenericStreamEncapsulatorArq ()
@@ -138,35 +149,30 @@ SatGenericStreamEncapsulatorArq::DoDispose ()
   NS_LOG_FUNCTION (this);
   m_seqNo = 0;
 
-  // Clean-up the Tx'ed buffer
-  std::map<uint8_t, Ptr<SatArqBufferContext> >::iterator it = m_txedBuffer.begin ();
-  while (it != m_txedBuffer.end ())
-    {
-      it->second->DoDispose ();
-      it->second = 0;
-      ++it;
-    }
-  m_txedBuffer.clear ();
-
-  // Clean-up the reTx buffer
-  it = m_retxBuffer.begin ();
-  while (it != m_retxBuffer.end ())
+  // Clean-up the Tx'ed and reTx buffers
+  for (uint32_t i = 0; i < m_txedBuffer.size (); ++i)
     {
-      it->second->DoDispose ();
-      it->second = 0;
-      ++it;
+      if (m_txedBuffer[i])
+        {
+          m_txedBuffer[i]->DoDispose ();
+          m_txedBuffer[i] = 0;
+        }
     }
   m_retxBuffer.clear ();
+  m_retxTimers.Clear ();
 
   // Clean-up the reordering buffer
-  std::map<uint32_t, Ptr<SatArqBufferContext> >::iterator it2 = m_reorderingBuffer.begin ();
-  while (it2 != m_reorderingBuffer.end ())
+  for (uint32_t i = 0; i < m_reorderingBuffer.size (); ++i)
     {
-      it2->second->DoDispose ();
-      it2->second = 0;
-      ++it2;
+      if (m_reorderingBuffer[i])
+        {
+          m_reorderingBuffer[i]->DoDispose ();
+          m_reorderingBuffer[i] = 0;
+        }
     }
   m_reorderingBuffer.clear ();
+  m_reorderingBufferEnd = m_nextExpectedSeqNo;
+  m_rxWaitingTimers.Clear ();
 
   SatGenericStreamEncapsulator::DoDispose ();
 }
@@ -189,7 +195,7 @@ SatGenericStreamEncapsulatorArq::NotifyTxOpportunity (uint32_t bytes, uint32_t &
   if (!m_retxBuffer.empty ())
     {
       // Oldest seqNo sent first
-      Ptr<SatArqBufferContext> context = m_retxBuffer.begin ()->second;
+      Ptr<SatArqBufferContext> context = m_txedBuffer[m_retxBuffer.front ()];
 
       // If the packet fits into the transmission opportunity
       if (context->m_pdu->GetSize () <= bytes)
@@ -203,20 +209,10 @@ SatGenericStreamEncapsulatorArq::NotifyTxOpportunity (uint32_t bytes, uint32_t &
           m_retxBufferSize -= context->m_pdu->GetSize ();
           m_txedBufferSize += context->m_pdu->GetSize ();
 
-          std::map<uint8_t, Ptr<SatArqBufferContext> >::iterator it = m_txedBuffer.find (context->m_seqNo);
-          if (it != m_txedBuffer.end ())
-            {
-              NS_FATAL_ERROR ("Trying to add retransmission packet to txedBuffer even though it already exists there!");
-            }
-
-          // Store it back to the transmitted packet container.
-          m_txedBuffer.insert (std::make_pair (context->m_seqNo, context));
-
-          // Create the retransmission event and store it to the context. Event is cancelled if a ACK
-          // is received. However, if the event triggers, we shall send the packet again, if the packet still
+          // Start the retransmission timer and store it to the context. Timer is stopped if a ACK
+          // is received. However, if the timer expires, we shall send the packet again, if the packet still
           // has retransmissions left.
-          EventId t = Simulator::Schedule (m_retransmissionTimer, &SatGenericStreamEncapsulatorArq::ArqReTxTimerExpired, this, context->m_seqNo);
-          context->m_waitingTimer = t;
+          context->m_waitingTimerId = m_retxTimers.Start (m_retransmissionTimer, context->m_seqNo);
 
           NS_LOG_INFO ("GW: << " << m_sourceAddress << " sent a retransmission packet of size: " << context->m_pdu->GetSize () << " with seqNo: " << (uint32_t)(context->m_seqNo) << " flowId: " << (uint32_t)(m_flowId) << " at: " << Now ().GetSeconds ());
 
@@ -264,14 +260,14 @@ SatGenericStreamEncapsulatorArq::NotifyTxOpportunity (uint32_t bytes, uint32_t &
           arqContext->m_pdu = copy;
           arqContext->m_seqNo = seqNo;
 
-          // Create the retransmission event and store it to the context. Event is cancelled if a ACK
-          // is received. However, if the event triggers, we shall send the packet again, if the packet still
+          // Start the retransmission timer and store it to the context. Timer is stopped if a ACK
+          // is received. However, if the timer expires, we shall send the packet again, if the packet still
           // has retransmissions left.
-          arqContext->m_waitingTimer = Simulator::Schedule (m_retransmissionTimer, &SatGenericStreamEncapsulatorArq::ArqReTxTimerExpired, this, seqNo);
+          arqContext->m_waitingTimerId = m_retxTimers.Start (m_retransmissionTimer, seqNo);
 
           // Update the buffer status
           m_txedBufferSize += packet->GetSize ();
-          m_txedBuffer.insert (std::make_pair (seqNo, arqContext));
+          m_txedBuffer[seqNo] = arqContext;
 
           if (packet->GetSize () > bytes)
             {
@@ -293,36 +289,42 @@ SatGenericStreamEncapsulatorArq::NotifyTxOpportunity (uint32_t bytes, uint32_t &
 }
 
 void
-SatGenericStreamEncapsulatorArq::ArqReTxTimerExpired (uint8_t seqNo)
+SatGenericStreamEncapsulatorArq::ArqReTxTimerExpired (uint32_t seqNo)
 {
-  NS_LOG_FUNCTION (this << (uint32_t) seqNo);
+  NS_LOG_FUNCTION (this << seqNo);
 
-  NS_LOG_INFO ("At GW: " << m_sourceAddress << " ARQ retransmission timer expired for: " << (uint32_t)(seqNo) << " at: " << Now ().GetSeconds ());
+  NS_LOG_INFO ("At GW: " << m_sourceAddress << " ARQ retransmission timer expired for: " << seqNo << " at: " << Now ().GetSeconds ());
 
-  std::map<uint8_t, Ptr<SatArqBufferContext> >::iterator it = m_txedBuffer.find (seqNo);
+  Ptr<SatArqBufferContext> context = m_txedBuffer[seqNo];
 
-  if (it != m_txedBuffer.end ())
+  if (context)
     {
-      NS_ASSERT (seqNo == it->second->m_seqNo);
-      NS_ASSERT (it->second->m_pdu);
+      NS_ASSERT (seqNo == context->m_seqNo);
+      NS_ASSERT (context->m_pdu);
 
       // Retransmission still possible
-      if (it->second->m_retransmissionCount < m_maxNoOfRetransmissions)
+      if (context->m_retransmissionCount < m_maxNoOfRetransmissions)
         {
           NS_LOG_INFO ("Moving the ARQ context to retransmission buffer");
 
-          Ptr<SatArqBufferContext> context = it->second;
-
-          m_txedBuffer.erase (it);
+          // The context is still in m_txedBuffer to be found by its seqNo, but
+          // its size is moved to the retransmission buffer, as the size is added
+          // to the Tx'ed buffer again when the PDU is retransmitted.
+          m_txedBufferSize -= context->m_pdu->GetSize ();
           m_retxBufferSize += context->m_pdu->GetSize ();
 
-          // Push to the retransmission buffer
-          m_retxBuffer.insert (std::make_pair (seqNo, context));
+          // Push to the retransmission buffer, keeping it in the seqNo order
+          m_retxBuffer.insert (std::lower_bound (m_retxBuffer.begin (), m_retxBuffer.end (), (uint8_t) seqNo), (uint8_t) seqNo);
+
+          if (!m_backlogCallback.IsNull ())
+            {
+              m_backlogCallback (m_destAddress, m_flowId);
+            }
         }
       // Maximum retransmissions reached
       else
         {
-          NS_LOG_INFO ("For GW: " << m_sourceAddress << " max retransmissions reached for " << (uint32_t)(seqNo) << " at: " << Now ().GetSeconds ());
+          NS_LOG_INFO ("For GW: " << m_sourceAddress << " max retransmissions reached for " << seqNo << " at: " << Now ().GetSeconds ());
 
           // Do clean-up
           CleanUp (seqNo);
@@ -342,26 +344,29 @@ SatGenericStreamEncapsulatorArq::CleanUp (uint8_t sequenceNumber)
   // Release sequence number
   m_seqNo->Release (sequenceNumber);
 
-  // Clean-up the Tx'ed buffer
-  std::map<uint8_t, Ptr<SatArqBufferContext> >::iterator it = m_txedBuffer.find (sequenceNumber);
-  if (it != m_txedBuffer.end ())
+  Ptr<SatArqBufferContext> context = m_txedBuffer[sequenceNumber];
+  if (context)
     {
-      NS_LOG_INFO ("Sequence no: " << (uint32_t) sequenceNumber << " clean up from txedBuffer!");
-      m_txedBufferSize -= it->second->m_pdu->GetSize ();
-      it->second->DoDispose ();
-      it->second = 0;
-      m_txedBuffer.erase (it);
-    }
+      m_retxTimers.Stop (context->m_waitingTimerId);
 
-  // Clean-up the reTx buffer
-  it = m_retxBuffer.find (sequenceNumber);
-  if (it != m_retxBuffer.end ())
-    {
-      NS_LOG_INFO ("Sequence no: " << (uint32_t) sequenceNumber << " clean up from retxBuffer!");
-      m_retxBufferSize -= it->second->m_pdu->GetSize ();
-      it->second->DoDispose ();
-      it->second = 0;
-      m_retxBuffer.erase (it);
+      std::vector<uint8_t>::iterator it = std::find (m_retxBuffer.begin (), m_retxBuffer.end (), sequenceNumber);
+
+      // Clean-up the reTx buffer
+      if (it != m_retxBuffer.end ())
+        {
+          NS_LOG_INFO ("Sequence no: " << (uint32_t) sequenceNumber << " clean up from retxBuffer!");
+          m_retxBufferSize -= context->m_pdu->GetSize ();
+          m_retxBuffer.erase (it);
+        }
+      // Clean-up the Tx'ed buffer
+      else
+        {
+          NS_LOG_INFO ("Sequence no: " << (uint32_t) sequenceNumber << " clean up from txedBuffer!");
+          m_txedBufferSize -= context->m_pdu->GetSize ();
+        }
+
+      context->DoDispose ();
+      m_txedBuffer[sequenceNumber] = 0;
     }
 }
 
@@ -426,10 +431,10 @@ SatGenericStreamEncapsulatorArq::ReceivePdu (Ptr<Packet> p)
   // nothing is needed to be done.
   if (sn >= m_nextExpectedSeqNo)
     {
-      std::map<uint32_t, Ptr<SatArqBufferContext > >::iterator it = m_reorderingBuffer.find (sn);
+      Ptr<SatArqBufferContext> context = GetReorderingContext (sn);
 
       // If the context is not found, then we create a new one.
-      if (it == m_reorderingBuffer.end ())
+      if (!context)
         {
           NS_LOG_INFO ("GW: " << m_sourceAddress << " created a new ARQ buffer entry for SeqNo: " << sn << " at: " << Now ().GetSeconds ());
           Ptr<SatArqBufferContext> arqContext = CreateObject<SatArqBufferContext> ();
@@ -437,15 +442,15 @@ SatGenericStreamEncapsulatorArq::ReceivePdu (Ptr<Packet> p)
           arqContext->m_rxStatus = true;
           arqContext->m_seqNo = sn;
           arqContext->m_retransmissionCount = 0;
-          m_reorderingBuffer.insert (std::make_pair (sn, arqContext));
+          AddReorderingContext (arqContext);
         }
       // If the context is found, update it.
       else
         {
           NS_LOG_INFO ("GW: " << m_sourceAddress << " reset an existing ARQ entry for SeqNo: " << sn << " at " << Now ().GetSeconds ());
-          it->second->m_waitingTimer.Cancel ();
-          it->second->m_pdu = p;
-          it->second->m_rxStatus = true;
+          m_rxWaitingTimers.Stop (context->m_waitingTimerId);
+          context->m_pdu = p;
+          context->m_rxStatus = true;
         }
 
       NS_LOG_INFO ("Received a packet with SeqNo: " << sn << ", expecting: " << m_nextExpectedSeqNo);
@@ -456,12 +461,10 @@ SatGenericStreamEncapsulatorArq::ReceivePdu (Ptr<Packet> p)
           // Add context
           for (uint32_t i = m_nextExpectedSeqNo; i < sn; ++i)
             {
-              std::map<uint32_t, Ptr<SatArqBufferContext > >::iterator it2 = m_reorderingBuffer.find (i);
-
               NS_LOG_INFO ("Finding context for " << i);
 
               // If context not found
-              if (it2 == m_reorderingBuffer.end ())
+              if (!GetReorderingContext (i))
                 {
                   NS_LOG_INFO ("Context NOT found for SeqNo: " << i);
 
@@ -470,9 +473,8 @@ SatGenericStreamEncapsulatorArq::ReceivePdu (Ptr<Packet> p)
                   arqContext->m_rxStatus = false;
                   arqContext->m_seqNo = i;
                   arqContext->m_retransmissionCount = 0;
-                  m_reorderingBuffer.insert (std::make_pair (i, arqContext));
-                  EventId id = Simulator::Schedule (m_rxWaitingTimer, &SatGenericStreamEncapsulatorArq::RxWaitingTimerExpired, this, i);
-                  arqContext->m_waitingTimer = id;
+                  arqContext->m_waitingTimerId = m_rxWaitingTimers.Start (m_rxWaitingTimer, i);
+                  AddReorderingContext (arqContext);
                 }
             }
         }
@@ -529,37 +531,76 @@ SatGenericStreamEncapsulatorArq::ReassembleAndReceive ()
 {
   NS_LOG_FUNCTION (this);
 
-  // Start from the expected sequence number iterator
-  std::map<uint32_t, Ptr<SatArqBufferContext> >::iterator it = m_reorderingBuffer.begin ();
-
-  NS_LOG_INFO ("Process SeqNo: " << it->first << ", expected: " << m_nextExpectedSeqNo << ", status: " << it->second->m_rxStatus);
-
   /**
    * As long as the PDU is the next expected one, process the PDU
    * and erase it.
    */
-  while (it != m_reorderingBuffer.end () && it->first == m_nextExpectedSeqNo && it->second->m_rxStatus == true)
+  Ptr<SatArqBufferContext> context = GetReorderingContext (m_nextExpectedSeqNo);
+
+  while (context && context->m_rxStatus == true)
     {
-      NS_LOG_INFO ("Process SeqNo: " << it->first << ", expected: " << m_nextExpectedSeqNo << ", status: " << it->second->m_rxStatus);
+      NS_LOG_INFO ("Process SeqNo: " << context->m_seqNo << ", expected: " << m_nextExpectedSeqNo << ", status: " << context->m_rxStatus);
 
       // If PDU == NULL, it means that the RxWaitingTimer has expired
       // without PDU being received
-      if (it->second->m_pdu)
+      if (context->m_pdu)
         {
           // Process the PDU
-          ProcessPdu (it->second->m_pdu);
+          ProcessPdu (context->m_pdu);
         }
 
-      it->second->DoDispose ();
-      it->second = 0;
-      m_reorderingBuffer.erase (it);
-      it = m_reorderingBuffer.begin ();
+      context->DoDispose ();
+      m_reorderingBuffer[m_nextExpectedSeqNo & (m_reorderingBuffer.size () - 1)] = 0;
 
       // Increase the seq no
       ++m_nextExpectedSeqNo;
 
       NS_LOG_INFO ("Increasing SeqNo to " << m_nextExpectedSeqNo);
+
+      context = GetReorderingContext (m_nextExpectedSeqNo);
+    }
+}
+
+Ptr<SatArqBufferContext>
+SatGenericStreamEncapsulatorArq::GetReorderingContext (uint32_t sn) const
+{
+  if (sn < m_nextExpectedSeqNo || sn >= m_reorderingBufferEnd)
+    {
+      return 0;
+    }
+
+  return m_reorderingBuffer[sn & (m_reorderingBuffer.size () - 1)];
+}
+
+void
+SatGenericStreamEncapsulatorArq::AddReorderingContext (Ptr<SatArqBufferContext> context)
+{
+  NS_LOG_FUNCTION (this << context->m_seqNo);
+  NS_ASSERT (context->m_seqNo >= m_nextExpectedSeqNo);
+
+  uint32_t sn = context->m_seqNo;
+
+  if (sn - m_nextExpectedSeqNo >= m_reorderingBuffer.size ())
+    {
+      // Grow the ring buffer to cover the sequence number, keeping the
+      // contexts at their sequence number positions
+      uint32_t size = std::max<uint32_t> (16, m_reorderingBuffer.size ());
+      while (sn - m_nextExpectedSeqNo >= size)
+        {
+          size *= 2;
+        }
+
+      std::vector<Ptr<SatArqBufferContext> > buffer (size);
+      for (uint32_t i = m_nextExpectedSeqNo; i < m_reorderingBufferEnd; ++i)
+        {
+          buffer[i & (size - 1)] = m_reorderingBuffer[i & (m_reorderingBuffer.size () - 1)];
+        }
+
+      m_reorderingBuffer.swap (buffer);
     }
+
+  m_reorderingBuffer[sn & (m_reorderingBuffer.size () - 1)] = context;
+  m_reorderingBufferEnd = std::max (m_reorderingBufferEnd, sn + 1);
 }
 
 
@@ -571,12 +612,11 @@ SatGenericStreamEncapsulatorArq::RxWaitingTimerExpired (uint32_t seqNo)
   NS_LOG_INFO ("For GW: " << m_sourceAddress << " max waiting time reached for SeqNo: " << seqNo << " at: " << Now ().GetSeconds ());
   NS_LOG_INFO ("Mark the PDU received and move forward!");
 
-  // Find waiting timer, erase it and mark the packet received.
-  std::map<uint32_t, Ptr<SatArqBufferContext> >::iterator it = m_reorderingBuffer.find (seqNo);
-  if (it != m_reorderingBuffer.end ())
+  // Find the context and mark the packet received.
+  Ptr<SatArqBufferContext> context = GetReorderingContext (seqNo);
+  if (context)
     {
-      it->second->m_waitingTimer.Cancel ();
-      it->second->m_rxStatus = true;
+      context->m_rxStatus = true;
     }
   else
     {
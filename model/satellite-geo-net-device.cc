@@ -289,4 +289,16 @@ SatGeoNetDevice::AddFeederPhy (Ptr<SatPhy> phy, uint32_t beamId)
   m_feederPhy.insert (std::pair<uint32_t, Ptr<SatPhy> > (beamId, phy));
 }
 
+const std::map<uint32_t, Ptr<SatPhy> >&
+SatGeoNetDevice::GetUserPhy () const
+{
+  return m_userPhy;
+}
+
+const std::map<uint32_t, Ptr<SatPhy> >&
+SatGeoNetDevice::GetFeederPhy () const
+{
+  return m_feederPhy;
+}
+
 } // namespace ns3
@@ -88,6 +88,18 @@ public:
    */
   void AddFeederPhy (Ptr<SatPhy> phy, uint32_t beamId);
 
+  /**
+   * Get the User Phy objects of the beams
+   * \return map of beam id to user phy object
+   */
+  const std::map<uint32_t, Ptr<SatPhy> >& GetUserPhy () const;
+
+  /**
+   * Get the Feeder Phy objects of the beams
+   * \return map of beam id to feeder phy object
+   */
+  const std::map<uint32_t, Ptr<SatPhy> >& GetFeederPhy () const;
+
   /**
    * Attach a receive ErrorModel to the SatGeoNetDevice.
    * \param em Ptr to the ErrorModel.
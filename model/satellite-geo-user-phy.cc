@@ -33,6 +33,7 @@
 #include "satellite-mac.h"
 #include "satellite-signal-parameters.h"
 #include "satellite-channel-estimation-error-container.h"
+#include "satellite-packet-trace.h"
 
 NS_LOG_COMPONENT_DEFINE ("SatGeoUserPhy");
 
@@ -181,14 +182,18 @@ SatGeoUserPhy::SendPduWithParams (Ptr<SatSignalParameters> txParams )
   NS_LOG_INFO (this << " sending a packet with carrierId: " << txParams->m_carrierId << " duration: " << txParams->m_duration);
 
   // Add packet trace entry:
-  m_packetTrace (Simulator::Now (),
-                 SatEnums::PACKET_SENT,
-                 m_nodeInfo->GetNodeType (),
-                 m_nodeInfo->GetNodeId (),
-                 m_nodeInfo->GetMacAddress (),
-                 SatEnums::LL_PHY,
-                 SatEnums::LD_FORWARD,
-                 SatUtils::GetPacketInfo (txParams->m_packetsInBurst));
+  if (!m_packetTrace.IsEmpty ()
+      && SatPacketTrace::IsTraced (SatEnums::PACKET_SENT, m_nodeInfo->GetNodeType (), SatEnums::LD_FORWARD))
+    {
+      m_packetTrace (Simulator::Now (),
+                     SatEnums::PACKET_SENT,
+                     m_nodeInfo->GetNodeType (),
+                     m_nodeInfo->GetNodeId (),
+                     m_nodeInfo->GetMacAddress (),
+                     SatEnums::LL_PHY,
+                     SatEnums::LD_FORWARD,
+                     SatUtils::GetPacketInfo (txParams->m_packetsInBurst));
+    }
 
   // copy as sender own PhyTx object (at satellite) to ensure right distance calculation
   // and antenna gain getting at receiver (UT or GW)
@@ -205,14 +210,18 @@ SatGeoUserPhy::Receive (Ptr<SatSignalParameters> rxParams, bool /*phyError*/)
   NS_LOG_FUNCTION (this << rxParams);
 
   // Add packet trace entry:
-  m_packetTrace (Simulator::Now (),
-                 SatEnums::PACKET_RECV,
-                 m_nodeInfo->GetNodeType (),
-                 m_nodeInfo->GetNodeId (),
-                 m_nodeInfo->GetMacAddress (),
-                 SatEnums::LL_PHY,
-                 SatEnums::LD_RETURN,
-                 SatUtils::GetPacketInfo (rxParams->m_packetsInBurst));
+  if (!m_packetTrace.IsEmpty ()
+      && SatPacketTrace::IsTraced (SatEnums::PACKET_RECV, m_nodeInfo->GetNodeType (), SatEnums::LD_RETURN))
+    {
+      m_packetTrace (Simulator::Now (),
+                     SatEnums::PACKET_RECV,
+                     m_nodeInfo->GetNodeType (),
+                     m_nodeInfo->GetNodeId (),
+                     m_nodeInfo->GetMacAddress (),
+                     SatEnums::LL_PHY,
+                     SatEnums::LD_RETURN,
+                     SatUtils::GetPacketInfo (rxParams->m_packetsInBurst));
+    }
 
   m_rxCallback ( rxParams->m_packetsInBurst, rxParams);
 }
@@ -30,6 +30,7 @@
 #include "satellite-node-info.h"
 #include "satellite-enums.h"
 #include "satellite-utils.h"
+#include "satellite-packet-trace.h"
 
 NS_LOG_COMPONENT_DEFINE ("SatGwLlc");
 
@@ -62,6 +63,8 @@ SatGwLlc::DoDispose ()
 {
   NS_LOG_FUNCTION (this);
 
+  m_backloggedEncaps.clear ();
+
   SatLlc::DoDispose ();
 }
 
@@ -72,26 +75,34 @@ SatGwLlc::NotifyTxOpportunity (uint32_t bytes, Mac48Address utAddr, uint8_t flow
   NS_LOG_FUNCTION (this << utAddr << bytes << (uint32_t) flowId);
 
   Ptr<Packet> packet;
-  Ptr<EncapKey> key = Create<EncapKey> (m_nodeInfo->GetMacAddress (), utAddr, flowId);
-  EncapContainer_t::iterator it = m_encaps.find (key);
+  EncapContainer_t::iterator it = m_encaps.find (m_nodeInfo->GetMacAddress (), utAddr, flowId);
 
   if (it != m_encaps.end ())
     {
       packet = it->second->NotifyTxOpportunity (bytes, bytesLeft, nextMinTxO);
 
+      if (it->second->GetTxBufferSizeInBytes () == 0)
+        {
+          m_backloggedEncaps.erase (it->first);
+        }
+
       if (packet)
         {
           SatEnums::SatLinkDir_t ld = SatEnums::LD_FORWARD;
 
           // Add packet trace entry:
-          m_packetTrace (Simulator::Now (),
-                         SatEnums::PACKET_SENT,
-                         m_nodeInfo->GetNodeType (),
-                         m_nodeInfo->GetNodeId (),
-                         m_nodeInfo->GetMacAddress (),
-                         SatEnums::LL_LLC,
-                         ld,
-                         SatUtils::GetPacketInfo (packet));
+          if (!m_packetTrace.IsEmpty ()
+              && SatPacketTrace::IsTraced (SatEnums::PACKET_SENT, m_nodeInfo->GetNodeType (), ld))
+            {
+              m_packetTrace (Simulator::Now (),
+                             SatEnums::PACKET_SENT,
+                             m_nodeInfo->GetNodeType (),
+                             m_nodeInfo->GetNodeId (),
+                             m_nodeInfo->GetMacAddress (),
+                             SatEnums::LL_LLC,
+                             ld,
+                             SatUtils::GetPacketInfo (packet));
+            }
         }
     }
   else
@@ -121,6 +132,7 @@ SatGwLlc::CreateEncap (Ptr<EncapKey> key)
 
   Ptr<SatQueue> queue = CreateObject<SatQueue> (key->m_flowId);
   gwEncap->SetQueue (queue);
+  gwEncap->SetBacklogCallback (MakeCallback (&SatGwLlc::ArqBacklogged, this));
 
   NS_LOG_INFO ("Create encapsulator with key (" << key->m_source << ", " << key->m_destination << ", " << (uint32_t) key->m_flowId << ")");
 
@@ -162,28 +174,65 @@ SatGwLlc::CreateDecap (Ptr<EncapKey> key)
 }
 
 
+void
+SatGwLlc::EncapBacklogged (Ptr<EncapKey> key, Ptr<SatBaseEncapsulator> encap)
+{
+  NS_LOG_FUNCTION (this << key->m_source << key->m_destination << (uint32_t)(key->m_flowId));
+
+  if (m_backloggedEncaps.find (key) == m_backloggedEncaps.end ())
+    {
+      BacklogEntry_t entry;
+      entry.encap = encap;
+      m_backloggedEncaps.insert (std::make_pair (key, entry));
+    }
+}
+
+void
+SatGwLlc::ArqBacklogged (Mac48Address utAddr, uint8_t flowId)
+{
+  NS_LOG_FUNCTION (this << utAddr << (uint32_t) flowId);
+
+  EncapContainer_t::iterator it = m_encaps.find (m_nodeInfo->GetMacAddress (), utAddr, flowId);
+
+  if (it != m_encaps.end ())
+    {
+      EncapBacklogged (it->first, it->second);
+    }
+}
+
 void SatGwLlc::GetSchedulingContexts (std::vector< Ptr<SatSchedulingObject> > & output) const
 {
   NS_LOG_FUNCTION (this);
 
-  // Head of link queuing delay
-  Time holDelay;
+  // Only the backlogged encapsulators in flow id order
+  BacklogContainer_t::iterator it = m_backloggedEncaps.begin ();
 
-  // Then the user data
-  for (EncapContainer_t::const_iterator cit = m_encaps.begin ();
-       cit != m_encaps.end ();
-       ++cit)
+  while (it != m_backloggedEncaps.end ())
     {
-      uint32_t buf = cit->second->GetTxBufferSizeInBytes ();
+      uint32_t buf = it->second.encap->GetTxBufferSizeInBytes ();
 
-      if (buf > 0)
+      if (buf == 0)
         {
-          holDelay = cit->second->GetHolDelay ();
-          uint32_t minTxOpportunityInBytes = cit->second->GetMinTxOpportunityInBytes ();
-          Ptr<SatSchedulingObject> so =
-            Create<SatSchedulingObject> (cit->first->m_destination, buf, minTxOpportunityInBytes, holDelay, cit->first->m_flowId);
-          output.push_back (so);
+          m_backloggedEncaps.erase (it++);
+          continue;
         }
+
+      // Head of link queuing delay
+      Time holDelay = it->second.encap->GetHolDelay ();
+      uint32_t minTxOpportunityInBytes = it->second.encap->GetMinTxOpportunityInBytes ();
+
+      if (it->second.schedulingObject)
+        {
+          it->second.schedulingObject->Update (buf, minTxOpportunityInBytes, holDelay);
+        }
+      else
+        {
+          it->second.schedulingObject =
+            Create<SatSchedulingObject> (it->first->m_destination, buf, minTxOpportunityInBytes, holDelay, it->first->m_flowId);
+        }
+
+      output.push_back (it->second.schedulingObject);
+      ++it;
     }
 }
 
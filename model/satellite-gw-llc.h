@@ -21,8 +21,10 @@
 #ifndef SATELLITE_GW_LLC_H_
 #define SATELLITE_GW_LLC_H_
 
+#include <map>
 #include "ns3/ptr.h"
 #include "satellite-llc.h"
+#include "satellite-scheduling-object.h"
 
 namespace ns3 {
 
@@ -31,6 +33,11 @@ namespace ns3 {
  * \brief SatGwLlc holds the GW implementation of LLC layer. SatGwLlc is inherited from
  * SatLlc base class and implements the needed changes from the base class related to
  * GW LLC packet transmissions and receptions.
+ *
+ * SatGwLlc keeps an index of the backlogged encapsulators, i.e. the ones
+ * having data to be transmitted, ordered by flow id. The index is updated
+ * when PDUs are enqueued to or transmitted from the encapsulators, thus the
+ * scheduling contexts are created only for the backlogged encapsulators.
  */
 class SatGwLlc : public SatLlc
 {
@@ -70,6 +77,8 @@ public:
   /**
    * \brief Create and fill the scheduling objects based on LLC layer information.
    * Scheduling objects may be used at the MAC layer to assist in scheduling.
+   * The objects are given in flow id order. The same object is reused for an
+   * encapsulator as long as it stays backlogged.
    * \param output reference to an output vector that will be filled with
    *               pointer to scheduling objects
    */
@@ -114,6 +123,61 @@ protected:
    */
   virtual void CreateDecap (Ptr<EncapKey> key);
 
+  /**
+   * \brief Add an encapsulator to the index of backlogged encapsulators.
+   * \param key Encapsulator key class
+   * \param encap Encapsulator
+   */
+  virtual void EncapBacklogged (Ptr<EncapKey> key, Ptr<SatBaseEncapsulator> encap);
+
+private:
+  /**
+   * \brief Callback of the encapsulators to inform that they have data to be
+   * transmitted without a new PDU being enqueued, e.g. due to ARQ retransmission.
+   * \param utAddr MAC address of the UT
+   * \param flowId Flow identifier
+   */
+  void ArqBacklogged (Mac48Address utAddr, uint8_t flowId);
+
+  /**
+   * \brief BacklogKeyCompare orders the encapsulator keys primarily by
+   * flow id, and secondarily as EncapKeyCompare.
+   */
+  class BacklogKeyCompare
+  {
+  public:
+    bool operator() (Ptr<EncapKey> key1, Ptr<EncapKey> key2) const
+    {
+      if ( key1->m_flowId != key2->m_flowId )
+        {
+          return (uint8_t) key1->m_flowId < (uint8_t) key2->m_flowId;
+        }
+
+      return EncapKeyCompare () (key1, key2);
+    }
+  };
+
+  /**
+   * \brief Entry of a backlogged encapsulator
+   */
+  typedef struct
+  {
+    Ptr<SatBaseEncapsulator> encap;
+    Ptr<SatSchedulingObject> schedulingObject;
+  } BacklogEntry_t;
+
+  /**
+   * Key = Ptr<EncapKey> (source, dest, flowId)
+   * Value = BacklogEntry_t
+   * Compare class = BacklogKeyCompare
+   */
+  typedef std::map < Ptr<EncapKey>, BacklogEntry_t, BacklogKeyCompare > BacklogContainer_t;
+
+  /**
+   * Index of the backlogged encapsulators. Encapsulators found empty while
+   * creating the scheduling contexts are removed from the index.
+   */
+  mutable BacklogContainer_t m_backloggedEncaps;
 };
 
 } // namespace ns3
@@ -29,6 +29,7 @@
 #include <ns3/satellite-utils.h>
 #include <ns3/satellite-log.h>
 #include "satellite-gw-mac.h"
+#include "satellite-packet-trace.h"
 
 #include <ns3/packet.h>
 #include <ns3/address.h>
@@ -125,14 +126,18 @@ SatGwMac::Receive (SatPhy::PacketContainer_t packets, Ptr<SatSignalParameters> /
   NS_LOG_FUNCTION (this);
 
   // Add packet trace entry:
-  m_packetTrace (Simulator::Now (),
-                 SatEnums::PACKET_RECV,
-                 m_nodeInfo->GetNodeType (),
-                 m_nodeInfo->GetNodeId (),
-                 m_nodeInfo->GetMacAddress (),
-                 SatEnums::LL_MAC,
-                 SatEnums::LD_RETURN,
-                 SatUtils::GetPacketInfo (packets));
+  if (!m_packetTrace.IsEmpty ()
+      && SatPacketTrace::IsTraced (SatEnums::PACKET_RECV, m_nodeInfo->GetNodeType (), SatEnums::LD_RETURN))
+    {
+      m_packetTrace (Simulator::Now (),
+                     SatEnums::PACKET_RECV,
+                     m_nodeInfo->GetNodeType (),
+                     m_nodeInfo->GetNodeId (),
+                     m_nodeInfo->GetMacAddress (),
+                     SatEnums::LL_MAC,
+                     SatEnums::LD_RETURN,
+                     SatUtils::GetPacketInfo (packets));
+    }
 
   // Invoke the `Rx` and `RxDelay` trace sources.
   RxTraces (packets);
@@ -205,14 +210,18 @@ SatGwMac::StartTransmission (uint32_t carrierId)
           m_bbFrameTxTrace (bbFrame->GetFrameType ());
 
           // Add packet trace entry:
-          m_packetTrace (Simulator::Now (),
-                         SatEnums::PACKET_SENT,
-                         m_nodeInfo->GetNodeType (),
-                         m_nodeInfo->GetNodeId (),
-                         m_nodeInfo->GetMacAddress (),
-                         SatEnums::LL_MAC,
-                         SatEnums::LD_FORWARD,
-                         SatUtils::GetPacketInfo (bbFrame->GetPayload ()));
+          if (!m_packetTrace.IsEmpty ()
+              && SatPacketTrace::IsTraced (SatEnums::PACKET_SENT, m_nodeInfo->GetNodeType (), SatEnums::LD_FORWARD))
+            {
+              m_packetTrace (Simulator::Now (),
+                             SatEnums::PACKET_SENT,
+                             m_nodeInfo->GetNodeType (),
+                             m_nodeInfo->GetNodeId (),
+                             m_nodeInfo->GetMacAddress (),
+                             SatEnums::LL_MAC,
+                             SatEnums::LD_FORWARD,
+                             SatUtils::GetPacketInfo (bbFrame->GetPayload ()));
+            }
 
           SatSignalParameters::txInfo_s txInfo;
           txInfo.packetType = SatEnums::PACKET_TYPE_DEDICATED_ACCESS;
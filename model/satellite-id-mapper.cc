@@ -22,7 +22,9 @@
 #include <ns3/log.h>
 #include <ns3/node.h>
 #include <ns3/address.h>
+#include <ns3/mac48-address.h>
 #include <ns3/satellite-net-device.h>
+#include <algorithm>
 #include <sstream>
 
 NS_LOG_COMPONENT_DEFINE ("SatIdMapper");
@@ -77,50 +79,11 @@ SatIdMapper::Reset ()
       PrintTraceMap ();
     }
 
-  // Trace ID maps
+  m_records.Clear ();
 
-  if (!m_macToTraceIdMap.empty ())
-    {
-      m_macToTraceIdMap.clear ();
-    }
   m_traceIdIndex = 1;
-
-  // UT ID maps
-
-  if (!m_macToUtIdMap.empty ())
-    {
-      m_macToUtIdMap.clear ();
-    }
   m_utIdIndex = 1;
-
-  // UT user ID maps
-
-  if (!m_macToUtUserIdMap.empty ())
-    {
-      m_macToUtUserIdMap.clear ();
-    }
   m_utUserIdIndex = 1;
-
-  // Beam ID maps
-
-  if (!m_macToBeamIdMap.empty ())
-    {
-      m_macToBeamIdMap.clear ();
-    }
-
-  // GW ID maps
-
-  if (!m_macToGwIdMap.empty ())
-    {
-      m_macToGwIdMap.clear ();
-    }
-
-  // GW user ID maps
-
-  if (!m_macToGwUserIdMap.empty ())
-    {
-      m_macToGwUserIdMap.clear ();
-    }
   m_gwUserIdIndex = 1;
 
   m_enableMapPrint = false;
@@ -133,18 +96,18 @@ SatIdMapper::AttachMacToTraceId (Address mac)
 {
   NS_LOG_FUNCTION (this);
 
-  const uint32_t ret = m_traceIdIndex;
-  std::pair < std::map<Address, uint32_t>::iterator, bool> resultMacToTraceId = m_macToTraceIdMap.insert (std::make_pair (mac, m_traceIdIndex));
+  MacRecord_t& record = GetOrAddRecord (mac);
 
-  if (resultMacToTraceId.second == false)
+  if (record.traceId >= 0)
     {
       NS_FATAL_ERROR ("SatIdMapper::AttachMacToTraceId - MAC to Trace ID failed");
     }
 
+  record.traceId = m_traceIdIndex;
+
   NS_LOG_INFO ("SatIdMapper::AttachMacToTraceId - Added MAC " << mac << " with Trace ID " << m_traceIdIndex);
 
-  m_traceIdIndex++;
-  return ret;
+  return m_traceIdIndex++;
 }
 
 uint32_t
@@ -152,18 +115,18 @@ SatIdMapper::AttachMacToUtId (Address mac)
 {
   NS_LOG_FUNCTION (this);
 
-  const uint32_t ret = m_utIdIndex;
-  std::pair < std::map<Address, uint32_t>::iterator, bool> resultMacToUtId = m_macToUtIdMap.insert (std::make_pair (mac, m_utIdIndex));
+  MacRecord_t& record = GetOrAddRecord (mac);
 
-  if (resultMacToUtId.second == false)
+  if (record.utId >= 0)
     {
       NS_FATAL_ERROR ("SatIdMapper::AttachMacToUtId - MAC to UT ID failed");
     }
 
+  record.utId = m_utIdIndex;
+
   NS_LOG_INFO ("SatIdMapper::AttachMacToUtId - Added MAC " << mac << " with UT ID " << m_utIdIndex);
 
-  m_utIdIndex++;
-  return ret;
+  return m_utIdIndex++;
 }
 
 uint32_t
@@ -171,18 +134,18 @@ SatIdMapper::AttachMacToUtUserId (Address mac)
 {
   NS_LOG_FUNCTION (this);
 
-  const uint32_t ret = m_utUserIdIndex;
-  std::pair < std::map<Address, uint32_t>::iterator, bool> resultMacToUtUserId = m_macToUtUserIdMap.insert (std::make_pair (mac, m_utUserIdIndex));
+  MacRecord_t& record = GetOrAddRecord (mac);
 
-  if (resultMacToUtUserId.second == false)
+  if (record.utUserId >= 0)
     {
       NS_FATAL_ERROR ("SatIdMapper::AttachMacToUtUserId - MAC to UT user ID failed");
     }
 
+  record.utUserId = m_utUserIdIndex;
+
   NS_LOG_INFO ("SatIdMapper::AttachMacToUtUserId - Added MAC " << mac << " with UT user ID " << m_utUserIdIndex);
 
-  m_utUserIdIndex++;
-  return ret;
+  return m_utUserIdIndex++;
 }
 
 void
@@ -190,13 +153,15 @@ SatIdMapper::AttachMacToBeamId (Address mac, uint32_t beamId)
 {
   NS_LOG_FUNCTION (this);
 
-  std::pair < std::map<Address, uint32_t>::iterator, bool> resultMacToBeamId = m_macToBeamIdMap.insert (std::make_pair (mac, beamId));
+  MacRecord_t& record = GetOrAddRecord (mac);
 
-  if (resultMacToBeamId.second == false)
+  if (record.beamId >= 0)
     {
       NS_FATAL_ERROR ("SatIdMapper::AttachMacToBeamId - MAC to beam ID failed");
     }
 
+  record.beamId = beamId;
+
   NS_LOG_INFO ("SatIdMapper::AttachMacToBeamId - Added MAC " << mac << " with beam ID " << beamId);
 }
 
@@ -205,13 +170,15 @@ SatIdMapper::AttachMacToGwId (Address mac, uint32_t gwId)
 {
   NS_LOG_FUNCTION (this);
 
-  std::pair < std::map<Address, uint32_t>::iterator, bool> resultMacToGwId = m_macToGwIdMap.insert (std::make_pair (mac, gwId));
+  MacRecord_t& record = GetOrAddRecord (mac);
 
-  if (resultMacToGwId.second == false)
+  if (record.gwId >= 0)
     {
       NS_FATAL_ERROR ("SatIdMapper::AttachMacToGwId - MAC to GW ID failed");
     }
 
+  record.gwId = gwId;
+
   NS_LOG_INFO ("SatIdMapper::AttachMacToGwId - Added MAC " << mac << " with GW ID " << gwId);
 }
 
@@ -220,18 +187,18 @@ SatIdMapper::AttachMacToGwUserId (Address mac)
 {
   NS_LOG_FUNCTION (this);
 
-  const uint32_t ret = m_gwUserIdIndex;
-  std::pair < std::map<Address, uint32_t>::iterator, bool> resultMacToGwUserId = m_macToGwUserIdMap.insert (std::make_pair (mac, m_gwUserIdIndex));
+  MacRecord_t& record = GetOrAddRecord (mac);
 
-  if (resultMacToGwUserId.second == false)
+  if (record.gwUserId >= 0)
     {
       NS_FATAL_ERROR ("SatIdMapper::AttachMacToGwUserId - MAC to GW user ID failed");
     }
 
+  record.gwUserId = m_gwUserIdIndex;
+
   NS_LOG_INFO ("SatIdMapper::AttachMacToGwUserId - Added MAC " << mac << " with GW user ID " << m_gwUserIdIndex);
 
-  m_gwUserIdIndex++;
-  return ret;
+  return m_gwUserIdIndex++;
 }
 
 // ID GETTERS
@@ -241,14 +208,7 @@ SatIdMapper::GetTraceIdWithMac (Address mac) const
 {
   NS_LOG_FUNCTION (this);
 
-  std::map<Address, uint32_t>::const_iterator iter = m_macToTraceIdMap.find (mac);
-
-  if (iter == m_macToTraceIdMap.end ())
-    {
-      return -1;
-    }
-
-  return iter->second;
+  return GetTraceIdWithHandle (GetHandleWithMac (mac));
 }
 
 int32_t
@@ -256,74 +216,147 @@ SatIdMapper::GetUtIdWithMac (Address mac) const
 {
   NS_LOG_FUNCTION (this);
 
-  std::map<Address, uint32_t>::const_iterator iter = m_macToUtIdMap.find (mac);
+  return GetUtIdWithHandle (GetHandleWithMac (mac));
+}
 
-  if (iter == m_macToUtIdMap.end ())
-    {
-      return -1;
-    }
+int32_t
+SatIdMapper::GetUtUserIdWithMac (Address mac) const
+{
+  NS_LOG_FUNCTION (this);
 
-  return iter->second;
+  return GetUtUserIdWithHandle (GetHandleWithMac (mac));
 }
 
 int32_t
-SatIdMapper::GetUtUserIdWithMac (Address mac) const
+SatIdMapper::GetBeamIdWithMac (Address mac) const
 {
   NS_LOG_FUNCTION (this);
 
-  std::map<Address, uint32_t>::const_iterator iter = m_macToUtUserIdMap.find (mac);
+  return GetBeamIdWithHandle (GetHandleWithMac (mac));
+}
 
-  if (iter == m_macToUtUserIdMap.end ())
-    {
-      return -1;
-    }
+int32_t
+SatIdMapper::GetGwIdWithMac (Address mac) const
+{
+  NS_LOG_FUNCTION (this);
 
-  return iter->second;
+  return GetGwIdWithHandle (GetHandleWithMac (mac));
 }
 
 int32_t
-SatIdMapper::GetBeamIdWithMac (Address mac) const
+SatIdMapper::GetGwUserIdWithMac (Address mac) const
 {
   NS_LOG_FUNCTION (this);
 
-  std::map<Address, uint32_t>::const_iterator iter = m_macToBeamIdMap.find (mac);
+  return GetGwUserIdWithHandle (GetHandleWithMac (mac));
+}
+
+// HANDLE GETTERS
 
-  if (iter == m_macToBeamIdMap.end ())
+uint32_t
+SatIdMapper::GetHandleWithMac (Address mac) const
+{
+  NS_LOG_FUNCTION (this);
+
+  uint64_t key;
+
+  if (!GetMacKey (mac, key))
     {
-      return -1;
+      return INVALID_HANDLE;
     }
 
-  return iter->second;
+  uint32_t handle = m_records.Find (key);
+
+  return (handle == m_records.NOT_FOUND) ? INVALID_HANDLE : handle;
 }
 
 int32_t
-SatIdMapper::GetGwIdWithMac (Address mac) const
+SatIdMapper::GetTraceIdWithHandle (uint32_t handle) const
 {
-  NS_LOG_FUNCTION (this);
+  const MacRecord_t* record = GetRecord (handle);
+  return record ? record->traceId : -1;
+}
+
+int32_t
+SatIdMapper::GetUtIdWithHandle (uint32_t handle) const
+{
+  const MacRecord_t* record = GetRecord (handle);
+  return record ? record->utId : -1;
+}
+
+int32_t
+SatIdMapper::GetUtUserIdWithHandle (uint32_t handle) const
+{
+  const MacRecord_t* record = GetRecord (handle);
+  return record ? record->utUserId : -1;
+}
+
+int32_t
+SatIdMapper::GetBeamIdWithHandle (uint32_t handle) const
+{
+  const MacRecord_t* record = GetRecord (handle);
+  return record ? record->beamId : -1;
+}
+
+int32_t
+SatIdMapper::GetGwIdWithHandle (uint32_t handle) const
+{
+  const MacRecord_t* record = GetRecord (handle);
+  return record ? record->gwId : -1;
+}
+
+int32_t
+SatIdMapper::GetGwUserIdWithHandle (uint32_t handle) const
+{
+  const MacRecord_t* record = GetRecord (handle);
+  return record ? record->gwUserId : -1;
+}
 
-  std::map<Address, uint32_t>::const_iterator iter = m_macToGwIdMap.find (mac);
+// RECORD STORAGE
+
+SatIdMapper::MacRecord_t&
+SatIdMapper::GetOrAddRecord (Address mac)
+{
+  NS_LOG_FUNCTION (this << mac);
 
-  if (iter == m_macToGwIdMap.end ())
+  uint64_t key;
+
+  if (!GetMacKey (mac, key))
     {
-      return -1;
+      NS_FATAL_ERROR ("SatIdMapper::GetOrAddRecord - " << mac << " is not a MAC address");
     }
 
-  return iter->second;
+  MacRecord_t record;
+  record.traceId = -1;
+  record.utId = -1;
+  record.utUserId = -1;
+  record.beamId = -1;
+  record.gwId = -1;
+  record.gwUserId = -1;
+
+  // The new record is not inserted, if the MAC address already has one
+  return m_records.GetValue (m_records.Insert (key, record).first);
 }
 
-int32_t
-SatIdMapper::GetGwUserIdWithMac (Address mac) const
+bool
+SatIdMapper::GetMacKey (Address mac, uint64_t& key)
 {
-  NS_LOG_FUNCTION (this);
+  if (!Mac48Address::IsMatchingType (mac))
+    {
+      return false;
+    }
+
+  uint8_t buffer[6];
+  Mac48Address::ConvertFrom (mac).CopyTo (buffer);
 
-  std::map<Address, uint32_t>::const_iterator iter = m_macToGwUserIdMap.find (mac);
+  key = 0;
 
-  if (iter == m_macToGwUserIdMap.end ())
+  for (uint32_t i = 0; i < 6; ++i)
     {
-      return -1;
+      key = (key << 8) | buffer[i];
     }
 
-  return iter->second;
+  return true;
 }
 
 // NODE GETTERS
@@ -454,35 +487,29 @@ SatIdMapper::GetMacInfo (Address mac) const
 
   out << mac << " ";
 
-  std::map<Address, uint32_t>::const_iterator iterTrace = m_macToTraceIdMap.find (mac);
+  const MacRecord_t* record = GetRecord (GetHandleWithMac (mac));
 
-  if (!(iterTrace == m_macToTraceIdMap.end ()))
+  if (record && record->traceId >= 0)
     {
-      out << "trace ID: " << iterTrace->second << " ";
+      out << "trace ID: " << record->traceId << " ";
       isInMap = true;
     }
 
-  std::map<Address, uint32_t>::const_iterator iterBeam = m_macToBeamIdMap.find (mac);
-
-  if (!(iterBeam == m_macToBeamIdMap.end ()))
+  if (record && record->beamId >= 0)
     {
-      out << "beam ID: " << iterBeam->second << " ";
+      out << "beam ID: " << record->beamId << " ";
       isInMap = true;
     }
 
-  std::map<Address, uint32_t>::const_iterator iterUt = m_macToUtIdMap.find (mac);
-
-  if (!(iterUt == m_macToUtIdMap.end ()))
+  if (record && record->utId >= 0)
     {
-      out << "UT ID: " << iterUt->second << " ";
+      out << "UT ID: " << record->utId << " ";
       isInMap = true;
     }
 
-  std::map<Address, uint32_t>::const_iterator iterGw = m_macToGwIdMap.find (mac);
-
-  if (!(iterGw == m_macToGwIdMap.end ()))
+  if (record && record->gwId >= 0)
     {
-      out << "GW ID: " << iterGw->second << " ";
+      out << "GW ID: " << record->gwId << " ";
       isInMap = true;
     }
 
@@ -503,11 +530,32 @@ SatIdMapper::PrintTraceMap () const
 {
   NS_LOG_FUNCTION (this);
 
-  std::map<Address, uint32_t>::const_iterator iter;
+  // Print in the order of the MAC addresses
+  std::vector<std::pair<uint64_t, uint32_t> > traced;
 
-  for (iter = m_macToTraceIdMap.begin (); iter != m_macToTraceIdMap.end (); ++iter)
+  for (uint32_t i = 0; i < m_records.GetSize (); ++i)
     {
-      std::cout << GetMacInfo (iter->first) << std::endl;
+      if (m_records.GetValue (i).traceId >= 0)
+        {
+          traced.push_back (std::make_pair (m_records.GetKey (i), i));
+        }
+    }
+
+  std::sort (traced.begin (), traced.end ());
+
+  for (uint32_t i = 0; i < traced.size (); ++i)
+    {
+      uint8_t buffer[6];
+
+      for (uint32_t j = 0; j < 6; ++j)
+        {
+          buffer[j] = (traced[i].first >> (8 * (5 - j))) & 0xFF;
+        }
+
+      Mac48Address mac;
+      mac.CopyFrom (buffer);
+
+      std::cout << GetMacInfo (mac) << std::endl;
     }
 }
 
@@ -21,7 +21,8 @@
 #define SATELLITE_ID_MAPPER_H
 
 #include <ns3/object.h>
-#include <map>
+#include <ns3/satellite-flat-hash-map.h>
+#include <vector>
 
 namespace ns3 {
 
@@ -36,6 +37,12 @@ class Address;
  * MAC-address to UT/GW/user/beam ID. These IDs can be obtained with
  * MAC-address by using the provided functions. It is also possible to
  * obtain the MAC-address with node.
+ *
+ * All the IDs of a MAC address are kept in a single record. The records are
+ * found by the 48-bit value of the MAC address from an open addressing hash
+ * table. The index of a record can be obtained as a handle, with which the
+ * IDs are read by array indexing. The handles stay valid until the mapper
+ * is reset.
  */
 class SatIdMapper : public Object
 {
@@ -153,6 +160,63 @@ public:
    */
   int32_t GetGwUserIdWithMac (Address mac) const;
 
+  /* HANDLE GETTERS */
+
+  /**
+   * \brief Handle value of a MAC address which is not in the mapper
+   */
+  static const uint32_t INVALID_HANDLE = 0xFFFFFFFF;
+
+  /**
+   * \brief Function for getting the handle of a MAC address, with which the
+   *        IDs of the MAC address can be obtained without searching for it.
+   * \param mac MAC address
+   * \return handle or INVALID_HANDLE, if the MAC is not in the mapper
+   */
+  uint32_t GetHandleWithMac (Address mac) const;
+
+  /**
+   * \brief Function for getting the trace ID with handle. Returns -1 if the ID is not attached
+   * \param handle handle of a MAC address
+   * \return Trace ID
+   */
+  int32_t GetTraceIdWithHandle (uint32_t handle) const;
+
+  /**
+   * \brief Function for getting the UT ID with handle. Returns -1 if the ID is not attached
+   * \param handle handle of a MAC address
+   * \return UT ID
+   */
+  int32_t GetUtIdWithHandle (uint32_t handle) const;
+
+  /**
+   * \brief Function for getting the UT user ID with handle. Returns -1 if the ID is not attached
+   * \param handle handle of a MAC address
+   * \return UT user ID
+   */
+  int32_t GetUtUserIdWithHandle (uint32_t handle) const;
+
+  /**
+   * \brief Function for getting the beam ID with handle. Returns -1 if the ID is not attached
+   * \param handle handle of a MAC address
+   * \return beam ID
+   */
+  int32_t GetBeamIdWithHandle (uint32_t handle) const;
+
+  /**
+   * \brief Function for getting the GW ID with handle. Returns -1 if the ID is not attached
+   * \param handle handle of a MAC address
+   * \return GW ID
+   */
+  int32_t GetGwIdWithHandle (uint32_t handle) const;
+
+  /**
+   * \brief Function for getting the GW user ID with handle. Returns -1 if the ID is not attached
+   * \param handle handle of a MAC address
+   * \return GW user ID
+   */
+  int32_t GetGwUserIdWithHandle (uint32_t handle) const;
+
   /* NODE GETTERS */
 
   /**
@@ -225,34 +289,48 @@ private:
   uint32_t m_gwUserIdIndex;
 
   /**
-   * \brief Map for MAC to trace ID conversion
-   */
-  std::map <Address, uint32_t> m_macToTraceIdMap;
-
-  /**
-   * \brief Map for MAC to UT ID conversion
+   * \brief IDs of a MAC address, -1 meaning an ID which is not attached
    */
-  std::map <Address, uint32_t> m_macToUtIdMap;
+  typedef struct
+  {
+    int32_t traceId;
+    int32_t utId;
+    int32_t utUserId;
+    int32_t beamId;
+    int32_t gwId;
+    int32_t gwUserId;
+  } MacRecord_t;
 
   /**
-   * \brief Map for MAC to UT user ID conversion
+   * \brief Function for getting the record of a MAC address, a new record is added if needed
+   * \param mac MAC address
+   * \return record of the MAC address
    */
-  std::map <Address, uint32_t> m_macToUtUserIdMap;
+  MacRecord_t& GetOrAddRecord (Address mac);
 
   /**
-   * \brief Map for MAC to beam ID conversion
+   * \brief Function for getting the record of a handle
+   * \param handle handle of a MAC address
+   * \return record or NULL, if the handle is not valid
    */
-  std::map <Address, uint32_t> m_macToBeamIdMap;
+  inline const MacRecord_t* GetRecord (uint32_t handle) const
+  {
+    return (handle < m_records.GetSize ()) ? &m_records.GetValue (handle) : 0;
+  }
 
   /**
-   * \brief Map for MAC to GW ID conversion
+   * \brief Function for converting a MAC address to a 48-bit integer
+   * \param mac MAC address
+   * \param key the converted value
+   * \return true if the address is a Mac48Address, otherwise false
    */
-  std::map <Address, uint32_t> m_macToGwIdMap;
+  static bool GetMacKey (Address mac, uint64_t& key);
 
   /**
-   * \brief Map for MAC to GW user ID conversion
+   * \brief Records by the MAC addresses as 48-bit integers, handle being
+   *        the index of the record
    */
-  std::map <Address, uint32_t> m_macToGwUserIdMap;
+  SatFlatHashMap<uint64_t, MacRecord_t> m_records;
 
   /**
    * \brief Is map printing enabled or not
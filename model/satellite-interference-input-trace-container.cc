@@ -142,7 +142,7 @@ SatInterferenceInputTraceContainer::GetInterferenceDensity (key_t key)
 {
   NS_LOG_FUNCTION (this);
 
-  return FindNode (key)->ProceedToNextClosestTimeSample ().at (SatBaseTraceContainer::INTF_TRACE_DEFAULT_INTF_DENSITY_INDEX);
+  return FindNode (key)->ProceedToNextClosestTimeSample (SatBaseTraceContainer::INTF_TRACE_DEFAULT_INTF_DENSITY_INDEX);
 }
 
 } // namespace ns3
@@ -85,16 +85,24 @@ SatInterferenceOutputTraceContainer::Reset ()
 }
 
 Ptr<SatOutputFileStreamDoubleContainer>
-SatInterferenceOutputTraceContainer::AddNode (key_t key)
+SatInterferenceOutputTraceContainer::AddNode (key_t key, uint32_t idMapperHandle)
 {
-  NS_LOG_FUNCTION (this);
+  NS_LOG_FUNCTION (this << idMapperHandle);
 
   std::stringstream filename;
   std::string dataPath = Singleton<SatEnvVariables>::Get ()->GetOutputPath ();
 
-  int32_t gwId = Singleton<SatIdMapper>::Get ()->GetGwIdWithMac (key.first);
-  int32_t utId = Singleton<SatIdMapper>::Get ()->GetUtIdWithMac (key.first);
-  int32_t beamId = Singleton<SatIdMapper>::Get ()->GetBeamIdWithMac (key.first);
+  SatIdMapper* idMapper = Singleton<SatIdMapper>::Get ();
+
+  // The MAC address is looked up only if the caller did not have the handle
+  if (idMapperHandle == SatIdMapper::INVALID_HANDLE)
+    {
+      idMapperHandle = idMapper->GetHandleWithMac (key.first);
+    }
+
+  int32_t gwId = idMapper->GetGwIdWithHandle (idMapperHandle);
+  int32_t utId = idMapper->GetUtIdWithHandle (idMapperHandle);
+  int32_t beamId = idMapper->GetBeamIdWithHandle (idMapperHandle);
 
   if (beamId < 0 || (utId < 0 && gwId < 0))
     {
@@ -126,15 +134,15 @@ SatInterferenceOutputTraceContainer::AddNode (key_t key)
 }
 
 Ptr<SatOutputFileStreamDoubleContainer>
-SatInterferenceOutputTraceContainer::FindNode (key_t key)
+SatInterferenceOutputTraceContainer::FindNode (key_t key, uint32_t idMapperHandle)
 {
-  NS_LOG_FUNCTION (this);
+  NS_LOG_FUNCTION (this << idMapperHandle);
 
   container_t::iterator iter = m_container.find (key);
 
   if (iter == m_container.end ())
     {
-      return AddNode (key);
+      return AddNode (key, idMapperHandle);
     }
 
   return iter->second;
@@ -163,16 +171,16 @@ SatInterferenceOutputTraceContainer::WriteToFile ()
 }
 
 void
-SatInterferenceOutputTraceContainer::AddToContainer (key_t key, std::vector<double> newItem)
+SatInterferenceOutputTraceContainer::AddToContainer (key_t key, std::vector<double> newItem, uint32_t idMapperHandle)
 {
-  NS_LOG_FUNCTION (this);
+  NS_LOG_FUNCTION (this << idMapperHandle);
 
   if (newItem.size () != SatBaseTraceContainer::INTF_TRACE_DEFAULT_NUMBER_OF_COLUMNS)
     {
       NS_FATAL_ERROR ("SatInterferenceOutputTraceContainer::AddToContainer - Incorrect vector size");
     }
 
-  Ptr<SatOutputFileStreamDoubleContainer> node = FindNode (key);
+  Ptr<SatOutputFileStreamDoubleContainer> node = FindNode (key, idMapperHandle);
 
   if (node != NULL)
     {
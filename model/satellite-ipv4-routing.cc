@@ -0,0 +1,322 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2016 Magister Solutions Ltd
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: agent <agent@local>
+ */
+
+#include <iomanip>
+#include <sstream>
+#include <ns3/log.h>
+#include <ns3/simulator.h>
+#include <ns3/node.h>
+#include <ns3/packet.h>
+#include <ns3/ipv4-route.h>
+#include <ns3/output-stream-wrapper.h>
+#include "satellite-ipv4-routing.h"
+
+NS_LOG_COMPONENT_DEFINE ("SatIpv4Routing");
+
+namespace ns3 {
+
+NS_OBJECT_ENSURE_REGISTERED (SatIpv4Routing);
+
+TypeId
+SatIpv4Routing::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::SatIpv4Routing")
+    .SetParent<Ipv4RoutingProtocol> ()
+    .AddConstructor<SatIpv4Routing> ()
+  ;
+  return tid;
+}
+
+SatIpv4Routing::SatIpv4Routing ()
+  : m_ipv4 (),
+    m_routes (),
+    m_trie ()
+{
+  NS_LOG_FUNCTION (this);
+
+  TrieNode_t root;
+  root.children[0] = 0;
+  root.children[1] = 0;
+  root.route = NO_ROUTE;
+  m_trie.push_back (root);
+}
+
+SatIpv4Routing::~SatIpv4Routing ()
+{
+  NS_LOG_FUNCTION (this);
+}
+
+void
+SatIpv4Routing::DoDispose (void)
+{
+  NS_LOG_FUNCTION (this);
+
+  m_ipv4 = 0;
+  m_routes.clear ();
+  m_trie.clear ();
+
+  Ipv4RoutingProtocol::DoDispose ();
+}
+
+void
+SatIpv4Routing::AddNetworkRouteTo (Ipv4Address network, Ipv4Mask networkMask, Ipv4Address nextHop, uint32_t interface)
+{
+  NS_LOG_FUNCTION (this << network << networkMask << nextHop << interface);
+
+  uint16_t prefixLength = networkMask.GetPrefixLength ();
+
+  uint32_t contiguousMask = (prefixLength == 0) ? 0 : (0xFFFFFFFF << (32 - prefixLength));
+
+  if (networkMask.Get () != contiguousMask)
+    {
+      NS_FATAL_ERROR ("SatIpv4Routing::AddNetworkRouteTo - non-contiguous network mask " << networkMask);
+    }
+
+  uint32_t routeIndex = m_routes.size ();
+  m_routes.push_back (Ipv4RoutingTableEntry::CreateNetworkRouteTo (network, networkMask, nextHop, interface));
+
+  uint32_t address = network.CombineMask (networkMask).Get ();
+  uint32_t node = 0;
+
+  for (uint16_t i = 0; i < prefixLength; ++i)
+    {
+      uint32_t bit = (address >> (31 - i)) & 1;
+
+      if (m_trie[node].children[bit] == 0)
+        {
+          TrieNode_t child;
+          child.children[0] = 0;
+          child.children[1] = 0;
+          child.route = NO_ROUTE;
+          m_trie[node].children[bit] = m_trie.size ();
+          m_trie.push_back (child);
+        }
+
+      node = m_trie[node].children[bit];
+    }
+
+  // Later route to the same network replaces the earlier one
+  m_trie[node].route = routeIndex;
+}
+
+uint32_t
+SatIpv4Routing::GetNRoutes (void) const
+{
+  return m_routes.size ();
+}
+
+Ipv4RoutingTableEntry
+SatIpv4Routing::GetRoute (uint32_t index) const
+{
+  NS_ASSERT (index < m_routes.size ());
+  return m_routes[index];
+}
+
+Ptr<Ipv4Route>
+SatIpv4Routing::Lookup (Ipv4Address dest, Ptr<NetDevice> oif) const
+{
+  NS_LOG_FUNCTION (this << dest << oif);
+
+  uint32_t address = dest.Get ();
+  uint32_t node = 0;
+  uint32_t routeIndex = NO_ROUTE;
+
+  for (uint16_t i = 0; ; ++i)
+    {
+      uint32_t route = m_trie[node].route;
+
+      // Routes through a down interface are skipped, i.e. a shorter
+      // matching prefix is used as with Ipv4StaticRouting, which removes them
+      if (route != NO_ROUTE
+          && m_ipv4->IsUp (m_routes[route].GetInterface ())
+          && (oif == 0 || oif == m_ipv4->GetNetDevice (m_routes[route].GetInterface ())))
+        {
+          routeIndex = route;
+        }
+
+      if (i == 32 || m_trie[node].children[(address >> (31 - i)) & 1] == 0)
+        {
+          break;
+        }
+
+      node = m_trie[node].children[(address >> (31 - i)) & 1];
+    }
+
+  if (routeIndex == NO_ROUTE)
+    {
+      NS_LOG_LOGIC ("No route to " << dest);
+      return 0;
+    }
+
+  const Ipv4RoutingTableEntry& entry = m_routes[routeIndex];
+  uint32_t interface = entry.GetInterface ();
+
+  Ptr<Ipv4Route> route = Create<Ipv4Route> ();
+  route->SetDestination (entry.GetDest ());
+  route->SetSource (SourceAddressSelection (interface, entry.GetDest ()));
+  route->SetGateway (entry.GetGateway ());
+  route->SetOutputDevice (m_ipv4->GetNetDevice (interface));
+
+  NS_LOG_LOGIC ("Route to " << dest << " via " << entry.GetGateway () << ", interface " << interface);
+
+  return route;
+}
+
+Ipv4Address
+SatIpv4Routing::SourceAddressSelection (uint32_t interface, Ipv4Address dest) const
+{
+  NS_LOG_FUNCTION (this << interface << dest);
+
+  if (m_ipv4->GetNAddresses (interface) == 1)
+    {
+      return m_ipv4->GetAddress (interface, 0).GetLocal ();
+    }
+
+  // Prefer the primary address in the same subnet as the destination
+  Ipv4Address candidate = m_ipv4->GetAddress (interface, 0).GetLocal ();
+
+  for (uint32_t i = 0; i < m_ipv4->GetNAddresses (interface); ++i)
+    {
+      Ipv4InterfaceAddress address = m_ipv4->GetAddress (interface, i);
+
+      if (address.GetLocal ().CombineMask (address.GetMask ()) == dest.CombineMask (address.GetMask ())
+          && address.IsSecondary () == false)
+        {
+          return address.GetLocal ();
+        }
+    }
+
+  return candidate;
+}
+
+Ptr<Ipv4Route>
+SatIpv4Routing::RouteOutput (Ptr<Packet> p, const Ipv4Header &header, Ptr<NetDevice> oif, Socket::SocketErrno &sockerr)
+{
+  NS_LOG_FUNCTION (this << p << header << oif);
+
+  Ipv4Address dest = header.GetDestination ();
+  Ptr<Ipv4Route> route;
+
+  // Multicast and broadcast are left to the static routing
+  if (!dest.IsMulticast () && !dest.IsBroadcast ())
+    {
+      route = Lookup (dest, oif);
+    }
+
+  sockerr = route ? Socket::ERROR_NOTERROR : Socket::ERROR_NOROUTETOHOST;
+
+  return route;
+}
+
+bool
+SatIpv4Routing::RouteInput (Ptr<const Packet> p, const Ipv4Header &header, Ptr<const NetDevice> idev,
+                            UnicastForwardCallback ucb, MulticastForwardCallback mcb,
+                            LocalDeliverCallback lcb, ErrorCallback ecb)
+{
+  NS_LOG_FUNCTION (this << p << header << idev);
+
+  Ipv4Address dest = header.GetDestination ();
+
+  if (dest.IsMulticast () || dest.IsBroadcast ())
+    {
+      return false;
+    }
+
+  Ptr<Ipv4Route> route = Lookup (dest);
+
+  if (route == 0)
+    {
+      return false;
+    }
+
+  ucb (route, p, header);
+  return true;
+}
+
+void
+SatIpv4Routing::NotifyInterfaceUp (uint32_t interface)
+{
+  NS_LOG_FUNCTION (this << interface);
+}
+
+void
+SatIpv4Routing::NotifyInterfaceDown (uint32_t interface)
+{
+  NS_LOG_FUNCTION (this << interface);
+}
+
+void
+SatIpv4Routing::NotifyAddAddress (uint32_t interface, Ipv4InterfaceAddress address)
+{
+  NS_LOG_FUNCTION (this << interface << address);
+}
+
+void
+SatIpv4Routing::NotifyRemoveAddress (uint32_t interface, Ipv4InterfaceAddress address)
+{
+  NS_LOG_FUNCTION (this << interface << address);
+}
+
+void
+SatIpv4Routing::SetIpv4 (Ptr<Ipv4> ipv4)
+{
+  NS_LOG_FUNCTION (this << ipv4);
+  NS_ASSERT (m_ipv4 == 0 && ipv4 != 0);
+
+  m_ipv4 = ipv4;
+}
+
+void
+SatIpv4Routing::PrintRoutingTable (Ptr<OutputStreamWrapper> stream, Time::Unit unit) const
+{
+  NS_LOG_FUNCTION (this << stream);
+
+  std::ostream* os = stream->GetStream ();
+  Ptr<Node> node = m_ipv4->GetObject<Node> ();
+
+  *os << "Node: " << node->GetId ()
+      << ", Time: " << Now ().As (unit)
+      << ", Local time: " << node->GetLocalTime ().As (unit)
+      << ", SatIpv4Routing table" << std::endl;
+
+  if (!m_routes.empty ())
+    {
+      *os << "Destination     Gateway         Genmask         Iface" << std::endl;
+
+      for (std::vector<Ipv4RoutingTableEntry>::const_iterator it = m_routes.begin ();
+           it != m_routes.end (); ++it)
+        {
+          std::ostringstream dest, gw, mask;
+          dest << it->GetDest ();
+          gw << it->GetGateway ();
+          mask << it->GetDestNetworkMask ();
+
+          *os << std::setiosflags (std::ios::left)
+              << std::setw (16) << dest.str ()
+              << std::setw (16) << gw.str ()
+              << std::setw (16) << mask.str ()
+              << it->GetInterface () << std::endl;
+        }
+    }
+
+  *os << std::endl;
+}
+
+} // namespace ns3
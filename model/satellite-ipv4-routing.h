@@ -0,0 +1,156 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2016 Magister Solutions Ltd
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: agent <agent@local>
+ */
+
+#ifndef SATELLITE_IPV4_ROUTING_H
+#define SATELLITE_IPV4_ROUTING_H
+
+#include <vector>
+#include <stdint.h>
+#include <ns3/ptr.h>
+#include <ns3/ipv4-address.h>
+#include <ns3/ipv4.h>
+#include <ns3/ipv4-routing-protocol.h>
+#include <ns3/ipv4-routing-table-entry.h>
+
+namespace ns3 {
+
+/**
+ * \ingroup satellite
+ * \brief IPv4 routing protocol holding the network routes towards the UT
+ * subscriber networks at the GW and at the terrestrial router.
+ *
+ * The routes are stored in a binary prefix trie, in which a destination is
+ * resolved by walking at most the prefix length of the longest route,
+ * independent of the number of UTs. The forwarding decision is the same
+ * as Ipv4StaticRouting would make for the same network routes: the longest
+ * matching prefix wins, and a later route to the same prefix replaces an
+ * earlier one. Routes through an interface which is down are not used.
+ * Unlike Ipv4StaticRouting, which deletes them, they are used again when
+ * the interface comes back up.
+ *
+ * The protocol is installed to the Ipv4ListRouting of the node with a higher
+ * priority than Ipv4StaticRouting, which keeps handling the interface,
+ * default and multicast routes. If no UT network route matches, the
+ * request is left to the other routing protocols.
+ */
+class SatIpv4Routing : public Ipv4RoutingProtocol
+{
+public:
+  /**
+   * \brief Get the type ID
+   * \return the object TypeId
+   */
+  static TypeId GetTypeId (void);
+
+  /**
+   * Default constructor
+   */
+  SatIpv4Routing ();
+
+  /**
+   * Destructor for SatIpv4Routing
+   */
+  virtual ~SatIpv4Routing ();
+
+  // Inherited from Ipv4RoutingProtocol
+  virtual Ptr<Ipv4Route> RouteOutput (Ptr<Packet> p, const Ipv4Header &header, Ptr<NetDevice> oif, Socket::SocketErrno &sockerr);
+  virtual bool RouteInput  (Ptr<const Packet> p, const Ipv4Header &header, Ptr<const NetDevice> idev,
+                            UnicastForwardCallback ucb, MulticastForwardCallback mcb,
+                            LocalDeliverCallback lcb, ErrorCallback ecb);
+  virtual void NotifyInterfaceUp (uint32_t interface);
+  virtual void NotifyInterfaceDown (uint32_t interface);
+  virtual void NotifyAddAddress (uint32_t interface, Ipv4InterfaceAddress address);
+  virtual void NotifyRemoveAddress (uint32_t interface, Ipv4InterfaceAddress address);
+  virtual void SetIpv4 (Ptr<Ipv4> ipv4);
+  virtual void PrintRoutingTable (Ptr<OutputStreamWrapper> stream, Time::Unit unit = Time::S) const;
+
+  /**
+   * \brief Add a network route to the routing table
+   * \param network Network address of the destination
+   * \param networkMask Network mask of the destination
+   * \param nextHop Next hop address
+   * \param interface Interface index of the next hop
+   */
+  void AddNetworkRouteTo (Ipv4Address network, Ipv4Mask networkMask, Ipv4Address nextHop, uint32_t interface);
+
+  /**
+   * \brief Get the number of routes in the routing table
+   * \return Number of routes
+   */
+  uint32_t GetNRoutes (void) const;
+
+  /**
+   * \brief Get a route from the routing table
+   * \param index Index of the route in the order of addition
+   * \return Route
+   */
+  Ipv4RoutingTableEntry GetRoute (uint32_t index) const;
+
+  /**
+   * \brief Find the route for a destination through an interface which is up
+   * \param dest Destination address
+   * \param oif Output device constraint, or 0 for any device
+   * \return Route or 0, if there is no matching route
+   */
+  Ptr<Ipv4Route> Lookup (Ipv4Address dest, Ptr<NetDevice> oif = 0) const;
+
+protected:
+  virtual void DoDispose (void);
+
+private:
+  /**
+   * \brief Node of the prefix trie. Children and route are indices, zero
+   * (the root cannot be a child) and NO_ROUTE marking a missing one.
+   */
+  typedef struct
+  {
+    uint32_t children[2];
+    uint32_t route;
+  } TrieNode_t;
+
+  static const uint32_t NO_ROUTE = 0xFFFFFFFF;
+
+  /**
+   * \brief Select the source address as Ipv4StaticRouting does
+   * \param interface Interface index
+   * \param dest Destination address
+   * \return Source address
+   */
+  Ipv4Address SourceAddressSelection (uint32_t interface, Ipv4Address dest) const;
+
+  /**
+   * IPv4 protocol of the node
+   */
+  Ptr<Ipv4> m_ipv4;
+
+  /**
+   * Routes in the order of addition
+   */
+  std::vector<Ipv4RoutingTableEntry> m_routes;
+
+  /**
+   * Prefix trie of the routes, root at index zero
+   */
+  std::vector<TrieNode_t> m_trie;
+};
+
+} // namespace ns3
+
+#endif /* SATELLITE_IPV4_ROUTING_H */
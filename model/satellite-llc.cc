@@ -31,6 +31,7 @@
 #include <ns3/satellite-enums.h>
 #include <ns3/satellite-utils.h>
 #include <ns3/satellite-typedefs.h>
+#include <ns3/satellite-packet-trace.h>
 
 
 NS_LOG_COMPONENT_DEFINE ("SatLlc");
@@ -111,9 +112,8 @@ SatLlc::Enque (Ptr<Packet> packet, Address dest, uint8_t flowId)
   NS_LOG_INFO ("dest=" << dest );
   NS_LOG_INFO ("UID is " << packet->GetUid ());
 
-  Ptr<EncapKey> key = Create<EncapKey> (m_nodeInfo->GetMacAddress (), Mac48Address::ConvertFrom (dest), flowId);
-
-  EncapContainer_t::iterator it = m_encaps.find (key);
+  Mac48Address destMacAddress = Mac48Address::ConvertFrom (dest);
+  EncapContainer_t::iterator it = m_encaps.find (m_nodeInfo->GetMacAddress (), destMacAddress, flowId);
 
   if (it == m_encaps.end ())
     {
@@ -122,28 +122,34 @@ SatLlc::Enque (Ptr<Packet> packet, Address dest, uint8_t flowId)
        * implemented in the inherited classes, which knows which type
        * of encapsulator to create.
        */
-      CreateEncap (key);
-      it = m_encaps.find (key);
+      CreateEncap (Create<EncapKey> (m_nodeInfo->GetMacAddress (), destMacAddress, flowId));
+      it = m_encaps.find (m_nodeInfo->GetMacAddress (), destMacAddress, flowId);
     }
 
   // Store packet arrival time
   SatTimeTag timeTag (Simulator::Now ());
   packet->AddPacketTag (timeTag);
 
-  it->second->EnquePdu (packet, Mac48Address::ConvertFrom (dest));
+  it->second->EnquePdu (packet, destMacAddress);
+
+  EncapBacklogged (it->first, it->second);
 
   SatEnums::SatLinkDir_t ld =
     (m_nodeInfo->GetNodeType () == SatEnums::NT_UT) ? SatEnums::LD_RETURN : SatEnums::LD_FORWARD;
 
   // Add packet trace entry:
-  m_packetTrace (Simulator::Now (),
-                 SatEnums::PACKET_ENQUE,
-                 m_nodeInfo->GetNodeType (),
-                 m_nodeInfo->GetNodeId (),
-                 m_nodeInfo->GetMacAddress (),
-                 SatEnums::LL_LLC,
-                 ld,
-                 SatUtils::GetPacketInfo (packet));
+  if (!m_packetTrace.IsEmpty ()
+      && SatPacketTrace::IsTraced (SatEnums::PACKET_ENQUE, m_nodeInfo->GetNodeType (), ld))
+    {
+      m_packetTrace (Simulator::Now (),
+                     SatEnums::PACKET_ENQUE,
+                     m_nodeInfo->GetNodeType (),
+                     m_nodeInfo->GetNodeId (),
+                     m_nodeInfo->GetMacAddress (),
+                     SatEnums::LL_LLC,
+                     ld,
+                     SatUtils::GetPacketInfo (packet));
+    }
 
   return true;
 }
@@ -157,14 +163,18 @@ SatLlc::Receive (Ptr<Packet> packet, Mac48Address source, Mac48Address dest)
     (m_nodeInfo->GetNodeType () == SatEnums::NT_UT) ? SatEnums::LD_FORWARD : SatEnums::LD_RETURN;
 
   // Add packet trace entry:
-  m_packetTrace (Simulator::Now (),
-                 SatEnums::PACKET_RECV,
-                 m_nodeInfo->GetNodeType (),
-                 m_nodeInfo->GetNodeId (),
-                 m_nodeInfo->GetMacAddress (),
-                 SatEnums::LL_LLC,
-                 ld,
-                 SatUtils::GetPacketInfo (packet));
+  if (!m_packetTrace.IsEmpty ()
+      && SatPacketTrace::IsTraced (SatEnums::PACKET_RECV, m_nodeInfo->GetNodeType (), ld))
+    {
+      m_packetTrace (Simulator::Now (),
+                     SatEnums::PACKET_RECV,
+                     m_nodeInfo->GetNodeType (),
+                     m_nodeInfo->GetNodeId (),
+                     m_nodeInfo->GetMacAddress (),
+                     SatEnums::LL_LLC,
+                     ld,
+                     SatUtils::GetPacketInfo (packet));
+    }
 
   // Receive packet with a decapsulator instance which is handling the
   // packets for this specific id
@@ -173,8 +183,7 @@ SatLlc::Receive (Ptr<Packet> packet, Mac48Address source, Mac48Address dest)
   if (mSuccess)
     {
       uint32_t flowId = flowIdTag.GetFlowId ();
-      Ptr<EncapKey> key = Create<EncapKey> (source, dest, flowId);
-      EncapContainer_t::iterator it = m_decaps.find (key);
+      EncapContainer_t::iterator it = m_decaps.find (source, dest, flowId);
 
       // Control messages not received by this method
       if (flowId == SatEnums::CONTROL_FID)
@@ -189,8 +198,8 @@ SatLlc::Receive (Ptr<Packet> packet, Mac48Address source, Mac48Address dest)
            * implemented in the inherited classes, which knows which type
            * of decapsulator to create.
            */
-          CreateDecap (key);
-          it = m_decaps.find (key);
+          CreateDecap (Create<EncapKey> (source, dest, flowId));
+          it = m_decaps.find (source, dest, flowId);
         }
 
       it->second->ReceivePdu (packet);
@@ -211,8 +220,7 @@ SatLlc::ReceiveAck (Ptr<SatArqAckMessage> ack, Mac48Address source, Mac48Address
    */
   uint32_t flowId = ack->GetFlowId ();
 
-  Ptr<EncapKey> key = Create<EncapKey> (dest, source, flowId);
-  EncapContainer_t::iterator it = m_encaps.find (key);
+  EncapContainer_t::iterator it = m_encaps.find (dest, source, flowId);
 
   if (it != m_encaps.end ())
     {
@@ -224,6 +232,12 @@ SatLlc::ReceiveAck (Ptr<SatArqAckMessage> ack, Mac48Address source, Mac48Address
     }
 }
 
+void
+SatLlc::EncapBacklogged (Ptr<EncapKey> key, Ptr<SatBaseEncapsulator> encap)
+{
+  NS_LOG_FUNCTION (this << key->m_source << key->m_destination << (uint32_t)(key->m_flowId));
+}
+
 
 void
 SatLlc::ReceiveHigherLayerPdu (Ptr<Packet> packet, Mac48Address source, Mac48Address dest)
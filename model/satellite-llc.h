@@ -26,9 +26,9 @@
 #include <ns3/object.h>
 #include <ns3/traced-callback.h>
 #include <ns3/ptr.h>
-#include <ns3/simple-ref-count.h>
 #include <ns3/mac48-address.h>
 #include <ns3/satellite-base-encapsulator.h>
+#include <ns3/satellite-encap-container.h>
 
 namespace ns3 {
 
@@ -39,56 +39,6 @@ class SatControlMessage;
 class SatSchedulingObject;
 class SatNodeInfo;
 
-/**
- * \ingroup satellite
- * \brief EncapKey class is used as a key in the encapsulator/decapsulator container. It
- * will hold the flow information related to one single encapsulator/decapsulator.
- */
-class EncapKey : public SimpleRefCount <EncapKey>
-{
-public:
-  Mac48Address  m_source;
-  Mac48Address  m_destination;
-  int8_t        m_flowId;
-
-  EncapKey (const Mac48Address source, const Mac48Address dest, const uint8_t flowId)
-    : m_source (source),
-      m_destination (dest),
-      m_flowId (flowId)
-  {
-  }
-};
-
-/**
- * \ingroup satellite
- * \brief EncapKeyCompare is used as a custom compare method within
- * EncapContainer map. Encap key has three member variables (source
- * address, dest address and flow id) and to be able to store them in
- * a map container, a custom compare method needs to be implemented.
- */
-class EncapKeyCompare
-{
-public:
-  bool operator() (Ptr<EncapKey> key1, Ptr<EncapKey> key2) const
-  {
-    if ( key1->m_source == key2->m_source )
-      {
-        if ( key1->m_destination == key2->m_destination )
-          {
-            return key1->m_flowId < key2->m_flowId;
-          }
-        else
-          {
-            return key1->m_destination < key2->m_destination;
-          }
-      }
-    else
-      {
-        return key1->m_source < key2->m_source;
-      }
-  }
-};
-
 /**
  * \ingroup satellite
  * \brief SatLlc base class holds the UT specific SatBaseEncapsulator instances, which are responsible
@@ -136,9 +86,9 @@ public:
   /**
    * Key = Ptr<EncapKey> (source, dest, flowId)
    * Value = Ptr<SatBaseEncapsulator>
-   * Compare class = EncapKeyCompare
+   * Lookup by packed flow key, iteration in EncapKeyCompare order
    */
-  typedef std::map<Ptr<EncapKey>, Ptr<SatBaseEncapsulator>, EncapKeyCompare > EncapContainer_t;
+  typedef SatEncapContainer EncapContainer_t;
 
   /**
    * \brief Receive callback used for sending packet to netdevice layer.
@@ -336,6 +286,15 @@ protected:
    */
   virtual void ReceiveAck (Ptr<SatArqAckMessage> ack, Mac48Address source, Mac48Address dest);
 
+  /**
+   * \brief Virtual method to inform that an encapsulator has data to be
+   * transmitted, e.g. after a PDU has been enqueued to it. The default
+   * implementation does nothing.
+   * \param key Encapsulator key class
+   * \param encap Encapsulator
+   */
+  virtual void EncapBacklogged (Ptr<EncapKey> key, Ptr<SatBaseEncapsulator> encap);
+
   /**
    * Trace callback used for packet tracing:
    */
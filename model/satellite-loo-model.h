@@ -22,7 +22,7 @@
 
 #include "ns3/vector.h"
 #include "satellite-base-fader.h"
-#include "satellite-fading-oscillator.h"
+#include "satellite-fading-oscillator-bank.h"
 #include "satellite-loo-conf.h"
 #include "ns3/random-variable-stream.h"
 
@@ -129,14 +129,14 @@ private:
   Ptr<UniformRandomVariable> m_uniformVariable;
 
   /**
-   * \brief Direct signal oscillators
+   * \brief Direct signal oscillators of each state
    */
-  std::vector< std::vector< Ptr<SatFadingOscillator> > > m_directSignalOscillators;
+  std::vector<SatFadingOscillatorBank> m_directSignalOscillators;
 
   /**
-   * \brief Multipath oscillators
+   * \brief Multipath oscillators of each state
    */
-  std::vector< std::vector< Ptr<SatFadingOscillator> > > m_multipathOscillators;
+  std::vector<SatFadingOscillatorBank> m_multipathOscillators;
 
   /**
    * \brief Function for constructing direct signal oscillators
@@ -148,22 +148,6 @@ private:
    */
   void ConstructMultipathOscillators ();
 
-  /**
-   * \brief Function for calculating cosine wave oscillator complex sum
-   * \param oscillator oscillator
-   * \param timeInSeconds current time in seconds
-   * \return sum
-   */
-  std::complex<double> GetOscillatorCosineWaveSum (std::vector< Ptr<SatFadingOscillator> > oscillator, double timeInSeconds);
-
-  /**
-   * \brief Function for calculating oscillator complex sum
-   * \param oscillator oscillator
-   * \param timeInSeconds current time in seconds
-   * \return sum
-   */
-  std::complex<double> GetOscillatorComplexSum (std::vector< Ptr<SatFadingOscillator> > oscillator, double timeInSeconds);
-
   /**
    * \brief Function for setting the state
    * \param newState new state
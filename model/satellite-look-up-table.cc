@@ -20,9 +20,13 @@
  */
 
 #include <cmath>
+#include <algorithm>
+#include <functional>
 
 #include "ns3/log.h"
+#include "ns3/double.h"
 #include "ns3/fatal-error.h"
+#include "ns3/satellite-binary-data-file.h"
 #include "satellite-look-up-table.h"
 #include "satellite-utils.h"
 
@@ -34,9 +38,21 @@ NS_OBJECT_ENSURE_REGISTERED (SatLookUpTable);
 
 
 SatLookUpTable::SatLookUpTable (std::string linkResultPath)
+  : m_esNoDb (),
+    m_bler (),
+    m_ifs (0),
+    m_esNoGridStepDb (0.01),
+    m_esNoGridIndices ()
 {
   NS_LOG_FUNCTION (this << linkResultPath);
+
+  // Attributes are needed already in construction phase:
+  // - ConstructSelf call in constructor
+  // - GetInstanceTypeId is needed to be implemented
+  ObjectBase::ConstructSelf (AttributeConstructionList ());
+
   Load (linkResultPath);
+  BuildEsNoGrid ();
 }
 
 
@@ -53,6 +69,7 @@ SatLookUpTable::DoDispose ()
 
   m_esNoDb.clear ();
   m_bler.clear ();
+  m_esNoGridIndices.clear ();
 
   if (m_ifs != 0)
     {
@@ -74,10 +91,21 @@ SatLookUpTable::GetTypeId ()
 {
   static TypeId tid = TypeId ("ns3::SatLookUpTable")
     .SetParent<Object> ()
+    .AddAttribute ("EsNoGridStepDb",
+                   "Step of the uniform Es/No grid used to index the link result table in dB",
+                   DoubleValue (0.01),
+                   MakeDoubleAccessor (&SatLookUpTable::m_esNoGridStepDb),
+                   MakeDoubleChecker<double> (0.0001))
   ;
   return tid;
 }
 
+TypeId
+SatLookUpTable::GetInstanceTypeId (void) const
+{
+  return GetTypeId ();
+}
+
 
 
 double
@@ -85,7 +113,7 @@ SatLookUpTable::GetBler (double esNoDb) const
 {
   NS_LOG_FUNCTION (this << esNoDb);
 
-  uint16_t n = m_esNoDb.size ();
+  uint32_t n = m_esNoDb.size ();
 
   NS_ASSERT (n > 0);
   NS_ASSERT (m_bler.size () == n);
@@ -97,9 +125,26 @@ SatLookUpTable::GetBler (double esNoDb) const
       return 1.0;
     }
 
-  uint16_t i = 1;
+  if (n == 1 || esNoDb > m_esNoDb[n - 1])
+    {
+      // edge case: very high SINR, return minimum BLER (100% success rate)
+      NS_LOG_INFO (this << " Very high SINR -> BLER = 0.0");
+      return 0.0;
+    }
 
-  while ((i < n) && (esNoDb > m_esNoDb[i]))
+  // normal case: find the first table entry i with esNoDb <= m_esNoDb[i]
+  // starting from the entry indexed by the grid cell of esNoDb
+  uint32_t cell = std::min<uint32_t> ((esNoDb - m_esNoDb[0]) / m_esNoGridStepDb,
+                                      m_esNoGridIndices.size () - 1);
+  uint32_t i = m_esNoGridIndices[cell];
+
+  // the cell boundary may be off by rounding
+  while ((i > 1) && (esNoDb <= m_esNoDb[i - 1]))
+    {
+      i--;
+    }
+
+  while (esNoDb > m_esNoDb[i])
     {
       i++;
     }
@@ -107,26 +152,16 @@ SatLookUpTable::GetBler (double esNoDb) const
   NS_LOG_DEBUG (this << " i=" << i << " esno[i]=" << m_esNoDb[i]
                      << " bler[i]=" << m_bler[i]);
 
-  if (i >= n)
-    {
-      // edge case: very high SINR, return minimum BLER (100% success rate)
-      NS_LOG_INFO (this << " Very high SINR -> BLER = 0.0");
-      return 0.0;
-    }
-  else // sinrDb <= m_esNoDb[i]
-    {
-      // normal case
-      NS_ASSERT (i > 0);
-      NS_ASSERT (i < n);
+  NS_ASSERT (i > 0);
+  NS_ASSERT (i < n);
 
-      double esno = esNoDb;
-      double esno0 = m_esNoDb[i - 1];
-      double esno1 = m_esNoDb[i];
-      double bler = SatUtils::Interpolate (esno, esno0, esno1, m_bler[i - 1], m_bler[i]);
-      NS_LOG_INFO (this << " Interpolate: " << esno << " to BLER = " << bler << "(sinr0: " << esno0 << ", sinr1: " << esno1 << ", bler0: " << m_bler[i - 1] << ", bler1: " << m_bler[i] << ")");
+  double esno = esNoDb;
+  double esno0 = m_esNoDb[i - 1];
+  double esno1 = m_esNoDb[i];
+  double bler = SatUtils::Interpolate (esno, esno0, esno1, m_bler[i - 1], m_bler[i]);
+  NS_LOG_INFO (this << " Interpolate: " << esno << " to BLER = " << bler << "(sinr0: " << esno0 << ", sinr1: " << esno1 << ", bler0: " << m_bler[i - 1] << ", bler1: " << m_bler[i] << ")");
 
-      return bler;
-    }
+  return bler;
 
 } // end of double SatLookUpTable::GetBler (double sinrDb) const
 
@@ -136,7 +171,7 @@ SatLookUpTable::GetEsNoDb (double blerTarget) const
 {
   NS_LOG_FUNCTION (this << blerTarget);
 
-  uint16_t n = m_bler.size ();
+  uint32_t n = m_bler.size ();
 
   NS_ASSERT (n > 0);
   NS_ASSERT (m_esNoDb.size () == n);
@@ -155,17 +190,15 @@ SatLookUpTable::GetEsNoDb (double blerTarget) const
       NS_FATAL_ERROR ("The BLER target is set to be too high!");
     }
 
-  double sinr = 0.0;
-  // Go through the list from end to beginning
-  for (uint32_t i = 0; i < n; ++i)
-    {
-      if (blerTarget >= m_bler[i])
-        {
-          sinr = SatUtils::Interpolate (blerTarget, m_bler[i - 1], m_bler[i], m_esNoDb[i - 1], m_esNoDb[i]);
-          NS_LOG_INFO (this << " Interpolate: " << blerTarget << " to SINR = " << sinr << "(bler0: " << m_bler[i - 1] << ", bler1: " << m_bler[i] << ", sinr0: " << m_esNoDb[i - 1] << ", sinr1: " << m_esNoDb[i] << ")");
-          return sinr;
-        }
-    }
+  // The BLER values are in non-increasing order, thus the first entry
+  // with BLER not higher than the target is found by binary search
+  uint32_t i = std::lower_bound (m_bler.begin (), m_bler.end (), blerTarget, std::greater<double> ()) - m_bler.begin ();
+
+  NS_ASSERT (i > 0);
+  NS_ASSERT (i < n);
+
+  double sinr = SatUtils::Interpolate (blerTarget, m_bler[i - 1], m_bler[i], m_esNoDb[i - 1], m_esNoDb[i]);
+  NS_LOG_INFO (this << " Interpolate: " << blerTarget << " to SINR = " << sinr << "(bler0: " << m_bler[i - 1] << ", bler1: " << m_bler[i] << ", sinr0: " << m_esNoDb[i - 1] << ", sinr1: " << m_esNoDb[i] << ")");
 
   return sinr;
 } // end of double SatLookUpTable::GetSinr (double bler) const
@@ -176,6 +209,11 @@ SatLookUpTable::Load (std::string linkResultPath)
 {
   NS_LOG_FUNCTION (this << linkResultPath);
 
+  if (LoadFromBinaryFile (linkResultPath))
+    {
+      return;
+    }
+
   // READ FROM THE SPECIFIED INPUT FILE
 
   m_ifs = new std::ifstream (linkResultPath.c_str (), std::ifstream::in);
@@ -237,4 +275,97 @@ SatLookUpTable::Load (std::string linkResultPath)
 } // end of void Load (std::string linkResultPath)
 
 
+bool
+SatLookUpTable::LoadFromBinaryFile (std::string linkResultPath)
+{
+  NS_LOG_FUNCTION (this << linkResultPath);
+
+  Ptr<SatBinaryDataFile> file = SatBinaryDataFile::OpenForTextFile (linkResultPath, SatBinaryDataFile::CONTENT_LINK_RESULTS);
+
+  if (file == 0)
+    {
+      return false;
+    }
+
+  if (file->GetRows () == 0 || file->GetColumns () != 2)
+    {
+      NS_LOG_WARN ("Invalid binary link results of " << linkResultPath << ", using the text file");
+      return false;
+    }
+
+  double lastEsNoDb = -100.0; // very low value
+  double lastBler = 1.0; // maximum value
+  const double * row = file->GetData ();
+
+  for (uint32_t i = 0; i < file->GetRows (); ++i, row += 2)
+    {
+      // SANITY CHECK
+      if ((row[0] <= lastEsNoDb) || (row[1] > lastBler))
+        {
+          NS_FATAL_ERROR ("The binary data of file " << linkResultPath << " is not properly sorted.");
+        }
+
+      m_esNoDb.push_back (row[0]);
+      m_bler.push_back (row[1]);
+      lastEsNoDb = row[0];
+      lastBler = row[1];
+    }
+
+  return true;
+} // end of bool LoadFromBinaryFile (std::string linkResultPath)
+
+
+void
+SatLookUpTable::WriteBinaryFile (std::string filePathName) const
+{
+  NS_LOG_FUNCTION (this << filePathName);
+
+  std::vector<double> data;
+
+  for (uint32_t i = 0; i < m_esNoDb.size (); ++i)
+    {
+      data.push_back (m_esNoDb[i]);
+      data.push_back (m_bler[i]);
+    }
+
+  SatBinaryDataFile::Write (filePathName, SatBinaryDataFile::CONTENT_LINK_RESULTS,
+                            std::vector<double> (), m_esNoDb.size (), 2, data);
+}
+
+
+void
+SatLookUpTable::BuildEsNoGrid ()
+{
+  NS_LOG_FUNCTION (this);
+
+  m_esNoGridIndices.clear ();
+
+  uint32_t n = m_esNoDb.size ();
+
+  if (n < 2)
+    {
+      return;
+    }
+
+  uint32_t cellCount = (uint32_t)((m_esNoDb[n - 1] - m_esNoDb[0]) / m_esNoGridStepDb) + 1;
+  m_esNoGridIndices.reserve (cellCount);
+
+  // Each grid cell stores the first table entry (above zero) which Es/No is
+  // not lower than the start of the cell
+  uint32_t i = 1;
+
+  for (uint32_t cell = 0; cell < cellCount; ++cell)
+    {
+      double cellStartDb = m_esNoDb[0] + cell * m_esNoGridStepDb;
+
+      while ((i < n - 1) && (m_esNoDb[i] < cellStartDb))
+        {
+          i++;
+        }
+
+      m_esNoGridIndices.push_back (i);
+    }
+} // end of void BuildEsNoGrid ()
+
+
 } // end of namespace ns3
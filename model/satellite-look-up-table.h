@@ -34,6 +34,14 @@ namespace ns3 {
  * \ingroup satellite
  *
  * \brief Loads a link result file and provide query service for BLER.
+ *
+ * The Es/No range of the link result table is divided into a uniform grid of
+ * cells (attribute EsNoGridStepDb), each indexing the first table entry of the
+ * cell. Thus, a BLER query is an index computation followed by one linear
+ * interpolation between the original table entries, and the result is the same
+ * as interpolating over the full table. With the default step, which is finer
+ * than the Es/No resolution of the link results, the correct entry is found
+ * without advancing in the table.
  */
 class SatLookUpTable : public Object
 {
@@ -56,6 +64,12 @@ public:
    */
   static TypeId GetTypeId ();
 
+  /**
+   * \brief Get the type ID of instance
+   * \return the object TypeId
+   */
+  virtual TypeId GetInstanceTypeId (void) const;
+
   /**
    * \brief Get the BLER corresponding to a given SINR
    * \param sinrDb SINR in logarithmic scale
@@ -70,6 +84,12 @@ public:
    */
   double GetEsNoDb (double blerTarget) const;
 
+  /**
+   * \brief Write the link results to a binary data file
+   * \param filePathName Path and name of the binary data file
+   */
+  void WriteBinaryFile (std::string filePathName) const;
+
 private:
   virtual void DoDispose ();
 
@@ -79,9 +99,32 @@ private:
    */
   void Load (std::string linkResultPath);
 
+  /**
+   * \brief Load the link results from the binary data file of a link results file
+   * \param linkResultPath Path to a link results text file.
+   * \return true, if the binary data file was used, otherwise false
+   */
+  bool LoadFromBinaryFile (std::string linkResultPath);
+
+  /**
+   * \brief Build the uniform Es/No grid indexing the link result table
+   */
+  void BuildEsNoGrid ();
+
   std::vector<double> m_esNoDb;
   std::vector<double> m_bler;
   std::ifstream *m_ifs;
+
+  /**
+   * \brief Step of the uniform Es/No grid in dB
+   */
+  double m_esNoGridStepDb;
+
+  /**
+   * \brief Index of the first table entry with Es/No not lower than the
+   * start of each grid cell
+   */
+  std::vector<uint32_t> m_esNoGridIndices;
 };
 
 } // end of namespace ns3
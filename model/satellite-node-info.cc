@@ -19,6 +19,7 @@
  */
 
 #include <ns3/log.h>
+#include <ns3/satellite-id-mapper.h>
 #include "satellite-node-info.h"
 
 NS_LOG_COMPONENT_DEFINE ("SatNodeInfo");
@@ -29,7 +30,8 @@ namespace ns3 {
 SatNodeInfo::SatNodeInfo ()
   : m_nodeId (0),
     m_nodeType (SatEnums::NT_UNDEFINED),
-    m_macAddress ()
+    m_macAddress (),
+    m_idMapperHandle (SatIdMapper::INVALID_HANDLE)
 {
 
 }
@@ -37,7 +39,8 @@ SatNodeInfo::SatNodeInfo ()
 SatNodeInfo::SatNodeInfo (SatEnums::SatNodeType_t nodeType, uint32_t nodeId, Mac48Address macAddress)
   : m_nodeId (nodeId),
     m_nodeType (nodeType),
-    m_macAddress (macAddress)
+    m_macAddress (macAddress),
+    m_idMapperHandle (SatIdMapper::INVALID_HANDLE)
 {
 
 }
@@ -69,6 +72,20 @@ SatNodeInfo::GetMacAddress () const
   return m_macAddress;
 }
 
+void
+SatNodeInfo::SetIdMapperHandle (uint32_t handle)
+{
+  NS_LOG_FUNCTION (this << handle);
+  m_idMapperHandle = handle;
+}
+
+uint32_t
+SatNodeInfo::GetIdMapperHandle () const
+{
+  NS_LOG_FUNCTION (this);
+  return m_idMapperHandle;
+}
+
 } // namespace ns3
 
 
@@ -76,10 +76,24 @@ public:
    */
   Mac48Address GetMacAddress () const;
 
+  /**
+   * \brief Set the handle of the MAC address in SatIdMapper
+   * \param handle Handle obtained with SatIdMapper::GetHandleWithMac
+   */
+  void SetIdMapperHandle (uint32_t handle);
+
+  /**
+   * \brief Get the handle of the MAC address in SatIdMapper, with which the
+   * IDs of the node can be read without searching for the MAC address
+   * \return Handle or SatIdMapper::INVALID_HANDLE, if it is not set
+   */
+  uint32_t GetIdMapperHandle () const;
+
 private:
   uint32_t m_nodeId;
   SatEnums::SatNodeType_t m_nodeType;
   Mac48Address m_macAddress;
+  uint32_t m_idMapperHandle;
 
 };
 
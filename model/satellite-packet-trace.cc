@@ -20,6 +20,8 @@
 
 #include "ns3/object.h"
 #include "ns3/log.h"
+#include "ns3/enum.h"
+#include "ns3/uinteger.h"
 #include "ns3/output-stream-wrapper.h"
 #include "ns3/trace-helper.h"
 #include "ns3/string.h"
@@ -34,23 +36,76 @@ namespace ns3 {
 
 NS_OBJECT_ENSURE_REGISTERED (SatPacketTrace);
 
+static const char BINARY_MAGIC[8] = {'S', 'A', 'T', 'P', 'K', 'T', 'T', 'R'};
+
+uint32_t SatPacketTrace::m_instances = 0;
+uint32_t SatPacketTrace::m_tracedPacketEvents = 0;
+uint32_t SatPacketTrace::m_tracedNodeTypes = 0;
+uint32_t SatPacketTrace::m_tracedLinkDirs = 0;
+
 SatPacketTrace::SatPacketTrace ()
+  : m_outputFormat (FORMAT_TEXT),
+    m_bufferSize (65536),
+    m_packetEventMask (0xFFFFFFFF),
+    m_nodeTypeMask (0xFFFFFFFF),
+    m_linkDirMask (0xFFFFFFFF)
 {
   ObjectBase::ConstructSelf (AttributeConstructionList ());
 
-  AsciiTraceHelper asciiTraceHelper;
+  if (m_instances++ == 0)
+    {
+      m_tracedPacketEvents = 0;
+      m_tracedNodeTypes = 0;
+      m_tracedLinkDirs = 0;
+    }
+
+  // The union only grows while there are instances (also by the mask
+  // attribute setters), which at most lets through entries that the sink
+  // filters out.
+  m_tracedPacketEvents |= m_packetEventMask;
+  m_tracedNodeTypes |= m_nodeTypeMask;
+  m_tracedLinkDirs |= m_linkDirMask;
 
   std::stringstream outputPath;
-  outputPath << Singleton<SatEnvVariables>::Get ()->GetOutputPath () << "/" << m_fileName << ".log";
+  outputPath << Singleton<SatEnvVariables>::Get ()->GetOutputPath () << "/" << m_fileName;
+
+  if (m_outputFormat == FORMAT_BINARY)
+    {
+      outputPath << ".bin";
+
+      m_binaryStream.open (outputPath.str ().c_str (), std::ofstream::out | std::ofstream::binary | std::ofstream::trunc);
+
+      if (!m_binaryStream.is_open ())
+        {
+          NS_FATAL_ERROR ("SatPacketTrace::SatPacketTrace - unable to open " << outputPath.str ());
+        }
+
+      m_buffer.reserve (m_bufferSize);
+
+      uint32_t version = BINARY_FORMAT_VERSION;
+      uint32_t reserved = 0;
+      AppendToBuffer (BINARY_MAGIC, sizeof (BINARY_MAGIC));
+      AppendToBuffer (&version, sizeof (version));
+      AppendToBuffer (&reserved, sizeof (reserved));
+    }
+  else
+    {
+      outputPath << ".log";
 
-  m_packetTraceStream = asciiTraceHelper.CreateFileStream (outputPath.str ());
+      AsciiTraceHelper asciiTraceHelper;
+      m_packetTraceStream = asciiTraceHelper.CreateFileStream (outputPath.str ());
 
-  PrintHeader ();
+      PrintHeader ();
+    }
 }
 
 SatPacketTrace::~SatPacketTrace ()
 {
   NS_LOG_FUNCTION (this);
+
+  Flush ();
+
+  m_instances--;
 }
 
 TypeId
@@ -70,6 +125,35 @@ SatPacketTrace::GetTypeId ()
                    StringValue ("PacketTrace"),
                    MakeStringAccessor (&SatPacketTrace::m_fileName),
                    MakeStringChecker ())
+    .AddAttribute ("OutputFormat",
+                   "Format of the packet trace output",
+                   EnumValue (SatPacketTrace::FORMAT_TEXT),
+                   MakeEnumAccessor (&SatPacketTrace::m_outputFormat),
+                   MakeEnumChecker (SatPacketTrace::FORMAT_TEXT, "Text",
+                                    SatPacketTrace::FORMAT_BINARY, "Binary"))
+    .AddAttribute ("BufferSize",
+                   "Size of the binary entry buffer in bytes",
+                   UintegerValue (65536),
+                   MakeUintegerAccessor (&SatPacketTrace::m_bufferSize),
+                   MakeUintegerChecker<uint32_t> (1024))
+    .AddAttribute ("PacketEventMask",
+                   "Bit mask of the traced packet events (bit 0: SND, 1: RCV, 2: ENQ, 3: DRP)",
+                   UintegerValue (0xFFFFFFFF),
+                   MakeUintegerAccessor (&SatPacketTrace::SetPacketEventMask,
+                                         &SatPacketTrace::GetPacketEventMask),
+                   MakeUintegerChecker<uint32_t> ())
+    .AddAttribute ("NodeTypeMask",
+                   "Bit mask of the traced node types (bit 0: UT, 1: SAT, 2: GW, 3: NCC, 4: TER)",
+                   UintegerValue (0xFFFFFFFF),
+                   MakeUintegerAccessor (&SatPacketTrace::SetNodeTypeMask,
+                                         &SatPacketTrace::GetNodeTypeMask),
+                   MakeUintegerChecker<uint32_t> ())
+    .AddAttribute ("LinkDirMask",
+                   "Bit mask of the traced link directions (bit 0: FWD, 1: RTN)",
+                   UintegerValue (0xFFFFFFFF),
+                   MakeUintegerAccessor (&SatPacketTrace::SetLinkDirMask,
+                                         &SatPacketTrace::GetLinkDirMask),
+                   MakeUintegerChecker<uint32_t> ())
   ;
   return tid;
 }
@@ -78,9 +162,62 @@ void
 SatPacketTrace::DoDispose ()
 {
   NS_LOG_FUNCTION (this);
+
+  Flush ();
+
+  if (m_packetTraceStream)
+    {
+      m_packetTraceStream->GetStream ()->flush ();
+    }
+
   Object::DoDispose ();
 }
 
+void
+SatPacketTrace::SetPacketEventMask (uint32_t mask)
+{
+  NS_LOG_FUNCTION (this << mask);
+
+  m_packetEventMask = mask;
+  m_tracedPacketEvents |= mask;
+}
+
+uint32_t
+SatPacketTrace::GetPacketEventMask () const
+{
+  return m_packetEventMask;
+}
+
+void
+SatPacketTrace::SetNodeTypeMask (uint32_t mask)
+{
+  NS_LOG_FUNCTION (this << mask);
+
+  m_nodeTypeMask = mask;
+  m_tracedNodeTypes |= mask;
+}
+
+uint32_t
+SatPacketTrace::GetNodeTypeMask () const
+{
+  return m_nodeTypeMask;
+}
+
+void
+SatPacketTrace::SetLinkDirMask (uint32_t mask)
+{
+  NS_LOG_FUNCTION (this << mask);
+
+  m_linkDirMask = mask;
+  m_tracedLinkDirs |= mask;
+}
+
+uint32_t
+SatPacketTrace::GetLinkDirMask () const
+{
+  return m_linkDirMask;
+}
+
 void
 SatPacketTrace::PrintHeader ()
 {
@@ -111,28 +248,86 @@ SatPacketTrace::AddTraceEntry (Time now,
 {
   NS_LOG_FUNCTION (this << now.GetSeconds ());
 
-  /**
-   * TODO: Currently the packet trace logs all entries updated by the protocol layers.
-   * A filtering functionality may be implemented later, to restrict the amount of output
-   * data. The user may configure the filtering rules by attributes, e.g.
-   * - Entries from only certain type packet events
-   * - Entries from only certain node types
-   * - Entries from only certain node ids
-   * - Entries with certain log level (i.e. protocol layer)
-   * - Entries from one simulation direction
-   */
-
-  std::ostringstream oss;
-  oss << now.GetSeconds () << " "
-      << SatEnums::GetPacketEventName (packetEvent) << " "
-      << SatEnums::GetNodeTypeName (nodeType) << " "
-      << nodeId << " "
-      << macAddress << " "
-      << SatEnums::GetLogLevelName (logLevel) << " "
-      << SatEnums::GetLinkDirName (linkDir) << " "
-      << packetInfo;
-
-  *m_packetTraceStream->GetStream () << oss.str () << std::endl;
+  if ((m_packetEventMask & (1 << packetEvent)) == 0
+      || (m_nodeTypeMask & (1 << nodeType)) == 0
+      || (m_linkDirMask & (1 << linkDir)) == 0)
+    {
+      return;
+    }
+
+  if (m_outputFormat == FORMAT_BINARY)
+    {
+      AddBinaryEntry (now, packetEvent, nodeType, nodeId, macAddress, logLevel, linkDir, packetInfo);
+      return;
+    }
+
+  // The stream is flushed only when its buffer fills up or the trace is disposed
+  *m_packetTraceStream->GetStream () << now.GetSeconds () << " "
+                                     << SatEnums::GetPacketEventName (packetEvent) << " "
+                                     << SatEnums::GetNodeTypeName (nodeType) << " "
+                                     << nodeId << " "
+                                     << macAddress << " "
+                                     << SatEnums::GetLogLevelName (logLevel) << " "
+                                     << SatEnums::GetLinkDirName (linkDir) << " "
+                                     << packetInfo << "\n";
+}
+
+void
+SatPacketTrace::AddBinaryEntry (Time now,
+                                SatEnums::SatPacketEvent_t packetEvent,
+                                SatEnums::SatNodeType_t nodeType,
+                                uint32_t nodeId,
+                                Mac48Address macAddress,
+                                SatEnums::SatLogLevel_t logLevel,
+                                SatEnums::SatLinkDir_t linkDir,
+                                const std::string& packetInfo)
+{
+  NS_LOG_FUNCTION (this << now.GetSeconds ());
+
+  if (packetInfo.size () > 0xFFFF)
+    {
+      NS_FATAL_ERROR ("SatPacketTrace::AddBinaryEntry - too long packet info: " << packetInfo.size ());
+    }
+
+  double seconds = now.GetSeconds ();
+  uint8_t fields[4] = { (uint8_t) packetEvent, (uint8_t) nodeType, (uint8_t) logLevel, (uint8_t) linkDir };
+  uint8_t address[6];
+  uint16_t infoLength = packetInfo.size ();
+
+  macAddress.CopyTo (address);
+
+  if (m_buffer.size () + sizeof (seconds) + sizeof (nodeId) + sizeof (fields)
+      + sizeof (address) + sizeof (infoLength) + infoLength > m_bufferSize)
+    {
+      Flush ();
+    }
+
+  AppendToBuffer (&seconds, sizeof (seconds));
+  AppendToBuffer (&nodeId, sizeof (nodeId));
+  AppendToBuffer (fields, sizeof (fields));
+  AppendToBuffer (address, sizeof (address));
+  AppendToBuffer (&infoLength, sizeof (infoLength));
+  AppendToBuffer (packetInfo.data (), infoLength);
+}
+
+void
+SatPacketTrace::AppendToBuffer (const void * data, size_t size)
+{
+  const char * bytes = static_cast<const char *> (data);
+  m_buffer.insert (m_buffer.end (), bytes, bytes + size);
+}
+
+void
+SatPacketTrace::Flush ()
+{
+  NS_LOG_FUNCTION (this);
+
+  if (m_binaryStream.is_open () && !m_buffer.empty ())
+    {
+      m_binaryStream.write (&m_buffer[0], m_buffer.size ());
+      m_binaryStream.flush ();
+      m_buffer.clear ();
+    }
 }
 
 }
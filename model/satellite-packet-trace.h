@@ -21,6 +21,8 @@
 #ifndef SATELLITE_PACKET_TRACE_H_
 #define SATELLITE_PACKET_TRACE_H_
 
+#include <fstream>
+#include <vector>
 #include "ns3/object.h"
 #include "ns3/output-stream-wrapper.h"
 #include "satellite-enums.h"
@@ -33,11 +35,41 @@ namespace ns3 {
  * \brief The SatPacketTrace implements a packet trace functionality.
  * The movement of packet through the satellite stack can be traced
  * in different protocol layers and direction.
+ *
+ * The entries can be filtered by packet event, node type and link direction
+ * with bit mask attributes, where bit n enables the entries of the enum value n.
+ * The protocol layers check the filter with IsTraced before building the
+ * packet info of an entry, thus the filtered out entries are not formatted.
+ * The check covers the filters of all the existing SatPacketTrace instances,
+ * so also other sinks connected to the PacketTrace trace sources receive only
+ * the entries passing some of the filters, while a SatPacketTrace exists.
+ *
+ * The trace is written either as text or in a buffered binary format. The
+ * binary file consists of an 8 byte identifier "SATPKTTR", the format version
+ * and a reserved field (uint32_t each) followed by the entries. An entry
+ * consists of the time in seconds (double), node id (uint32_t), packet event,
+ * node type, log level and link direction (uint8_t each), MAC address (6 bytes),
+ * packet info length (uint16_t) and the packet info characters. All the values
+ * are in the byte order of the host.
  */
 
 class SatPacketTrace : public Object
 {
 public:
+  /**
+   * \brief Format of the packet trace output
+   */
+  typedef enum
+  {
+    FORMAT_TEXT,
+    FORMAT_BINARY
+  } OutputFormat_t;
+
+  /**
+   * \brief Version of the binary format
+   */
+  static const uint32_t BINARY_FORMAT_VERSION = 1;
+
   /**
    * \brief Constructor
    */
@@ -82,12 +114,99 @@ public:
                       SatEnums::SatLinkDir_t linkDir,
                       std::string packetInfo);
 
+  /**
+   * \brief Write the buffered binary entries to the file
+   */
+  void Flush ();
+
+  /**
+   * \brief Check whether an entry passes the filter of any existing packet
+   * trace. The protocol layers call this before building the packet info of
+   * an entry.
+   * \param packetEvent Packet event(SND, RCV, DRP, ENQ)
+   * \param nodeType Node type (UT, SAT, GW, NCC, TER)
+   * \param linkDir Link direction (FWD, RTN)
+   * \return true if the entry passes any filter or there is no packet trace
+   */
+  static inline bool IsTraced (SatEnums::SatPacketEvent_t packetEvent,
+                               SatEnums::SatNodeType_t nodeType,
+                               SatEnums::SatLinkDir_t linkDir)
+  {
+    return m_instances == 0
+           || ((m_tracedPacketEvents & (1 << packetEvent)) != 0
+               && (m_tracedNodeTypes & (1 << nodeType)) != 0
+               && (m_tracedLinkDirs & (1 << linkDir)) != 0);
+  }
+
 private:
+  /**
+   * \brief Set the bit mask of the traced packet events
+   * \param mask Bit mask
+   */
+  void SetPacketEventMask (uint32_t mask);
+
+  /**
+   * \brief Get the bit mask of the traced packet events
+   * \return Bit mask
+   */
+  uint32_t GetPacketEventMask () const;
+
+  /**
+   * \brief Set the bit mask of the traced node types
+   * \param mask Bit mask
+   */
+  void SetNodeTypeMask (uint32_t mask);
+
+  /**
+   * \brief Get the bit mask of the traced node types
+   * \return Bit mask
+   */
+  uint32_t GetNodeTypeMask () const;
+
+  /**
+   * \brief Set the bit mask of the traced link directions
+   * \param mask Bit mask
+   */
+  void SetLinkDirMask (uint32_t mask);
+
+  /**
+   * \brief Get the bit mask of the traced link directions
+   * \return Bit mask
+   */
+  uint32_t GetLinkDirMask () const;
+
   /**
    * \brief Print header to the packet trace log
    */
   void PrintHeader ();
 
+  /**
+   * \brief Add a binary packet trace entry to the buffer
+   * \param now Time time of a trace event
+   * \param packetEvent Packet event(SND, RCV, DRP, ENQ)
+   * \param nodeType Node type (UT, SAT, GW, NCC, TER)
+   * \param nodeId Node id
+   * \param macAddress MAC address
+   * \param logLevel Log level (ND, LLC, MAC, PHY, CH)
+   * \param linkDir Link direction (FWD, RTN)
+   * \param packetInfo Packet info
+   */
+  void AddBinaryEntry (Time now,
+                       SatEnums::SatPacketEvent_t packetEvent,
+                       SatEnums::SatNodeType_t nodeType,
+                       uint32_t nodeId,
+                       Mac48Address macAddress,
+                       SatEnums::SatLogLevel_t logLevel,
+                       SatEnums::SatLinkDir_t linkDir,
+                       const std::string& packetInfo);
+
+  /**
+   * \brief Append raw bytes to the binary buffer
+   * \param data Bytes to append
+   * \param size Number of bytes
+   */
+  void AppendToBuffer (const void * data, size_t size);
+
   /**
    * File name of the packet trace log
    */
@@ -98,6 +217,61 @@ private:
    */
   Ptr<OutputStreamWrapper> m_packetTraceStream;
 
+  /**
+   * Format of the packet trace output
+   */
+  OutputFormat_t m_outputFormat;
+
+  /**
+   * Size of the binary entry buffer in bytes
+   */
+  uint32_t m_bufferSize;
+
+  /**
+   * Bit mask of the traced packet events
+   */
+  uint32_t m_packetEventMask;
+
+  /**
+   * Bit mask of the traced node types
+   */
+  uint32_t m_nodeTypeMask;
+
+  /**
+   * Bit mask of the traced link directions
+   */
+  uint32_t m_linkDirMask;
+
+  /**
+   * Binary output file stream
+   */
+  std::ofstream m_binaryStream;
+
+  /**
+   * Buffered binary entries
+   */
+  std::vector<char> m_buffer;
+
+  /**
+   * Number of existing packet trace instances
+   */
+  static uint32_t m_instances;
+
+  /**
+   * Union of the packet event masks of the existing instances
+   */
+  static uint32_t m_tracedPacketEvents;
+
+  /**
+   * Union of the node type masks of the existing instances
+   */
+  static uint32_t m_tracedNodeTypes;
+
+  /**
+   * Union of the link direction masks of the existing instances
+   */
+  static uint32_t m_tracedLinkDirs;
+
 };
 
 }
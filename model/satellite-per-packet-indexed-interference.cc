@@ -0,0 +1,337 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2016 Magister Solutions Ltd.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: agent <agent@local>
+ */
+
+#include <algorithm>
+#include <limits>
+#include <cmath>
+#include "ns3/simulator.h"
+#include "ns3/log.h"
+#include "satellite-per-packet-indexed-interference.h"
+#include "ns3/singleton.h"
+
+NS_LOG_COMPONENT_DEFINE ("SatPerPacketIndexedInterference");
+
+namespace ns3 {
+
+NS_OBJECT_ENSURE_REGISTERED (SatPerPacketIndexedInterference);
+
+TypeId
+SatPerPacketIndexedInterference::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::SatPerPacketIndexedInterference")
+    .SetParent<SatInterference> ()
+    .AddConstructor<SatPerPacketIndexedInterference> ();
+
+  return tid;
+}
+
+TypeId
+SatPerPacketIndexedInterference::GetInstanceTypeId (void) const
+{
+  NS_LOG_FUNCTION (this);
+
+  return GetTypeId ();
+}
+
+SatPerPacketIndexedInterference::SatPerPacketIndexedInterference ()
+  : m_changeTimes (),
+    m_changePowers (),
+    m_powerSums (1, 0.0),
+    m_weightedPowerSums (1, 0.0),
+    m_head (0),
+    m_baseTime (),
+    m_residualPowerW (0.0),
+    m_nextEventId (0),
+    m_enableTraceOutput (false),
+    m_channelType (),
+    m_rxBandwidth_Hz ()
+{
+  NS_LOG_FUNCTION (this);
+}
+
+SatPerPacketIndexedInterference::SatPerPacketIndexedInterference (SatEnums::ChannelType_t channelType, double rxBandwidthHz)
+  : m_changeTimes (),
+    m_changePowers (),
+    m_powerSums (1, 0.0),
+    m_weightedPowerSums (1, 0.0),
+    m_head (0),
+    m_baseTime (),
+    m_residualPowerW (0.0),
+    m_nextEventId (0),
+    m_enableTraceOutput (true),
+    m_channelType (channelType),
+    m_rxBandwidth_Hz (rxBandwidthHz)
+{
+  NS_LOG_FUNCTION (this << channelType << rxBandwidthHz);
+
+  if (m_rxBandwidth_Hz <= std::numeric_limits<double>::epsilon ())
+    {
+      NS_FATAL_ERROR ("SatPerPacketIndexedInterference::SatPerPacketIndexedInterference - Invalid value");
+    }
+}
+
+SatPerPacketIndexedInterference::~SatPerPacketIndexedInterference ()
+{
+  NS_LOG_FUNCTION (this);
+
+  Reset ();
+}
+
+Ptr<SatInterference::InterferenceChangeEvent>
+SatPerPacketIndexedInterference::DoAdd (Time duration, double power, Address rxAddress)
+{
+  NS_LOG_FUNCTION (this << duration << power << rxAddress );
+
+  Ptr<SatInterference::InterferenceChangeEvent> event;
+  event = Create<SatInterference::InterferenceChangeEvent> (m_nextEventId++, duration, power, rxAddress);
+  Time now = event->GetStartTime ();
+
+  NS_LOG_INFO ( "Add change: Duration= " << duration << ", Power= " << power << ", Time: " << now );
+
+  /**
+   * Changes preceding the start of all ongoing and future receptions are
+   * taken into account fully by all of them, thus they can be folded to the
+   * residual power. If we are not receiving, this covers all the changes up to now.
+   */
+  std::vector<Time>::iterator foldIterator;
+
+  if (m_rxStartTimes.empty ())
+    {
+      foldIterator = std::upper_bound (m_changeTimes.begin () + m_head, m_changeTimes.end (), now);
+    }
+  else
+    {
+      foldIterator = std::lower_bound (m_changeTimes.begin () + m_head, m_changeTimes.end (), *m_rxStartTimes.begin ());
+    }
+
+  FoldChanges (foldIterator - m_changeTimes.begin ());
+
+  NS_LOG_INFO ( "Change count before addition: " << m_changeTimes.size () - m_head );
+
+  // if no changes in future, first power should be zero
+  if ( m_head == m_changeTimes.size () )
+    {
+      if ( ( m_residualPowerW != 0 ) && std::fabs (m_residualPowerW) < std::numeric_limits<long double>::epsilon () )
+        {
+          // if we end up here,
+          // reset first power (this probably due to roundin problem with very small values)
+          m_residualPowerW = 0;
+        }
+    }
+
+  InsertChange (now, power);
+  InsertChange (event->GetEndTime (), -power);
+
+  NS_LOG_INFO ( "Change count after addition: " << m_changeTimes.size () - m_head );
+
+  if ( m_residualPowerW < 0 )
+    {
+      // First power should never leak negative
+      NS_FATAL_ERROR ("First power negative!!!");
+    }
+
+  return event;
+}
+
+double
+SatPerPacketIndexedInterference::DoCalculate (Ptr<SatInterference::InterferenceChangeEvent> event)
+{
+  NS_LOG_FUNCTION (this);
+
+  if ( m_rxEventIds.empty () )
+    {
+      NS_FATAL_ERROR ("Receiving is not set on!!!");
+    }
+
+  NS_LOG_INFO ( "Calculate: IfPower (W)= " << m_residualPowerW << ", Duration= " << event->GetDuration () <<
+                ", StartTime= " << event->GetStartTime () << ", EndTime= " << event->GetEndTime () );
+
+  // changes until own start (including the ones at the same time) are taken into account fully
+  uint32_t startIndex = std::upper_bound (m_changeTimes.begin () + m_head, m_changeTimes.end (),
+                                          event->GetStartTime ()) - m_changeTimes.begin ();
+
+  // changes after own start and before own end are taken into account with the relative part of duration
+  uint32_t endIndex = std::lower_bound (m_changeTimes.begin () + startIndex, m_changeTimes.end (),
+                                        event->GetEndTime ()) - m_changeTimes.begin ();
+
+  // own 'start' change is not taken into account
+  long double ifPowerW = m_residualPowerW + (m_powerSums[startIndex] - m_powerSums[m_head]) - event->GetRxPower ();
+
+  if (endIndex > startIndex)
+    {
+      long double rxDuration = event->GetDuration ().GetDouble ();
+      long double rxEndTime = (event->GetEndTime () - m_baseTime).GetDouble ();
+
+      ifPowerW += (rxEndTime * (m_powerSums[endIndex] - m_powerSums[startIndex])
+                   - (m_weightedPowerSums[endIndex] - m_weightedPowerSums[startIndex])) / rxDuration;
+    }
+
+  NS_LOG_INFO ( "IfPower after update: " << ifPowerW );
+
+  if (m_enableTraceOutput)
+    {
+      std::vector<double> tempVector;
+      tempVector.push_back (Now ().GetSeconds ());
+      tempVector.push_back (ifPowerW / m_rxBandwidth_Hz);
+      Singleton<SatInterferenceOutputTraceContainer>::Get ()->AddToContainer (std::make_pair (event->GetSatEarthStationAddress (), m_channelType), tempVector);
+    }
+
+  return ifPowerW;
+}
+
+void
+SatPerPacketIndexedInterference::DoReset (void)
+{
+  NS_LOG_FUNCTION (this);
+
+  m_changeTimes.clear ();
+  m_changePowers.clear ();
+  m_powerSums.assign (1, 0.0);
+  m_weightedPowerSums.assign (1, 0.0);
+  m_head = 0;
+  m_rxEventIds.clear ();
+  m_rxStartTimes.clear ();
+  m_residualPowerW = 0.0;
+}
+
+void
+SatPerPacketIndexedInterference::DoNotifyRxStart (Ptr<SatInterference::InterferenceChangeEvent> event)
+{
+  NS_LOG_FUNCTION (this);
+
+  std::pair<std::set<uint32_t>::iterator, bool> result = m_rxEventIds.insert (event->GetId ());
+
+  NS_ASSERT (result.second);
+  m_rxStartTimes.insert (event->GetStartTime ());
+}
+
+void
+SatPerPacketIndexedInterference::DoNotifyRxEnd (Ptr<SatInterference::InterferenceChangeEvent> event)
+{
+  NS_LOG_FUNCTION (this);
+
+  if (m_rxEventIds.erase (event->GetId ()) > 0)
+    {
+      m_rxStartTimes.erase (m_rxStartTimes.find (event->GetStartTime ()));
+    }
+}
+
+void
+SatPerPacketIndexedInterference::InsertChange (Time time, long double power)
+{
+  NS_LOG_FUNCTION (this << time);
+
+  if (m_changeTimes.empty ())
+    {
+      m_baseTime = time;
+    }
+
+  // changes of the same time are kept in the order of addition
+  uint32_t index = std::upper_bound (m_changeTimes.begin () + m_head, m_changeTimes.end (), time) - m_changeTimes.begin ();
+
+  m_changeTimes.insert (m_changeTimes.begin () + index, time);
+  m_changePowers.insert (m_changePowers.begin () + index, power);
+  m_powerSums.push_back (0.0);
+  m_weightedPowerSums.push_back (0.0);
+
+  UpdatePrefixSums (index);
+}
+
+void
+SatPerPacketIndexedInterference::FoldChanges (uint32_t index)
+{
+  NS_LOG_FUNCTION (this << index);
+
+  for (uint32_t i = m_head; i < index; i++)
+    {
+      NS_LOG_INFO ( "Change to fold: Time= " << m_changeTimes[i] << ", PowerValue= " << m_changePowers[i]);
+
+      m_residualPowerW += m_changePowers[i];
+
+      NS_LOG_INFO ( "First power after fold: " << m_residualPowerW);
+    }
+
+  m_head = index;
+
+  if (m_head == m_changeTimes.size ())
+    {
+      m_changeTimes.clear ();
+      m_changePowers.clear ();
+      m_powerSums.assign (1, 0.0);
+      m_weightedPowerSums.assign (1, 0.0);
+      m_head = 0;
+    }
+  else if (m_head >= MIN_COMPACTION_SIZE && 2 * m_head > m_changeTimes.size ())
+    {
+      m_changeTimes.erase (m_changeTimes.begin (), m_changeTimes.begin () + m_head);
+      m_changePowers.erase (m_changePowers.begin (), m_changePowers.begin () + m_head);
+      m_powerSums.resize (m_changeTimes.size () + 1);
+      m_weightedPowerSums.resize (m_changeTimes.size () + 1);
+      m_head = 0;
+
+      // re-base the weighted sums to keep the precision
+      m_baseTime = m_changeTimes.front ();
+      UpdatePrefixSums (0);
+    }
+}
+
+void
+SatPerPacketIndexedInterference::UpdatePrefixSums (uint32_t index)
+{
+  NS_LOG_FUNCTION (this << index);
+
+  if (index == 0)
+    {
+      m_powerSums[0] = 0.0;
+      m_weightedPowerSums[0] = 0.0;
+    }
+
+  for (uint32_t i = index; i < m_changeTimes.size (); i++)
+    {
+      long double relativeTime = (m_changeTimes[i] - m_baseTime).GetDouble ();
+
+      m_powerSums[i + 1] = m_powerSums[i] + m_changePowers[i];
+      m_weightedPowerSums[i + 1] = m_weightedPowerSums[i] + m_changePowers[i] * relativeTime;
+    }
+}
+
+void
+SatPerPacketIndexedInterference::DoDispose ()
+{
+  NS_LOG_FUNCTION (this);
+
+  SatInterference::DoDispose ();
+}
+
+void
+SatPerPacketIndexedInterference::SetRxBandwidth (double rxBandwidth)
+{
+  NS_LOG_FUNCTION (this << rxBandwidth);
+
+  if (rxBandwidth <= std::numeric_limits<double>::epsilon ())
+    {
+      NS_FATAL_ERROR ("SatPerPacketIndexedInterference::SetRxBandwidth - Invalid value");
+    }
+
+  m_rxBandwidth_Hz = rxBandwidth;
+}
+
+}
+// namespace ns3
@@ -0,0 +1,239 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2016 Magister Solutions Ltd.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: agent <agent@local>
+ */
+
+#ifndef SATELLITE_PER_PACKET_INDEXED_INTERFERENCE_H
+#define SATELLITE_PER_PACKET_INDEXED_INTERFERENCE_H
+
+#include <vector>
+#include <set>
+#include "satellite-interference.h"
+#include "satellite-interference-output-trace-container.h"
+#include "satellite-enums.h"
+
+namespace ns3 {
+
+/**
+ * \ingroup satellite
+ * \brief Packet by packet interference using indexed interference changes.
+ * Calculates the same interference values as SatPerPacketInterference, but
+ * the interference changes are kept in time order in flat arrays together with
+ * prefix sums of the power changes. Thus, the time-weighted interference of a
+ * reception is calculated with two binary searches instead of walking through
+ * all the changes.
+ *
+ * The changes older than the start of the oldest ongoing reception are folded
+ * into a residual power, and the arrays are used as a sliding window, which is
+ * compacted when more than half of it has been folded.
+ */
+class SatPerPacketIndexedInterference : public SatInterference
+{
+public:
+  /**
+   * \brief Get the type ID
+   * \return the object TypeId
+   */
+  static TypeId GetTypeId (void);
+
+  /**
+   * \brief Get the type ID of instance
+   * \return the object TypeId
+   */
+  TypeId GetInstanceTypeId (void) const;
+
+  /**
+   * Default constructor.
+   */
+  SatPerPacketIndexedInterference ();
+
+  /**
+   * Constructor enabling the interference output trace.
+   *
+   * \param channelType Channel type
+   * \param rxBandwidthHz Receiver bandwidth in Hertz
+   */
+  SatPerPacketIndexedInterference (SatEnums::ChannelType_t channelType, double rxBandwidthHz);
+
+  /**
+   * Destructor
+   */
+  ~SatPerPacketIndexedInterference ();
+
+  /**
+   * Dispose of this class instance
+   */
+  void DoDispose ();
+
+  /**
+   * \brief Set the receiver bandwidth
+   * \param rxBandwidth Receiver bandwidth in Hertz
+   */
+  void SetRxBandwidth (double rxBandwidth);
+
+private:
+  /**
+   * Adds interference power to interference object.
+   *
+   * \param rxDuration Duration of the receiving.
+   * \param rxPower Receiving power.
+   * \param rxAddress MAC address.
+   *
+   * \return the pointer to interference event as a reference of the addition
+   */
+  virtual Ptr<SatInterference::InterferenceChangeEvent> DoAdd (Time rxDuration, double rxPower, Address rxAddress);
+
+  /**
+   * Calculates interference power for the given reference
+   *
+   * \param event Reference event which for interference is calculated.
+   *
+   * \return Final calculated power value at end of receiving
+   */
+  virtual double DoCalculate (Ptr<SatInterference::InterferenceChangeEvent> event);
+
+  /**
+   * Resets current interference.
+   */
+  virtual void DoReset (void);
+
+  /**
+   * Notifies that RX is started by a receiver.
+   *
+   * \param event Interference reference event of receiver
+   */
+  virtual void DoNotifyRxStart (Ptr<SatInterference::InterferenceChangeEvent> event);
+
+  /**
+   * Notifies that RX is ended by a receiver.
+   *
+   * \param event Interference reference event of receiver
+   */
+  virtual void DoNotifyRxEnd (Ptr<SatInterference::InterferenceChangeEvent> event);
+
+  /**
+   * \brief Insert an interference change after the existing changes of the same time
+   * \param time Time of the change
+   * \param power Power change
+   */
+  void InsertChange (Time time, long double power);
+
+  /**
+   * \brief Fold the changes preceding the given index to the residual power
+   * and compact the change arrays, if needed.
+   * \param index Index of the first change to keep
+   */
+  void FoldChanges (uint32_t index);
+
+  /**
+   * \brief Update the prefix sums starting from the given index
+   * \param index Index of the first change to update
+   */
+  void UpdatePrefixSums (uint32_t index);
+
+  /**
+   * Copy constructor. Not implemented.
+   * \param o Object to copy
+   */
+  SatPerPacketIndexedInterference (const SatPerPacketIndexedInterference &o);
+
+  /**
+   * Assignment operator. Not implemented.
+   * \param o Object to assign
+   * \return Reference to this object
+   */
+  SatPerPacketIndexedInterference &operator = (const SatPerPacketIndexedInterference &o);
+
+  /**
+   * \brief Times of the interference changes in increasing order
+   */
+  std::vector<Time> m_changeTimes;
+
+  /**
+   * \brief Power changes of the interference changes
+   */
+  std::vector<long double> m_changePowers;
+
+  /**
+   * \brief Prefix sums of the power changes. Element i holds the sum of
+   * power changes preceding change i, thus there is one more element than
+   * there are changes.
+   */
+  std::vector<long double> m_powerSums;
+
+  /**
+   * \brief Prefix sums of the power changes weighted by the change time
+   * relative to m_baseTime.
+   */
+  std::vector<long double> m_weightedPowerSums;
+
+  /**
+   * \brief Index of the first change not yet folded to the residual power
+   */
+  uint32_t m_head;
+
+  /**
+   * \brief Reference time of the weighted prefix sums
+   */
+  Time m_baseTime;
+
+  /**
+   * \brief notified interference event IDs
+   */
+  std::set <uint32_t> m_rxEventIds;
+
+  /**
+   * \brief start times of the notified interference events
+   */
+  std::multiset <Time> m_rxStartTimes;
+
+  /**
+   * \brief Residual power value for interference.
+   * Sum of the folded power changes.
+   */
+  long double m_residualPowerW;
+
+  /**
+   * \brief event id for Events
+   */
+  uint32_t m_nextEventId;
+
+  /**
+   * \brief Flag to indicate whether interference output trace is enabled
+   */
+  bool m_enableTraceOutput;
+
+  /**
+   * \brief Channel type
+   */
+  SatEnums::ChannelType_t m_channelType;
+
+  /**
+   * \brief RX Bandwidth in Hz
+   */
+  double m_rxBandwidth_Hz;
+
+  /**
+   * \brief Minimum number of folded changes before the arrays are compacted
+   */
+  static const uint32_t MIN_COMPACTION_SIZE = 64;
+};
+
+} // namespace ns3
+
+#endif /* SATELLITE_PER_PACKET_INDEXED_INTERFERENCE_H */
@@ -102,18 +102,17 @@ void
 SatPhyRxCarrierPerFrame::DoDispose ()
 {
 	SatPhyRxCarrierPerSlot::DoDispose ();
-  std::map<uint32_t,std::list<SatPhyRxCarrierPerFrame::crdsaPacketRxParams_s> >::iterator iter;
 
-  for (iter = m_crdsaPacketContainer.begin (); iter != m_crdsaPacketContainer.end (); iter++)
+  for (uint32_t i = 0; i < m_crdsaPackets.size (); i++)
     {
-      std::list<SatPhyRxCarrierPerFrame::crdsaPacketRxParams_s>::iterator iterList;
-      for (iterList = iter->second.begin (); iterList != iter->second.end (); iterList++)
-        {
-          iterList->rxParams = NULL;
-        }
-      iter->second.clear ();
+      m_crdsaPackets[i].rxParams = NULL;
     }
-  m_crdsaPacketContainer.clear ();
+
+  m_crdsaPackets.clear ();
+  m_crdsaSlotPackets.clear ();
+  m_crdsaReplicaLinks.clear ();
+  m_crdsaPacketRemoved.clear ();
+  m_crdsaSlotPacketCount.clear ();
 }
 
 void
@@ -159,7 +158,7 @@ SatPhyRxCarrierPerFrame::DoFrameEnd ()
 
   NS_LOG_INFO ("SatPhyRxCarrier::DoFrameEnd - Time: " << Now ().GetSeconds ());
 
-  if (!m_crdsaPacketContainer.empty ())
+  if (!m_crdsaPackets.empty ())
     {
       // Update the CRDSA random access load for unique payloads!
       UpdateRandomAccessLoad ();
@@ -168,7 +167,7 @@ SatPhyRxCarrierPerFrame::DoFrameEnd ()
 
       std::vector<SatPhyRxCarrierPerFrame::crdsaPacketRxParams_s> results = ProcessFrame ();
 
-      if (!m_crdsaPacketContainer.empty ())
+      if (!m_crdsaPackets.empty ())
         {
           NS_FATAL_ERROR ("SatPhyRxCarrier::DoFrameEnd - All CRDSA packets in the frame were not processed");
         }
@@ -221,7 +220,7 @@ SatPhyRxCarrierPerFrame::DoFrameEnd ()
     }
   else
     {
-      if (!m_crdsaPacketContainer.empty ())
+      if (!m_crdsaPackets.empty ())
         {
           NS_FATAL_ERROR ("SatPhyRxCarrier::DoFrameEnd - CRDSA packets received by carrier which has random access disabled");
         }
@@ -245,36 +244,24 @@ SatPhyRxCarrierPerFrame::UpdateRandomAccessLoad ()
 {
 	NS_LOG_FUNCTION (this);
 
-  std::vector<uint64_t> uniquePacketIds;
+  std::set<uint64_t> uniquePacketIds;
   uint32_t uniqueCrdsaBytes (0);
 
-	// Go through all the received CRDSA packets
-  std::map<uint32_t,std::list<SatPhyRxCarrierPerFrame::crdsaPacketRxParams_s> >::iterator iter;
-	for (iter = m_crdsaPacketContainer.begin (); iter != m_crdsaPacketContainer.end (); iter++)
-	  {
-	    // Go through all the packets received in the same slot id
-      std::list<SatPhyRxCarrierPerFrame::crdsaPacketRxParams_s>::iterator iterList;
-      for (iterList = iter->second.begin (); iterList != iter->second.end (); iterList++)
-        {
-          // It is sufficient to check the first packet Uid
-          uint64_t uid = iterList->rxParams->m_packetsInBurst.front ()->GetUid();
-
-          // Check if we have already counted the bytes of this transmission
-          std::vector<uint64_t>::iterator it = std::find (uniquePacketIds.begin (),
-                                                          uniquePacketIds.end (),
-                                                          uid);
-          // Not found -> is unique
-          if (it == uniquePacketIds.end ())
-            {
-              // Push this to accounted unique transmissions vector
-              uniquePacketIds.push_back (uid);
+  // Go through all the received CRDSA packets
+  for (uint32_t i = 0; i < m_crdsaPackets.size (); i++)
+    {
+      // It is sufficient to check the first packet Uid
+      uint64_t uid = m_crdsaPackets[i].rxParams->m_packetsInBurst.front ()->GetUid ();
 
-              // Update the load with FEC block size!
-              uniqueCrdsaBytes += iterList->rxParams->m_txInfo.fecBlockSizeInBytes;
-            }
-          // else, do nothing, i.e. this is a replica
+      // Check if we have already counted the bytes of this transmission.
+      // Not found -> is unique
+      if (uniquePacketIds.insert (uid).second)
+        {
+          // Update the load with FEC block size!
+          uniqueCrdsaBytes += m_crdsaPackets[i].rxParams->m_txInfo.fecBlockSizeInBytes;
         }
-	  }
+      // else, do nothing, i.e. this is a replica
+    }
 
 	// Update with the unique FEC block sum of CRDSA frame
 	m_randomAccessBitsInFrame = uniqueCrdsaBytes * SatConstVariables::BITS_PER_BYTE;
@@ -366,6 +353,8 @@ SatPhyRxCarrierPerFrame::AddCrdsaPacket (SatPhyRxCarrierPerFrame::crdsaPacketRxP
         }
 
       /// tags are not needed after this
+      crdsaPacketParams.rxParams->MaterializePackets ();
+
       for (uint32_t i = 0; i < crdsaPacketParams.rxParams->m_packetsInBurst.size (); i++)
         {
       	crdsaPacketParams.rxParams->m_packetsInBurst[i]->RemovePacketTag (replicaTag);
@@ -376,20 +365,8 @@ SatPhyRxCarrierPerFrame::AddCrdsaPacket (SatPhyRxCarrierPerFrame::crdsaPacketRxP
       NS_FATAL_ERROR ("SatPhyRxCarrierPerFrame::AddCrdsaPacket - CRDSA reception with 0 packets");
     }
 
-  std::map<uint32_t, std::list<SatPhyRxCarrierPerFrame::crdsaPacketRxParams_s> >::iterator result;
-
-  result = m_crdsaPacketContainer.find (crdsaPacketParams.ownSlotId);
-
-  if (result == m_crdsaPacketContainer.end ())
-    {
-      std::list<SatPhyRxCarrierPerFrame::crdsaPacketRxParams_s> tempList;
-      tempList.push_back (crdsaPacketParams);
-      m_crdsaPacketContainer.insert (std::make_pair (crdsaPacketParams.ownSlotId, tempList));
-    }
-  else
-    {
-      result->second.push_back (crdsaPacketParams);
-    }
+  m_crdsaSlotPackets[crdsaPacketParams.ownSlotId].push_back (m_crdsaPackets.size ());
+  m_crdsaPackets.push_back (crdsaPacketParams);
 
   NS_LOG_INFO ("SatPhyRxCarrierPerFrame::AddCrdsaPacket - Packet in slot " << crdsaPacketParams.ownSlotId << " was added to the CRDSA packet container");
 
@@ -406,140 +383,105 @@ SatPhyRxCarrierPerFrame::ProcessFrame ()
 
   NS_LOG_INFO ("SatPhyRxCarrier::ProcessFrame - Time: " << Now ().GetSeconds ());
 
-  std::map<uint32_t,std::list<SatPhyRxCarrierPerFrame::crdsaPacketRxParams_s> >::iterator iter;
   std::vector<SatPhyRxCarrierPerFrame::crdsaPacketRxParams_s> combinedPacketsForFrame;
-  SatPhyRxCarrierPerFrame::crdsaPacketRxParams_s processedPacket;
+  crdsaWorklist_t worklist;
 
-  bool nothingToProcess = true;
+  BuildReplicaLinks ();
 
-  NS_LOG_INFO ("SatPhyRxCarrierPerFrame::ProcessFrame - Packets to process: " << m_crdsaPacketContainer.size ());
+  m_crdsaPacketRemoved.assign (m_crdsaPackets.size (), false);
+  m_crdsaSlotPacketCount.clear ();
 
-  do
+  /// all the packets are waiting for processing in the beginning
+  for (uint32_t i = 0; i < m_crdsaPackets.size (); i++)
     {
-      NS_LOG_INFO ("SatPhyRxCarrierPerFrame::ProcessFrame - Searching for the next successfully received packet");
-
-      /// reset the flag
-      nothingToProcess = true;
-
-      /// go through the packets
-      for (iter = m_crdsaPacketContainer.begin (); iter != m_crdsaPacketContainer.end (); iter++)
-        {
-          NS_LOG_INFO ("SatPhyRxCarrierPerFrame::ProcessFrame - Iterating slot: " << iter->first);
-
-          if (iter->second.size () < 1)
-            {
-              NS_FATAL_ERROR ("SatPhyRxCarrierPerFrame::ProcessFrame - This should not happen");
-            }
-
-          std::list<SatPhyRxCarrierPerFrame::crdsaPacketRxParams_s>::iterator iterList;
-
-          for (iterList = iter->second.begin (); iterList != iter->second.end (); iterList++)
-            {
-              NS_LOG_INFO ("SatPhyRxCarrierPerFrame::ProcessFrame - Iterating packet in slot: " << iterList->ownSlotId);
-
-              if (!iterList->packetHasBeenProcessed)
-                {
-                  NS_LOG_INFO ("SatPhyRxCarrierPerFrame::ProcessFrame - Found a packet ready for processing");
-
-                  /// process the received packet
-                  *iterList = ProcessReceivedCrdsaPacket (*iterList, iter->second.size ());
-
-                  NS_LOG_INFO ("SatPhyRxCarrierPerFrame::ProcessFrame - Packet error: " << iterList->phyError);
-
-                  /// packet successfully received
-                  if (!iterList->phyError)
-                    {
-                      NS_LOG_INFO ("SatPhyRxCarrierPerFrame::ProcessFrame - Packet successfully received, breaking the slot iteration");
-
-                      nothingToProcess = false;
+      worklist.insert (std::make_pair (m_crdsaPackets[i].ownSlotId, i));
+      m_crdsaSlotPacketCount[m_crdsaPackets[i].ownSlotId]++;
+    }
 
-                      /// save packet for processing outside the loop
-                      processedPacket = *iterList;
+  NS_LOG_INFO ("SatPhyRxCarrierPerFrame::ProcessFrame - Packets to process: " << m_crdsaPackets.size ());
 
-                      /// remove the successfully received packet from the container
-                      iter->second.erase (iterList);
+  /// The first packet of the worklist is processed next, i.e. the packets are processed
+  /// in the same order as when scanning the slots from the beginning after each
+  /// successfully received packet. A packet is re-processed only if the interference
+  /// in its slot has been reduced after its previous processing.
+  while (!worklist.empty ())
+    {
+      uint16_t slotId = worklist.begin ()->first;
+      uint32_t packetIndex = worklist.begin ()->second;
+      worklist.erase (worklist.begin ());
 
-                      /// eliminate the interference caused by this packet to other packets in this slot
-                      EliminateInterference (iter,processedPacket);
+      NS_LOG_INFO ("SatPhyRxCarrierPerFrame::ProcessFrame - Found a packet ready for processing in slot: " << slotId);
 
-                      /// break the cycle
-                      break;
-                    }
-                }
-              else
-                {
-                  NS_LOG_INFO ("SatPhyRxCarrierPerFrame::ProcessFrame - This packet has already been processed");
-                }
-            }
+      /// process the received packet
+      SatPhyRxCarrierPerFrame::crdsaPacketRxParams_s& packet = m_crdsaPackets[packetIndex];
+      packet = ProcessReceivedCrdsaPacket (packet, m_crdsaSlotPacketCount[slotId]);
 
-          /// successfully received packet found
-          if (!nothingToProcess)
-            {
-              NS_LOG_INFO ("SatPhyRxCarrierPerFrame::ProcessFrame - Packet successfully received, breaking the container iteration");
-              break;
-            }
-        }
+      NS_LOG_INFO ("SatPhyRxCarrierPerFrame::ProcessFrame - Packet error: " << packet.phyError);
 
-      if (!nothingToProcess)
+      /// packet successfully received
+      if (!packet.phyError)
         {
           NS_LOG_INFO ("SatPhyRxCarrierPerFrame::ProcessFrame - Packet successfully received, processing the replicas");
 
-          /// find and remove replicas of the received packet
-          FindAndRemoveReplicas (processedPacket);
+          /// remove the successfully received packet from the slot
+          RemovePacket (packetIndex);
+
+          /// eliminate the interference caused by this packet to other packets in this slot
+          EliminateInterference (slotId, packet, worklist);
+
+          /// remove replicas of the received packet and eliminate their interference
+          RemoveReplicas (packetIndex, worklist);
 
           /// save the the received packet
-          combinedPacketsForFrame.push_back (processedPacket);
+          combinedPacketsForFrame.push_back (packet);
         }
     }
-  while (!nothingToProcess);
 
-  NS_LOG_INFO ("SatPhyRxCarrierPerFrame::ProcessFrame - All successfully received packets processed, packets left in container: " << m_crdsaPacketContainer.size ());
+  NS_LOG_INFO ("SatPhyRxCarrierPerFrame::ProcessFrame - All successfully received packets processed");
 
-  do
-    {
-      /// go through the packets
-      iter = m_crdsaPacketContainer.begin ();
+  /// the rest of the packets were not received successfully, one packet of each
+  /// set of replicas is passed on
+  std::map<uint16_t, std::vector<uint32_t> >::const_iterator iter;
 
-      if (iter != m_crdsaPacketContainer.end ())
+  for (iter = m_crdsaSlotPackets.begin (); iter != m_crdsaSlotPackets.end (); iter++)
+    {
+      for (uint32_t i = 0; i < iter->second.size (); i++)
         {
-          std::list<SatPhyRxCarrierPerFrame::crdsaPacketRxParams_s>::iterator iterList = iter->second.begin ();
+          uint32_t packetIndex = iter->second[i];
 
-          if (iterList != iter->second.end ())
+          if (m_crdsaPacketRemoved[packetIndex])
             {
-              NS_LOG_INFO ("SatPhyRxCarrierPerFrame::ProcessFrame - Processing unsuccessfully received packet in slot: " << iterList->ownSlotId
-                           << " packet phy error: " << iterList->phyError
-                           << " packet has been processed: " << iterList->packetHasBeenProcessed);
-
-              if (!iterList->packetHasBeenProcessed || !iterList->phyError)
-                {
-                  NS_FATAL_ERROR ("SatPhyRxCarrierPerFrame::ProcessFrame - All successfully received packets should have been processed by now");
-                }
-
-              /// find and remove replicas of the received packet
-              FindAndRemoveReplicas (*iterList);
+              continue;
+            }
 
-              /// save the the received packet
-              combinedPacketsForFrame.push_back (*iterList);
+          const SatPhyRxCarrierPerFrame::crdsaPacketRxParams_s& packet = m_crdsaPackets[packetIndex];
 
-              /// remove the packet from the container
-              iter->second.erase (iterList);
+          NS_LOG_INFO ("SatPhyRxCarrierPerFrame::ProcessFrame - Processing unsuccessfully received packet in slot: " << packet.ownSlotId
+                       << " packet phy error: " << packet.phyError
+                       << " packet has been processed: " << packet.packetHasBeenProcessed);
 
-              /// remove the empty slot container
-              if (iter->second.empty ())
-                {
-                  m_crdsaPacketContainer.erase (iter);
-                }
-            }
-          else
+          if (!packet.packetHasBeenProcessed || !packet.phyError)
             {
-              /// remove the empty slot container
-              m_crdsaPacketContainer.erase (iter);
+              NS_FATAL_ERROR ("SatPhyRxCarrierPerFrame::ProcessFrame - All successfully received packets should have been processed by now");
             }
+
+          RemovePacket (packetIndex);
+
+          /// remove replicas of the packet
+          RemoveReplicas (packetIndex, worklist);
+
+          /// save the the received packet
+          combinedPacketsForFrame.push_back (packet);
         }
     }
-  while (!m_crdsaPacketContainer.empty ());
 
-  NS_LOG_INFO ("SatPhyRxCarrierPerFrame::ProcessFrame - Container processed, packets left: " << m_crdsaPacketContainer.size ());
+  m_crdsaPackets.clear ();
+  m_crdsaSlotPackets.clear ();
+  m_crdsaReplicaLinks.clear ();
+  m_crdsaPacketRemoved.clear ();
+  m_crdsaSlotPacketCount.clear ();
+
+  NS_LOG_INFO ("SatPhyRxCarrierPerFrame::ProcessFrame - Frame processed, packets passed on: " << combinedPacketsForFrame.size ());
 
   return combinedPacketsForFrame;
 }
@@ -628,195 +570,159 @@ SatPhyRxCarrierPerFrame::ProcessReceivedCrdsaPacket (SatPhyRxCarrierPerFrame::cr
 }
 
 void
-SatPhyRxCarrierPerFrame::FindAndRemoveReplicas (SatPhyRxCarrierPerFrame::crdsaPacketRxParams_s packet)
+SatPhyRxCarrierPerFrame::BuildReplicaLinks ()
 {
   NS_LOG_FUNCTION (this);
-  NS_LOG_INFO ("SatPhyRxCarrier::FindAndRemoveReplicas - Time: " << Now ().GetSeconds ());
 
-  for (uint32_t i = 0; i < packet.slotIdsForOtherReplicas.size (); i++)
-    {
-      NS_LOG_INFO ("SatPhyRxCarrier::FindAndRemoveReplicas - Processing replica in slot: " << packet.slotIdsForOtherReplicas[i]);
+  /// replicas have the same source address and the same set of slot IDs
+  typedef std::pair<Mac48Address, std::vector<uint16_t> > replicaKey_t;
+  std::map<replicaKey_t, std::vector<uint32_t> > replicaSets;
 
-      /// get the vector of packets for processing
-      std::map<uint32_t,std::list<SatPhyRxCarrierPerFrame::crdsaPacketRxParams_s> >::iterator iter;
-      iter = m_crdsaPacketContainer.find (packet.slotIdsForOtherReplicas[i]);
+  for (uint32_t i = 0; i < m_crdsaPackets.size (); i++)
+    {
+      std::vector<uint16_t> slotIds = m_crdsaPackets[i].slotIdsForOtherReplicas;
+      slotIds.push_back (m_crdsaPackets[i].ownSlotId);
+      std::sort (slotIds.begin (), slotIds.end ());
 
-      if (iter == m_crdsaPacketContainer.end ())
-        {
-          NS_FATAL_ERROR ("SatPhyRxCarrier::FindAndRemoveReplicas - This should not happen");
-        }
+      replicaSets[std::make_pair (m_crdsaPackets[i].sourceAddress, slotIds)].push_back (i);
+    }
 
-      std::list<SatPhyRxCarrierPerFrame::crdsaPacketRxParams_s>::iterator iterList;
-      SatPhyRxCarrierPerFrame::crdsaPacketRxParams_s removedPacket;
+  m_crdsaReplicaLinks.assign (m_crdsaPackets.size (), std::vector<uint32_t> ());
 
-      bool replicaFound = false;
+  std::map<std::pair<Mac48Address, uint16_t>, const replicaKey_t *> slotOwners;
+  std::map<replicaKey_t, std::vector<uint32_t> >::const_iterator iter;
 
-      for (iterList = iter->second.begin (); iterList != iter->second.end (); )
+  for (iter = replicaSets.begin (); iter != replicaSets.end (); iter++)
+    {
+      /// sanity check
+      for (uint32_t i = 0; i < iter->first.second.size (); i++)
         {
-          /// check for the same UT & same slots
-          if (IsReplica (packet, iterList))
-            {
-              /// replica found for removal
-              replicaFound = true;
-              removedPacket = *iterList;
-              iter->second.erase (iterList++);
-            }
-          else
+          std::pair<Mac48Address, uint16_t> slotOwner = std::make_pair (iter->first.first, iter->first.second[i]);
+          std::map<std::pair<Mac48Address, uint16_t>, const replicaKey_t *>::iterator owner = slotOwners.find (slotOwner);
+
+          if (owner != slotOwners.end () && owner->second != &iter->first)
             {
-              ++iterList;
+              NS_FATAL_ERROR ("SatPhyRxCarrierPerFrame::BuildReplicaLinks - Partially overlapping CRDSA slots");
             }
-        }
 
-      if (!replicaFound)
-        {
-          NS_FATAL_ERROR ("SatPhyRxCarrier::FindAndRemoveReplicas - Replica not found");
+          slotOwners[slotOwner] = &iter->first;
         }
 
-      if (!packet.phyError)
+      const std::vector<uint32_t>& packets = iter->second;
+
+      for (uint32_t i = 0; i < packets.size (); i++)
         {
-          EliminateInterference (iter, removedPacket);
+          for (uint32_t j = 0; j < packets.size (); j++)
+            {
+              if (m_crdsaPackets[packets[i]].ownSlotId != m_crdsaPackets[packets[j]].ownSlotId)
+                {
+                  m_crdsaReplicaLinks[packets[i]].push_back (packets[j]);
+                }
+            }
         }
     }
 }
 
 void
-SatPhyRxCarrierPerFrame::EliminateInterference (
-		std::map<uint32_t,std::list<SatPhyRxCarrierPerFrame::crdsaPacketRxParams_s> >::iterator iter,
-		SatPhyRxCarrierPerFrame::crdsaPacketRxParams_s processedPacket)
+SatPhyRxCarrierPerFrame::RemovePacket (uint32_t packetIndex)
 {
-  NS_LOG_FUNCTION (this);
-  NS_LOG_INFO ("SatPhyRxCarrierPerFrame::EliminateInterference");
-
-  if (iter->second.empty ())
-    {
-      NS_LOG_INFO ("SatPhyRxCarrierPerFrame::EliminateInterference - No other packets in this slot, erasing the slot container");
-      m_crdsaPacketContainer.erase (iter);
-    }
-  else
-    {
-      std::list<SatPhyRxCarrierPerFrame::crdsaPacketRxParams_s>::iterator iterList;
-
-      for (iterList = iter->second.begin (); iterList != iter->second.end (); iterList++)
-        {
-          /// release packets in this slot for re-processing
-          iterList->packetHasBeenProcessed = false;
+  NS_LOG_FUNCTION (this << packetIndex);
 
-          NS_LOG_INFO ("SatPhyRxCarrierPerFrame::EliminateInterference- BEFORE INTERFERENCE ELIMINATION, RX sat: " << iterList->rxParams->m_rxPowerInSatellite_W <<
-                       " IF sat: " << iterList->rxParams->m_ifPowerInSatellite_W <<
-                       " RX gnd: " << iterList->rxParams->m_rxPower_W <<
-                       " IF gnd: " << iterList->rxParams->m_ifPower_W);
+  NS_ASSERT (!m_crdsaPacketRemoved[packetIndex]);
 
-          /// Reduce interference power for the colliding packets. Note, that the interference is
-          /// eliminated only from the user link interference power at the satellite! The intra-beam
-          /// interference is not handled in the return feeder link so that the intra-beam interference
-          /// is not taken into account twice!
-          /// TODO A more novel way to eliminate partially overlapping interference should be considered!
-          /// In addition, as the interference values are extremely small, the use of long double (instead
-          /// of double) should be considered to improve the accuracy.
+  m_crdsaPacketRemoved[packetIndex] = true;
+  m_crdsaSlotPacketCount[m_crdsaPackets[packetIndex].ownSlotId]--;
+}
 
-          iterList->rxParams->m_ifPowerInSatellite_W -= processedPacket.rxParams->m_rxPowerInSatellite_W;
+void
+SatPhyRxCarrierPerFrame::RemoveReplicas (uint32_t packetIndex, crdsaWorklist_t& worklist)
+{
+  NS_LOG_FUNCTION (this << packetIndex);
+  NS_LOG_INFO ("SatPhyRxCarrier::RemoveReplicas - Time: " << Now ().GetSeconds ());
 
-          if (std::abs (iterList->rxParams->m_ifPowerInSatellite_W) < std::numeric_limits<double>::epsilon ())
-            {
-              iterList->rxParams->m_ifPowerInSatellite_W = 0;
-            }
+  const SatPhyRxCarrierPerFrame::crdsaPacketRxParams_s& packet = m_crdsaPackets[packetIndex];
+  const std::vector<uint32_t>& replicas = m_crdsaReplicaLinks[packetIndex];
 
-          if (iterList->rxParams->m_ifPower_W < 0 || iterList->rxParams->m_ifPowerInSatellite_W < 0)
-            {
-              NS_FATAL_ERROR ("SatPhyRxCarrierPerFrame::EliminateInterference - Negative interference");
-            }
-
-          NS_LOG_INFO ("SatPhyRxCarrierPerFrame::EliminateInterference- AFTER INTERFERENCE ELIMINATION, RX sat: " <<
-          							iterList->rxParams->m_rxPowerInSatellite_W <<
-                       " IF sat: " << iterList->rxParams->m_ifPowerInSatellite_W <<
-                       " RX gnd: " << iterList->rxParams->m_rxPower_W <<
-                       " IF gnd: " << iterList->rxParams->m_ifPower_W);
-        }
+  if (replicas.size () < packet.slotIdsForOtherReplicas.size ())
+    {
+      NS_FATAL_ERROR ("SatPhyRxCarrier::RemoveReplicas - Replica not found");
     }
-}
 
-bool
-SatPhyRxCarrierPerFrame::IsReplica (SatPhyRxCarrierPerFrame::crdsaPacketRxParams_s packet,
-																std::list<SatPhyRxCarrierPerFrame::crdsaPacketRxParams_s>::iterator iter)
-{
-  NS_LOG_FUNCTION (this);
-  NS_LOG_INFO ("SatPhyRxCarrier::IsReplica - Time: " << Now ().GetSeconds ());
+  for (uint32_t i = 0; i < replicas.size (); i++)
+    {
+      if (m_crdsaPacketRemoved[replicas[i]])
+        {
+          continue;
+        }
 
-  NS_LOG_INFO ("SatPhyRxCarrier::IsReplica - Checking the source addresses");
+      const SatPhyRxCarrierPerFrame::crdsaPacketRxParams_s& removedPacket = m_crdsaPackets[replicas[i]];
 
-  bool isReplica = false;
+      NS_LOG_INFO ("SatPhyRxCarrier::RemoveReplicas - Processing replica in slot: " << removedPacket.ownSlotId);
 
-  if (iter->sourceAddress == packet.sourceAddress)
-    {
-      NS_LOG_INFO ("SatPhyRxCarrier::IsReplica - Same source addresses, checking slot IDs");
+      RemovePacket (replicas[i]);
+      worklist.erase (std::make_pair (removedPacket.ownSlotId, replicas[i]));
 
-      if (HaveSameSlotIds (packet, iter))
+      if (!packet.phyError)
         {
-          NS_LOG_INFO ("SatPhyRxCarrier::IsReplica - Same slot IDs, replica found");
-          isReplica = true;
+          EliminateInterference (removedPacket.ownSlotId, removedPacket, worklist);
         }
     }
-  return isReplica;
 }
 
-bool
-SatPhyRxCarrierPerFrame::HaveSameSlotIds (SatPhyRxCarrierPerFrame::crdsaPacketRxParams_s packet,
-                                          std::list<SatPhyRxCarrierPerFrame::crdsaPacketRxParams_s>::iterator iter)
+void
+SatPhyRxCarrierPerFrame::EliminateInterference (uint16_t slotId,
+                                                const SatPhyRxCarrierPerFrame::crdsaPacketRxParams_s& processedPacket,
+                                                crdsaWorklist_t& worklist)
 {
-  NS_LOG_FUNCTION (this);
-  NS_LOG_INFO ("SatPhyRxCarrierUt::HaveSameSlotIds - Time: " << Now ().GetSeconds ());
-
-  std::set<uint16_t> firstSet;
-  std::set<uint16_t> secondSet;
-  std::set<uint16_t>::iterator firstSetIterator;
-  std::set<uint16_t>::iterator secondSetIterator;
-  bool haveSameSlotIds = true;
+  NS_LOG_FUNCTION (this << slotId);
+  NS_LOG_INFO ("SatPhyRxCarrierPerFrame::EliminateInterference");
 
-  firstSet.insert (packet.ownSlotId);
-  secondSet.insert (iter->ownSlotId);
+  const std::vector<uint32_t>& packets = m_crdsaSlotPackets[slotId];
 
-  /// sanity check
-  if (iter->slotIdsForOtherReplicas.size () != packet.slotIdsForOtherReplicas.size ())
+  for (uint32_t i = 0; i < packets.size (); i++)
     {
-      NS_FATAL_ERROR ("SatPhyRxCarrierUt::HaveSameSlotIds - The amount of replicas does not match");
-    }
+      if (m_crdsaPacketRemoved[packets[i]])
+        {
+          continue;
+        }
 
-  NS_LOG_INFO ("SatPhyRxCarrierUt::HaveSameSlotIds - Comparing slot IDs");
+      SatPhyRxCarrierPerFrame::crdsaPacketRxParams_s& packet = m_crdsaPackets[packets[i]];
 
-  /// form sets
-  for (uint32_t i = 0; i < iter->slotIdsForOtherReplicas.size (); i++)
-    {
-      firstSet.insert (packet.slotIdsForOtherReplicas[i]);
-      secondSet.insert (iter->slotIdsForOtherReplicas[i]);
-    }
+      /// release packets in this slot for re-processing
+      packet.packetHasBeenProcessed = false;
+      worklist.insert (std::make_pair (slotId, packets[i]));
 
-  uint32_t numOfMatchingSlots = 0;
+      NS_LOG_INFO ("SatPhyRxCarrierPerFrame::EliminateInterference- BEFORE INTERFERENCE ELIMINATION, RX sat: " << packet.rxParams->m_rxPowerInSatellite_W <<
+                   " IF sat: " << packet.rxParams->m_ifPowerInSatellite_W <<
+                   " RX gnd: " << packet.rxParams->m_rxPower_W <<
+                   " IF gnd: " << packet.rxParams->m_ifPower_W);
 
-  /// compare sets
-  for (firstSetIterator = firstSet.begin (); firstSetIterator != firstSet.end (); firstSetIterator++)
-    {
-      secondSetIterator = secondSet.find (*firstSetIterator);
+      /// Reduce interference power for the colliding packets. Note, that the interference is
+      /// eliminated only from the user link interference power at the satellite! The intra-beam
+      /// interference is not handled in the return feeder link so that the intra-beam interference
+      /// is not taken into account twice!
+      /// TODO A more novel way to eliminate partially overlapping interference should be considered!
+      /// In addition, as the interference values are extremely small, the use of long double (instead
+      /// of double) should be considered to improve the accuracy.
 
-      if (secondSetIterator == secondSet.end ())
+      packet.rxParams->m_ifPowerInSatellite_W -= processedPacket.rxParams->m_rxPowerInSatellite_W;
+
+      if (std::abs (packet.rxParams->m_ifPowerInSatellite_W) < std::numeric_limits<double>::epsilon ())
         {
-          haveSameSlotIds = false;
+          packet.rxParams->m_ifPowerInSatellite_W = 0;
         }
-      else
+
+      if (packet.rxParams->m_ifPower_W < 0 || packet.rxParams->m_ifPowerInSatellite_W < 0)
         {
-          numOfMatchingSlots++;
+          NS_FATAL_ERROR ("SatPhyRxCarrierPerFrame::EliminateInterference - Negative interference");
         }
-    }
 
-  NS_LOG_INFO ("SatPhyRxCarrier::HaveSameSlotIds - Are slot IDs identical: " << haveSameSlotIds
-               << ", number of matching slots: " << numOfMatchingSlots);
-
-  /// sanity check
-  if (!haveSameSlotIds && numOfMatchingSlots > 0)
-    {
-      NS_FATAL_ERROR ("SatPhyRxCarrier::HaveSameSlotIds - Partially overlapping CRDSA slots");
+      NS_LOG_INFO ("SatPhyRxCarrierPerFrame::EliminateInterference- AFTER INTERFERENCE ELIMINATION, RX sat: " <<
+                   packet.rxParams->m_rxPowerInSatellite_W <<
+                   " IF sat: " << packet.rxParams->m_ifPowerInSatellite_W <<
+                   " RX gnd: " << packet.rxParams->m_rxPower_W <<
+                   " IF gnd: " << packet.rxParams->m_ifPower_W);
     }
-
-  return haveSameSlotIds;
 }
 
 bool
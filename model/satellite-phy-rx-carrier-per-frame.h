@@ -21,6 +21,9 @@
 #ifndef SATELLITE_PHY_RX_CARRIER_PER_FRAME_H
 #define SATELLITE_PHY_RX_CARRIER_PER_FRAME_H
 
+#include <map>
+#include <set>
+#include <vector>
 #include <ns3/singleton.h>
 #include <ns3/satellite-rtn-link-time.h>
 #include <ns3/satellite-crdsa-replica-tag.h>
@@ -118,13 +121,22 @@ protected:
 
 private:
 
+  /**
+   * \brief Worklist of the CRDSA packets waiting for (re-)processing.
+   * Elements are pairs of slot ID and packet index, thus the packets are
+   * ordered by slot and by the order of reception within a slot.
+   */
+  typedef std::set<std::pair<uint16_t, uint32_t> > crdsaWorklist_t;
+
   /**
    * \brief Function for eliminating the interference to other packets in the slot from the correctly received packet
-   * \param iter Packets in the slot
+   * \param slotId Slot of the packets
    * \param processedPacket Correctly received processed packet
+   * \param worklist Worklist to which the packets of the slot are released for re-processing
    */
-  void EliminateInterference (std::map<uint32_t,std::list<SatPhyRxCarrierPerFrame::crdsaPacketRxParams_s> >::iterator iter,
-  		SatPhyRxCarrierPerFrame::crdsaPacketRxParams_s processedPacket);
+  void EliminateInterference (uint16_t slotId,
+                              const SatPhyRxCarrierPerFrame::crdsaPacketRxParams_s& processedPacket,
+                              crdsaWorklist_t& worklist);
 
   /**
    * \brief Function for storing the received CRDSA packets
@@ -164,28 +176,25 @@ private:
   std::vector<SatPhyRxCarrierPerFrame::crdsaPacketRxParams_s> ProcessFrame ();
 
   /**
-   * \brief Function for finding and removing the replicas of the CRDSA packet
-   * \param packet CRDSA packet
+   * \brief Function for linking the replicas of the received CRDSA packets
+   * to each other. Replicas are identified by the source address and the slot IDs.
    */
-  void FindAndRemoveReplicas (SatPhyRxCarrierPerFrame::crdsaPacketRxParams_s packet);
+  void BuildReplicaLinks ();
 
   /**
-   * \brief Function for identifying whether the packet is a replica of another packet
-   * \param packet Packet
-   * \param iter A packet in certain slot
-   * \return Is the packet a replica
+   * \brief Function for removing a packet from its slot
+   * \param packetIndex Index of the packet
    */
-  bool IsReplica (SatPhyRxCarrierPerFrame::crdsaPacketRxParams_s packet,
-  		std::list<SatPhyRxCarrierPerFrame::crdsaPacketRxParams_s>::iterator iter);
+  void RemovePacket (uint32_t packetIndex);
 
   /**
-   * \brief Function for checking do the packets have identical slots
-   * \param packet Packet
-   * \param iter A packet in certain slot
-   * \return Have the packets identical slots
+   * \brief Function for removing the replicas of the CRDSA packet. If the
+   * packet was received successfully, the interference caused by the replicas
+   * is eliminated from the other packets in their slots.
+   * \param packetIndex Index of the packet
+   * \param worklist Worklist of the packets waiting for processing
    */
-  bool HaveSameSlotIds (SatPhyRxCarrierPerFrame::crdsaPacketRxParams_s packet,
-  		std::list<SatPhyRxCarrierPerFrame::crdsaPacketRxParams_s>::iterator iter);
+  void RemoveReplicas (uint32_t packetIndex, crdsaWorklist_t& worklist);
 
   /**
    * \brief Function for calculating the normalized offered random access load
@@ -218,9 +227,30 @@ private:
 
 
   /**
-   * \brief CRDSA packet container
+   * \brief CRDSA packets of the frame in the order of reception
+   */
+  std::vector<SatPhyRxCarrierPerFrame::crdsaPacketRxParams_s> m_crdsaPackets;
+
+  /**
+   * \brief Indices of the CRDSA packets received in each slot
+   */
+  std::map<uint16_t, std::vector<uint32_t> > m_crdsaSlotPackets;
+
+  /**
+   * \brief Indices of the other replicas of each CRDSA packet
+   */
+  std::vector<std::vector<uint32_t> > m_crdsaReplicaLinks;
+
+  /**
+   * \brief Flags telling whether a CRDSA packet has been removed from its slot
+   * during the frame processing
+   */
+  std::vector<bool> m_crdsaPacketRemoved;
+
+  /**
+   * \brief Number of not removed CRDSA packets in each slot
    */
-  std::map<uint32_t, std::list<SatPhyRxCarrierPerFrame::crdsaPacketRxParams_s> > m_crdsaPacketContainer;
+  std::map<uint16_t, uint32_t> m_crdsaSlotPacketCount;
 
   /**
    * \brief Has the frame end scheduling been initialized
@@ -24,6 +24,7 @@
 #include <ns3/satellite-utils.h>
 #include <ns3/satellite-constant-interference.h>
 #include <ns3/satellite-per-packet-interference.h>
+#include <ns3/satellite-per-packet-indexed-interference.h>
 #include <ns3/satellite-traced-interference.h>
 #include <ns3/satellite-mac-tag.h>
 #include <ns3/singleton.h>
@@ -132,6 +133,19 @@ SatPhyRxCarrier::DoCreateInterferenceModel (Ptr<SatPhyRxCarrierConf> carrierConf
           }
         break;
       }
+    case SatPhyRxCarrierConf::IF_PER_PACKET_INDEXED:
+      {
+        NS_LOG_INFO (this << " Indexed per packet interference model created for carrier: " << carrierId);
+        if (carrierConf->IsIntfOutputTraceEnabled ())
+          {
+            m_satInterference = CreateObject<SatPerPacketIndexedInterference> (GetChannelType (), rxBandwidthHz);
+          }
+        else
+          {
+            m_satInterference = CreateObject<SatPerPacketIndexedInterference> ();
+          }
+        break;
+      }
     case SatPhyRxCarrierConf::IF_TRACE:
       {
         NS_LOG_INFO (this << " Traced interference model created for carrier: " << carrierId);
@@ -359,7 +373,8 @@ SatPhyRxCarrier::DoCompositeSinrOutputTrace (double cSinr)
   tempVector.push_back (Now ().GetSeconds ());
   tempVector.push_back (cSinr);
 
-  Singleton<SatCompositeSinrOutputTraceContainer>::Get ()->AddToContainer (std::make_pair (GetOwnAddress (), GetChannelType ()), tempVector);
+  Singleton<SatCompositeSinrOutputTraceContainer>::Get ()->AddToContainer (std::make_pair (GetOwnAddress (), GetChannelType ()), tempVector,
+                                                                           m_nodeInfo->GetIdMapperHandle ());
 }
 
 
@@ -33,6 +33,7 @@
 #include "satellite-phy-rx-carrier-conf.h"
 #include "satellite-signal-parameters.h"
 #include "satellite-antenna-gain-pattern.h"
+#include "satellite-id-mapper.h"
 
 NS_LOG_COMPONENT_DEFINE ("SatPhyRx");
 
@@ -43,6 +44,7 @@ NS_OBJECT_ENSURE_REGISTERED (SatPhyRx);
 
 SatPhyRx::SatPhyRx ()
   : m_beamId (),
+    m_idMapperHandle (SatIdMapper::INVALID_HANDLE),
     m_maxAntennaGain (),
     m_antennaLoss (),
     m_defaultFadingValue ()
@@ -182,12 +184,21 @@ SatPhyRx::GetAddress () const
   return m_macAddress;
 }
 
+uint32_t
+SatPhyRx::GetIdMapperHandle () const
+{
+  NS_LOG_FUNCTION (this);
+
+  return m_idMapperHandle;
+}
+
 void
 SatPhyRx::SetNodeInfo (const Ptr<SatNodeInfo> nodeInfo)
 {
   NS_LOG_FUNCTION (this << nodeInfo->GetNodeId ());
 
   m_macAddress = nodeInfo->GetMacAddress ();
+  m_idMapperHandle = nodeInfo->GetIdMapperHandle ();
 
   for (std::vector< Ptr<SatPhyRxCarrier> >::iterator it = m_rxCarriers.begin ();
        it != m_rxCarriers.end ();
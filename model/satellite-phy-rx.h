@@ -71,6 +71,21 @@ public:
    */
   virtual void DoDispose ();
 
+  /**
+   * List of the RX carriers of the receiver
+   */
+  typedef std::vector< Ptr<SatPhyRxCarrier> > RxCarrierList_t;
+
+  /**
+   * \brief Get the RX carriers of the receiver, e.g. for connecting to their
+   * trace sources without going through the attribute system
+   * \return RX carriers in the order of carrier id
+   */
+  inline const RxCarrierList_t& GetRxCarrierList () const
+  {
+    return m_rxCarriers;
+  }
+
   void SetMobility (Ptr<MobilityModel> m);
   Ptr<MobilityModel> GetMobility ();
 
@@ -208,6 +223,12 @@ public:
    */
   void SetNodeInfo (const Ptr<SatNodeInfo> nodeInfo);
 
+  /**
+   * \brief Get the handle of the MAC address of this PHY in SatIdMapper
+   * \return Handle or SatIdMapper::INVALID_HANDLE, if it is not set
+   */
+  uint32_t GetIdMapperHandle () const;
+
   /**
    * \brief Begin frame end scheduling for processes utilizing frame length as interval
    */
@@ -219,6 +240,7 @@ private:
 
   uint32_t m_beamId;
   Mac48Address m_macAddress;
+  uint32_t m_idMapperHandle;
 
   /*
    * Receive antenna gain pattern
@@ -38,6 +38,7 @@
 #include <ns3/satellite-address-tag.h>
 #include <ns3/satellite-time-tag.h>
 #include <ns3/satellite-typedefs.h>
+#include <ns3/satellite-packet-trace.h>
 
 
 NS_LOG_COMPONENT_DEFINE ("SatPhy");
@@ -307,14 +308,18 @@ SatPhy::SendPdu (PacketContainer_t p, uint32_t carrierId, Time duration, SatSign
   SatEnums::SatLinkDir_t ld =
     (m_nodeInfo->GetNodeType () == SatEnums::NT_UT) ? SatEnums::LD_RETURN : SatEnums::LD_FORWARD;
 
-  m_packetTrace (Simulator::Now (),
-                 SatEnums::PACKET_SENT,
-                 m_nodeInfo->GetNodeType (),
-                 m_nodeInfo->GetNodeId (),
-                 m_nodeInfo->GetMacAddress (),
-                 SatEnums::LL_PHY,
-                 ld,
-                 SatUtils::GetPacketInfo (p));
+  if (!m_packetTrace.IsEmpty ()
+      && SatPacketTrace::IsTraced (SatEnums::PACKET_SENT, m_nodeInfo->GetNodeType (), ld))
+    {
+      m_packetTrace (Simulator::Now (),
+                     SatEnums::PACKET_SENT,
+                     m_nodeInfo->GetNodeType (),
+                     m_nodeInfo->GetNodeId (),
+                     m_nodeInfo->GetMacAddress (),
+                     SatEnums::LL_PHY,
+                     ld,
+                     SatUtils::GetPacketInfo (p));
+    }
 
 
   // Create a new SatSignalParameters related to this packet transmission
@@ -368,14 +373,18 @@ SatPhy::Receive (Ptr<SatSignalParameters> rxParams, bool phyError)
 
   SatEnums::SatPacketEvent_t event = (phyError) ? SatEnums::PACKET_DROP : SatEnums::PACKET_RECV;
 
-  m_packetTrace (Simulator::Now (),
-                 event,
-                 m_nodeInfo->GetNodeType (),
-                 m_nodeInfo->GetNodeId (),
-                 m_nodeInfo->GetMacAddress (),
-                 SatEnums::LL_PHY,
-                 ld,
-                 SatUtils::GetPacketInfo (rxParams->m_packetsInBurst));
+  if (!m_packetTrace.IsEmpty ()
+      && SatPacketTrace::IsTraced (event, m_nodeInfo->GetNodeType (), ld))
+    {
+      m_packetTrace (Simulator::Now (),
+                     event,
+                     m_nodeInfo->GetNodeType (),
+                     m_nodeInfo->GetNodeId (),
+                     m_nodeInfo->GetMacAddress (),
+                     SatEnums::LL_PHY,
+                     ld,
+                     SatUtils::GetPacketInfo (rxParams->m_packetsInBurst));
+    }
 
   if (phyError)
     {
@@ -385,6 +394,9 @@ SatPhy::Receive (Ptr<SatSignalParameters> rxParams, bool phyError)
     }
   else
     {
+      // The packets are modified by the upper layers, thus stop sharing them
+      rxParams->MaterializePackets ();
+
       // Invoke the `Rx` and `RxDelay` trace sources.
       if (m_isStatisticsTagsEnabled)
         {
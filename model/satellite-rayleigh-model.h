@@ -21,7 +21,7 @@
 #define SATELLITE_RAYLEIGH_MODEL_H
 
 #include "ns3/vector.h"
-#include "satellite-fading-oscillator.h"
+#include "satellite-fading-oscillator-bank.h"
 #include "satellite-base-fader.h"
 #include "ns3/random-variable-stream.h"
 #include "satellite-rayleigh-conf.h"
@@ -104,9 +104,9 @@ private:
   void Reset ();
 
   /**
-   * \brief Vector of oscillators
+   * \brief Oscillators
    */
-  std::vector< Ptr<SatFadingOscillator> > m_oscillators;
+  SatFadingOscillatorBank m_oscillators;
 
   /**
    * \brief Current parameter set
@@ -22,12 +22,12 @@
 #define SATELLITE_RETURN_LINK_ENCAPSULATOR_ARQ
 
 
-#include <map>
-#include "ns3/event-id.h"
+#include <vector>
 #include "ns3/mac48-address.h"
 #include "satellite-return-link-encapsulator.h"
 #include "satellite-arq-sequence-number.h"
 #include "satellite-arq-buffer-context.h"
+#include "satellite-arq-timer-queue.h"
 #include "satellite-control-message.h"
 
 namespace ns3 {
@@ -47,6 +47,9 @@ namespace ns3 {
  * sequence numbers for each sent packet. When a packet is received, and
  * ACK is sent to the receiver with a proper sequence number.
  *
+ * The retransmission and Rx waiting timers are kept in SatArqTimerQueue
+ * objects, and the transmitted and reordering buffers are ring buffers
+ * indexed by the sequence number.
  */
 class SatReturnLinkEncapsulatorArq : public SatReturnLinkEncapsulator
 {
@@ -116,7 +119,7 @@ private:
    * retransmissions has been reached. Otherwise the packet will be resent.
    * \param seqNo Sequence number
    */
-  void ArqReTxTimerExpired (uint8_t seqNo);
+  void ArqReTxTimerExpired (uint32_t seqNo);
 
   /**
    * \brief Clean-up a certain sequence number
@@ -137,6 +140,20 @@ private:
    */
   void ReassembleAndReceive ();
 
+  /**
+   * \brief Get the context of a sequence number from the reordering buffer
+   * \param sn 32-bit sequence number
+   * \return Context or 0, if there is no context for the sequence number
+   */
+  Ptr<SatArqBufferContext> GetReorderingContext (uint32_t sn) const;
+
+  /**
+   * \brief Add a context to the reordering buffer. The reordering buffer is
+   * grown, if the sequence number does not fit into it.
+   * \param context Context, sequence number not less than the next expected one
+   */
+  void AddReorderingContext (Ptr<SatArqBufferContext> context);
+
   /**
    * \brief Rx waiting timer for a PDU has expired
    * \param sn Sequence number
@@ -155,13 +172,21 @@ private:
   Ptr<SatArqSequenceNumber> m_seqNo;
 
   /**
-   * Transmitted and retransmission context buffer
+   * Transmitted and retransmission context buffer. The transmitted buffer
+   * is indexed by the 8-bit sequence number, and holds also the packets
+   * waiting for retransmission. The retransmission buffer holds the sequence
+   * numbers of the packets waiting for retransmission in ascending order.
    */
-  std::map < uint8_t, Ptr<SatArqBufferContext> > m_txedBuffer;       // Transmitted packets buffer
-  std::map < uint8_t, Ptr<SatArqBufferContext> > m_retxBuffer;       // Retransmission buffer
+  std::vector<Ptr<SatArqBufferContext> > m_txedBuffer;       // Transmitted packets buffer
+  std::vector<uint8_t> m_retxBuffer;                         // Retransmission buffer
   uint32_t m_retxBufferSize;
   uint32_t m_txedBufferSize;
 
+  /**
+   * Retransmission timers of the transmitted packets
+   */
+  SatArqTimerQueue m_retxTimers;
+
   /**
    * Max RTN link ARQ segment size
    */
@@ -200,10 +225,20 @@ private:
   Time m_rxWaitingTimer;
 
   /**
-   * key = sequence number
-   * value = RLE packet
+   * Ring buffer of power of two size indexed by the 32-bit sequence number,
+   * holding the contexts from m_nextExpectedSeqNo to m_reorderingBufferEnd.
+   */
+  std::vector<Ptr<SatArqBufferContext> > m_reorderingBuffer;
+
+  /**
+   * One past the highest sequence number in the reordering buffer
+   */
+  uint32_t m_reorderingBufferEnd;
+
+  /**
+   * Rx waiting timers of the missing sequence numbers
    */
-  std::map<uint32_t, Ptr<SatArqBufferContext> > m_reorderingBuffer;
+  SatArqTimerQueue m_rxWaitingTimers;
 };
 
 
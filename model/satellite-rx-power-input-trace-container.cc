@@ -142,7 +142,7 @@ SatRxPowerInputTraceContainer::GetRxPowerDensity (key_t key)
 {
   NS_LOG_FUNCTION (this);
 
-  return FindNode (key)->ProceedToNextClosestTimeSample ().at (SatBaseTraceContainer::RX_POWER_TRACE_DEFAULT_RX_POWER_DENSITY_INDEX);
+  return FindNode (key)->ProceedToNextClosestTimeSample (SatBaseTraceContainer::RX_POWER_TRACE_DEFAULT_RX_POWER_DENSITY_INDEX);
 }
 
 } // namespace ns3
@@ -93,4 +93,14 @@ SatSchedulingObject::GetHolDelay () const
   return m_holDelay;
 }
 
+void
+SatSchedulingObject::Update (uint32_t bytes, uint32_t minTxOpportunity, Time holDelay)
+{
+  NS_LOG_FUNCTION (this << bytes << minTxOpportunity << holDelay);
+
+  m_bufferedBytes = bytes;
+  m_minTxOpportunity = minTxOpportunity;
+  m_holDelay = holDelay;
+}
+
 } // namespace ns3
@@ -91,6 +91,15 @@ public:
    */
   Time GetHolDelay () const;
 
+  /**
+   * \brief Update the buffering information of the object. Used for
+   * reusing the same object in consecutive scheduling rounds.
+   * \param bytes Amount of bytes at an encapsulator
+   * \param minTxOpportunity Minimum size of the Tx opportunity
+   * \param holDelay Head of line queuing delay
+   */
+  void Update (uint32_t bytes, uint32_t minTxOpportunity, Time holDelay);
+
 private:
   Mac48Address m_macAddress;
   uint32_t m_bufferedBytes;
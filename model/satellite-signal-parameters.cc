@@ -44,17 +44,16 @@ SatSignalParameters::SatSignalParameters ()
     m_rxNoisePowerInSatellite_W (),
     m_rxAciIfPowerInSatellite_W (),
     m_rxExtNoisePowerInSatellite_W (),
-    m_sinrCalculate ()
+    m_sinrCalculate (),
+    m_packetsShared (false)
 {
   NS_LOG_FUNCTION (this);
 }
 
 SatSignalParameters::SatSignalParameters ( const SatSignalParameters& p )
 {
-  for ( PacketsInBurst_t::const_iterator i = p.m_packetsInBurst.begin (); i != p.m_packetsInBurst.end (); i++  )
-    {
-      m_packetsInBurst.push_back ((*i)->Copy ());
-    }
+  m_packetsInBurst = p.m_packetsInBurst;
+  m_packetsShared = true;
 
   m_beamId = p.m_beamId;
   m_carrierId = p.m_carrierId;
@@ -89,6 +88,22 @@ SatSignalParameters::Copy ()
   return p;
 }
 
+void
+SatSignalParameters::MaterializePackets ()
+{
+  NS_LOG_FUNCTION (this);
+
+  if (m_packetsShared)
+    {
+      for ( PacketsInBurst_t::iterator i = m_packetsInBurst.begin (); i != m_packetsInBurst.end (); i++  )
+        {
+          *i = (*i)->Copy ();
+        }
+
+      m_packetsShared = false;
+    }
+}
+
 TypeId
 SatSignalParameters::GetTypeId (void)
 {
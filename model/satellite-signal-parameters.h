@@ -37,6 +37,11 @@ class SatPhyTx;
 * through the SatChannel from the transmitter to the receiver. It includes e.g. the packet
 * container (BBFrame in FWD link, FPDU in RTN link) as well as all the transmission related
 * information (MODCODs, frequency, tx power, etc.).
+*
+* One transmission is delivered to each receiver in the channel as a separate copy
+* of SatSignalParameters holding the receiver specific information (Rx power,
+* SINR, interference). The packets of the burst are, however, shared by all the
+* copies and must be treated as read-only until MaterializePackets has been called.
 */
 class SatSignalParameters : public Object
 {
@@ -66,12 +71,23 @@ public:
   SatSignalParameters ();
 
   /**
-   * copy constructor
+   * copy constructor. The packets in burst are shared with the copy.
    */
   SatSignalParameters (const SatSignalParameters& p);
 
+  /**
+   * \brief Create a copy of the signal parameters sharing the packets in burst.
+   * \return The copy of the signal parameters
+   */
   Ptr<SatSignalParameters> Copy ();
 
+  /**
+   * \brief Replace the packets in burst shared with other copies of the signal
+   * parameters by private copies of the packets. This must be called before
+   * modifying the packets, e.g. before passing them to the upper layers.
+   */
+  void MaterializePackets ();
+
   /**
    * \brief Get the type ID
    * \return the object TypeId
@@ -173,6 +189,12 @@ public:
    * Callback for SINR calculation
    */
   Callback<double, double> m_sinrCalculate;
+
+private:
+  /**
+   * Flag telling whether the packets in burst are shared with other copies
+   */
+  bool m_packetsShared;
 };
 
 
@@ -95,13 +95,14 @@ public:
    * \brief Generate time slots in TBTP(s) for the UT/RC.
    *
    * \param tbtpContainer TBTP message container to add/fill TBTPs.
+   * \param tbtpPool Pool to take the new TBTPs from.
    * \param maxSizeInBytes Maximum size for a TBTP message.
    * \param utAllocContainer Reference to UT allocation container to fill in info of the allocation
    * \param waveformTrace Wave form trace callback
    * \param utLoadTrace UT load per the frame trace callback
    * \param loadTrace Load per the frame trace callback
    */
-  void GenerateTimeSlots (SatFrameAllocator::TbtpMsgContainer_t& tbtpContainer, uint32_t maxSizeInBytes, SatFrameAllocator::UtAllocInfoContainer_t& utAllocContainer,
+  void GenerateTimeSlots (SatFrameAllocator::TbtpMsgContainer_t& tbtpContainer, Ptr<SatTbtpMessagePool> tbtpPool, uint32_t maxSizeInBytes, SatFrameAllocator::UtAllocInfoContainer_t& utAllocContainer,
                           TracedCallback<uint32_t> waveformTrace, TracedCallback<uint32_t, uint32_t> utLoadTrace, TracedCallback<uint32_t, double> loadTrace);
 
 private:
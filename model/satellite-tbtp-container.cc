@@ -18,7 +18,6 @@
  * Author: Jani Puttonen <jani.puttonen@magister.fi>
  */
 
-#include <algorithm>
 #include <iostream>
 #include "ns3/mac48-address.h"
 #include "ns3/uinteger.h"
@@ -136,15 +135,14 @@ SatTbtpContainer::HasScheduledTimeSlots ()
     {
       RemovePastTbtps ();
 
-      SatTbtpMessage::DaTimeSlotInfoItem_t info;
       for (TbtpMap_t::const_reverse_iterator it = m_tbtps.rbegin ();
            it != m_tbtps.rend ();
            ++it)
         {
-          info = it->second->GetDaTimeslots (m_address);
+          const SatTbtpMessage::DaTimeSlotInfoItem_t& info = it->second->GetDaTimeslots (m_address);
 
           // This TBTP has time slots for this UT
-          if (!info.second.empty ())
+          if (info.count > 0)
             {
               Time superframeStartTime = it->first;
 
@@ -162,21 +160,29 @@ SatTbtpContainer::HasScheduledTimeSlots ()
                 {
                   /**
                    * The time slots are not necessarily in increasing order in the TBTP.
-                   * Sort the time slots into increasing order based on time.
+                   * Find the time slot starting last.
                    */
-                  std::sort (info.second.begin (), info.second.end (), SortTimeSlots ());
+                  uint32_t lastSlotIndex = info.first;
+
+                  for (uint32_t i = info.first + 1; i < info.first + info.count; ++i)
+                    {
+                      if (it->second->GetDaTimeslot (i).startTime >= it->second->GetDaTimeslot (lastSlotIndex).startTime)
+                        {
+                          lastSlotIndex = i;
+                        }
+                    }
 
                   // Start time offset for the last time slot for this UT
-                  Time startTimeOffsetForLastSlot = (*(info.second.rbegin ()))->GetStartTime ();
+                  Time startTimeOffsetForLastSlot = it->second->GetDaTimeslot (lastSlotIndex).startTime;
 
                   /**
                    * Calculate the duration of the last slot. To be able to do that we need the
                    * superframe conf, frame conf, time slot conf and symbol rate.
                    */
                   Ptr<SatSuperframeConf> superframeConf = m_superframeSeq->GetSuperframeConf (SatConstVariables::SUPERFRAME_SEQUENCE);
-                  uint8_t frameId = info.first;
+                  uint8_t frameId = info.frameId;
                   Ptr<SatFrameConf> frameConf = superframeConf->GetFrameConf (frameId);
-                  uint32_t wfId = (*(info.second.rbegin ()))->GetWaveFormId ();
+                  uint32_t wfId = it->second->GetDaTimeslot (lastSlotIndex).waveFormId;
                   Ptr<SatWaveform> wf = m_superframeSeq->GetWaveformConf ()->GetWaveform (wfId);
                   Time lastSlotDuration = wf->GetBurstDuration (frameConf->GetBtuConf ()->GetSymbolRateInBauds ());
 
@@ -36,6 +36,7 @@
 #include <ns3/address.h>
 #include <ns3/mac48-address.h>
 #include <ns3/satellite-scheduling-object.h>
+#include <ns3/satellite-packet-trace.h>
 
 
 NS_LOG_COMPONENT_DEFINE ("SatUtLlc");
@@ -105,9 +106,7 @@ SatUtLlc::Enque (Ptr<Packet> packet, Address dest, uint8_t flowId)
       destMacAddress = m_gwAddress;
     }
 
-  Ptr<EncapKey> key = Create<EncapKey> (m_nodeInfo->GetMacAddress (), destMacAddress, flowId);
-
-  EncapContainer_t::iterator it = m_encaps.find (key);
+  EncapContainer_t::iterator it = m_encaps.find (m_nodeInfo->GetMacAddress (), destMacAddress, flowId);
 
   if (it == m_encaps.end ())
     {
@@ -116,8 +115,8 @@ SatUtLlc::Enque (Ptr<Packet> packet, Address dest, uint8_t flowId)
        * implemented in the inherited classes, which knows which type
        * of encapsulator to create.
        */
-      CreateEncap (key);
-      it = m_encaps.find (key);
+      CreateEncap (Create<EncapKey> (m_nodeInfo->GetMacAddress (), destMacAddress, flowId));
+      it = m_encaps.find (m_nodeInfo->GetMacAddress (), destMacAddress, flowId);
     }
 
   it->second->EnquePdu (packet, Mac48Address::ConvertFrom (dest));
@@ -126,14 +125,18 @@ SatUtLlc::Enque (Ptr<Packet> packet, Address dest, uint8_t flowId)
     (m_nodeInfo->GetNodeType () == SatEnums::NT_UT) ? SatEnums::LD_RETURN : SatEnums::LD_FORWARD;
 
   // Add packet trace entry:
-  m_packetTrace (Simulator::Now (),
-                 SatEnums::PACKET_ENQUE,
-                 m_nodeInfo->GetNodeType (),
-                 m_nodeInfo->GetNodeId (),
-                 m_nodeInfo->GetMacAddress (),
-                 SatEnums::LL_LLC,
-                 ld,
-                 SatUtils::GetPacketInfo (packet));
+  if (!m_packetTrace.IsEmpty ()
+      && SatPacketTrace::IsTraced (SatEnums::PACKET_ENQUE, m_nodeInfo->GetNodeType (), ld))
+    {
+      m_packetTrace (Simulator::Now (),
+                     SatEnums::PACKET_ENQUE,
+                     m_nodeInfo->GetNodeType (),
+                     m_nodeInfo->GetNodeId (),
+                     m_nodeInfo->GetMacAddress (),
+                     SatEnums::LL_LLC,
+                     ld,
+                     SatUtils::GetPacketInfo (packet));
+    }
 
   return true;
 }
@@ -145,8 +148,7 @@ SatUtLlc::NotifyTxOpportunity (uint32_t bytes, Mac48Address utAddr, uint8_t rcIn
   NS_LOG_FUNCTION (this << utAddr << bytes << (uint32_t) rcIndex);
 
   Ptr<Packet> packet;
-  Ptr<EncapKey> key = Create<EncapKey> (utAddr, m_gwAddress, rcIndex);
-  EncapContainer_t::iterator it = m_encaps.find (key);
+  EncapContainer_t::iterator it = m_encaps.find (utAddr, m_gwAddress, rcIndex);
 
   if (it != m_encaps.end ())
     {
@@ -157,14 +159,18 @@ SatUtLlc::NotifyTxOpportunity (uint32_t bytes, Mac48Address utAddr, uint8_t rcIn
           SatEnums::SatLinkDir_t ld = SatEnums::LD_RETURN;
 
           // Add packet trace entry:
-          m_packetTrace (Simulator::Now (),
-                         SatEnums::PACKET_SENT,
-                         m_nodeInfo->GetNodeType (),
-                         m_nodeInfo->GetNodeId (),
-                         m_nodeInfo->GetMacAddress (),
-                         SatEnums::LL_LLC,
-                         ld,
-                         SatUtils::GetPacketInfo (packet));
+          if (!m_packetTrace.IsEmpty ()
+              && SatPacketTrace::IsTraced (SatEnums::PACKET_SENT, m_nodeInfo->GetNodeType (), ld))
+            {
+              m_packetTrace (Simulator::Now (),
+                             SatEnums::PACKET_SENT,
+                             m_nodeInfo->GetNodeType (),
+                             m_nodeInfo->GetNodeId (),
+                             m_nodeInfo->GetMacAddress (),
+                             SatEnums::LL_LLC,
+                             ld,
+                             SatUtils::GetPacketInfo (packet));
+            }
         }
     }
   /*
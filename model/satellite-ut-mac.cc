@@ -39,6 +39,7 @@
 #include <ns3/satellite-const-variables.h>
 #include <ns3/satellite-log.h>
 #include "satellite-ut-mac.h"
+#include "satellite-packet-trace.h"
 
 NS_LOG_COMPONENT_DEFINE ("SatUtMac");
 
@@ -112,6 +113,7 @@ SatUtMac::SatUtMac (Ptr<SatSuperframeSeq> seq, uint32_t beamId, bool crdsaOnlyFo
 
   m_uniformRandomVariable = CreateObject<UniformRandomVariable> ();
   m_tbtpContainer = CreateObject<SatTbtpContainer> (m_superframeSeq);
+  m_daTxOpportunities.SetTxCallback (MakeCallback (&SatUtMac::DoDaTxOpportunity, this));
 }
 
 SatUtMac::~SatUtMac ()
@@ -128,6 +130,7 @@ SatUtMac::DoDispose (void)
   NS_LOG_FUNCTION (this);
 
   m_timingAdvanceCb.Nullify ();
+  m_daTxOpportunities.Clear ();
   m_tbtpContainer->DoDispose ();
   m_utScheduler->DoDispose ();
   m_utScheduler = NULL;
@@ -260,42 +263,55 @@ SatUtMac::ScheduleTimeSlots (Ptr<SatTbtpMessage> tbtp)
   NS_LOG_INFO ("Time to start sending the superframe for this UT: " << txTime.GetSeconds ());
   NS_LOG_INFO ("Waiting delay before the superframe start: " << startDelay.GetSeconds ());
 
-  SatTbtpMessage::DaTimeSlotInfoItem_t info = tbtp->GetDaTimeslots (m_nodeInfo->GetMacAddress ());
+  const SatTbtpMessage::DaTimeSlotInfoItem_t& info = tbtp->GetDaTimeslots (m_nodeInfo->GetMacAddress ());
 
   // Counters for allocated TBTP resources
   uint32_t payloadSumInSuperFrame = 0;
   uint32_t payloadSumPerRcIndex [SatEnums::NUM_FIDS] = { };
 
-  if (!info.second.empty ())
+  if (info.count > 0)
     {
-      NS_LOG_INFO ("TBTP contains " << info.second.size () << " timeslots for UT: " << m_nodeInfo->GetMacAddress ());
+      NS_LOG_INFO ("TBTP contains " << info.count << " timeslots for UT: " << m_nodeInfo->GetMacAddress ());
 
-      uint8_t frameId = info.first;
+      // Configuration of the frame is the same for all the time slots of the UT
+      uint8_t frameId = info.frameId;
+      Ptr<SatSuperframeConf> superframeConf = m_superframeSeq->GetSuperframeConf (SatConstVariables::SUPERFRAME_SEQUENCE);
+      Ptr<SatFrameConf> frameConf = superframeConf->GetFrameConf (frameId);
+      Ptr<SatWaveformConf> waveformConf = m_superframeSeq->GetWaveformConf ();
+      double symbolRateInBauds = frameConf->GetBtuConf ()->GetSymbolRateInBauds ();
 
-      // schedule time slots
-      for ( SatTbtpMessage::DaTimeSlotConfContainer_t::iterator it = info.second.begin (); it != info.second.end (); it++ )
+      std::vector<SatDaTxOpportunityQueue::DaTxOpportunity_t> txOpportunities;
+      txOpportunities.reserve (info.count);
+
+      // collect time slots
+      for (uint32_t i = info.first; i < info.first + info.count; i++)
         {
-          Ptr<SatSuperframeConf> superframeConf = m_superframeSeq->GetSuperframeConf (SatConstVariables::SUPERFRAME_SEQUENCE);
-          Ptr<SatFrameConf> frameConf = superframeConf->GetFrameConf (frameId);
-          Ptr<SatTimeSlotConf> timeSlotConf = *it;
+          const SatTbtpMessage::DaTimeSlot_t& timeSlot = tbtp->GetDaTimeslot (i);
+
+          SatDaTxOpportunityQueue::DaTxOpportunity_t txOpportunity;
 
           // Start time
-          Time slotDelay = startDelay + timeSlotConf->GetStartTime ();
-          NS_LOG_INFO ("Slot start delay: " << slotDelay.GetSeconds ());
+          txOpportunity.txTime = txTime + timeSlot.startTime;
+          NS_LOG_INFO ("Slot start delay: " << (startDelay + timeSlot.startTime).GetSeconds ());
 
           // Duration
-          Ptr<SatWaveform> wf = m_superframeSeq->GetWaveformConf ()->GetWaveform (timeSlotConf->GetWaveFormId ());
-          Time duration = wf->GetBurstDuration (frameConf->GetBtuConf ()->GetSymbolRateInBauds ());
+          txOpportunity.waveform = waveformConf->GetWaveform (timeSlot.waveFormId);
+          txOpportunity.duration = txOpportunity.waveform->GetBurstDuration (symbolRateInBauds);
 
           // Carrier
-          uint32_t carrierId = m_superframeSeq->GetCarrierId (0, frameId, timeSlotConf->GetCarrierId () );
+          txOpportunity.carrierId = m_superframeSeq->GetCarrierId (0, frameId, timeSlot.carrierId );
+
+          txOpportunity.slotType = timeSlot.slotType;
+          txOpportunity.rcIndex = timeSlot.rcIndex;
 
-          // Schedule individual time slot
-          ScheduleDaTxOpportunity (slotDelay, duration, wf, timeSlotConf, carrierId);
+          txOpportunities.push_back (txOpportunity);
 
-          payloadSumInSuperFrame += wf->GetPayloadInBytes ();
-          payloadSumPerRcIndex [timeSlotConf->GetRcIndex ()] += wf->GetPayloadInBytes ();
+          payloadSumInSuperFrame += txOpportunity.waveform->GetPayloadInBytes ();
+          payloadSumPerRcIndex [timeSlot.rcIndex] += txOpportunity.waveform->GetPayloadInBytes ();
         }
+
+      // Schedule the time slots of the superframe at once
+      m_daTxOpportunities.Schedule (txOpportunities);
     }
 
   // Assigned TBTP resources
@@ -309,20 +325,19 @@ SatUtMac::ScheduleTimeSlots (Ptr<SatTbtpMessage> tbtp)
 }
 
 void
-SatUtMac::ScheduleDaTxOpportunity (Time transmitDelay, Time duration, Ptr<SatWaveform> wf, Ptr<SatTimeSlotConf> tsConf, uint32_t carrierId)
+SatUtMac::DoDaTxOpportunity (const SatDaTxOpportunityQueue::DaTxOpportunity_t& txOpportunity)
 {
-  NS_LOG_FUNCTION (this << transmitDelay.GetSeconds () << duration.GetSeconds () << wf->GetPayloadInBytes () << (uint32_t)(tsConf->GetRcIndex ()) << carrierId);
-  NS_LOG_INFO ("SatUtMac::ScheduleDaTxOpportunity - after delay: " << transmitDelay.GetSeconds () << " duration: " << duration.GetSeconds () << ", payload: " << wf->GetPayloadInBytes () << ", rcIndex: " << (uint32_t)(tsConf->GetRcIndex ()) << ", carrier: " << carrierId);
+  NS_LOG_FUNCTION (this << txOpportunity.txTime.GetSeconds ());
 
-  Simulator::Schedule (transmitDelay, &SatUtMac::DoTransmit, this, duration, carrierId, wf, tsConf, SatUtScheduler::LOOSE);
+  DoTransmit (txOpportunity.duration, txOpportunity.carrierId, txOpportunity.waveform, txOpportunity.slotType, txOpportunity.rcIndex, SatUtScheduler::LOOSE);
 }
 
 
 void
-SatUtMac::DoTransmit (Time duration, uint32_t carrierId, Ptr<SatWaveform> wf, Ptr<SatTimeSlotConf> tsConf, SatUtScheduler::SatCompliancePolicy_t policy)
+SatUtMac::DoTransmit (Time duration, uint32_t carrierId, Ptr<SatWaveform> wf, SatTimeSlotConf::SatTimeSlotType_t slotType, uint8_t rcIndex, SatUtScheduler::SatCompliancePolicy_t policy)
 {
-  NS_LOG_FUNCTION (this << duration.GetSeconds () << wf->GetPayloadInBytes () << carrierId << (uint32_t)(tsConf->GetRcIndex ()));
-  NS_LOG_INFO ("DA Tx opportunity for UT: " << m_nodeInfo->GetMacAddress () << " at time: " << Simulator::Now ().GetSeconds () << " duration: " << duration.GetSeconds () << ", payload: " << wf->GetPayloadInBytes () << ", carrier: " << carrierId << ", RC index: " << (uint32_t)(tsConf->GetRcIndex ()));
+  NS_LOG_FUNCTION (this << duration.GetSeconds () << wf->GetPayloadInBytes () << carrierId << (uint32_t)(rcIndex));
+  NS_LOG_INFO ("DA Tx opportunity for UT: " << m_nodeInfo->GetMacAddress () << " at time: " << Simulator::Now ().GetSeconds () << " duration: " << duration.GetSeconds () << ", payload: " << wf->GetPayloadInBytes () << ", carrier: " << carrierId << ", RC index: " << (uint32_t)(rcIndex));
 
   SatSignalParameters::txInfo_s txInfo;
   txInfo.packetType = SatEnums::PACKET_TYPE_DEDICATED_ACCESS;
@@ -331,7 +346,7 @@ SatUtMac::DoTransmit (Time duration, uint32_t carrierId, Ptr<SatWaveform> wf, Pt
   txInfo.frameType = SatEnums::UNDEFINED_FRAME;
   txInfo.waveformId = wf->GetWaveformId ();
 
-  TransmitPackets (FetchPackets (wf->GetPayloadInBytes (), tsConf->GetSlotType (), tsConf->GetRcIndex (), policy), duration, carrierId, txInfo);
+  TransmitPackets (FetchPackets (wf->GetPayloadInBytes (), slotType, rcIndex, policy), duration, carrierId, txInfo);
 }
 
 void
@@ -359,19 +374,23 @@ SatUtMac::DoSlottedAlohaTransmit (Time duration, Ptr<SatWaveform> waveform, uint
     {
       NS_LOG_INFO ("Number of packets sent in a slotted ALOHA slot: " << packets.size ());
 
-      for (SatPhy::PacketContainer_t::const_iterator it = packets.begin ();
-           it != packets.end ();
-           ++it)
+      // Add packet trace entries:
+      if (!m_packetTrace.IsEmpty ()
+          && SatPacketTrace::IsTraced (SatEnums::PACKET_SENT, m_nodeInfo->GetNodeType (), SatEnums::LD_RETURN))
         {
-          // Add packet trace entry:
-          m_packetTrace (Simulator::Now (),
-                         SatEnums::PACKET_SENT,
-                         m_nodeInfo->GetNodeType (),
-                         m_nodeInfo->GetNodeId (),
-                         m_nodeInfo->GetMacAddress (),
-                         SatEnums::LL_MAC,
-                         SatEnums::LD_RETURN,
-                         SatUtils::GetPacketInfo (*it));
+          for (SatPhy::PacketContainer_t::const_iterator it = packets.begin ();
+               it != packets.end ();
+               ++it)
+            {
+              m_packetTrace (Simulator::Now (),
+                             SatEnums::PACKET_SENT,
+                             m_nodeInfo->GetNodeType (),
+                             m_nodeInfo->GetNodeId (),
+                             m_nodeInfo->GetMacAddress (),
+                             SatEnums::LL_MAC,
+                             SatEnums::LD_RETURN,
+                             SatUtils::GetPacketInfo (*it));
+            }
         }
 
       SatSignalParameters::txInfo_s txInfo;
@@ -408,19 +427,23 @@ SatUtMac::FetchPackets (uint32_t payloadBytes, SatTimeSlotConf::SatTimeSlotType_
     {
       NS_LOG_INFO ("Number of packets: " << packets.size ());
 
-      for (SatPhy::PacketContainer_t::const_iterator it = packets.begin ();
-           it != packets.end ();
-           ++it)
+      // Add packet trace entries:
+      if (!m_packetTrace.IsEmpty ()
+          && SatPacketTrace::IsTraced (SatEnums::PACKET_SENT, m_nodeInfo->GetNodeType (), SatEnums::LD_RETURN))
         {
-          // Add packet trace entry:
-          m_packetTrace (Simulator::Now (),
-                         SatEnums::PACKET_SENT,
-                         m_nodeInfo->GetNodeType (),
-                         m_nodeInfo->GetNodeId (),
-                         m_nodeInfo->GetMacAddress (),
-                         SatEnums::LL_MAC,
-                         SatEnums::LD_RETURN,
-                         SatUtils::GetPacketInfo (*it));
+          for (SatPhy::PacketContainer_t::const_iterator it = packets.begin ();
+               it != packets.end ();
+               ++it)
+            {
+              m_packetTrace (Simulator::Now (),
+                             SatEnums::PACKET_SENT,
+                             m_nodeInfo->GetNodeType (),
+                             m_nodeInfo->GetNodeId (),
+                             m_nodeInfo->GetMacAddress (),
+                             SatEnums::LL_MAC,
+                             SatEnums::LD_RETURN,
+                             SatUtils::GetPacketInfo (*it));
+            }
         }
     }
 
@@ -478,14 +501,18 @@ SatUtMac::Receive (SatPhy::PacketContainer_t packets, Ptr<SatSignalParameters> /
   NS_LOG_FUNCTION (this << packets.size ());
 
   // Add packet trace entry:
-  m_packetTrace (Simulator::Now (),
-                 SatEnums::PACKET_RECV,
-                 m_nodeInfo->GetNodeType (),
-                 m_nodeInfo->GetNodeId (),
-                 m_nodeInfo->GetMacAddress (),
-                 SatEnums::LL_MAC,
-                 SatEnums::LD_FORWARD,
-                 SatUtils::GetPacketInfo (packets));
+  if (!m_packetTrace.IsEmpty ()
+      && SatPacketTrace::IsTraced (SatEnums::PACKET_RECV, m_nodeInfo->GetNodeType (), SatEnums::LD_FORWARD))
+    {
+      m_packetTrace (Simulator::Now (),
+                     SatEnums::PACKET_RECV,
+                     m_nodeInfo->GetNodeType (),
+                     m_nodeInfo->GetNodeId (),
+                     m_nodeInfo->GetMacAddress (),
+                     SatEnums::LL_MAC,
+                     SatEnums::LD_FORWARD,
+                     SatUtils::GetPacketInfo (packets));
+    }
 
   // Invoke the `Rx` and `RxDelay` trace sources.
   RxTraces (packets);
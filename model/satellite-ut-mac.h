@@ -33,6 +33,7 @@
 #include <ns3/satellite-signal-parameters.h>
 #include <ns3/satellite-random-access-container.h>
 #include <ns3/satellite-enums.h>
+#include <ns3/satellite-da-tx-opportunity-queue.h>
 #include <utility>
 
 namespace ns3 {
@@ -305,14 +306,10 @@ private:
   void ScheduleTimeSlots (Ptr<SatTbtpMessage> tbtp);
 
   /**
-   * Schdules one Tx opportunity, i.e. time slot.
-   * \param transmitDelay time when transmit possibility starts
-   * \param duration duration of the burst
-   * \param wf waveform
-   * \param tsConf Time slot conf
-   * \param carrierId Carrier id used for the transmission
+   * Transmit a DA Tx opportunity, i.e. time slot, at its transmission time.
+   * \param txOpportunity Tx opportunity
    */
-  void ScheduleDaTxOpportunity (Time transmitDelay, Time duration, Ptr<SatWaveform> wf, Ptr<SatTimeSlotConf> tsConf, uint32_t carrierId);
+  void DoDaTxOpportunity (const SatDaTxOpportunityQueue::DaTxOpportunity_t& txOpportunity);
 
   /**
    * Notify the upper layer about the Tx opportunity. If upper layer
@@ -321,10 +318,11 @@ private:
    * \param duration duration of the burst
    * \param carrierId Carrier id used for the transmission
    * \param wf waveform
-   * \param tsConf Time slot conf
+   * \param slotType Time slot type
+   * \param rcIndex RC index of the time slot
    * \param policy UT scheduler policy
    */
-  void DoTransmit (Time duration, uint32_t carrierId, Ptr<SatWaveform> wf, Ptr<SatTimeSlotConf> tsConf, SatUtScheduler::SatCompliancePolicy_t policy = SatUtScheduler::LOOSE);
+  void DoTransmit (Time duration, uint32_t carrierId, Ptr<SatWaveform> wf, SatTimeSlotConf::SatTimeSlotType_t slotType, uint8_t rcIndex, SatUtScheduler::SatCompliancePolicy_t policy = SatUtScheduler::LOOSE);
 
   /**
    * Notify the upper layer about the Slotted ALOHA Tx opportunity. If upper layer
@@ -402,6 +400,11 @@ private:
    */
   Ptr<SatTbtpContainer> m_tbtpContainer;
 
+  /**
+   * Pending DA Tx opportunities driven by a single event
+   */
+  SatDaTxOpportunityQueue m_daTxOpportunities;
+
   /**
    * \brief Uniform random variable distribution generator
    */
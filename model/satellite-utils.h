@@ -203,13 +203,7 @@ public:
   static inline std::string GetPacketInfo (const Ptr<const Packet> p)
   {
     std::ostringstream oss;
-    oss << p->GetUid () << " ";
-    SatMacTag tag;
-    if (p->PeekPacketTag (tag))
-      {
-        oss << tag.GetSourceAddress () << " ";
-        oss << tag.GetDestAddress () << " ";
-      }
+    AddPacketInfo (oss, p);
     return oss.str ();
   }
 
@@ -219,18 +213,35 @@ public:
    * \param packets A vector of packets
    * \return Packet information in std::string
    */
-  static inline std::string GetPacketInfo (const std::vector< Ptr<Packet> > packets)
+  static inline std::string GetPacketInfo (const std::vector< Ptr<Packet> >& packets)
   {
     std::ostringstream oss;
     for (std::vector< Ptr<Packet> >::const_iterator it = packets.begin ();
          it != packets.end ();
          ++it)
       {
-        oss << GetPacketInfo (*it);
+        AddPacketInfo (oss, *it);
       }
     return oss.str ();
   }
 
+  /**
+   * \brief Add packet information to a stream for printing purposes
+   *
+   * \param os Output stream
+   * \param p Packet
+   */
+  static inline void AddPacketInfo (std::ostream& os, const Ptr<const Packet> p)
+  {
+    os << p->GetUid () << " ";
+    SatMacTag tag;
+    if (p->PeekPacketTag (tag))
+      {
+        os << tag.GetSourceAddress () << " ";
+        os << tag.GetDestAddress () << " ";
+      }
+  }
+
   /**
    * \brief Get the modulated bits of a certain MODCOD
    *
@@ -309,6 +309,9 @@ void SatWaveformConf::InitializeEbNoRequirements ( Ptr<SatLinkResultsDvbRcs2> li
       double ebnoRequirementDb = linkResults->GetEbNoDb (it->first, m_targetBLER);
       it->second->SetEbNoRequirement (SatUtils::DbToLinear (ebnoRequirementDb));
     }
+
+  // The thresholds have changed, thus the tables are built again when needed
+  m_acmTables.clear ();
 }
 
 Ptr<SatWaveform>
@@ -352,27 +355,40 @@ SatWaveformConf::GetBestWaveformId (double cno, double symbolRateInBaud, uint32_
       return success;
     }
 
-  // Return the waveform with best spectral efficiency
-  for ( std::map< uint32_t, Ptr<SatWaveform> >::const_reverse_iterator rit = m_waveforms.rbegin ();
-        rit != m_waveforms.rend ();
-        ++rit )
+  // Return the waveform with best spectral efficiency, whose threshold is met
+  success = GetAcmTable (burstLength, symbolRateInBaud).GetBestId (cno, wfId);
+
+  NS_LOG_INFO ("Get best waveform in RTN link (ACM)! CNo: " << SatUtils::LinearToDb(cno) << ", Symbol rate: " << symbolRateInBaud << ", burst length: " << burstLength << ", WF: " << wfId);
+
+  return success;
+}
+
+const SatAcmThresholdTable&
+SatWaveformConf::GetAcmTable (uint32_t burstLength, double symbolRateInBaud) const
+{
+  NS_LOG_FUNCTION (this << burstLength << symbolRateInBaud);
+
+  std::pair<uint32_t, double> key = std::make_pair (burstLength, symbolRateInBaud);
+  std::map< std::pair<uint32_t, double>, SatAcmThresholdTable >::iterator it = m_acmTables.find (key);
+
+  if (it == m_acmTables.end ())
     {
-      if (rit->second->GetBurstLengthInSymbols () == burstLength)
+      it = m_acmTables.insert (std::make_pair (key, SatAcmThresholdTable ())).first;
+
+      for ( std::map< uint32_t, Ptr<SatWaveform> >::const_iterator wit = m_waveforms.begin ();
+            wit != m_waveforms.end ();
+            ++wit )
         {
-          double cnoThr = rit->second->GetCNoThreshold (symbolRateInBaud);
-          // The first waveform over the threshold
-          if (cnoThr <= cno)
+          if (wit->second->GetBurstLengthInSymbols () == burstLength)
             {
-              wfId = rit->first;
-              success = true;
-              break;
+              it->second.Add (wit->second->GetCNoThreshold (symbolRateInBaud), wit->first);
             }
         }
-    }
 
-  NS_LOG_INFO ("Get best waveform in RTN link (ACM)! CNo: " << SatUtils::LinearToDb(cno) << ", Symbol rate: " << symbolRateInBaud << ", burst length: " << burstLength << ", WF: " << wfId);
+      it->second.Build ();
+    }
 
-  return success;
+  return it->second;
 }
 
 bool
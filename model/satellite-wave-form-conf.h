@@ -22,11 +22,13 @@
 #define SATELLITE_WAVE_FORM_CONF_H
 
 #include <vector>
+#include <map>
 #include <ns3/nstime.h>
 #include <ns3/ptr.h>
 #include <ns3/simple-ref-count.h>
 #include <ns3/object.h>
 #include <ns3/satellite-enums.h>
+#include <ns3/satellite-acm-threshold-table.h>
 
 namespace ns3 {
 
@@ -331,11 +333,25 @@ private:
    */
   SatEnums::SatModcod_t ConvertToModCod (uint32_t modulatedBits, uint32_t codingRateNumerator, uint32_t codingRateDenominator) const;
 
+  /**
+   * \brief Get the ACM threshold table of the waveforms with a certain burst
+   * length and symbol rate. The table is built when it is requested first time.
+   * \param burstLength Burst length in symbols
+   * \param symbolRateInBaud Symbol rate used for waveform C/No requirement calculation
+   * \return ACM threshold table of the waveform ids
+   */
+  const SatAcmThresholdTable& GetAcmTable (uint32_t burstLength, double symbolRateInBaud) const;
+
   /**
    * Container of the waveforms
    */
   std::map< uint32_t, Ptr<SatWaveform> > m_waveforms;
 
+  /**
+   * ACM threshold tables of the waveform ids by burst length and symbol rate
+   */
+  mutable std::map< std::pair<uint32_t, double>, SatAcmThresholdTable > m_acmTables;
+
   /**
    * Block error rate target for the waveforms. Default value
    * set as an attribute to 10^(-5).
@@ -23,7 +23,6 @@
 #include <ns3/enum.h>
 #include <ns3/string.h>
 #include <ns3/boolean.h>
-#include <ns3/object-vector.h>
 #include <ns3/callback.h>
 
 #include <ns3/node-container.h>
@@ -316,17 +315,16 @@ SatStatsFwdCompositeSinrHelper::DoInstallProbes ()
       NS_ASSERT (satPhy != 0);
       Ptr<SatPhyRx> satPhyRx = satPhy->GetPhyRx ();
       NS_ASSERT (satPhyRx != 0);
-      ObjectVectorValue carriers;
-      satPhyRx->GetAttribute ("RxCarrierList", carriers);
+      const SatPhyRx::RxCarrierList_t& carriers = satPhyRx->GetRxCarrierList ();
       NS_LOG_DEBUG (this << " Node ID " << (*it)->GetId ()
                          << " device #" << dev->GetIfIndex ()
-                         << " has " << carriers.GetN () << " RX carriers");
+                         << " has " << carriers.size () << " RX carriers");
 
-      for (ObjectVectorValue::Iterator itCarrier = carriers.Begin ();
-           itCarrier != carriers.End (); ++itCarrier)
+      for (SatPhyRx::RxCarrierList_t::const_iterator itCarrier = carriers.begin ();
+           itCarrier != carriers.end (); ++itCarrier)
         {
           // Connect the object to the probe.
-          if (probe->ConnectByObject ("Sinr", itCarrier->second))
+          if (probe->ConnectByObject ("Sinr", *itCarrier))
             {
               // Connect the probe to the right collector.
               bool ret = false;
@@ -378,17 +376,17 @@ SatStatsFwdCompositeSinrHelper::DoInstallProbes ()
                                     << " to collector " << identifier);
                 }
 
-            } // end of `if (probe->ConnectByObject ("Sinr", itCarrier->second))`
+            } // end of `if (probe->ConnectByObject ("Sinr", *itCarrier))`
           else
             {
               NS_FATAL_ERROR ("Error connecting to Sinr trace source"
                               << " of SatPhyRxCarrier"
                               << " at node ID " << (*it)->GetId ()
                               << " device #" << dev->GetIfIndex ()
-                              << " RX carrier #" << itCarrier->first);
+                              << " RX carrier #" << (itCarrier - carriers.begin ()));
             }
 
-        } // end of `for (ObjectVectorValue::Iterator itCarrier = carriers)`
+        } // end of `for (SatPhyRx::RxCarrierList_t::const_iterator itCarrier = carriers)`
 
     } // end of `for (it = uts.Begin(); it != uts.End (); ++it)`
 
@@ -453,22 +451,21 @@ SatStatsRtnCompositeSinrHelper::DoInstallProbes ()
           NS_ASSERT (satPhy != 0);
           Ptr<SatPhyRx> satPhyRx = satPhy->GetPhyRx ();
           NS_ASSERT (satPhyRx != 0);
-          ObjectVectorValue carriers;
-          satPhyRx->GetAttribute ("RxCarrierList", carriers);
+          const SatPhyRx::RxCarrierList_t& carriers = satPhyRx->GetRxCarrierList ();
           NS_LOG_DEBUG (this << " Node ID " << (*it)->GetId ()
                              << " device #" << (*itDev)->GetIfIndex ()
-                             << " has " << carriers.GetN () << " RX carriers");
+                             << " has " << carriers.size () << " RX carriers");
 
-          for (ObjectVectorValue::Iterator itCarrier = carriers.Begin ();
-               itCarrier != carriers.End (); ++itCarrier)
+          for (SatPhyRx::RxCarrierList_t::const_iterator itCarrier = carriers.begin ();
+               itCarrier != carriers.end (); ++itCarrier)
             {
-              if (itCarrier->second->TraceConnectWithoutContext ("Sinr",
-                                                                 callback))
+              if ((*itCarrier)->TraceConnectWithoutContext ("Sinr",
+                                                            callback))
                 {
                   NS_LOG_INFO (this << " successfully connected with node ID "
                                     << (*it)->GetId ()
                                     << " device #" << (*itDev)->GetIfIndex ()
-                                    << " RX carrier #" << itCarrier->first);
+                                    << " RX carrier #" << (itCarrier - carriers.begin ()));
                 }
               else
                 {
@@ -476,10 +473,10 @@ SatStatsRtnCompositeSinrHelper::DoInstallProbes ()
                                   << " of SatPhyRxCarrier"
                                   << " at node ID " << (*it)->GetId ()
                                   << " device #" << (*itDev)->GetIfIndex ()
-                                  << " RX carrier #" << itCarrier->first);
+                                  << " RX carrier #" << (itCarrier - carriers.begin ()));
                 }
 
-            } // end of `for (ObjectVectorValue::Iterator itCarrier = carriers)`
+            } // end of `for (SatPhyRx::RxCarrierList_t::const_iterator itCarrier = carriers)`
 
         } // end of `for (NetDeviceContainer::Iterator itDev = devs)`
 
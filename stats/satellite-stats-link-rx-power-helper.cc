@@ -23,8 +23,6 @@
 #include <ns3/enum.h>
 #include <ns3/string.h>
 #include <ns3/boolean.h>
-#include <ns3/object-map.h>
-#include <ns3/object-vector.h>
 
 #include <ns3/node.h>
 #include <ns3/satellite-geo-net-device.h>
@@ -349,42 +347,40 @@ SatStatsFwdFeederLinkRxPowerHelper::DoInstallProbes ()
   Ptr<NetDevice> dev = geoSat->GetDevice (0);
   Ptr<SatGeoNetDevice> satGeoDev = dev->GetObject<SatGeoNetDevice> ();
   NS_ASSERT (satGeoDev != 0);
-  ObjectMapValue phy;
-  satGeoDev->GetAttribute ("FeederPhy", phy);
+  const std::map<uint32_t, Ptr<SatPhy> >& phy = satGeoDev->GetFeederPhy ();
   NS_LOG_DEBUG (this << " GeoSat Node ID " << geoSat->GetId ()
                      << " device #" << dev->GetIfIndex ()
-                     << " has " << phy.GetN () << " PHY instance(s)");
+                     << " has " << phy.size () << " PHY instance(s)");
 
-  for (ObjectMapValue::Iterator itPhy = phy.Begin ();
-       itPhy != phy.End (); ++itPhy)
+  for (std::map<uint32_t, Ptr<SatPhy> >::const_iterator itPhy = phy.begin ();
+       itPhy != phy.end (); ++itPhy)
     {
-      Ptr<SatPhy> satPhy = itPhy->second->GetObject<SatPhy> ();
+      Ptr<SatPhy> satPhy = itPhy->second;
       NS_ASSERT (satPhy != 0);
       Ptr<SatPhyRx> satPhyRx = satPhy->GetPhyRx ();
       NS_ASSERT (satPhyRx != 0);
-      ObjectVectorValue carriers;
-      satPhyRx->GetAttribute ("RxCarrierList", carriers);
+      const SatPhyRx::RxCarrierList_t& carriers = satPhyRx->GetRxCarrierList ();
       NS_LOG_DEBUG (this << " PHY #" << itPhy->first
-                         << " has " << carriers.GetN () << " RX carrier(s)");
+                         << " has " << carriers.size () << " RX carrier(s)");
 
-      for (ObjectVectorValue::Iterator itCarrier = carriers.Begin ();
-           itCarrier != carriers.End (); ++itCarrier)
+      for (SatPhyRx::RxCarrierList_t::const_iterator itCarrier = carriers.begin ();
+           itCarrier != carriers.end (); ++itCarrier)
         {
-          //NS_ASSERT (itCarrier->second->m_channelType == SatEnums::FORWARD_FEEDER_CH)
-          if (!itCarrier->second->TraceConnectWithoutContext ("RxPowerTrace",
-                                                              GetTraceSinkCallback ()))
+          //NS_ASSERT ((*itCarrier)->m_channelType == SatEnums::FORWARD_FEEDER_CH)
+          if (!(*itCarrier)->TraceConnectWithoutContext ("RxPowerTrace",
+                                                         GetTraceSinkCallback ()))
             {
               NS_FATAL_ERROR ("Error connecting to RxPowerTrace trace source"
                               << " of SatPhyRxCarrier"
                               << " at GeoSat node ID " << geoSat->GetId ()
                               << " device #" << dev->GetIfIndex ()
                               << " PHY #" << itPhy->first
-                              << " RX carrier #" << itCarrier->first);
+                              << " RX carrier #" << (itCarrier - carriers.begin ()));
             }
 
-        } // end of `for (ObjectVectorValue::Iterator itCarrier = carriers)`
+        } // end of `for (SatPhyRx::RxCarrierList_t::const_iterator itCarrier = carriers)`
 
-    } // end of `for (ObjectMapValue::Iterator itPhy = phys)`
+    } // end of `for (std::map<uint32_t, Ptr<SatPhy> >::const_iterator itPhy = phy)`
 
 } // end of `void DoInstallProbes ();`
 
@@ -435,27 +431,26 @@ SatStatsFwdUserLinkRxPowerHelper::DoInstallProbes ()
       NS_ASSERT (satPhy != 0);
       Ptr<SatPhyRx> satPhyRx = satPhy->GetPhyRx ();
       NS_ASSERT (satPhyRx != 0);
-      ObjectVectorValue carriers;
-      satPhyRx->GetAttribute ("RxCarrierList", carriers);
+      const SatPhyRx::RxCarrierList_t& carriers = satPhyRx->GetRxCarrierList ();
       NS_LOG_DEBUG (this << " Node ID " << (*it)->GetId ()
                          << " device #" << dev->GetIfIndex ()
-                         << " has " << carriers.GetN () << " RX carriers");
+                         << " has " << carriers.size () << " RX carriers");
 
-      for (ObjectVectorValue::Iterator itCarrier = carriers.Begin ();
-           itCarrier != carriers.End (); ++itCarrier)
+      for (SatPhyRx::RxCarrierList_t::const_iterator itCarrier = carriers.begin ();
+           itCarrier != carriers.end (); ++itCarrier)
         {
-          //NS_ASSERT (itCarrier->second->m_channelType == SatEnums::FORWARD_USER_CH)
-          if (!itCarrier->second->TraceConnectWithoutContext ("RxPowerTrace",
-                                                              GetTraceSinkCallback ()))
+          //NS_ASSERT ((*itCarrier)->m_channelType == SatEnums::FORWARD_USER_CH)
+          if (!(*itCarrier)->TraceConnectWithoutContext ("RxPowerTrace",
+                                                         GetTraceSinkCallback ()))
             {
               NS_FATAL_ERROR ("Error connecting to RxPowerTrace trace source"
                               << " of SatPhyRxCarrier"
                               << " at node ID " << (*it)->GetId ()
                               << " device #" << dev->GetIfIndex ()
-                              << " RX carrier #" << itCarrier->first);
+                              << " RX carrier #" << (itCarrier - carriers.begin ()));
             }
 
-        } // end of `for (ObjectVectorValue::Iterator itCarrier = carriers)`
+        } // end of `for (SatPhyRx::RxCarrierList_t::const_iterator itCarrier = carriers)`
 
     } // end of `for (it = uts.Begin(); it != uts.End (); ++it)`
 
@@ -508,27 +503,26 @@ SatStatsRtnFeederLinkRxPowerHelper::DoInstallProbes ()
           NS_ASSERT (satPhy != 0);
           Ptr<SatPhyRx> satPhyRx = satPhy->GetPhyRx ();
           NS_ASSERT (satPhyRx != 0);
-          ObjectVectorValue carriers;
-          satPhyRx->GetAttribute ("RxCarrierList", carriers);
+          const SatPhyRx::RxCarrierList_t& carriers = satPhyRx->GetRxCarrierList ();
           NS_LOG_DEBUG (this << " Node ID " << (*it)->GetId ()
                              << " device #" << (*itDev)->GetIfIndex ()
-                             << " has " << carriers.GetN () << " RX carriers");
+                             << " has " << carriers.size () << " RX carriers");
 
-          for (ObjectVectorValue::Iterator itCarrier = carriers.Begin ();
-               itCarrier != carriers.End (); ++itCarrier)
+          for (SatPhyRx::RxCarrierList_t::const_iterator itCarrier = carriers.begin ();
+               itCarrier != carriers.end (); ++itCarrier)
             {
-              //NS_ASSERT (itCarrier->second->m_channelType == SatEnums::RETURN_FEEDER_CH)
-              if (!itCarrier->second->TraceConnectWithoutContext ("RxPowerTrace",
-                                                                  GetTraceSinkCallback ()))
+              //NS_ASSERT ((*itCarrier)->m_channelType == SatEnums::RETURN_FEEDER_CH)
+              if (!(*itCarrier)->TraceConnectWithoutContext ("RxPowerTrace",
+                                                             GetTraceSinkCallback ()))
                 {
                   NS_FATAL_ERROR ("Error connecting to RxPowerTrace trace source"
                                   << " of SatPhyRxCarrier"
                                   << " at node ID " << (*it)->GetId ()
                                   << " device #" << (*itDev)->GetIfIndex ()
-                                  << " RX carrier #" << itCarrier->first);
+                                  << " RX carrier #" << (itCarrier - carriers.begin ()));
                 }
 
-            } // end of `for (ObjectVectorValue::Iterator itCarrier = carriers)`
+            } // end of `for (SatPhyRx::RxCarrierList_t::const_iterator itCarrier = carriers)`
 
         } // end of `for (it = gws.Begin(); it != gws.End (); ++it)`
 
@@ -574,42 +568,40 @@ SatStatsRtnUserLinkRxPowerHelper::DoInstallProbes ()
   Ptr<NetDevice> dev = geoSat->GetDevice (0);
   Ptr<SatGeoNetDevice> satGeoDev = dev->GetObject<SatGeoNetDevice> ();
   NS_ASSERT (satGeoDev != 0);
-  ObjectMapValue phy;
-  satGeoDev->GetAttribute ("UserPhy", phy);
+  const std::map<uint32_t, Ptr<SatPhy> >& phy = satGeoDev->GetUserPhy ();
   NS_LOG_DEBUG (this << " GeoSat Node ID " << geoSat->GetId ()
                      << " device #" << dev->GetIfIndex ()
-                     << " has " << phy.GetN () << " PHY instance(s)");
+                     << " has " << phy.size () << " PHY instance(s)");
 
-  for (ObjectMapValue::Iterator itPhy = phy.Begin ();
-       itPhy != phy.End (); ++itPhy)
+  for (std::map<uint32_t, Ptr<SatPhy> >::const_iterator itPhy = phy.begin ();
+       itPhy != phy.end (); ++itPhy)
     {
-      Ptr<SatPhy> satPhy = itPhy->second->GetObject<SatPhy> ();
+      Ptr<SatPhy> satPhy = itPhy->second;
       NS_ASSERT (satPhy != 0);
       Ptr<SatPhyRx> satPhyRx = satPhy->GetPhyRx ();
       NS_ASSERT (satPhyRx != 0);
-      ObjectVectorValue carriers;
-      satPhyRx->GetAttribute ("RxCarrierList", carriers);
+      const SatPhyRx::RxCarrierList_t& carriers = satPhyRx->GetRxCarrierList ();
       NS_LOG_DEBUG (this << " PHY #" << itPhy->first
-                         << " has " << carriers.GetN () << " RX carrier(s)");
+                         << " has " << carriers.size () << " RX carrier(s)");
 
-      for (ObjectVectorValue::Iterator itCarrier = carriers.Begin ();
-           itCarrier != carriers.End (); ++itCarrier)
+      for (SatPhyRx::RxCarrierList_t::const_iterator itCarrier = carriers.begin ();
+           itCarrier != carriers.end (); ++itCarrier)
         {
-          //NS_ASSERT (itCarrier->second->m_channelType == SatEnums::RETURN_USER_CH)
-          if (!itCarrier->second->TraceConnectWithoutContext ("RxPowerTrace",
-                                                              GetTraceSinkCallback ()))
+          //NS_ASSERT ((*itCarrier)->m_channelType == SatEnums::RETURN_USER_CH)
+          if (!(*itCarrier)->TraceConnectWithoutContext ("RxPowerTrace",
+                                                         GetTraceSinkCallback ()))
             {
               NS_FATAL_ERROR ("Error connecting to RxPowerTrace trace source"
                               << " of SatPhyRxCarrier"
                               << " at GeoSat node ID " << geoSat->GetId ()
                               << " device #" << dev->GetIfIndex ()
                               << " PHY #" << itPhy->first
-                              << " RX carrier #" << itCarrier->first);
+                              << " RX carrier #" << (itCarrier - carriers.begin ()));
             }
 
-        } // end of `for (ObjectVectorValue::Iterator itCarrier = carriers)`
+        } // end of `for (SatPhyRx::RxCarrierList_t::const_iterator itCarrier = carriers)`
 
-    } // end of `for (ObjectMapValue::Iterator itPhy = phys)`
+    } // end of `for (std::map<uint32_t, Ptr<SatPhy> >::const_iterator itPhy = phy)`
 
 } // end of `void DoInstallProbes ();`
 
@@ -23,7 +23,6 @@
 #include <ns3/enum.h>
 #include <ns3/string.h>
 #include <ns3/boolean.h>
-#include <ns3/object-vector.h>
 #include <ns3/callback.h>
 
 #include <ns3/node-container.h>
@@ -232,26 +231,25 @@ SatStatsPacketCollisionHelper::DoInstall ()
           NS_ASSERT (satPhy != 0);
           Ptr<SatPhyRx> satPhyRx = satPhy->GetPhyRx ();
           NS_ASSERT (satPhyRx != 0);
-          ObjectVectorValue carriers;
-          satPhyRx->GetAttribute ("RxCarrierList", carriers);
+          const SatPhyRx::RxCarrierList_t& carriers = satPhyRx->GetRxCarrierList ();
           NS_LOG_DEBUG (this << " Node ID " << (*it)->GetId ()
                              << " device #" << (*itDev)->GetIfIndex ()
-                             << " has " << carriers.GetN () << " RX carriers");
+                             << " has " << carriers.size () << " RX carriers");
 
-          for (ObjectVectorValue::Iterator itCarrier = carriers.Begin ();
-               itCarrier != carriers.End (); ++itCarrier)
+          for (SatPhyRx::RxCarrierList_t::const_iterator itCarrier = carriers.begin ();
+               itCarrier != carriers.end (); ++itCarrier)
             {
-          		SatPhyRxCarrier::CarrierType ct = DynamicCast<SatPhyRxCarrier> (itCarrier->second)->GetCarrierType ();
+          		SatPhyRxCarrier::CarrierType ct = (*itCarrier)->GetCarrierType ();
           		if (ct != GetValidCarrierType ()) continue;
 
-              const bool ret = itCarrier->second->TraceConnectWithoutContext (
+              const bool ret = (*itCarrier)->TraceConnectWithoutContext (
                   GetTraceSourceName (), callback);
               if (ret)
                 {
                   NS_LOG_INFO (this << " successfully connected with node ID "
                                     << (*it)->GetId ()
                                     << " device #" << (*itDev)->GetIfIndex ()
-                                    << " RX carrier #" << itCarrier->first);
+                                    << " RX carrier #" << (itCarrier - carriers.begin ()));
                 }
               else
                 {
@@ -260,10 +258,10 @@ SatStatsPacketCollisionHelper::DoInstall ()
                                   << " of SatPhyRxCarrier"
                                   << " at node ID " << (*it)->GetId ()
                                   << " device #" << (*itDev)->GetIfIndex ()
-                                  << " RX carrier #" << itCarrier->first);
+                                  << " RX carrier #" << (itCarrier - carriers.begin ()));
                 }
 
-            } // end of `for (ObjectVectorValue::Iterator itCarrier = carriers)`
+            } // end of `for (SatPhyRx::RxCarrierList_t::const_iterator itCarrier = carriers)`
 
         } // end of `for (NetDeviceContainer::Iterator itDev = devs)`
 
@@ -23,7 +23,6 @@
 #include <ns3/enum.h>
 #include <ns3/string.h>
 #include <ns3/boolean.h>
-#include <ns3/object-vector.h>
 #include <ns3/callback.h>
 
 #include <ns3/node-container.h>
@@ -370,25 +369,24 @@ SatStatsPacketErrorHelper::InstallProbeOnGw (Ptr<Node> gwNode)
       NS_ASSERT (satPhy != 0);
       Ptr<SatPhyRx> satPhyRx = satPhy->GetPhyRx ();
       NS_ASSERT (satPhyRx != 0);
-      ObjectVectorValue carriers;
-      satPhyRx->GetAttribute ("RxCarrierList", carriers);
+      const SatPhyRx::RxCarrierList_t& carriers = satPhyRx->GetRxCarrierList ();
       NS_LOG_DEBUG (this << " Node ID " << gwNode->GetId ()
                          << " device #" << (*itDev)->GetIfIndex ()
-                         << " has " << carriers.GetN () << " RX carriers");
+                         << " has " << carriers.size () << " RX carriers");
 
-      for (ObjectVectorValue::Iterator itCarrier = carriers.Begin ();
-           itCarrier != carriers.End (); ++itCarrier)
+      for (SatPhyRx::RxCarrierList_t::const_iterator itCarrier = carriers.begin ();
+           itCarrier != carriers.end (); ++itCarrier)
         {
-					if (DynamicCast<SatPhyRxCarrier> (itCarrier->second)->GetCarrierType () != GetValidCarrierType ())
+					if ((*itCarrier)->GetCarrierType () != GetValidCarrierType ())
 						continue;
-          const bool ret = itCarrier->second->TraceConnectWithoutContext (
+          const bool ret = (*itCarrier)->TraceConnectWithoutContext (
               GetTraceSourceName (), callback);
           if (ret)
             {
               NS_LOG_INFO (this << " successfully connected with node ID "
                                 << gwNode->GetId ()
                                 << " device #" << (*itDev)->GetIfIndex ()
-                                << " RX carrier #" << itCarrier->first);
+                                << " RX carrier #" << (itCarrier - carriers.begin ()));
             }
           else
             {
@@ -397,10 +395,10 @@ SatStatsPacketErrorHelper::InstallProbeOnGw (Ptr<Node> gwNode)
                               << " of SatPhyRxCarrier"
                               << " at node ID " << gwNode->GetId ()
                               << " device #" << (*itDev)->GetIfIndex ()
-                              << " RX carrier #" << itCarrier->first);
+                              << " RX carrier #" << (itCarrier - carriers.begin ()));
             }
 
-        } // end of `for (ObjectVectorValue::Iterator itCarrier = carriers)`
+        } // end of `for (SatPhyRx::RxCarrierList_t::const_iterator itCarrier = carriers)`
 
     } // end of `for (NetDeviceContainer::Iterator itDev = devs)`
 
@@ -430,19 +428,18 @@ SatStatsPacketErrorHelper::InstallProbeOnUt (Ptr<Node> utNode)
   NS_ASSERT (satPhy != 0);
   Ptr<SatPhyRx> satPhyRx = satPhy->GetPhyRx ();
   NS_ASSERT (satPhyRx != 0);
-  ObjectVectorValue carriers;
-  satPhyRx->GetAttribute ("RxCarrierList", carriers);
+  const SatPhyRx::RxCarrierList_t& carriers = satPhyRx->GetRxCarrierList ();
   NS_LOG_DEBUG (this << " Node ID " << utNode->GetId ()
                      << " device #" << dev->GetIfIndex ()
-                     << " has " << carriers.GetN () << " RX carriers");
+                     << " has " << carriers.size () << " RX carriers");
 
-  for (ObjectVectorValue::Iterator itCarrier = carriers.Begin ();
-       itCarrier != carriers.End (); ++itCarrier)
+  for (SatPhyRx::RxCarrierList_t::const_iterator itCarrier = carriers.begin ();
+       itCarrier != carriers.end (); ++itCarrier)
     {
-  		if (DynamicCast<SatPhyRxCarrier> (itCarrier->second)->GetCarrierType () != GetValidCarrierType ())
+  		if ((*itCarrier)->GetCarrierType () != GetValidCarrierType ())
   			continue;
       // Connect the object to the probe.
-      if (probe->ConnectByObject (GetTraceSourceName (), itCarrier->second))
+      if (probe->ConnectByObject (GetTraceSourceName (), *itCarrier))
         {
           // Connect the probe to the right collector.
           bool ret = false;
@@ -482,7 +479,7 @@ SatStatsPacketErrorHelper::InstallProbeOnUt (Ptr<Node> utNode)
                                 << " to collector " << identifier);
             }
 
-        } // end of `if (probe->ConnectByObject (GetTraceSourceName (), itCarrier->second))`
+        } // end of `if (probe->ConnectByObject (GetTraceSourceName (), *itCarrier))`
       else
         {
           NS_FATAL_ERROR ("Error connecting to "
@@ -490,10 +487,10 @@ SatStatsPacketErrorHelper::InstallProbeOnUt (Ptr<Node> utNode)
                           << " of SatPhyRxCarrier"
                           << " at node ID " << utNode->GetId ()
                           << " device #" << dev->GetIfIndex ()
-                          << " RX carrier #" << itCarrier->first);
+                          << " RX carrier #" << (itCarrier - carriers.begin ()));
         }
 
-    } // end of `for (ObjectVectorValue::Iterator itCarrier = carriers)`
+    } // end of `for (SatPhyRx::RxCarrierList_t::const_iterator itCarrier = carriers)`
 
 } // end of `void InstallProbeOnUt (Ptr<Node>)`
 
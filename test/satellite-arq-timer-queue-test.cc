@@ -0,0 +1,454 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2016 Magister Solutions Ltd
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: agent <agent@local>
+ */
+
+/**
+ * \file satellite-arq-timer-queue-test.cc
+ * \ingroup satellite
+ * \brief Test cases to unit test the ARQ timer queue.
+ */
+
+#include <vector>
+#include <map>
+#include "ns3/log.h"
+#include "ns3/test.h"
+#include "ns3/simulator.h"
+#include "../model/satellite-arq-timer-queue.h"
+
+using namespace ns3;
+
+/**
+ * \ingroup satellite
+ * \brief Base test case of the ARQ timer queue, recording the expired timers.
+ */
+class SatArqTimerQueueBaseTestCase : public TestCase
+{
+public:
+  SatArqTimerQueueBaseTestCase (std::string info) : TestCase (info)
+  {
+  }
+  virtual ~SatArqTimerQueueBaseTestCase ()
+  {
+  }
+
+  // start a timer of the queue
+  void StartTimer (Time delay, uint32_t seqNo);
+
+  // record an expired timer, set as the expiry callback of the queue
+  virtual void TimerExpired (uint32_t seqNo);
+
+protected:
+  virtual void DoRun (void) = 0;
+
+  // set the expiry callback and clear the records
+  void Init ();
+
+  SatArqTimerQueue m_queue;
+  std::map<uint32_t, uint64_t> m_timerIds; // timer ids by sequence number
+  std::vector<uint32_t> m_expiredSeqNos;
+  std::vector<Time> m_expiryTimes;
+};
+
+void
+SatArqTimerQueueBaseTestCase::Init ()
+{
+  m_queue.SetExpiryCallback (MakeCallback (&SatArqTimerQueueBaseTestCase::TimerExpired, this));
+  m_timerIds.clear ();
+  m_expiredSeqNos.clear ();
+  m_expiryTimes.clear ();
+}
+
+void
+SatArqTimerQueueBaseTestCase::StartTimer (Time delay, uint32_t seqNo)
+{
+  m_timerIds[seqNo] = m_queue.Start (delay, seqNo);
+}
+
+void
+SatArqTimerQueueBaseTestCase::TimerExpired (uint32_t seqNo)
+{
+  m_expiredSeqNos.push_back (seqNo);
+  m_expiryTimes.push_back (Simulator::Now ());
+}
+
+/**
+ * \ingroup satellite
+ * \brief Test case to unit test the expiry order of the ARQ timer queue.
+ *
+ *  1.  Start timers of the same duration at different points of time, two
+ *      of them at the same point of time.
+ *  2.  Run the simulation.
+ *
+ *  Expected result:
+ *   The timers expire in the order they were started at their start time
+ *   + duration.
+ *
+ *
+ */
+class SatArqTimerQueueFifoTestCase : public SatArqTimerQueueBaseTestCase
+{
+public:
+  SatArqTimerQueueFifoTestCase () : SatArqTimerQueueBaseTestCase ("Test the expiry order of the ARQ timer queue.")
+  {
+  }
+  virtual ~SatArqTimerQueueFifoTestCase ()
+  {
+  }
+
+protected:
+  virtual void DoRun (void);
+};
+
+void
+SatArqTimerQueueFifoTestCase::DoRun (void)
+{
+  Init ();
+
+  Time delay = Seconds (0.6);
+  double startTimes[] = { 0.0, 0.1, 0.1, 0.25, 0.7, 1.4 };
+  uint32_t timers = sizeof (startTimes) / sizeof (double);
+
+  for (uint32_t i = 0; i < timers; ++i)
+    {
+      Simulator::Schedule (Seconds (startTimes[i]), &SatArqTimerQueueFifoTestCase::StartTimer, this, delay, 10 + i);
+    }
+
+  Simulator::Run ();
+
+  NS_TEST_ASSERT_MSG_EQ (m_timerIds.size (), timers, "timers not started");
+  NS_TEST_ASSERT_MSG_EQ (m_expiredSeqNos.size (), timers, "unexpected number of expired timers");
+
+  for (uint32_t i = 0; i < timers; ++i)
+    {
+      NS_TEST_ASSERT_MSG_NE (m_timerIds[10 + i], 0, "zero timer id");
+      NS_TEST_ASSERT_MSG_EQ (m_expiredSeqNos[i], 10 + i, "timer " << i << " expired out of order");
+      NS_TEST_ASSERT_MSG_EQ (m_expiryTimes[i], Seconds (startTimes[i]) + delay, "timer " << i << " expired at wrong time");
+      NS_TEST_ASSERT_MSG_EQ (m_queue.IsRunning (m_timerIds[10 + i]), false, "expired timer " << i << " running");
+    }
+
+  Simulator::Destroy ();
+}
+
+/**
+ * \ingroup satellite
+ * \brief Test case to unit test stopping the timers of the ARQ timer queue.
+ *
+ *  1.  Start timers at different points of time.
+ *  2.  Stop the first timer before its expiry, a timer in the middle of the
+ *      queue and a timer already expired.
+ *  3.  Start and stop all the timers of a second burst.
+ *  4.  Run the simulation.
+ *
+ *  Expected result:
+ *   Only the timers not stopped expire, at their own expiry times. A stopped
+ *   timer is not running, and stopping an expired timer has no effect.
+ *
+ *
+ */
+class SatArqTimerQueueStopTestCase : public SatArqTimerQueueBaseTestCase
+{
+public:
+  SatArqTimerQueueStopTestCase () : SatArqTimerQueueBaseTestCase ("Test stopping the timers of the ARQ timer queue.")
+  {
+  }
+  virtual ~SatArqTimerQueueStopTestCase ()
+  {
+  }
+
+  // stop a running timer by its sequence number
+  void StopRunningTimer (uint32_t seqNo);
+
+  // stop an expired timer by its sequence number
+  void StopExpiredTimer (uint32_t seqNo);
+
+protected:
+  virtual void DoRun (void);
+};
+
+void
+SatArqTimerQueueStopTestCase::StopRunningTimer (uint32_t seqNo)
+{
+  NS_TEST_EXPECT_MSG_EQ (m_queue.IsRunning (m_timerIds[seqNo]), true, "timer " << seqNo << " not running before stopped");
+  m_queue.Stop (m_timerIds[seqNo]);
+  NS_TEST_EXPECT_MSG_EQ (m_queue.IsRunning (m_timerIds[seqNo]), false, "timer " << seqNo << " running after stopped");
+}
+
+void
+SatArqTimerQueueStopTestCase::StopExpiredTimer (uint32_t seqNo)
+{
+  NS_TEST_EXPECT_MSG_EQ (m_queue.IsRunning (m_timerIds[seqNo]), false, "expired timer " << seqNo << " running");
+  m_queue.Stop (m_timerIds[seqNo]);
+}
+
+void
+SatArqTimerQueueStopTestCase::DoRun (void)
+{
+  Init ();
+
+  Time delay = MilliSeconds (500);
+
+  // timers 0 - 4 started at 0, 100, ..., 400 ms
+  for (uint32_t i = 0; i < 5; ++i)
+    {
+      Simulator::Schedule (MilliSeconds (100 * i), &SatArqTimerQueueStopTestCase::StartTimer, this, delay, i);
+    }
+
+  // stop the first timer and a timer in the middle before their expiry
+  Simulator::Schedule (MilliSeconds (450), &SatArqTimerQueueStopTestCase::StopRunningTimer, this, 0);
+  Simulator::Schedule (MilliSeconds (450), &SatArqTimerQueueStopTestCase::StopRunningTimer, this, 2);
+
+  // stop the expired timer 1, no effect on the following timers
+  Simulator::Schedule (MilliSeconds (650), &SatArqTimerQueueStopTestCase::StopExpiredTimer, this, 1);
+
+  // timers 5 - 7 started and stopped before their expiry
+  for (uint32_t i = 5; i < 8; ++i)
+    {
+      Simulator::Schedule (MilliSeconds (1000), &SatArqTimerQueueStopTestCase::StartTimer, this, delay, i);
+      Simulator::Schedule (MilliSeconds (1100), &SatArqTimerQueueStopTestCase::StopRunningTimer, this, i);
+    }
+
+  Simulator::Run ();
+
+  NS_TEST_ASSERT_MSG_EQ (m_expiredSeqNos.size (), 3, "unexpected number of expired timers");
+  NS_TEST_ASSERT_MSG_EQ (m_expiredSeqNos[0], 1, "unexpected first expired timer");
+  NS_TEST_ASSERT_MSG_EQ (m_expiryTimes[0], MilliSeconds (600), "unexpected expiry time of timer 1");
+  NS_TEST_ASSERT_MSG_EQ (m_expiredSeqNos[1], 3, "unexpected second expired timer");
+  NS_TEST_ASSERT_MSG_EQ (m_expiryTimes[1], MilliSeconds (800), "unexpected expiry time of timer 3");
+  NS_TEST_ASSERT_MSG_EQ (m_expiredSeqNos[2], 4, "unexpected third expired timer");
+  NS_TEST_ASSERT_MSG_EQ (m_expiryTimes[2], MilliSeconds (900), "unexpected expiry time of timer 4");
+
+  Simulator::Destroy ();
+}
+
+/**
+ * \ingroup satellite
+ * \brief Test case to unit test the timer ids over the growth of the ring
+ * buffer of the ARQ timer queue.
+ *
+ *  1.  Start timers, and let some of them expire, so that the head of the
+ *      ring buffer is not at its beginning.
+ *  2.  Start so many timers that the ring buffer wraps around and grows
+ *      twice.
+ *  3.  Stop every third timer by its id after the growth.
+ *  4.  Run the simulation.
+ *
+ *  Expected result:
+ *   The ids are unique and given in the start order. The ids refer to the
+ *   same timers after the growth, i.e. exactly the timers stopped by their
+ *   ids do not expire.
+ *
+ *
+ */
+class SatArqTimerQueueGrowthTestCase : public SatArqTimerQueueBaseTestCase
+{
+public:
+  SatArqTimerQueueGrowthTestCase () : SatArqTimerQueueBaseTestCase ("Test the ids of the ARQ timers over the growth of the timer queue.")
+  {
+  }
+  virtual ~SatArqTimerQueueGrowthTestCase ()
+  {
+  }
+
+  // start a burst of timers with consecutive sequence numbers
+  void StartTimers (uint32_t firstSeqNo, uint32_t count);
+
+  // stop every third timer from the given sequence number on
+  void StopTimers (uint32_t firstSeqNo);
+
+protected:
+  virtual void DoRun (void);
+
+private:
+  Time m_delay;
+};
+
+void
+SatArqTimerQueueGrowthTestCase::StartTimers (uint32_t firstSeqNo, uint32_t count)
+{
+  for (uint32_t i = 0; i < count; ++i)
+    {
+      StartTimer (m_delay, firstSeqNo + i);
+    }
+}
+
+void
+SatArqTimerQueueGrowthTestCase::StopTimers (uint32_t firstSeqNo)
+{
+  for (uint32_t i = firstSeqNo; i < m_timerIds.size (); i += 3)
+    {
+      NS_TEST_EXPECT_MSG_EQ (m_queue.IsRunning (m_timerIds[i]), true, "timer " << i << " not running after growth");
+      m_queue.Stop (m_timerIds[i]);
+    }
+}
+
+void
+SatArqTimerQueueGrowthTestCase::DoRun (void)
+{
+  Init ();
+
+  m_delay = Seconds (1.0);
+
+  uint32_t firstBurst = 10;
+  uint32_t secondBurst = 50;
+
+  // 5 timers expiring at 1.0 seconds and 5 at 1.5 seconds, then 50 timers
+  // started when only 5 are left, wrapping around the initial 16 timers and
+  // growing the ring buffer to 32 and 64 timers
+  Simulator::Schedule (Seconds (0.0), &SatArqTimerQueueGrowthTestCase::StartTimers, this, 0, 5);
+  Simulator::Schedule (Seconds (0.5), &SatArqTimerQueueGrowthTestCase::StartTimers, this, 5, firstBurst - 5);
+  Simulator::Schedule (Seconds (1.2), &SatArqTimerQueueGrowthTestCase::StartTimers, this, firstBurst, secondBurst);
+  Simulator::Schedule (Seconds (1.3), &SatArqTimerQueueGrowthTestCase::StopTimers, this, firstBurst);
+
+  Simulator::Run ();
+
+  NS_TEST_ASSERT_MSG_EQ (m_timerIds.size (), firstBurst + secondBurst, "timers not started");
+
+  for (uint32_t i = 1; i < m_timerIds.size (); ++i)
+    {
+      NS_TEST_ASSERT_MSG_EQ (m_timerIds[i], m_timerIds[i - 1] + 1, "timer ids not consecutive at " << i);
+    }
+
+  std::vector<uint32_t> expected;
+
+  for (uint32_t i = 0; i < firstBurst + secondBurst; ++i)
+    {
+      if (i < firstBurst || (i - firstBurst) % 3 != 0)
+        {
+          expected.push_back (i);
+        }
+    }
+
+  NS_TEST_ASSERT_MSG_EQ (m_expiredSeqNos.size (), expected.size (), "unexpected number of expired timers");
+
+  for (uint32_t i = 0; i < expected.size (); ++i)
+    {
+      NS_TEST_ASSERT_MSG_EQ (m_expiredSeqNos[i], expected[i], "unexpected expired timer at " << i);
+    }
+
+  Simulator::Destroy ();
+}
+
+/**
+ * \ingroup satellite
+ * \brief Test case to unit test starting and stopping timers of the ARQ
+ * timer queue from the expiry callback.
+ *
+ *  1.  Start three timers at the same point of time and a fourth one later.
+ *  2.  From the expiry callback of the first timer, stop the second timer
+ *      expiring at the same time and start a new timer.
+ *  3.  From the expiry callback of the new timer, stop the fourth timer
+ *      and start one more timer.
+ *  4.  Run the simulation.
+ *
+ *  Expected result:
+ *   The timers stopped from the callback do not expire, even if they
+ *   expire at the same time as the calling timer. The timers started from
+ *   the callback expire at their own expiry times.
+ *
+ *
+ */
+class SatArqTimerQueueReentryTestCase : public SatArqTimerQueueBaseTestCase
+{
+public:
+  SatArqTimerQueueReentryTestCase () : SatArqTimerQueueBaseTestCase ("Test starting and stopping ARQ timers from the expiry callback.")
+  {
+  }
+  virtual ~SatArqTimerQueueReentryTestCase ()
+  {
+  }
+
+  // record an expired timer, and start and stop timers for some of them
+  virtual void TimerExpired (uint32_t seqNo);
+
+protected:
+  virtual void DoRun (void);
+
+private:
+  Time m_delay;
+};
+
+void
+SatArqTimerQueueReentryTestCase::TimerExpired (uint32_t seqNo)
+{
+  SatArqTimerQueueBaseTestCase::TimerExpired (seqNo);
+
+  if (seqNo == 0)
+    {
+      // timer 1 expires at the same time as timer 0
+      NS_TEST_EXPECT_MSG_EQ (m_queue.IsRunning (m_timerIds[1]), true, "timer 1 not running");
+      m_queue.Stop (m_timerIds[1]);
+      StartTimer (m_delay, 10);
+    }
+  else if (seqNo == 10)
+    {
+      m_queue.Stop (m_timerIds[3]);
+      StartTimer (m_delay, 11);
+    }
+}
+
+void
+SatArqTimerQueueReentryTestCase::DoRun (void)
+{
+  Init ();
+
+  m_delay = Seconds (0.5);
+
+  // timers 0, 1 and 2 expiring at 0.5 seconds, timer 3 at 1.2 seconds
+  Simulator::Schedule (Seconds (0.0), &SatArqTimerQueueReentryTestCase::StartTimer, this, m_delay, 0);
+  Simulator::Schedule (Seconds (0.0), &SatArqTimerQueueReentryTestCase::StartTimer, this, m_delay, 1);
+  Simulator::Schedule (Seconds (0.0), &SatArqTimerQueueReentryTestCase::StartTimer, this, m_delay, 2);
+  Simulator::Schedule (Seconds (0.7), &SatArqTimerQueueReentryTestCase::StartTimer, this, m_delay, 3);
+
+  Simulator::Run ();
+
+  // timer 10 started at 0.5 seconds, timer 11 at 1.0 seconds
+  NS_TEST_ASSERT_MSG_EQ (m_expiredSeqNos.size (), 4, "unexpected number of expired timers");
+  NS_TEST_ASSERT_MSG_EQ (m_expiredSeqNos[0], 0, "unexpected first expired timer");
+  NS_TEST_ASSERT_MSG_EQ (m_expiryTimes[0], Seconds (0.5), "unexpected expiry time of timer 0");
+  NS_TEST_ASSERT_MSG_EQ (m_expiredSeqNos[1], 2, "unexpected second expired timer");
+  NS_TEST_ASSERT_MSG_EQ (m_expiryTimes[1], Seconds (0.5), "unexpected expiry time of timer 2");
+  NS_TEST_ASSERT_MSG_EQ (m_expiredSeqNos[2], 10, "unexpected third expired timer");
+  NS_TEST_ASSERT_MSG_EQ (m_expiryTimes[2], Seconds (1.0), "unexpected expiry time of timer 10");
+  NS_TEST_ASSERT_MSG_EQ (m_expiredSeqNos[3], 11, "unexpected fourth expired timer");
+  NS_TEST_ASSERT_MSG_EQ (m_expiryTimes[3], Seconds (1.5), "unexpected expiry time of timer 11");
+
+  Simulator::Destroy ();
+}
+
+/**
+ * \ingroup satellite
+ * \brief Test suite for the ARQ timer queue.
+ */
+class SatArqTimerQueueTestSuite : public TestSuite
+{
+public:
+  SatArqTimerQueueTestSuite ();
+};
+
+SatArqTimerQueueTestSuite::SatArqTimerQueueTestSuite ()
+  : TestSuite ("sat-arq-timer-queue-test", UNIT)
+{
+  AddTestCase (new SatArqTimerQueueFifoTestCase, TestCase::QUICK);
+  AddTestCase (new SatArqTimerQueueStopTestCase, TestCase::QUICK);
+  AddTestCase (new SatArqTimerQueueGrowthTestCase, TestCase::QUICK);
+  AddTestCase (new SatArqTimerQueueReentryTestCase, TestCase::QUICK);
+}
+
+// Do allocate an instance of this TestSuite
+static SatArqTimerQueueTestSuite satArqTimerQueueTestSuite;
@@ -0,0 +1,207 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2016 Magister Solutions Ltd
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: agent <agent@local>
+ */
+
+/**
+ * \file satellite-binary-data-file-test.cc
+ * \ingroup satellite
+ * \brief Test cases to unit test the binary data file format.
+ */
+
+#include <vector>
+#include <string>
+#include <fstream>
+#include <unistd.h>
+#include "ns3/log.h"
+#include "ns3/test.h"
+#include "ns3/ptr.h"
+#include "../utils/satellite-binary-data-file.h"
+
+using namespace ns3;
+
+/**
+ * \ingroup satellite
+ * \brief Test case to unit test writing and reading a binary data file.
+ *
+ *   1.  Write a binary data file with parameters and a data matrix.
+ *   2.  Open the file for the text file of the same name.
+ *
+ *   Expected result:
+ *     The opened file has the written dimensions, parameters and data values.
+ *
+ */
+class SatBinaryDataFileRoundTripTestCase : public TestCase
+{
+public:
+  SatBinaryDataFileRoundTripTestCase ();
+  virtual ~SatBinaryDataFileRoundTripTestCase ();
+
+private:
+  virtual void DoRun (void);
+};
+
+SatBinaryDataFileRoundTripTestCase::SatBinaryDataFileRoundTripTestCase ()
+  : TestCase ("Test writing and reading a binary data file.")
+{
+}
+
+SatBinaryDataFileRoundTripTestCase::~SatBinaryDataFileRoundTripTestCase ()
+{
+}
+
+void
+SatBinaryDataFileRoundTripTestCase::DoRun (void)
+{
+  std::string textFile = CreateTempDirFilename ("sat-binary-data-file-round-trip.txt");
+  std::string binaryFile = SatBinaryDataFile::GetBinaryFileName (textFile);
+
+  NS_TEST_ASSERT_MSG_EQ (binaryFile, CreateTempDirFilename ("sat-binary-data-file-round-trip.bin"), "Unexpected binary file name");
+
+  std::vector<double> parameters;
+  parameters.push_back (-1.5);
+  parameters.push_back (42.0);
+
+  uint32_t rows = 3;
+  uint32_t columns = 4;
+  std::vector<double> data;
+
+  for (uint32_t i = 0; i < rows * columns; ++i)
+    {
+      data.push_back (0.25 * i - 1.0);
+    }
+
+  SatBinaryDataFile::Write (binaryFile, SatBinaryDataFile::CONTENT_LINK_RESULTS, parameters, rows, columns, data);
+
+  Ptr<SatBinaryDataFile> file = SatBinaryDataFile::OpenForTextFile (textFile, SatBinaryDataFile::CONTENT_LINK_RESULTS);
+
+  NS_TEST_ASSERT_MSG_NE (file, 0, "Written binary data file not opened");
+  NS_TEST_ASSERT_MSG_EQ (file->GetParameterCount (), parameters.size (), "Unexpected parameter count");
+  NS_TEST_ASSERT_MSG_EQ (file->GetRows (), rows, "Unexpected row count");
+  NS_TEST_ASSERT_MSG_EQ (file->GetColumns (), columns, "Unexpected column count");
+
+  for (uint32_t i = 0; i < parameters.size (); ++i)
+    {
+      NS_TEST_ASSERT_MSG_EQ (file->GetParameters ()[i], parameters[i], "Unexpected parameter " << i);
+    }
+
+  for (uint32_t i = 0; i < data.size (); ++i)
+    {
+      NS_TEST_ASSERT_MSG_EQ (file->GetData ()[i], data[i], "Unexpected data value " << i);
+    }
+
+  file = 0;
+  unlink (binaryFile.c_str ());
+}
+
+/**
+ * \ingroup satellite
+ * \brief Test case to unit test rejecting invalid binary data files.
+ *
+ *   1.  Write a valid binary data file and open it with wrong content type.
+ *   2.  Overwrite the magic identifier of the file and open it.
+ *   3.  Rewrite the file, truncate its data and open it.
+ *
+ *   Expected result:
+ *     The invalid files are not opened, i.e. the text file would be used.
+ *
+ */
+class SatBinaryDataFileRejectTestCase : public TestCase
+{
+public:
+  SatBinaryDataFileRejectTestCase ();
+  virtual ~SatBinaryDataFileRejectTestCase ();
+
+private:
+  virtual void DoRun (void);
+};
+
+SatBinaryDataFileRejectTestCase::SatBinaryDataFileRejectTestCase ()
+  : TestCase ("Test rejecting invalid binary data files.")
+{
+}
+
+SatBinaryDataFileRejectTestCase::~SatBinaryDataFileRejectTestCase ()
+{
+}
+
+void
+SatBinaryDataFileRejectTestCase::DoRun (void)
+{
+  std::string textFile = CreateTempDirFilename ("sat-binary-data-file-reject.txt");
+  std::string binaryFile = SatBinaryDataFile::GetBinaryFileName (textFile);
+
+  std::vector<double> parameters (1, 1.0);
+  std::vector<double> data (4, 2.0);
+
+  // Content type mismatch
+  SatBinaryDataFile::Write (binaryFile, SatBinaryDataFile::CONTENT_ANTENNA_PATTERN, parameters, 2, 2, data);
+
+  NS_TEST_ASSERT_MSG_NE (SatBinaryDataFile::OpenForTextFile (textFile, SatBinaryDataFile::CONTENT_ANTENNA_PATTERN), 0,
+                         "Valid binary data file not opened");
+  NS_TEST_ASSERT_MSG_EQ (SatBinaryDataFile::OpenForTextFile (textFile, SatBinaryDataFile::CONTENT_LINK_RESULTS), 0,
+                         "Binary data file of wrong content type opened");
+
+  // Bad magic identifier
+  std::fstream fs (binaryFile.c_str (), std::fstream::in | std::fstream::out | std::fstream::binary);
+  NS_TEST_ASSERT_MSG_EQ (fs.is_open (), true, "Binary data file not opened for modification");
+  fs.seekp (0);
+  fs.write ("NOTSAT", 6);
+  fs.close ();
+
+  NS_TEST_ASSERT_MSG_EQ (SatBinaryDataFile::OpenForTextFile (textFile, SatBinaryDataFile::CONTENT_ANTENNA_PATTERN), 0,
+                         "Binary data file with bad magic opened");
+
+  // Truncated data
+  SatBinaryDataFile::Write (binaryFile, SatBinaryDataFile::CONTENT_ANTENNA_PATTERN, parameters, 2, 2, data);
+
+  std::ifstream ifs (binaryFile.c_str (), std::ifstream::binary | std::ifstream::ate);
+  off_t length = ifs.tellg ();
+  ifs.close ();
+
+  NS_TEST_ASSERT_MSG_EQ (truncate (binaryFile.c_str (), length - sizeof (double)), 0, "Binary data file not truncated");
+  NS_TEST_ASSERT_MSG_EQ (SatBinaryDataFile::OpenForTextFile (textFile, SatBinaryDataFile::CONTENT_ANTENNA_PATTERN), 0,
+                         "Truncated binary data file opened");
+
+  // Truncated header
+  NS_TEST_ASSERT_MSG_EQ (truncate (binaryFile.c_str (), 8), 0, "Binary data file not truncated");
+  NS_TEST_ASSERT_MSG_EQ (SatBinaryDataFile::OpenForTextFile (textFile, SatBinaryDataFile::CONTENT_ANTENNA_PATTERN), 0,
+                         "Binary data file with truncated header opened");
+
+  unlink (binaryFile.c_str ());
+}
+
+/**
+ * \ingroup satellite
+ * \brief Test suite for the binary data file.
+ */
+class SatBinaryDataFileTestSuite : public TestSuite
+{
+public:
+  SatBinaryDataFileTestSuite ();
+};
+
+SatBinaryDataFileTestSuite::SatBinaryDataFileTestSuite ()
+  : TestSuite ("sat-binary-data-file-test", UNIT)
+{
+  AddTestCase (new SatBinaryDataFileRoundTripTestCase, TestCase::QUICK);
+  AddTestCase (new SatBinaryDataFileRejectTestCase, TestCase::QUICK);
+}
+
+// Do allocate an instance of this TestSuite
+static SatBinaryDataFileTestSuite satBinaryDataFileTestSuite;
@@ -81,7 +81,21 @@ SatEstimatorBaseTestCase::GetCnoEstimation ()
 void
 SatEstimatorBaseTestCase::CreateEstimator (SatCnoEstimator::EstimationMode_t mode, Time window)
 {
-  m_estimator = Create<SatBasicCnoEstimator> (mode, window);
+  switch (mode)
+    {
+    case SatCnoEstimator::EWMA:
+      m_estimator = Create<SatEwmaCnoEstimator> (window);
+      break;
+
+    case SatCnoEstimator::PERCENTILE:
+      // median of the samples in window
+      m_estimator = Create<SatPercentileCnoEstimator> (window, 50.0);
+      break;
+
+    default:
+      m_estimator = Create<SatBasicCnoEstimator> (mode, window);
+      break;
+    }
 }
 
 /**
@@ -322,6 +336,139 @@ SatBasicEstimatorAverageTestCase::DoRun (void)
   Singleton<SatEnvVariables>::Get ()->DoDispose ();
 }
 
+/**
+ * \ingroup satellite
+ * \brief Test case to unit test satellite C/N0 estimator with mode EWMA.
+ *
+ * This case tests that SatEwmaCnoEstimator can be created and C/N0 is
+ * estimated correctly with set time constant.
+ *  1.  Create SatEwmaCnoEstimator object with time constant 100 ms.
+ *  2.  Set samples to estimator at different points of time (method AddSample).
+ *  3.  Get C/N0 estimation from estimator at some points of time (method GetCnoEstimation).
+ *
+ *  Expected result:
+ *   Returned C/N0 estimation must be the exponentially weighted average of samples,
+ *   the weight of the previous average being exp (-(time since previous sample) / time constant).
+ *
+ *   C/N0 estimation must be NAN, if no samples are got during time constant.
+ *
+ *
+ */
+class SatEwmaEstimatorTestCase : public SatEstimatorBaseTestCase
+{
+public:
+  SatEwmaEstimatorTestCase () : SatEstimatorBaseTestCase ("Test satellite C per N0 estimator with mode EWMA.")
+  {
+  }
+  virtual ~SatEwmaEstimatorTestCase ()
+  {
+  }
+
+protected:
+  virtual void DoRun (void);
+};
+
+void
+SatEwmaEstimatorTestCase::DoRun (void)
+{
+  // Set simulation output details
+  Singleton<SatEnvVariables>::Get ()->DoInitialize ();
+  Singleton<SatEnvVariables>::Get ()->SetOutputVariables ("test-sat-cno-estimator-unit", "ewma", true);
+
+  // create estimator with time constant 100 ms
+  Simulator::Schedule (Seconds (0.05), &SatEwmaEstimatorTestCase::CreateEstimator, this, SatCnoEstimator::EWMA, Seconds (0.10) );
+
+  // simulate sample additions
+  Simulator::Schedule (Seconds (0.10), &SatEwmaEstimatorTestCase::AddSample, this, -4.0 );
+  Simulator::Schedule (Seconds (0.20), &SatEwmaEstimatorTestCase::AddSample, this, 6.0 );
+  Simulator::Schedule (Seconds (0.25), &SatEwmaEstimatorTestCase::AddSample, this, NAN );
+
+  // simulate C/N0 estimations
+  Simulator::Schedule (Seconds (0.09), &SatEwmaEstimatorTestCase::GetCnoEstimation, this ); // NAN expected
+  Simulator::Schedule (Seconds (0.15), &SatEwmaEstimatorTestCase::GetCnoEstimation, this ); // -4.0 expected
+  Simulator::Schedule (Seconds (0.27), &SatEwmaEstimatorTestCase::GetCnoEstimation, this ); // -4.0 * e^-1 + 6.0 * (1 - e^-1) expected
+  Simulator::Schedule (Seconds (0.31), &SatEwmaEstimatorTestCase::GetCnoEstimation, this ); // NAN expected
+
+  Simulator::Run ();
+
+  // After simulation check that estimations are as expected
+  NS_TEST_ASSERT_MSG_EQ ( std::isnan (m_cnoEstimations[0]), true, "first estimation incorrect");
+  NS_TEST_ASSERT_MSG_EQ_TOL ( m_cnoEstimations[1], -4.0, 0.0001, "second estimation incorrect");
+  NS_TEST_ASSERT_MSG_EQ_TOL ( m_cnoEstimations[2], -4.0 * exp (-1.0) + 6.0 * (1.0 - exp (-1.0)), 0.0001, "third estimation incorrect");
+  NS_TEST_ASSERT_MSG_EQ ( std::isnan (m_cnoEstimations[3]), true, "fourth estimation incorrect");
+
+  Simulator::Destroy ();
+
+  Singleton<SatEnvVariables>::Get ()->DoDispose ();
+}
+
+/**
+ * \ingroup satellite
+ * \brief Test case to unit test satellite C/N0 estimator with mode PERCENTILE.
+ *
+ * This case tests that SatPercentileCnoEstimator can be created and C/N0 is
+ * estimated correctly in set window.
+ *  1.  Create SatPercentileCnoEstimator object estimating the median in window 200 ms.
+ *  2.  Set samples to estimator at different points of time (method AddSample).
+ *  3.  Get C/N0 estimation from estimator at some points of time (method GetCnoEstimation).
+ *
+ *  Expected result:
+ *   Returned C/N0 estimation must be the median (nearest rank) of samples in window.
+ *
+ *   C/N0 estimation must be NAN, if no samples are got during time window.
+ *
+ *
+ */
+class SatPercentileEstimatorTestCase : public SatEstimatorBaseTestCase
+{
+public:
+  SatPercentileEstimatorTestCase () : SatEstimatorBaseTestCase ("Test satellite C per N0 estimator with mode PERCENTILE.")
+  {
+  }
+  virtual ~SatPercentileEstimatorTestCase ()
+  {
+  }
+
+protected:
+  virtual void DoRun (void);
+};
+
+void
+SatPercentileEstimatorTestCase::DoRun (void)
+{
+  // Set simulation output details
+  Singleton<SatEnvVariables>::Get ()->DoInitialize ();
+  Singleton<SatEnvVariables>::Get ()->SetOutputVariables ("test-sat-cno-estimator-unit", "percentile", true);
+
+  // create estimator with window 200 ms
+  Simulator::Schedule (Seconds (0.05), &SatPercentileEstimatorTestCase::CreateEstimator, this, SatCnoEstimator::PERCENTILE, Seconds (0.20) );
+
+  // simulate sample additions
+  Simulator::Schedule (Seconds (0.17), &SatPercentileEstimatorTestCase::AddSample, this, -4.2 );
+  Simulator::Schedule (Seconds (0.22), &SatPercentileEstimatorTestCase::AddSample, this, 8.1 );
+  Simulator::Schedule (Seconds (0.26), &SatPercentileEstimatorTestCase::AddSample, this, -15.7 );
+  Simulator::Schedule (Seconds (0.43), &SatPercentileEstimatorTestCase::AddSample, this, 2.4 );
+
+  // simulate C/N0 estimations
+  Simulator::Schedule (Seconds (0.09), &SatPercentileEstimatorTestCase::GetCnoEstimation, this ); // NAN expected
+  Simulator::Schedule (Seconds (0.19), &SatPercentileEstimatorTestCase::GetCnoEstimation, this ); // -4.2 expected
+  Simulator::Schedule (Seconds (0.35), &SatPercentileEstimatorTestCase::GetCnoEstimation, this ); // median of -4.2, 8.1, -15.7 expected
+  Simulator::Schedule (Seconds (0.41), &SatPercentileEstimatorTestCase::GetCnoEstimation, this ); // lower median of 8.1, -15.7 expected
+  Simulator::Schedule (Seconds (0.69), &SatPercentileEstimatorTestCase::GetCnoEstimation, this ); // NAN expected
+
+  Simulator::Run ();
+
+  // After simulation check that estimations are as expected
+  NS_TEST_ASSERT_MSG_EQ ( std::isnan (m_cnoEstimations[0]), true, "first estimation incorrect");
+  NS_TEST_ASSERT_MSG_EQ ( m_cnoEstimations[1], -4.2, "second estimation incorrect");
+  NS_TEST_ASSERT_MSG_EQ ( m_cnoEstimations[2], -4.2, "third estimation incorrect");
+  NS_TEST_ASSERT_MSG_EQ ( m_cnoEstimations[3], -15.7, "fourth estimation incorrect");
+  NS_TEST_ASSERT_MSG_EQ ( std::isnan (m_cnoEstimations[4]), true, "fifth estimation incorrect");
+
+  Simulator::Destroy ();
+
+  Singleton<SatEnvVariables>::Get ()->DoDispose ();
+}
 
 /**
  * \ingroup satellite
@@ -339,6 +486,8 @@ SatBasicCnoEstimatorTestSuite::SatBasicCnoEstimatorTestSuite ()
   AddTestCase (new SatBasicEstimatorLastTestCase, TestCase::QUICK);
   AddTestCase (new SatBasicEstimatorMinTestCase, TestCase::QUICK);
   AddTestCase (new SatBasicEstimatorAverageTestCase, TestCase::QUICK);
+  AddTestCase (new SatEwmaEstimatorTestCase, TestCase::QUICK);
+  AddTestCase (new SatPercentileEstimatorTestCase, TestCase::QUICK);
 }
 
 // Do allocate an instance of this TestSuite
@@ -33,6 +33,9 @@
 #include "ns3/boolean.h"
 #include "ns3/string.h"
 #include "../model/satellite-control-message.h"
+#include "../model/satellite-tbtp-container.h"
+#include "../model/satellite-superframe-sequence.h"
+#include "../model/satellite-frame-conf.h"
 #include "ns3/singleton.h"
 #include "../utils/satellite-env-variables.h"
 
@@ -227,6 +230,134 @@ SatCtrlMsgContDelOffTestCase::DoRun (void)
   Singleton<SatEnvVariables>::Get ()->DoDispose ();
 }
 
+/**
+ * \ingroup satellite
+ * \brief Test case to unit test reusing the TBTP messages of SatTbtpMessagePool.
+ *
+ * This case tests that SatTbtpMessagePool reuses only the TBTP messages not
+ * referred anywhere else than from the pool.
+ *  1.  Get a TBTP message from the pool, set a DA time slot to it and store it
+ *      to SatControlMsgContainer with deletedOnRead flag not set.
+ *  2.  Get a TBTP message from the pool and store it to SatTbtpContainer.
+ *  3.  Get a TBTP message from the pool, release it and get a message again.
+ *  4.  Get a TBTP message from the pool after the store time of the control
+ *      message container is expired.
+ *  5.  Release the TBTP container and get a TBTP message from the pool.
+ *
+ *  Expected result:
+ *   A message stored to a container is not returned by the pool until it is
+ *   removed from the container. A reused message has no time slots left and
+ *   has the new super frame counter.
+ *
+ *
+ */
+class SatTbtpMessagePoolTestCase : public SatCtrlMsgContBaseTestCase
+{
+public:
+  SatTbtpMessagePoolTestCase () : SatCtrlMsgContBaseTestCase ("Test reusing the TBTP messages held by the containers.")
+  {
+  }
+  virtual ~SatTbtpMessagePoolTestCase ()
+  {
+  }
+
+  // get messages from the pool and store them to the containers
+  void StoreMessages ();
+
+  // get messages from the pool after the containers released them
+  void ReuseMessages ();
+
+protected:
+  virtual void DoRun (void);
+
+private:
+  Ptr<SatTbtpMessagePool> m_pool;
+  Ptr<SatTbtpContainer> m_tbtpContainer;
+  SatTbtpMessage* m_ctrlContainerMsg;
+  SatTbtpMessage* m_tbtpContainerMsg;
+  Mac48Address m_utAddress;
+};
+
+void
+SatTbtpMessagePoolTestCase::StoreMessages ()
+{
+  SatTbtpMessage::DaTimeSlot_t timeSlot;
+  timeSlot.startTime = Seconds (0.0);
+  timeSlot.waveFormId = 3;
+  timeSlot.carrierId = 0;
+  timeSlot.rcIndex = 0;
+  timeSlot.slotType = SatTimeSlotConf::SLOT_TYPE_TRC;
+
+  Ptr<SatTbtpMessage> tbtp = m_pool->Get (0, 1);
+  tbtp->SetDaTimeslot (m_utAddress, 0, timeSlot);
+  AddMessage (tbtp);
+  m_ctrlContainerMsg = PeekPointer (tbtp);
+  tbtp = NULL;
+
+  // the message in the control message container is not reused
+  tbtp = m_pool->Get (0, 2);
+  NS_TEST_EXPECT_MSG_NE (PeekPointer (tbtp), m_ctrlContainerMsg, "message in control message container reused");
+  m_tbtpContainer->Add (Seconds (1.0), tbtp);
+  m_tbtpContainerMsg = PeekPointer (tbtp);
+  tbtp = NULL;
+
+  // neither the message in the TBTP container is reused
+  tbtp = m_pool->Get (0, 3);
+  NS_TEST_EXPECT_MSG_NE (PeekPointer (tbtp), m_ctrlContainerMsg, "message in control message container reused");
+  NS_TEST_EXPECT_MSG_NE (PeekPointer (tbtp), m_tbtpContainerMsg, "message in TBTP container reused");
+  SatTbtpMessage* releasedMsg = PeekPointer (tbtp);
+  tbtp = NULL;
+
+  // the released message is the only one to reuse
+  tbtp = m_pool->Get (0, 4);
+  NS_TEST_EXPECT_MSG_EQ (PeekPointer (tbtp), releasedMsg, "released message not reused");
+}
+
+void
+SatTbtpMessagePoolTestCase::ReuseMessages ()
+{
+  // the store time of the control message container is expired
+  Ptr<SatTbtpMessage> tbtp = m_pool->Get (0, 5);
+  NS_TEST_EXPECT_MSG_EQ (PeekPointer (tbtp), m_ctrlContainerMsg, "message released by control message container not reused");
+  NS_TEST_EXPECT_MSG_EQ (tbtp->GetDaTimeslots (m_utAddress).count, 0, "time slots of reused message not reset");
+  NS_TEST_EXPECT_MSG_EQ (tbtp->GetSuperframeCounter (), 5, "super frame counter of reused message not set");
+  tbtp = NULL;
+
+  m_tbtpContainer->Dispose ();
+  m_tbtpContainer = NULL;
+
+  tbtp = m_pool->Get (0, 6);
+  NS_TEST_EXPECT_MSG_EQ (PeekPointer (tbtp), m_tbtpContainerMsg, "message released by TBTP container not reused");
+}
+
+void
+SatTbtpMessagePoolTestCase::DoRun (void)
+{
+  // Set simulation output details
+  Singleton<SatEnvVariables>::Get ()->DoInitialize ();
+  Singleton<SatEnvVariables>::Get ()->SetOutputVariables ("test-sat-ctrl-msg-container-unit", "tbtppool", true);
+
+  // create container with store time 100 ms and flag deletedOnRead NOT set
+  m_container = Create<SatControlMsgContainer> (Seconds (0.10), false);
+  m_pool = Create<SatTbtpMessagePool> ();
+  m_utAddress = Mac48Address ("00:00:00:00:00:01");
+
+  Ptr<SatSuperframeSeq> seq = CreateObject<SatSuperframeSeq> ();
+  seq->AddSuperframe (CreateObject<SatSuperframeConf0> ());
+  m_tbtpContainer = CreateObject<SatTbtpContainer> (seq);
+
+  Simulator::Schedule (Seconds (0.05), &SatTbtpMessagePoolTestCase::StoreMessages, this);
+  Simulator::Schedule (Seconds (0.20), &SatTbtpMessagePoolTestCase::ReuseMessages, this);
+
+  Simulator::Run ();
+
+  Simulator::Destroy ();
+
+  m_pool->Clear ();
+
+  Singleton<SatEnvVariables>::Get ()->DoDispose ();
+}
+
 /**
  * \ingroup satellite
  * \brief Test suite for Satellite control message container unit test cases.
@@ -242,6 +373,7 @@ SatCtrlMsgContainerTestSuite::SatCtrlMsgContainerTestSuite ()
 {
   AddTestCase (new SatCtrlMsgContDelOnTestCase, TestCase::QUICK);
   AddTestCase (new SatCtrlMsgContDelOffTestCase, TestCase::QUICK);
+  AddTestCase (new SatTbtpMessagePoolTestCase, TestCase::QUICK);
 }
 
 // Do allocate an instance of this TestSuite
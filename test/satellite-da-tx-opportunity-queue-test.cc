@@ -0,0 +1,349 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2016 Magister Solutions Ltd
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: agent <agent@local>
+ */
+
+/**
+ * \file satellite-da-tx-opportunity-queue-test.cc
+ * \ingroup satellite
+ * \brief Test cases to unit test the DA Tx opportunity queue of the UT MAC.
+ */
+
+#include <vector>
+#include "ns3/log.h"
+#include "ns3/test.h"
+#include "ns3/simulator.h"
+#include "../model/satellite-da-tx-opportunity-queue.h"
+
+using namespace ns3;
+
+/**
+ * \ingroup satellite
+ * \brief Base test case of the DA Tx opportunity queue, recording the
+ * transmitted Tx opportunities.
+ */
+class SatDaTxOpportunityQueueBaseTestCase : public TestCase
+{
+public:
+  SatDaTxOpportunityQueueBaseTestCase (std::string info) : TestCase (info)
+  {
+  }
+  virtual ~SatDaTxOpportunityQueueBaseTestCase ()
+  {
+  }
+
+  // schedule the Tx opportunities of a TBTP, the carrier ids identifying the time slots
+  void ScheduleTbtp (std::vector<uint32_t> txTimesInMs, std::vector<uint32_t> carrierIds);
+
+  // record a transmitted Tx opportunity, set as the Tx callback of the queue
+  void TxOpportunity (const SatDaTxOpportunityQueue::DaTxOpportunity_t& txOpportunity);
+
+  // record the number of pending Tx opportunities
+  void CheckSize ();
+
+protected:
+  virtual void DoRun (void) = 0;
+
+  // set the Tx callback and clear the records
+  void Init ();
+
+  // check the recorded Tx opportunities against the expected ones
+  void CheckTxOpportunities (std::vector<uint32_t> txTimesInMs, std::vector<uint32_t> carrierIds);
+
+  SatDaTxOpportunityQueue m_queue;
+  std::vector<uint32_t> m_txCarrierIds;
+  std::vector<Time> m_txTimes;
+  std::vector<uint32_t> m_sizes;
+};
+
+void
+SatDaTxOpportunityQueueBaseTestCase::Init ()
+{
+  m_queue.SetTxCallback (MakeCallback (&SatDaTxOpportunityQueueBaseTestCase::TxOpportunity, this));
+  m_txCarrierIds.clear ();
+  m_txTimes.clear ();
+  m_sizes.clear ();
+}
+
+void
+SatDaTxOpportunityQueueBaseTestCase::ScheduleTbtp (std::vector<uint32_t> txTimesInMs, std::vector<uint32_t> carrierIds)
+{
+  std::vector<SatDaTxOpportunityQueue::DaTxOpportunity_t> txOpportunities;
+
+  for (uint32_t i = 0; i < txTimesInMs.size (); ++i)
+    {
+      SatDaTxOpportunityQueue::DaTxOpportunity_t txOpportunity;
+      txOpportunity.txTime = MilliSeconds (txTimesInMs[i]);
+      txOpportunity.duration = MicroSeconds (100);
+      txOpportunity.slotType = SatTimeSlotConf::SLOT_TYPE_TR;
+      txOpportunity.rcIndex = 0;
+      txOpportunity.carrierId = carrierIds[i];
+
+      txOpportunities.push_back (txOpportunity);
+    }
+
+  m_queue.Schedule (txOpportunities);
+}
+
+void
+SatDaTxOpportunityQueueBaseTestCase::TxOpportunity (const SatDaTxOpportunityQueue::DaTxOpportunity_t& txOpportunity)
+{
+  NS_TEST_EXPECT_MSG_EQ (txOpportunity.txTime, Simulator::Now (), "Tx opportunity " << txOpportunity.carrierId << " not at its transmission time");
+
+  m_txCarrierIds.push_back (txOpportunity.carrierId);
+  m_txTimes.push_back (Simulator::Now ());
+}
+
+void
+SatDaTxOpportunityQueueBaseTestCase::CheckSize ()
+{
+  m_sizes.push_back (m_queue.GetSize ());
+}
+
+void
+SatDaTxOpportunityQueueBaseTestCase::CheckTxOpportunities (std::vector<uint32_t> txTimesInMs, std::vector<uint32_t> carrierIds)
+{
+  NS_TEST_ASSERT_MSG_EQ (m_txCarrierIds.size (), carrierIds.size (), "unexpected number of transmitted Tx opportunities");
+
+  for (uint32_t i = 0; i < carrierIds.size (); ++i)
+    {
+      NS_TEST_ASSERT_MSG_EQ (m_txCarrierIds[i], carrierIds[i], "unexpected Tx opportunity at " << i);
+      NS_TEST_ASSERT_MSG_EQ (m_txTimes[i], MilliSeconds (txTimesInMs[i]), "unexpected transmission time at " << i);
+    }
+}
+
+/**
+ * \ingroup satellite
+ * \brief Test case to unit test the order of the Tx opportunities of one TBTP.
+ *
+ *  1.  Schedule the Tx opportunities of a TBTP in an order other than the
+ *      transmission time, some of them at the same time.
+ *  2.  Run the simulation.
+ *
+ *  Expected result:
+ *   The Tx opportunities are transmitted at their transmission times, and
+ *   the ones at the same time in their TBTP order.
+ *
+ *
+ */
+class SatDaTxOpportunityQueueOrderTestCase : public SatDaTxOpportunityQueueBaseTestCase
+{
+public:
+  SatDaTxOpportunityQueueOrderTestCase () : SatDaTxOpportunityQueueBaseTestCase ("Test the order of the DA Tx opportunities of a TBTP.")
+  {
+  }
+  virtual ~SatDaTxOpportunityQueueOrderTestCase ()
+  {
+  }
+
+protected:
+  virtual void DoRun (void);
+};
+
+void
+SatDaTxOpportunityQueueOrderTestCase::DoRun (void)
+{
+  Init ();
+
+  // time slot i at 100, 200, 300 or 400 ms, enough time slots not to be
+  // sorted by insertion only
+  uint32_t slotCount = 64;
+  std::vector<uint32_t> tbtpTimes;
+  std::vector<uint32_t> tbtpCarriers;
+
+  for (uint32_t i = 0; i < slotCount; ++i)
+    {
+      tbtpTimes.push_back (100 * (1 + (i * 3) % 4));
+      tbtpCarriers.push_back (i);
+    }
+
+  Simulator::Schedule (MilliSeconds (50), &SatDaTxOpportunityQueueOrderTestCase::ScheduleTbtp, this, tbtpTimes, tbtpCarriers);
+
+  Simulator::Run ();
+
+  std::vector<uint32_t> txTimes;
+  std::vector<uint32_t> txCarriers;
+
+  for (uint32_t time = 100; time <= 400; time += 100)
+    {
+      for (uint32_t i = 0; i < slotCount; ++i)
+        {
+          if (tbtpTimes[i] == time)
+            {
+              txTimes.push_back (time);
+              txCarriers.push_back (i);
+            }
+        }
+    }
+
+  CheckTxOpportunities (txTimes, txCarriers);
+
+  NS_TEST_ASSERT_MSG_EQ (m_queue.GetSize (), 0, "Tx opportunities left in the queue");
+
+  Simulator::Destroy ();
+}
+
+/**
+ * \ingroup satellite
+ * \brief Test case to unit test merging the Tx opportunities of a TBTP
+ * overlapping the pending ones.
+ *
+ *  1.  Schedule the Tx opportunities of a first TBTP.
+ *  2.  Before their transmission, schedule the Tx opportunities of a second
+ *      TBTP, interleaved with the pending ones and one at the same time as
+ *      a pending one.
+ *  3.  Schedule the Tx opportunities of a third TBTP after all the pending
+ *      ones.
+ *  4.  Run the simulation.
+ *
+ *  Expected result:
+ *   The Tx opportunities of all the TBTPs are transmitted in the order of the
+ *   transmission time, the pending one first at the same time.
+ *
+ *
+ */
+class SatDaTxOpportunityQueueMergeTestCase : public SatDaTxOpportunityQueueBaseTestCase
+{
+public:
+  SatDaTxOpportunityQueueMergeTestCase () : SatDaTxOpportunityQueueBaseTestCase ("Test merging the DA Tx opportunities of overlapping TBTPs.")
+  {
+  }
+  virtual ~SatDaTxOpportunityQueueMergeTestCase ()
+  {
+  }
+
+protected:
+  virtual void DoRun (void);
+};
+
+void
+SatDaTxOpportunityQueueMergeTestCase::DoRun (void)
+{
+  Init ();
+
+  uint32_t firstTimes[] = { 1000, 1200, 1400 };
+  uint32_t firstCarriers[] = { 0, 1, 2 };
+  uint32_t secondTimes[] = { 1300, 1100, 1200 };
+  uint32_t secondCarriers[] = { 12, 10, 11 };
+  uint32_t thirdTimes[] = { 2000, 1500 };
+  uint32_t thirdCarriers[] = { 21, 20 };
+
+  Simulator::Schedule (MilliSeconds (0), &SatDaTxOpportunityQueueMergeTestCase::ScheduleTbtp, this,
+                       std::vector<uint32_t> (firstTimes, firstTimes + 3), std::vector<uint32_t> (firstCarriers, firstCarriers + 3));
+  Simulator::Schedule (MilliSeconds (500), &SatDaTxOpportunityQueueMergeTestCase::ScheduleTbtp, this,
+                       std::vector<uint32_t> (secondTimes, secondTimes + 3), std::vector<uint32_t> (secondCarriers, secondCarriers + 3));
+  Simulator::Schedule (MilliSeconds (600), &SatDaTxOpportunityQueueMergeTestCase::ScheduleTbtp, this,
+                       std::vector<uint32_t> (thirdTimes, thirdTimes + 2), std::vector<uint32_t> (thirdCarriers, thirdCarriers + 2));
+  Simulator::Schedule (MilliSeconds (700), &SatDaTxOpportunityQueueMergeTestCase::CheckSize, this);
+  Simulator::Schedule (MilliSeconds (1250), &SatDaTxOpportunityQueueMergeTestCase::CheckSize, this);
+
+  Simulator::Run ();
+
+  uint32_t txTimes[] = { 1000, 1100, 1200, 1200, 1300, 1400, 1500, 2000 };
+  uint32_t txCarriers[] = { 0, 10, 1, 11, 12, 2, 20, 21 };
+
+  CheckTxOpportunities (std::vector<uint32_t> (txTimes, txTimes + 8), std::vector<uint32_t> (txCarriers, txCarriers + 8));
+
+  NS_TEST_ASSERT_MSG_EQ (m_sizes.size (), 2, "sizes not checked");
+  NS_TEST_ASSERT_MSG_EQ (m_sizes[0], 8, "unexpected number of pending Tx opportunities before the first transmission");
+  NS_TEST_ASSERT_MSG_EQ (m_sizes[1], 4, "unexpected number of pending Tx opportunities after the merged ones");
+
+  Simulator::Destroy ();
+}
+
+/**
+ * \ingroup satellite
+ * \brief Test case to unit test rescheduling the event of the queue earlier
+ * for a TBTP starting before the pending Tx opportunities.
+ *
+ *  1.  Schedule the Tx opportunities of a first TBTP.
+ *  2.  Schedule a second TBTP starting and ending before the first one.
+ *  3.  Schedule a third TBTP starting before the second one, after the first
+ *      transmission of the second one.
+ *  4.  Run the simulation.
+ *
+ *  Expected result:
+ *   The event of the queue is cancelled and scheduled earlier for each TBTP
+ *   starting before the pending Tx opportunities, so all the Tx opportunities
+ *   are transmitted at their own transmission times, each one once.
+ *
+ *
+ */
+class SatDaTxOpportunityQueueRescheduleTestCase : public SatDaTxOpportunityQueueBaseTestCase
+{
+public:
+  SatDaTxOpportunityQueueRescheduleTestCase () : SatDaTxOpportunityQueueBaseTestCase ("Test rescheduling the DA Tx event for an earlier TBTP.")
+  {
+  }
+  virtual ~SatDaTxOpportunityQueueRescheduleTestCase ()
+  {
+  }
+
+protected:
+  virtual void DoRun (void);
+};
+
+void
+SatDaTxOpportunityQueueRescheduleTestCase::DoRun (void)
+{
+  Init ();
+
+  uint32_t firstTimes[] = { 2000, 2100 };
+  uint32_t firstCarriers[] = { 0, 1 };
+  uint32_t secondTimes[] = { 800, 1000 };
+  uint32_t secondCarriers[] = { 10, 11 };
+  uint32_t thirdTimes[] = { 900 };
+  uint32_t thirdCarriers[] = { 20 };
+
+  Simulator::Schedule (MilliSeconds (0), &SatDaTxOpportunityQueueRescheduleTestCase::ScheduleTbtp, this,
+                       std::vector<uint32_t> (firstTimes, firstTimes + 2), std::vector<uint32_t> (firstCarriers, firstCarriers + 2));
+  Simulator::Schedule (MilliSeconds (100), &SatDaTxOpportunityQueueRescheduleTestCase::ScheduleTbtp, this,
+                       std::vector<uint32_t> (secondTimes, secondTimes + 2), std::vector<uint32_t> (secondCarriers, secondCarriers + 2));
+  Simulator::Schedule (MilliSeconds (850), &SatDaTxOpportunityQueueRescheduleTestCase::ScheduleTbtp, this,
+                       std::vector<uint32_t> (thirdTimes, thirdTimes + 1), std::vector<uint32_t> (thirdCarriers, thirdCarriers + 1));
+
+  Simulator::Run ();
+
+  uint32_t txTimes[] = { 800, 900, 1000, 2000, 2100 };
+  uint32_t txCarriers[] = { 10, 20, 11, 0, 1 };
+
+  CheckTxOpportunities (std::vector<uint32_t> (txTimes, txTimes + 5), std::vector<uint32_t> (txCarriers, txCarriers + 5));
+
+  Simulator::Destroy ();
+}
+
+/**
+ * \ingroup satellite
+ * \brief Test suite for the DA Tx opportunity queue.
+ */
+class SatDaTxOpportunityQueueTestSuite : public TestSuite
+{
+public:
+  SatDaTxOpportunityQueueTestSuite ();
+};
+
+SatDaTxOpportunityQueueTestSuite::SatDaTxOpportunityQueueTestSuite ()
+  : TestSuite ("sat-da-tx-opportunity-queue-test", UNIT)
+{
+  AddTestCase (new SatDaTxOpportunityQueueOrderTestCase, TestCase::QUICK);
+  AddTestCase (new SatDaTxOpportunityQueueMergeTestCase, TestCase::QUICK);
+  AddTestCase (new SatDaTxOpportunityQueueRescheduleTestCase, TestCase::QUICK);
+}
+
+// Do allocate an instance of this TestSuite
+static SatDaTxOpportunityQueueTestSuite satDaTxOpportunityQueueTestSuite;
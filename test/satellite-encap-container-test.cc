@@ -0,0 +1,308 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2016 Magister Solutions Ltd
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: agent <agent@local>
+ */
+
+/**
+ * \file satellite-encap-container-test.cc
+ * \ingroup satellite
+ * \brief Test cases to unit test the flat hash map and the LLC encapsulator container.
+ */
+
+#include <vector>
+#include <map>
+#include "ns3/log.h"
+#include "ns3/test.h"
+#include "ns3/ptr.h"
+#include "ns3/mac48-address.h"
+#include "../model/satellite-flat-hash-map.h"
+#include "../model/satellite-encap-container.h"
+#include "../model/satellite-base-encapsulator.h"
+
+using namespace ns3;
+
+/**
+ * \brief Hash function mapping the keys to a few hash values, so that
+ * the keys collide in the hash table
+ */
+class SatCollidingHash
+{
+public:
+  inline uint64_t operator() (uint64_t key) const
+  {
+    return key % 3;
+  }
+};
+
+/**
+ * \ingroup satellite
+ * \brief Test case to unit test inserting and finding entries of SatFlatHashMap.
+ *
+ *   1.  Insert enough keys to grow the hash table several times, both with
+ *       the default hash function and with a hash function colliding most
+ *       of the keys.
+ *   2.  Find all the inserted keys after each insertion and insert the
+ *       keys again.
+ *   3.  Clear the map and insert the keys again.
+ *
+ *   Expected result:
+ *     The inserted keys are found at their insertion index with their
+ *     values, also after the hash table has grown, keys not inserted are
+ *     not found, inserting a key again returns its existing index and
+ *     clearing removes all the entries.
+ *
+ */
+class SatFlatHashMapTestCase : public TestCase
+{
+public:
+  SatFlatHashMapTestCase ();
+  virtual ~SatFlatHashMapTestCase ();
+
+private:
+  virtual void DoRun (void);
+
+  template <typename H>
+  void CheckMap (uint32_t keyCount);
+};
+
+SatFlatHashMapTestCase::SatFlatHashMapTestCase ()
+  : TestCase ("Test inserting and finding entries of the flat hash map.")
+{
+}
+
+SatFlatHashMapTestCase::~SatFlatHashMapTestCase ()
+{
+}
+
+template <typename H>
+void
+SatFlatHashMapTestCase::CheckMap (uint32_t keyCount)
+{
+  SatFlatHashMap<uint64_t, double, H> map;
+
+  NS_TEST_ASSERT_MSG_EQ (map.IsEmpty (), true, "New map not empty");
+  NS_TEST_ASSERT_MSG_EQ (map.Find (0), map.NOT_FOUND, "Key found from an empty map");
+
+  for (uint32_t round = 0; round < 2; round++)
+    {
+      for (uint32_t i = 0; i < keyCount; i++)
+        {
+          // keys with equal low bits and with large values
+          uint64_t key = ((uint64_t) i << 40) + 7 * i;
+          std::pair<uint32_t, bool> result = map.Insert (key, 0.5 * i);
+
+          NS_TEST_ASSERT_MSG_EQ (result.first, i, "Unexpected index of key " << i);
+          NS_TEST_ASSERT_MSG_EQ (result.second, true, "Key " << i << " not inserted");
+          NS_TEST_ASSERT_MSG_EQ (map.GetSize (), i + 1, "Unexpected size");
+
+          for (uint32_t j = 0; j <= i; j++)
+            {
+              uint64_t insertedKey = ((uint64_t) j << 40) + 7 * j;
+              uint32_t index = map.Find (insertedKey);
+
+              NS_TEST_ASSERT_MSG_EQ (index, j, "Key " << j << " not found after inserting key " << i);
+              NS_TEST_ASSERT_MSG_EQ (map.GetKey (index), insertedKey, "Unexpected key " << j);
+              NS_TEST_ASSERT_MSG_EQ (map.GetValue (index), 0.5 * j, "Unexpected value of key " << j);
+            }
+
+          NS_TEST_ASSERT_MSG_EQ (map.Find (key + 1), map.NOT_FOUND, "Key not inserted found");
+        }
+
+      for (uint32_t i = 0; i < keyCount; i++)
+        {
+          std::pair<uint32_t, bool> result = map.Insert (((uint64_t) i << 40) + 7 * i, -1.0);
+
+          NS_TEST_ASSERT_MSG_EQ (result.first, i, "Unexpected index of key " << i << " inserted again");
+          NS_TEST_ASSERT_MSG_EQ (result.second, false, "Key " << i << " inserted twice");
+          NS_TEST_ASSERT_MSG_EQ (map.GetValue (i), 0.5 * i, "Value of key " << i << " replaced");
+        }
+
+      NS_TEST_ASSERT_MSG_EQ (map.GetSize (), keyCount, "Unexpected size after inserting the keys again");
+
+      map.Clear ();
+
+      NS_TEST_ASSERT_MSG_EQ (map.IsEmpty (), true, "Cleared map not empty");
+      NS_TEST_ASSERT_MSG_EQ (map.Find (0), map.NOT_FOUND, "Key found from a cleared map");
+    }
+}
+
+void
+SatFlatHashMapTestCase::DoRun (void)
+{
+  CheckMap<SatFlatHashMapHash> (300);
+  CheckMap<SatCollidingHash> (100);
+}
+
+/**
+ * \ingroup satellite
+ * \brief Test case to unit test the order and the lookup of SatEncapContainer.
+ *
+ *   1.  Insert encapsulators of flows both to the container and to an ordered
+ *       map with EncapKeyCompare in a scrambled order. The flows differ by
+ *       source address, by each part of the destination address and by flow
+ *       id, also by flow ids having the highest bit set.
+ *   2.  Insert some of the flows again with other encapsulators.
+ *   3.  Iterate both and find each flow from the container.
+ *   4.  Clear the container.
+ *
+ *   Expected result:
+ *     The container is iterated in the same order as the ordered map, each
+ *     flow is found with its first encapsulator, inserting a flow again
+ *     returns its existing encapsulator, flows not inserted are not found
+ *     and the cleared container is empty.
+ *
+ */
+class SatEncapContainerTestCase : public TestCase
+{
+public:
+  SatEncapContainerTestCase ();
+  virtual ~SatEncapContainerTestCase ();
+
+private:
+  virtual void DoRun (void);
+};
+
+SatEncapContainerTestCase::SatEncapContainerTestCase ()
+  : TestCase ("Test the order and the lookup of the encapsulator container.")
+{
+}
+
+SatEncapContainerTestCase::~SatEncapContainerTestCase ()
+{
+}
+
+void
+SatEncapContainerTestCase::DoRun (void)
+{
+  typedef std::map<Ptr<EncapKey>, Ptr<SatBaseEncapsulator>, EncapKeyCompare> OrderedMap_t;
+
+  const uint8_t flowIds[] = { 0, 1, 3, 127, 128, 200, 255 };
+  const uint32_t flowIdCount = sizeof (flowIds) / sizeof (flowIds[0]);
+
+  std::vector<Ptr<EncapKey> > keys;
+
+  for (uint32_t s = 0; s < 3; s++)
+    {
+      for (uint32_t d = 0; d < 4; d++)
+        {
+          uint8_t source[6] = { 0, 0, 0, 0, 0, (uint8_t) (1 + s) };
+          uint8_t dest[6] = { 0, 0, 0, 0, 0, 0x10 };
+
+          // destinations differing in the part packed with the source and in the part packed with the flow id
+          dest[d % 2] = (uint8_t) (0x80 * (d / 2));
+          dest[5] = (uint8_t) (0x10 + d);
+
+          Mac48Address sourceAddress;
+          Mac48Address destAddress;
+          sourceAddress.CopyFrom (source);
+          destAddress.CopyFrom (dest);
+
+          for (uint32_t f = 0; f < flowIdCount; f++)
+            {
+              keys.push_back (Create<EncapKey> (sourceAddress, destAddress, flowIds[f]));
+            }
+        }
+    }
+
+  SatEncapContainer container;
+  OrderedMap_t orderedMap;
+
+  NS_TEST_ASSERT_MSG_EQ (container.empty (), true, "New container not empty");
+  NS_TEST_ASSERT_MSG_EQ ((container.begin () == container.end ()), true, "New container not empty");
+
+  // scrambled insertion order
+  for (uint32_t i = 0; i < keys.size (); i++)
+    {
+      Ptr<EncapKey> key = keys[(i * 37) % keys.size ()];
+      Ptr<SatBaseEncapsulator> encap = CreateObject<SatBaseEncapsulator> ();
+
+      std::pair<SatEncapContainer::iterator, bool> result = container.insert (std::make_pair (key, encap));
+      orderedMap.insert (std::make_pair (key, encap));
+
+      NS_TEST_ASSERT_MSG_EQ (result.second, true, "Flow " << i << " not inserted");
+      NS_TEST_ASSERT_MSG_EQ (result.first->second, encap, "Insert of flow " << i << " returned another encapsulator");
+    }
+
+  NS_TEST_ASSERT_MSG_EQ (keys.size (), orderedMap.size (), "Flows of the test not unique");
+
+  for (uint32_t i = 0; i < keys.size (); i += 5)
+    {
+      Ptr<EncapKey> key = Create<EncapKey> (keys[i]->m_source, keys[i]->m_destination, keys[i]->m_flowId);
+      std::pair<SatEncapContainer::iterator, bool> result = container.insert (std::make_pair (key, CreateObject<SatBaseEncapsulator> ()));
+
+      NS_TEST_ASSERT_MSG_EQ (result.second, false, "Flow " << i << " inserted twice");
+      NS_TEST_ASSERT_MSG_EQ (result.first->second, orderedMap[keys[i]], "Encapsulator of flow " << i << " replaced");
+    }
+
+  NS_TEST_ASSERT_MSG_EQ (container.size (), orderedMap.size (), "Unexpected container size");
+
+  SatEncapContainer::const_iterator it = container.begin ();
+  uint32_t position = 0;
+
+  for (OrderedMap_t::const_iterator expected = orderedMap.begin (); expected != orderedMap.end (); ++expected, ++it, ++position)
+    {
+      NS_TEST_ASSERT_MSG_EQ ((it != container.end ()), true, "Container ended at position " << position);
+      NS_TEST_ASSERT_MSG_EQ (it->first->m_source, expected->first->m_source, "Unexpected source at position " << position);
+      NS_TEST_ASSERT_MSG_EQ (it->first->m_destination, expected->first->m_destination, "Unexpected destination at position " << position);
+      NS_TEST_ASSERT_MSG_EQ ((int32_t) it->first->m_flowId, (int32_t) expected->first->m_flowId, "Unexpected flow id at position " << position);
+      NS_TEST_ASSERT_MSG_EQ (it->second, expected->second, "Unexpected encapsulator at position " << position);
+    }
+
+  NS_TEST_ASSERT_MSG_EQ ((it == container.end ()), true, "Container not ended with the ordered map");
+
+  for (OrderedMap_t::const_iterator expected = orderedMap.begin (); expected != orderedMap.end (); ++expected)
+    {
+      Ptr<EncapKey> key = expected->first;
+      SatEncapContainer::iterator found = container.find (key->m_source, key->m_destination, key->m_flowId);
+
+      NS_TEST_ASSERT_MSG_EQ ((found != container.end ()), true, "Flow not found");
+      NS_TEST_ASSERT_MSG_EQ (found->second, expected->second, "Unexpected encapsulator found");
+      NS_TEST_ASSERT_MSG_EQ ((container.find (key) == found), true, "Flow found by key at another position");
+
+      NS_TEST_ASSERT_MSG_EQ ((container.find (key->m_destination, key->m_source, key->m_flowId) == container.end ()), true,
+                             "Flow with swapped addresses found");
+      NS_TEST_ASSERT_MSG_EQ ((container.find (key->m_source, key->m_destination, 64) == container.end ()), true,
+                             "Flow with flow id not inserted found");
+    }
+
+  container.clear ();
+
+  NS_TEST_ASSERT_MSG_EQ (container.empty (), true, "Cleared container not empty");
+  NS_TEST_ASSERT_MSG_EQ ((container.begin () == container.end ()), true, "Cleared container not empty");
+  NS_TEST_ASSERT_MSG_EQ ((container.find (keys[0]) == container.end ()), true, "Flow found from a cleared container");
+}
+
+/**
+ * \ingroup satellite
+ * \brief Test suite for the flat hash map and the encapsulator container.
+ */
+class SatEncapContainerTestSuite : public TestSuite
+{
+public:
+  SatEncapContainerTestSuite ();
+};
+
+SatEncapContainerTestSuite::SatEncapContainerTestSuite ()
+  : TestSuite ("sat-encap-container-test", UNIT)
+{
+  AddTestCase (new SatFlatHashMapTestCase, TestCase::QUICK);
+  AddTestCase (new SatEncapContainerTestCase, TestCase::QUICK);
+}
+
+// Do allocate an instance of this TestSuite
+static SatEncapContainerTestSuite satEncapContainerTestSuite;
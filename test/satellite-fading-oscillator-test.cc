@@ -0,0 +1,145 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2016 Magister Solutions Ltd
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: agent <agent@local>
+ */
+
+/**
+ * \file satellite-fading-oscillator-test.cc
+ * \ingroup satellite
+ * \brief Test cases to unit test the fading oscillator bank.
+ */
+
+#include <vector>
+#include <complex>
+#include "ns3/log.h"
+#include "ns3/test.h"
+#include "ns3/simulator.h"
+#include "ns3/random-variable-stream.h"
+#include "../model/satellite-fading-oscillator.h"
+#include "../model/satellite-fading-oscillator-bank.h"
+
+using namespace ns3;
+
+/**
+ * \ingroup satellite
+ * \brief Test case to unit test the sums of SatFadingOscillatorBank.
+ *
+ *   1.  Create random oscillators both as SatFadingOscillator objects and
+ *       to SatFadingOscillatorBank banks.
+ *   2.  Sum the oscillator values of each bank at different times.
+ *
+ *   Expected result:
+ *     The bank sums are equal (in tolerance) to the sums of the
+ *     SatFadingOscillator values.
+ *
+ */
+class SatFadingOscillatorBankTestCase : public TestCase
+{
+public:
+  SatFadingOscillatorBankTestCase ();
+  virtual ~SatFadingOscillatorBankTestCase ();
+
+private:
+  virtual void DoRun (void);
+};
+
+SatFadingOscillatorBankTestCase::SatFadingOscillatorBankTestCase ()
+  : TestCase ("Test satellite fading oscillator bank.")
+{
+}
+
+SatFadingOscillatorBankTestCase::~SatFadingOscillatorBankTestCase ()
+{
+}
+
+void
+SatFadingOscillatorBankTestCase::DoRun (void)
+{
+  const uint32_t banks = 8;
+  const double tolerance = 1e-9;
+
+  Ptr<UniformRandomVariable> uniform = CreateObject<UniformRandomVariable> ();
+
+  std::vector<SatFadingOscillatorBank> complexBanks (banks);
+  std::vector<SatFadingOscillatorBank> cosineBanks (banks);
+  std::vector< std::vector< Ptr<SatFadingOscillator> > > complexOscillators (banks);
+  std::vector< std::vector< Ptr<SatFadingOscillator> > > cosineOscillators (banks);
+
+  for (uint32_t b = 0; b < banks; b++)
+    {
+      // different oscillator counts, including an empty bank
+      for (uint32_t i = 0; i < b * 3; i++)
+        {
+          double phase = uniform->GetValue (-M_PI, M_PI);
+          double omega = uniform->GetValue (0.0, 100.0);
+          std::complex<double> amplitude (uniform->GetValue (-1.0, 1.0), uniform->GetValue (-1.0, 1.0));
+          double realAmplitude = uniform->GetValue (0.0, 1.0);
+
+          complexBanks[b].Add (amplitude, phase, omega);
+          complexOscillators[b].push_back (CreateObject<SatFadingOscillator> (amplitude, phase, omega));
+
+          cosineBanks[b].Add (realAmplitude, phase, omega);
+          cosineOscillators[b].push_back (CreateObject<SatFadingOscillator> (realAmplitude, phase, omega));
+        }
+
+      NS_TEST_ASSERT_MSG_EQ (complexBanks[b].GetN (), b * 3, "Wrong number of oscillators");
+    }
+
+  for (double t = 0.0; t < 10.0; t += 0.37)
+    {
+      for (uint32_t b = 0; b < banks; b++)
+        {
+          std::complex<double> complexSum (0, 0);
+          std::complex<double> cosineSum (0, 0);
+
+          for (uint32_t i = 0; i < complexOscillators[b].size (); i++)
+            {
+              complexSum += complexOscillators[b][i]->GetComplexValueAt (t);
+              cosineSum += cosineOscillators[b][i]->GetCosineWaveValueAt (t);
+            }
+
+          std::complex<double> bankComplexSum = complexBanks[b].GetComplexSum (t);
+          std::complex<double> bankCosineSum = cosineBanks[b].GetCosineWaveSum (t);
+
+          NS_TEST_ASSERT_MSG_EQ_TOL (bankComplexSum.real (), complexSum.real (), tolerance, "Complex sum incorrect");
+          NS_TEST_ASSERT_MSG_EQ_TOL (bankComplexSum.imag (), complexSum.imag (), tolerance, "Complex sum incorrect");
+          NS_TEST_ASSERT_MSG_EQ_TOL (bankCosineSum.real (), cosineSum.real (), tolerance, "Cosine wave sum incorrect");
+          NS_TEST_ASSERT_MSG_EQ_TOL (bankCosineSum.imag (), cosineSum.imag (), tolerance, "Cosine wave sum incorrect");
+        }
+    }
+
+  Simulator::Destroy ();
+}
+
+/**
+ * \brief Test suite for satellite fading oscillator unit test cases.
+ */
+class SatFadingOscillatorTestSuite : public TestSuite
+{
+public:
+  SatFadingOscillatorTestSuite ();
+};
+
+SatFadingOscillatorTestSuite::SatFadingOscillatorTestSuite ()
+  : TestSuite ("sat-fading-oscillator-test", UNIT)
+{
+  AddTestCase (new SatFadingOscillatorBankTestCase, TestCase::QUICK);
+}
+
+// Do allocate an instance of this TestSuite
+static SatFadingOscillatorTestSuite satFadingOscillatorTestSuite;
@@ -191,7 +191,7 @@ SatFrameAllocatorTestCase::RunSingleUtTest (SatSuperframeConf::ConfigType_t conf
                       tbtpContainer.push_back (tptp);
                       SatFrameAllocator::UtAllocInfoContainer_t utAllocContainer;
 
-                      m_frameAllocator->GenerateTimeSlots (tbtpContainer, 1000, utAllocContainer, false, TracedCallback<uint32_t> (), TracedCallback<uint32_t, uint32_t> (), TracedCallback<uint32_t, double> ());
+                      m_frameAllocator->GenerateTimeSlots (tbtpContainer, Create<SatTbtpMessagePool> (), 1000, utAllocContainer, false, TracedCallback<uint32_t> (), TracedCallback<uint32_t, uint32_t> (), TracedCallback<uint32_t, double> ());
 
                       CheckSingleUtTestResults (bytesReq, req, allocationResult, configType, tbtpContainer, utAllocContainer, false, fcaEnabled, acmEnabled);
 
@@ -202,7 +202,7 @@ SatFrameAllocatorTestCase::RunSingleUtTest (SatSuperframeConf::ConfigType_t conf
                       tbtpContainer.push_back (tptp);
                       utAllocContainer.clear ();
 
-                      m_frameAllocator->GenerateTimeSlots (tbtpContainer, 1000, utAllocContainer, true, TracedCallback<uint32_t> (), TracedCallback<uint32_t, uint32_t> (), TracedCallback<uint32_t, double> ());
+                      m_frameAllocator->GenerateTimeSlots (tbtpContainer, Create<SatTbtpMessagePool> (), 1000, utAllocContainer, true, TracedCallback<uint32_t> (), TracedCallback<uint32_t, uint32_t> (), TracedCallback<uint32_t, double> ());
 
                       CheckSingleUtTestResults (bytesReq, req, allocationResult, configType, tbtpContainer, utAllocContainer, true, fcaEnabled, acmEnabled);
                     }
@@ -242,7 +242,7 @@ SatFrameAllocatorTestCase::RunSingleUtTest (SatSuperframeConf::ConfigType_t conf
               tbtpContainer.push_back (tptp);
               SatFrameAllocator::UtAllocInfoContainer_t utAllocContainer;
 
-              m_frameAllocator->GenerateTimeSlots (tbtpContainer, 1000, utAllocContainer, false, TracedCallback<uint32_t> (), TracedCallback<uint32_t, uint32_t> (), TracedCallback<uint32_t, double> ());
+              m_frameAllocator->GenerateTimeSlots (tbtpContainer, Create<SatTbtpMessagePool> (), 1000, utAllocContainer, false, TracedCallback<uint32_t> (), TracedCallback<uint32_t, uint32_t> (), TracedCallback<uint32_t, double> ());
 
               CheckSingleUtTestResults (bytesReq, req, allocationResult, configType, tbtpContainer, utAllocContainer, false, fcaEnabled, acmEnabled);
 
@@ -253,7 +253,7 @@ SatFrameAllocatorTestCase::RunSingleUtTest (SatSuperframeConf::ConfigType_t conf
               tbtpContainer.push_back (tptp);
               utAllocContainer.clear ();
 
-              m_frameAllocator->GenerateTimeSlots (tbtpContainer, 1000, utAllocContainer, true, TracedCallback<uint32_t> (), TracedCallback<uint32_t, uint32_t> (), TracedCallback<uint32_t, double> () );
+              m_frameAllocator->GenerateTimeSlots (tbtpContainer, Create<SatTbtpMessagePool> (), 1000, utAllocContainer, true, TracedCallback<uint32_t> (), TracedCallback<uint32_t, uint32_t> (), TracedCallback<uint32_t, double> () );
 
               CheckSingleUtTestResults (bytesReq, req, allocationResult, configType, tbtpContainer, utAllocContainer, true, fcaEnabled, acmEnabled);
             }
@@ -277,14 +277,14 @@ SatFrameAllocatorTestCase::CheckSingleUtTestResults (uint32_t bytesReq, SatFrame
 
   for ( SatFrameAllocator::TbtpMsgContainer_t::const_iterator it = tbtpContainer.begin (); it != tbtpContainer.end (); it++)
     {
-      SatTbtpMessage::DaTimeSlotInfoItem_t info = (*it)->GetDaTimeslots (req.m_address);
+      const SatTbtpMessage::DaTimeSlotInfoItem_t& info = (*it)->GetDaTimeslots (req.m_address);
 
-      for (SatTbtpMessage::DaTimeSlotConfContainer_t::const_iterator it2 = info.second.begin (); it2 != info.second.end (); it2++ )
+      for (uint32_t i = info.first; i < info.first + info.count; i++ )
         {
-          tbtpAllocatedBytes += m_frameConf->GetWaveformConf ()->GetWaveform ((*it2)->GetWaveFormId ())->GetPayloadInBytes ();
+          tbtpAllocatedBytes += m_frameConf->GetWaveformConf ()->GetWaveform ((*it)->GetDaTimeslot (i).waveFormId)->GetPayloadInBytes ();
         }
 
-      slotsAllocated += info.second.size ();
+      slotsAllocated += info.count;
     }
 
   // check that information is identical in TBTP container and UT allocation container
@@ -420,7 +420,7 @@ SatFrameAllocatorTestCase::RunMultiUtTest ()
               tbtpContainer.push_back (tptp);
               SatFrameAllocator::UtAllocInfoContainer_t utAllocContainer;
 
-              m_frameAllocator->GenerateTimeSlots (tbtpContainer, 1000, utAllocContainer, false, TracedCallback<uint32_t> (), TracedCallback<uint32_t, uint32_t> (), TracedCallback<uint32_t, double> ());
+              m_frameAllocator->GenerateTimeSlots (tbtpContainer, Create<SatTbtpMessagePool> (), 1000, utAllocContainer, false, TracedCallback<uint32_t> (), TracedCallback<uint32_t, uint32_t> (), TracedCallback<uint32_t, double> ());
 
               ReqInfo_t reqInfo;
               reqInfo.insert (std::make_pair ( req[n].m_address, std::make_pair (req[n], utBytesReq[n])) );
@@ -456,7 +456,7 @@ SatFrameAllocatorTestCase::RunMultiUtTest ()
               tbtpContainer.push_back (tptp);
               SatFrameAllocator::UtAllocInfoContainer_t utAllocContainer;
 
-              m_frameAllocator->GenerateTimeSlots (tbtpContainer, 1000, utAllocContainer, false, TracedCallback<uint32_t> (), TracedCallback<uint32_t, uint32_t> (), TracedCallback<uint32_t, double> ());
+              m_frameAllocator->GenerateTimeSlots (tbtpContainer, Create<SatTbtpMessagePool> (), 1000, utAllocContainer, false, TracedCallback<uint32_t> (), TracedCallback<uint32_t, uint32_t> (), TracedCallback<uint32_t, double> ());
 
               ReqInfo_t reqInfo;
               reqInfo.insert (std::make_pair ( req[n].m_address, std::make_pair (req[n], utBytesReq[n])) );
@@ -0,0 +1,258 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2016 Magister Solutions Ltd
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: agent <agent@local>
+ */
+
+/**
+ * \file satellite-id-mapper-test.cc
+ * \ingroup satellite
+ * \brief Test cases to unit test the SatIdMapper records and handles.
+ */
+
+#include <vector>
+#include "ns3/log.h"
+#include "ns3/test.h"
+#include "ns3/ptr.h"
+#include "ns3/address.h"
+#include "ns3/mac16-address.h"
+#include "ns3/mac48-address.h"
+#include "../model/satellite-id-mapper.h"
+#include "../model/satellite-node-info.h"
+
+using namespace ns3;
+
+/**
+ * \ingroup satellite
+ * \brief Test case to unit test attaching IDs to MAC addresses and
+ * looking them up with the MAC addresses and with the handles.
+ *
+ *   1.  Attach IDs to enough MAC addresses to grow the hash table of the
+ *       mapper several times, different IDs to different addresses.
+ *   2.  Look up the IDs and the handles of all the addresses.
+ *   3.  Store the handle of an address to a SatNodeInfo.
+ *
+ *   Expected result:
+ *     The IDs attached before and after growing the table are found both
+ *     with the MAC address and with the handle, the handle of an address does
+ *     not change when the table grows, and the SatNodeInfo returns the stored
+ *     handle.
+ *
+ */
+class SatIdMapperLookupTestCase : public TestCase
+{
+public:
+  SatIdMapperLookupTestCase ();
+  virtual ~SatIdMapperLookupTestCase ();
+
+private:
+  virtual void DoRun (void);
+};
+
+SatIdMapperLookupTestCase::SatIdMapperLookupTestCase ()
+  : TestCase ("Test looking up SatIdMapper IDs with MAC addresses and handles.")
+{
+}
+
+SatIdMapperLookupTestCase::~SatIdMapperLookupTestCase ()
+{
+}
+
+void
+SatIdMapperLookupTestCase::DoRun (void)
+{
+  const uint32_t macCount = 1000;
+
+  Ptr<SatIdMapper> mapper = CreateObject<SatIdMapper> ();
+
+  std::vector<Mac48Address> macs;
+  std::vector<uint32_t> handles;
+  std::vector<uint32_t> traceIds;
+  std::vector<uint32_t> utIds;
+
+  for (uint32_t i = 0; i < macCount; ++i)
+    {
+      Mac48Address mac = Mac48Address::Allocate ();
+      macs.push_back (mac);
+
+      traceIds.push_back (mapper->AttachMacToTraceId (mac));
+      mapper->AttachMacToBeamId (mac, i % 72);
+
+      // every other address as UT, the others as GW
+      if (i % 2 == 0)
+        {
+          utIds.push_back (mapper->AttachMacToUtId (mac));
+        }
+      else
+        {
+          utIds.push_back (0);
+          mapper->AttachMacToGwId (mac, i);
+        }
+
+      handles.push_back (mapper->GetHandleWithMac (mac));
+
+      NS_TEST_ASSERT_MSG_NE (handles.back (), SatIdMapper::INVALID_HANDLE, "No handle for attached MAC " << mac);
+    }
+
+  for (uint32_t i = 0; i < macCount; ++i)
+    {
+      Address mac = macs[i];
+      uint32_t handle = mapper->GetHandleWithMac (mac);
+
+      NS_TEST_ASSERT_MSG_EQ (handle, handles[i], "Handle of MAC " << macs[i] << " changed");
+
+      NS_TEST_ASSERT_MSG_EQ (mapper->GetTraceIdWithMac (mac), (int32_t) traceIds[i], "Unexpected trace ID of MAC " << macs[i]);
+      NS_TEST_ASSERT_MSG_EQ (mapper->GetBeamIdWithMac (mac), (int32_t) (i % 72), "Unexpected beam ID of MAC " << macs[i]);
+
+      if (i % 2 == 0)
+        {
+          NS_TEST_ASSERT_MSG_EQ (mapper->GetUtIdWithMac (mac), (int32_t) utIds[i], "Unexpected UT ID of MAC " << macs[i]);
+          NS_TEST_ASSERT_MSG_EQ (mapper->GetGwIdWithMac (mac), -1, "Unexpected GW ID of UT MAC " << macs[i]);
+        }
+      else
+        {
+          NS_TEST_ASSERT_MSG_EQ (mapper->GetUtIdWithMac (mac), -1, "Unexpected UT ID of GW MAC " << macs[i]);
+          NS_TEST_ASSERT_MSG_EQ (mapper->GetGwIdWithMac (mac), (int32_t) i, "Unexpected GW ID of MAC " << macs[i]);
+        }
+
+      NS_TEST_ASSERT_MSG_EQ (mapper->GetUtUserIdWithMac (mac), -1, "Unexpected UT user ID of MAC " << macs[i]);
+      NS_TEST_ASSERT_MSG_EQ (mapper->GetGwUserIdWithMac (mac), -1, "Unexpected GW user ID of MAC " << macs[i]);
+
+      // The handle lookups agree with the MAC address lookups
+      NS_TEST_ASSERT_MSG_EQ (mapper->GetTraceIdWithHandle (handle), mapper->GetTraceIdWithMac (mac), "Trace ID of handle differs");
+      NS_TEST_ASSERT_MSG_EQ (mapper->GetUtIdWithHandle (handle), mapper->GetUtIdWithMac (mac), "UT ID of handle differs");
+      NS_TEST_ASSERT_MSG_EQ (mapper->GetUtUserIdWithHandle (handle), mapper->GetUtUserIdWithMac (mac), "UT user ID of handle differs");
+      NS_TEST_ASSERT_MSG_EQ (mapper->GetBeamIdWithHandle (handle), mapper->GetBeamIdWithMac (mac), "Beam ID of handle differs");
+      NS_TEST_ASSERT_MSG_EQ (mapper->GetGwIdWithHandle (handle), mapper->GetGwIdWithMac (mac), "GW ID of handle differs");
+      NS_TEST_ASSERT_MSG_EQ (mapper->GetGwUserIdWithHandle (handle), mapper->GetGwUserIdWithMac (mac), "GW user ID of handle differs");
+    }
+
+  // A user ID attached later is found with the earlier handle
+  uint32_t utUserId = mapper->AttachMacToUtUserId (macs[0]);
+  NS_TEST_ASSERT_MSG_EQ (mapper->GetUtUserIdWithHandle (handles[0]), (int32_t) utUserId, "UT user ID not found with the handle");
+
+  Ptr<SatNodeInfo> nodeInfo = Create<SatNodeInfo> (SatEnums::NT_UT, 0, macs[0]);
+  NS_TEST_ASSERT_MSG_EQ (nodeInfo->GetIdMapperHandle (), SatIdMapper::INVALID_HANDLE, "Handle of new node info is set");
+
+  nodeInfo->SetIdMapperHandle (mapper->GetHandleWithMac (nodeInfo->GetMacAddress ()));
+  NS_TEST_ASSERT_MSG_EQ (nodeInfo->GetIdMapperHandle (), handles[0], "Unexpected handle of node info");
+  NS_TEST_ASSERT_MSG_EQ (mapper->GetUtIdWithHandle (nodeInfo->GetIdMapperHandle ()), (int32_t) utIds[0], "Unexpected UT ID with node info handle");
+
+  mapper->Dispose ();
+}
+
+/**
+ * \ingroup satellite
+ * \brief Test case to unit test looking up addresses which are not in SatIdMapper.
+ *
+ *   1.  Attach IDs to some MAC addresses.
+ *   2.  Look up MAC addresses without IDs, a non-MAC address and an invalid handle.
+ *   3.  Reset the mapper and look up the earlier attached addresses.
+ *
+ *   Expected result:
+ *     The lookups return an invalid handle and -1 as the IDs.
+ *
+ */
+class SatIdMapperNotFoundTestCase : public TestCase
+{
+public:
+  SatIdMapperNotFoundTestCase ();
+  virtual ~SatIdMapperNotFoundTestCase ();
+
+private:
+  virtual void DoRun (void);
+};
+
+SatIdMapperNotFoundTestCase::SatIdMapperNotFoundTestCase ()
+  : TestCase ("Test looking up addresses which are not in SatIdMapper.")
+{
+}
+
+SatIdMapperNotFoundTestCase::~SatIdMapperNotFoundTestCase ()
+{
+}
+
+void
+SatIdMapperNotFoundTestCase::DoRun (void)
+{
+  Ptr<SatIdMapper> mapper = CreateObject<SatIdMapper> ();
+
+  // Lookups from an empty mapper
+  Address unknown = Mac48Address::Allocate ();
+  NS_TEST_ASSERT_MSG_EQ (mapper->GetHandleWithMac (unknown), SatIdMapper::INVALID_HANDLE, "Handle found from empty mapper");
+  NS_TEST_ASSERT_MSG_EQ (mapper->GetTraceIdWithMac (unknown), -1, "Trace ID found from empty mapper");
+
+  std::vector<Mac48Address> macs;
+
+  for (uint32_t i = 0; i < 100; ++i)
+    {
+      macs.push_back (Mac48Address::Allocate ());
+      mapper->AttachMacToTraceId (macs.back ());
+    }
+
+  for (uint32_t i = 0; i < 100; ++i)
+    {
+      Address mac = Mac48Address::Allocate ();
+
+      NS_TEST_ASSERT_MSG_EQ (mapper->GetHandleWithMac (mac), SatIdMapper::INVALID_HANDLE, "Handle found for unknown MAC");
+      NS_TEST_ASSERT_MSG_EQ (mapper->GetTraceIdWithMac (mac), -1, "Trace ID found for unknown MAC");
+      NS_TEST_ASSERT_MSG_EQ (mapper->GetUtIdWithMac (mac), -1, "UT ID found for unknown MAC");
+      NS_TEST_ASSERT_MSG_EQ (mapper->GetUtUserIdWithMac (mac), -1, "UT user ID found for unknown MAC");
+      NS_TEST_ASSERT_MSG_EQ (mapper->GetBeamIdWithMac (mac), -1, "Beam ID found for unknown MAC");
+      NS_TEST_ASSERT_MSG_EQ (mapper->GetGwIdWithMac (mac), -1, "GW ID found for unknown MAC");
+      NS_TEST_ASSERT_MSG_EQ (mapper->GetGwUserIdWithMac (mac), -1, "GW user ID found for unknown MAC");
+    }
+
+  Address nonMac = Mac16Address::Allocate ();
+  NS_TEST_ASSERT_MSG_EQ (mapper->GetHandleWithMac (nonMac), SatIdMapper::INVALID_HANDLE, "Handle found for non-MAC address");
+  NS_TEST_ASSERT_MSG_EQ (mapper->GetTraceIdWithMac (nonMac), -1, "Trace ID found for non-MAC address");
+
+  NS_TEST_ASSERT_MSG_EQ (mapper->GetTraceIdWithHandle (SatIdMapper::INVALID_HANDLE), -1, "Trace ID found with invalid handle");
+  NS_TEST_ASSERT_MSG_EQ (mapper->GetUtIdWithHandle (SatIdMapper::INVALID_HANDLE), -1, "UT ID found with invalid handle");
+  NS_TEST_ASSERT_MSG_EQ (mapper->GetGwIdWithHandle (SatIdMapper::INVALID_HANDLE), -1, "GW ID found with invalid handle");
+  NS_TEST_ASSERT_MSG_EQ (mapper->GetTraceIdWithHandle (macs.size ()), -1, "Trace ID found with handle past the records");
+
+  mapper->Reset ();
+
+  for (uint32_t i = 0; i < macs.size (); ++i)
+    {
+      NS_TEST_ASSERT_MSG_EQ (mapper->GetHandleWithMac (macs[i]), SatIdMapper::INVALID_HANDLE, "Handle found after reset");
+      NS_TEST_ASSERT_MSG_EQ (mapper->GetTraceIdWithMac (macs[i]), -1, "Trace ID found after reset");
+    }
+
+  mapper->Dispose ();
+}
+
+/**
+ * \ingroup satellite
+ * \brief Test suite for SatIdMapper.
+ */
+class SatIdMapperTestSuite : public TestSuite
+{
+public:
+  SatIdMapperTestSuite ();
+};
+
+SatIdMapperTestSuite::SatIdMapperTestSuite ()
+  : TestSuite ("sat-id-mapper-test", UNIT)
+{
+  AddTestCase (new SatIdMapperLookupTestCase, TestCase::QUICK);
+  AddTestCase (new SatIdMapperNotFoundTestCase, TestCase::QUICK);
+}
+
+// Do allocate an instance of this TestSuite
+static SatIdMapperTestSuite satIdMapperTestSuite;
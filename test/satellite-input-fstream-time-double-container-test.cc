@@ -0,0 +1,420 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2016 Magister Solutions Ltd
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: agent <agent@local>
+ */
+
+/**
+ * \file satellite-input-fstream-time-double-container-test.cc
+ * \ingroup satellite
+ * \brief Test cases to unit test locating the time samples of the input trace container.
+ */
+
+#include <vector>
+#include <string>
+#include <fstream>
+#include <iomanip>
+#include <cmath>
+#include <cstring>
+#include <unistd.h>
+#include "ns3/log.h"
+#include "ns3/test.h"
+#include "ns3/ptr.h"
+#include "ns3/simulator.h"
+#include "ns3/nstime.h"
+#include "../utils/satellite-input-fstream-time-double-container.h"
+#include "../utils/satellite-binary-data-file.h"
+
+using namespace ns3;
+
+/**
+ * \ingroup satellite
+ * \brief Reference time sample locator scanning the samples forward one by
+ * one and looping them one pass at a time, i.e. the way the samples were
+ * located before the binary search.
+ */
+class SatTimeSampleForwardScan
+{
+public:
+  /**
+   * \brief Constructor
+   * \param rows Rows of the samples, the time in the first column
+   */
+  SatTimeSampleForwardScan (const std::vector<std::vector<double> >& rows)
+    : m_rows (rows),
+      m_lastValidPosition (0),
+      m_numOfPasses (0),
+      m_timeShiftValue (0)
+  {
+  }
+
+  /**
+   * \brief Locate the next closest time sample
+   * \param comparisonTimeValue Current time
+   * \return Row of the located sample
+   */
+  std::vector<double> Proceed (double comparisonTimeValue)
+  {
+    while (!FindNextClosest (m_lastValidPosition, m_timeShiftValue, comparisonTimeValue))
+      {
+        m_lastValidPosition = 0;
+        m_numOfPasses++;
+        m_timeShiftValue = m_numOfPasses * m_rows.back ()[0];
+      }
+
+    return m_rows[m_lastValidPosition];
+  }
+
+private:
+  bool FindNextClosest (uint32_t lastValidPosition, double timeShiftValue, double comparisonTimeValue)
+  {
+    bool valueFound = false;
+
+    for (uint32_t i = lastValidPosition; i < m_rows.size (); i++)
+      {
+        if (m_rows[i][0] + timeShiftValue >= comparisonTimeValue)
+          {
+            double difference1 = std::abs (m_rows[lastValidPosition][0] + timeShiftValue - comparisonTimeValue);
+            double difference2 = std::abs (m_rows[i][0] + timeShiftValue - comparisonTimeValue);
+
+            m_lastValidPosition = (difference1 < difference2) ? lastValidPosition : i;
+            valueFound = true;
+            break;
+          }
+        lastValidPosition = i;
+      }
+
+    if (valueFound && m_numOfPasses > 0 && m_lastValidPosition == 0)
+      {
+        double difference1 = std::abs (m_rows[m_lastValidPosition][0] + timeShiftValue - comparisonTimeValue);
+        double difference2 = std::abs (m_rows.back ()[0] + ((m_numOfPasses - 1) * m_rows.back ()[0]) - comparisonTimeValue);
+
+        if (difference1 > difference2)
+          {
+            m_lastValidPosition = m_rows.size () - 1;
+            m_numOfPasses--;
+            m_timeShiftValue = m_numOfPasses * m_rows.back ()[0];
+          }
+      }
+
+    return valueFound;
+  }
+
+  std::vector<std::vector<double> > m_rows;
+  uint32_t m_lastValidPosition;
+  uint32_t m_numOfPasses;
+  double m_timeShiftValue;
+};
+
+/**
+ * \brief Create the rows of a time series
+ * \param uniform Are the time samples uniformly spaced
+ * \return Rows of [time, index, value]
+ */
+static std::vector<std::vector<double> >
+CreateTimeSeries (bool uniform)
+{
+  std::vector<std::vector<double> > rows;
+  double time = 0.5;
+
+  for (uint32_t i = 0; i < 40; i++)
+    {
+      std::vector<double> row;
+      row.push_back (time);
+      row.push_back (i);
+      row.push_back (std::sin (0.7 * i) / 3.0);
+      rows.push_back (row);
+
+      if (uniform)
+        {
+          time += 0.25;
+        }
+      else if (i != 17)
+        {
+          // irregular steps, samples 17 and 18 have the same time
+          time += 0.05 + 0.3 * ((i * 7) % 5) / 5.0;
+        }
+    }
+
+  return rows;
+}
+
+/**
+ * \brief Write the rows of a time series to a text file with full precision
+ * \param fileName Name of the text file
+ * \param rows Rows to write
+ */
+static void
+WriteTimeSeries (std::string fileName, const std::vector<std::vector<double> >& rows)
+{
+  std::ofstream ofs (fileName.c_str ());
+  ofs << std::setprecision (17);
+
+  for (uint32_t i = 0; i < rows.size (); i++)
+    {
+      ofs << rows[i][0] << " " << rows[i][1] << " " << rows[i][2] << std::endl;
+    }
+}
+
+/**
+ * \ingroup satellite
+ * \brief Test case to unit test locating the closest time samples.
+ *
+ *   1.  Write a time series with uniformly or irregularly spaced time samples
+ *       to a text file and load it to the container.
+ *   2.  Locate the closest samples at increasing simulation times spanning
+ *       several passes over the samples and exactly between two samples.
+ *       Optionally jump over several passes at once and hit the times around
+ *       the pass boundaries.
+ *   3.  Locate the samples with the reference forward scan at the same times.
+ *
+ *   Expected result:
+ *     The container returns the same rows as the reference at every time,
+ *     i.e. also the wrap-around to the next pass and the returning to the
+ *     last sample of the previous pass match the reference.
+ *
+ */
+class SatInputFstreamTimeLookupTestCase : public TestCase
+{
+public:
+  SatInputFstreamTimeLookupTestCase (std::string name, bool uniform, bool jumpPasses);
+  virtual ~SatInputFstreamTimeLookupTestCase ();
+
+private:
+  virtual void DoRun (void);
+  void Check ();
+
+  bool m_uniform;
+  bool m_jumpPasses;
+  uint32_t m_checks;
+  Ptr<SatInputFileStreamTimeDoubleContainer> m_container;
+  SatTimeSampleForwardScan * m_reference;
+};
+
+SatInputFstreamTimeLookupTestCase::SatInputFstreamTimeLookupTestCase (std::string name, bool uniform, bool jumpPasses)
+  : TestCase (name),
+    m_uniform (uniform),
+    m_jumpPasses (jumpPasses),
+    m_checks (0),
+    m_container (),
+    m_reference (0)
+{
+}
+
+SatInputFstreamTimeLookupTestCase::~SatInputFstreamTimeLookupTestCase ()
+{
+}
+
+void
+SatInputFstreamTimeLookupTestCase::Check ()
+{
+  double now = Simulator::Now ().GetSeconds ();
+  std::vector<double> expected = m_reference->Proceed (now);
+  std::vector<double> row = m_container->ProceedToNextClosestTimeSample ();
+
+  NS_TEST_EXPECT_MSG_EQ (row.size (), expected.size (), "Unexpected row size @ " << now);
+
+  for (uint32_t i = 0; i < row.size () && i < expected.size (); i++)
+    {
+      NS_TEST_EXPECT_MSG_EQ (row[i], expected[i], "Unexpected value in column " << i << " @ " << now);
+    }
+
+  NS_TEST_EXPECT_MSG_EQ (m_container->ProceedToNextClosestTimeSample (1), expected[1], "Unexpected index @ " << now);
+
+  m_checks++;
+}
+
+void
+SatInputFstreamTimeLookupTestCase::DoRun (void)
+{
+  std::string fileName = CreateTempDirFilename (m_uniform ? "sat-time-lookup-uniform.txt" : "sat-time-lookup-irregular.txt");
+  std::vector<std::vector<double> > rows = CreateTimeSeries (m_uniform);
+  WriteTimeSeries (fileName, rows);
+
+  m_container = CreateObject<SatInputFileStreamTimeDoubleContainer> (fileName, std::ios::in, 3);
+  m_reference = new SatTimeSampleForwardScan (rows);
+
+  double period = rows.back ()[0];
+  std::vector<double> times;
+
+  // fine steps not aligned with the samples over several passes
+  for (double t = 0; t < 3.5 * period; t += period / 97.0)
+    {
+      times.push_back (t);
+    }
+
+  // exactly between two samples, the later sample is the closest one
+  for (uint32_t i = 1; i < rows.size (); i++)
+    {
+      times.push_back (4 * period + (rows[i - 1][0] + rows[i][0]) / 2);
+    }
+
+  if (m_jumpPasses)
+    {
+      // jump over several passes at once
+      times.push_back (6.3 * period);
+      times.push_back (9.05 * period);
+
+      // around the pass boundaries, where the last sample of the previous pass may be the closest one
+      for (uint32_t pass = 10; pass < 14; pass++)
+        {
+          times.push_back (pass * period - 0.01);
+          times.push_back (pass * period + 0.001);
+          times.push_back (pass * period + 0.2);
+        }
+
+      times.push_back (31.7 * period);
+    }
+
+  for (uint32_t i = 0; i < times.size (); i++)
+    {
+      Simulator::Schedule (Seconds (times[i]), &SatInputFstreamTimeLookupTestCase::Check, this);
+    }
+
+  Simulator::Run ();
+  Simulator::Destroy ();
+
+  NS_TEST_ASSERT_MSG_EQ (m_checks, times.size (), "Not all the times checked");
+
+  delete m_reference;
+  m_reference = 0;
+  m_container = 0;
+  unlink (fileName.c_str ());
+}
+
+/**
+ * \ingroup satellite
+ * \brief Test case to unit test converting a text input trace to a binary data file.
+ *
+ *   1.  Write a time series to a text file and load it to the container.
+ *   2.  Write the binary data file of the text file with the container.
+ *   3.  Open the binary data file and load the text file again, i.e. the
+ *       binary data file is used.
+ *   4.  Locate each time sample with the container.
+ *
+ *   Expected result:
+ *     The binary data file and the rows located by the container are bit
+ *     identical to the values written to the text file.
+ *
+ */
+class SatInputFstreamTimeBinaryFileTestCase : public TestCase
+{
+public:
+  SatInputFstreamTimeBinaryFileTestCase ();
+  virtual ~SatInputFstreamTimeBinaryFileTestCase ();
+
+private:
+  virtual void DoRun (void);
+  void Check (uint32_t index);
+
+  std::vector<std::vector<double> > m_rows;
+  Ptr<SatInputFileStreamTimeDoubleContainer> m_container;
+};
+
+SatInputFstreamTimeBinaryFileTestCase::SatInputFstreamTimeBinaryFileTestCase ()
+  : TestCase ("Test converting an input trace to a binary data file."),
+    m_rows (),
+    m_container ()
+{
+}
+
+SatInputFstreamTimeBinaryFileTestCase::~SatInputFstreamTimeBinaryFileTestCase ()
+{
+}
+
+void
+SatInputFstreamTimeBinaryFileTestCase::Check (uint32_t index)
+{
+  std::vector<double> row = m_container->ProceedToNextClosestTimeSample ();
+
+  NS_TEST_EXPECT_MSG_EQ (row.size (), m_rows[index].size (), "Unexpected row size of sample " << index);
+
+  if (row.size () == m_rows[index].size ())
+    {
+      NS_TEST_EXPECT_MSG_EQ (std::memcmp (&row[0], &m_rows[index][0], row.size () * sizeof (double)), 0,
+                             "Sample " << index << " not bit identical");
+    }
+}
+
+void
+SatInputFstreamTimeBinaryFileTestCase::DoRun (void)
+{
+  std::string textFile = CreateTempDirFilename ("sat-time-binary-file.txt");
+  std::string binaryFile = SatBinaryDataFile::GetBinaryFileName (textFile);
+  m_rows = CreateTimeSeries (false);
+  WriteTimeSeries (textFile, m_rows);
+
+  unlink (binaryFile.c_str ());
+  Ptr<SatInputFileStreamTimeDoubleContainer> textContainer = CreateObject<SatInputFileStreamTimeDoubleContainer> (textFile, std::ios::in, 3);
+  textContainer->WriteBinaryFile (binaryFile);
+  textContainer = 0;
+
+  Ptr<SatBinaryDataFile> file = SatBinaryDataFile::OpenForTextFile (textFile, SatBinaryDataFile::CONTENT_TIME_SERIES);
+
+  NS_TEST_ASSERT_MSG_NE (file, 0, "Written binary data file not opened");
+  NS_TEST_ASSERT_MSG_EQ (file->GetRows (), m_rows.size (), "Unexpected row count");
+  NS_TEST_ASSERT_MSG_EQ (file->GetColumns (), 3, "Unexpected column count");
+
+  for (uint32_t i = 0; i < m_rows.size (); i++)
+    {
+      NS_TEST_ASSERT_MSG_EQ (std::memcmp (file->GetData () + i * 3, &m_rows[i][0], 3 * sizeof (double)), 0,
+                             "Binary data of row " << i << " not bit identical");
+    }
+
+  file = 0;
+
+  m_container = CreateObject<SatInputFileStreamTimeDoubleContainer> (textFile, std::ios::in, 3);
+
+  // the samples 17 and 18 have the same time, the first one of them is located
+  for (uint32_t i = 0; i < m_rows.size (); i++)
+    {
+      if (i != 18)
+        {
+          Simulator::Schedule (Seconds (m_rows[i][0]), &SatInputFstreamTimeBinaryFileTestCase::Check, this, i);
+        }
+    }
+
+  Simulator::Run ();
+  Simulator::Destroy ();
+
+  m_container = 0;
+  unlink (binaryFile.c_str ());
+  unlink (textFile.c_str ());
+}
+
+/**
+ * \ingroup satellite
+ * \brief Test suite for the input trace container.
+ */
+class SatInputFstreamTimeDoubleContainerTestSuite : public TestSuite
+{
+public:
+  SatInputFstreamTimeDoubleContainerTestSuite ();
+};
+
+SatInputFstreamTimeDoubleContainerTestSuite::SatInputFstreamTimeDoubleContainerTestSuite ()
+  : TestSuite ("sat-input-fstream-time-double-container-test", UNIT)
+{
+  AddTestCase (new SatInputFstreamTimeLookupTestCase ("Test locating uniformly spaced time samples.", true, false), TestCase::QUICK);
+  AddTestCase (new SatInputFstreamTimeLookupTestCase ("Test locating irregularly spaced time samples.", false, false), TestCase::QUICK);
+  AddTestCase (new SatInputFstreamTimeLookupTestCase ("Test looping uniformly spaced time samples.", true, true), TestCase::QUICK);
+  AddTestCase (new SatInputFstreamTimeLookupTestCase ("Test looping irregularly spaced time samples.", false, true), TestCase::QUICK);
+  AddTestCase (new SatInputFstreamTimeBinaryFileTestCase, TestCase::QUICK);
+}
+
+// Do allocate an instance of this TestSuite
+static SatInputFstreamTimeDoubleContainerTestSuite satInputFstreamTimeDoubleContainerTestSuite;
@@ -36,6 +36,7 @@
 #include "../model/satellite-constant-interference.h"
 #include "../model/satellite-traced-interference.h"
 #include "../model/satellite-per-packet-interference.h"
+#include "../model/satellite-per-packet-indexed-interference.h"
 #include "ns3/singleton.h"
 #include "../utils/satellite-env-variables.h"
 
@@ -117,7 +118,8 @@ SatConstantInterferenceTestCase::DoRun (void)
  * \brief Test case to unit test satellite per packet interference model.
  *
  * This case tests that SatPerPacketInterference object can be created successfully and interference value calculated correctly.
- *  1.  Create SatPerPacketInterference object.
+ * The same case is used to test SatPerPacketIndexedInterference, which shall give the same results.
+ *  1.  Create SatPerPacketInterference (or SatPerPacketIndexedInterference) object.
  *  2.  Create events, add them to SatPerPacketInterference about them.
  *  3.  Notify SatPerPacketInterference about the event wanted to calculate.
  *  4.  Get interference with calculate method with the event to calculate.
@@ -130,6 +132,7 @@ class SatPerPacketInterferenceTestCase : public TestCase
 {
 public:
   SatPerPacketInterferenceTestCase ();
+  SatPerPacketInterferenceTestCase (Ptr<SatInterference> interference, std::string description);
   virtual ~SatPerPacketInterferenceTestCase ();
 
   // adds interference to model object
@@ -143,7 +146,7 @@ public:
 
 private:
   virtual void DoRun (void);
-  Ptr<SatPerPacketInterference> m_interference;
+  Ptr<SatInterference> m_interference;
   Ptr<SatInterference::InterferenceChangeEvent> m_rxEvent[4];
   uint32_t  m_rxIndex;
   double finalPower[4];
@@ -162,6 +165,19 @@ SatPerPacketInterferenceTestCase::SatPerPacketInterferenceTestCase ()
     }
 }
 
+SatPerPacketInterferenceTestCase::SatPerPacketInterferenceTestCase (Ptr<SatInterference> interference, std::string description)
+  : TestCase (description)
+{
+  m_interference = interference;
+  m_rxIndex = 0;
+
+  for (int i = 0; i < 4; i++)
+    {
+      finalPower[i] = 0;
+      m_rxEvent[i] = NULL;
+    }
+}
+
 SatPerPacketInterferenceTestCase::~SatPerPacketInterferenceTestCase ()
 {
 }
@@ -254,6 +270,8 @@ SatInterferenceTestSuite::SatInterferenceTestSuite ()
 {
   AddTestCase (new SatConstantInterferenceTestCase, TestCase::QUICK);
   AddTestCase (new SatPerPacketInterferenceTestCase, TestCase::QUICK);
+  AddTestCase (new SatPerPacketInterferenceTestCase (CreateObject<SatPerPacketIndexedInterference> (),
+                                                     "Test satellite indexed per packet interference model."), TestCase::QUICK);
 }
 
 // Do allocate an instance of this TestSuite
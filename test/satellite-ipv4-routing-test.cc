@@ -0,0 +1,353 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2016 Magister Solutions Ltd
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: agent <agent@local>
+ */
+
+/**
+ * \file satellite-ipv4-routing-test.cc
+ * \ingroup satellite
+ * \brief Test cases to unit test SatIpv4Routing against Ipv4StaticRouting.
+ */
+
+#include <vector>
+#include "ns3/log.h"
+#include "ns3/test.h"
+#include "ns3/simulator.h"
+#include "ns3/singleton.h"
+#include "ns3/packet.h"
+#include "ns3/ipv4.h"
+#include "ns3/ipv4-header.h"
+#include "ns3/ipv4-route.h"
+#include "ns3/ipv4-static-routing.h"
+#include "ns3/ipv4-static-routing-helper.h"
+#include "../helper/satellite-helper.h"
+#include "../helper/satellite-user-helper.h"
+#include "../helper/satellite-ipv4-routing-helper.h"
+#include "../model/satellite-ipv4-routing.h"
+#include "../utils/satellite-env-variables.h"
+
+using namespace ns3;
+
+/**
+ * \ingroup satellite
+ * \brief Test case to unit test that SatIpv4Routing makes the same forwarding
+ * decisions as Ipv4StaticRouting holding the UT network routes.
+ *
+ *   1.  Create the larger scenario, in which the UT network routes of the GWs
+ *       and of the router are held by SatIpv4Routing.
+ *   2.  For the GWs and the router, create an Ipv4StaticRouting holding the
+ *       static routes of the node and the UT network routes, i.e. the routing
+ *       setup used without SatIpv4Routing.
+ *   3.  Route output and input packets to the GW, UT and user addresses, and
+ *       to unassigned addresses of the user networks, with both the setups.
+ *   4.  Set the satellite interface of a GW down and repeat the step 3.
+ *
+ *   Expected result:
+ *     Both the setups find the same routes, or no route, for all the addresses.
+ *
+ */
+class SatIpv4RoutingEquivalenceTestCase : public TestCase
+{
+public:
+  SatIpv4RoutingEquivalenceTestCase ();
+  virtual ~SatIpv4RoutingEquivalenceTestCase ();
+
+private:
+  virtual void DoRun (void);
+
+  /**
+   * \brief Create the reference static routing of a node
+   * \param ipv4 IPv4 protocol of the node
+   * \return Static routing holding the static and the UT network routes of the node
+   */
+  Ptr<Ipv4StaticRouting> CreateReferenceRouting (Ptr<Ipv4> ipv4);
+
+  /**
+   * \brief Compare the routing of a node to the reference routing
+   * \param ipv4 IPv4 protocol of the node
+   * \param reference Reference routing
+   * \param addresses Destination addresses to route
+   */
+  void CompareRoutings (Ptr<Ipv4> ipv4, Ptr<Ipv4StaticRouting> reference, const std::vector<Ipv4Address>& addresses);
+
+  /**
+   * \brief Compare two routes
+   * \param route Route of the node
+   * \param expected Route of the reference routing
+   * \param dest Destination address
+   */
+  void CompareRoutes (Ptr<Ipv4Route> route, Ptr<Ipv4Route> expected, Ipv4Address dest);
+
+  /**
+   * \brief Route an input packet and store the result
+   * \param routing Routing protocol
+   * \param idev Input device
+   * \param dest Destination address
+   */
+  void RouteInput (Ptr<Ipv4RoutingProtocol> routing, Ptr<NetDevice> idev, Ipv4Address dest);
+
+  void UnicastForward (Ptr<Ipv4Route> route, Ptr<const Packet> p, const Ipv4Header &header);
+  void MulticastForward (Ptr<Ipv4MulticastRoute> route, Ptr<const Packet> p, const Ipv4Header &header);
+  void LocalDeliver (Ptr<const Packet> p, const Ipv4Header &header, uint32_t interface);
+  void Error (Ptr<const Packet> p, const Ipv4Header &header, Socket::SocketErrno sockerr);
+
+  /**
+   * Route of the last forwarded input packet
+   */
+  Ptr<Ipv4Route> m_inputRoute;
+
+  /**
+   * Whether the last input packet was delivered locally
+   */
+  bool m_localDelivered;
+
+  /**
+   * Whether the last input packet was dropped with an error
+   */
+  bool m_error;
+};
+
+SatIpv4RoutingEquivalenceTestCase::SatIpv4RoutingEquivalenceTestCase ()
+  : TestCase ("Test that SatIpv4Routing routes as Ipv4StaticRouting with the UT network routes."),
+    m_inputRoute (),
+    m_localDelivered (false),
+    m_error (false)
+{
+}
+
+SatIpv4RoutingEquivalenceTestCase::~SatIpv4RoutingEquivalenceTestCase ()
+{
+}
+
+/**
+ * \brief Add the addresses of the nodes, and an unassigned address of the
+ * network of each address
+ * \param nodes Nodes
+ * \param addresses Addresses to add to
+ */
+static void
+AddAddresses (NodeContainer nodes, std::vector<Ipv4Address>& addresses)
+{
+  for (NodeContainer::Iterator it = nodes.Begin (); it != nodes.End (); ++it)
+    {
+      Ptr<Ipv4> ipv4 = (*it)->GetObject<Ipv4> ();
+
+      // interface 0 is the loopback interface
+      for (uint32_t i = 1; i < ipv4->GetNInterfaces (); ++i)
+        {
+          for (uint32_t j = 0; j < ipv4->GetNAddresses (i); ++j)
+            {
+              Ipv4Address address = ipv4->GetAddress (i, j).GetLocal ();
+              addresses.push_back (address);
+              addresses.push_back (Ipv4Address (address.Get () + 200));
+            }
+        }
+    }
+}
+
+Ptr<Ipv4StaticRouting>
+SatIpv4RoutingEquivalenceTestCase::CreateReferenceRouting (Ptr<Ipv4> ipv4)
+{
+  Ipv4StaticRoutingHelper staticRoutingHelper;
+  SatIpv4RoutingHelper satRoutingHelper;
+  Ptr<Ipv4StaticRouting> staticRouting = staticRoutingHelper.GetStaticRouting (ipv4);
+  Ptr<SatIpv4Routing> satRouting = satRoutingHelper.GetSatRouting (ipv4);
+
+  // Setting the IPv4 adds the routes of the interfaces which are up
+  Ptr<Ipv4StaticRouting> reference = CreateObject<Ipv4StaticRouting> ();
+  reference->SetIpv4 (ipv4);
+
+  for (uint32_t i = 0; i < staticRouting->GetNRoutes (); ++i)
+    {
+      Ipv4RoutingTableEntry route = staticRouting->GetRoute (i);
+      reference->AddNetworkRouteTo (route.GetDestNetwork (), route.GetDestNetworkMask (), route.GetGateway (),
+                                    route.GetInterface (), staticRouting->GetMetric (i));
+    }
+
+  // The UT network routes are added after the static routes, as the
+  // helpers did before SatIpv4Routing
+  for (uint32_t i = 0; i < satRouting->GetNRoutes (); ++i)
+    {
+      Ipv4RoutingTableEntry route = satRouting->GetRoute (i);
+      reference->AddNetworkRouteTo (route.GetDestNetwork (), route.GetDestNetworkMask (), route.GetGateway (),
+                                    route.GetInterface ());
+    }
+
+  return reference;
+}
+
+void
+SatIpv4RoutingEquivalenceTestCase::CompareRoutes (Ptr<Ipv4Route> route, Ptr<Ipv4Route> expected, Ipv4Address dest)
+{
+  NS_TEST_ASSERT_MSG_EQ ((route == 0), (expected == 0), "Route found by only one of the routings to " << dest);
+
+  if (route != 0 && expected != 0)
+    {
+      NS_TEST_ASSERT_MSG_EQ (route->GetDestination (), expected->GetDestination (), "Unexpected route destination to " << dest);
+      NS_TEST_ASSERT_MSG_EQ (route->GetSource (), expected->GetSource (), "Unexpected source address to " << dest);
+      NS_TEST_ASSERT_MSG_EQ (route->GetGateway (), expected->GetGateway (), "Unexpected gateway to " << dest);
+      NS_TEST_ASSERT_MSG_EQ (route->GetOutputDevice (), expected->GetOutputDevice (), "Unexpected output device to " << dest);
+    }
+}
+
+void
+SatIpv4RoutingEquivalenceTestCase::RouteInput (Ptr<Ipv4RoutingProtocol> routing, Ptr<NetDevice> idev, Ipv4Address dest)
+{
+  Ipv4Header header;
+  header.SetDestination (dest);
+
+  m_inputRoute = 0;
+  m_localDelivered = false;
+  m_error = false;
+
+  routing->RouteInput (Create<Packet> (), header, idev,
+                       MakeCallback (&SatIpv4RoutingEquivalenceTestCase::UnicastForward, this),
+                       MakeCallback (&SatIpv4RoutingEquivalenceTestCase::MulticastForward, this),
+                       MakeCallback (&SatIpv4RoutingEquivalenceTestCase::LocalDeliver, this),
+                       MakeCallback (&SatIpv4RoutingEquivalenceTestCase::Error, this));
+}
+
+void
+SatIpv4RoutingEquivalenceTestCase::CompareRoutings (Ptr<Ipv4> ipv4, Ptr<Ipv4StaticRouting> reference, const std::vector<Ipv4Address>& addresses)
+{
+  Ptr<Ipv4RoutingProtocol> routing = ipv4->GetRoutingProtocol ();
+
+  for (std::vector<Ipv4Address>::const_iterator it = addresses.begin (); it != addresses.end (); ++it)
+    {
+      Ipv4Header header;
+      header.SetDestination (*it);
+      Socket::SocketErrno sockerr;
+
+      Ptr<Ipv4Route> route = routing->RouteOutput (Create<Packet> (), header, 0, sockerr);
+      Ptr<Ipv4Route> expected = reference->RouteOutput (Create<Packet> (), header, 0, sockerr);
+
+      CompareRoutes (route, expected, *it);
+
+      // Input packets are received from every interface of the node
+      for (uint32_t i = 1; i < ipv4->GetNInterfaces (); ++i)
+        {
+          Ptr<NetDevice> idev = ipv4->GetNetDevice (i);
+
+          RouteInput (routing, idev, *it);
+          Ptr<Ipv4Route> inputRoute = m_inputRoute;
+          bool localDelivered = m_localDelivered;
+          bool error = m_error;
+
+          RouteInput (reference, idev, *it);
+
+          CompareRoutes (inputRoute, m_inputRoute, *it);
+          NS_TEST_ASSERT_MSG_EQ (localDelivered, m_localDelivered, "Unexpected local delivery of " << *it);
+          NS_TEST_ASSERT_MSG_EQ (error, m_error, "Unexpected error of " << *it);
+        }
+    }
+}
+
+void
+SatIpv4RoutingEquivalenceTestCase::UnicastForward (Ptr<Ipv4Route> route, Ptr<const Packet> p, const Ipv4Header &header)
+{
+  m_inputRoute = route;
+}
+
+void
+SatIpv4RoutingEquivalenceTestCase::MulticastForward (Ptr<Ipv4MulticastRoute> route, Ptr<const Packet> p, const Ipv4Header &header)
+{
+}
+
+void
+SatIpv4RoutingEquivalenceTestCase::LocalDeliver (Ptr<const Packet> p, const Ipv4Header &header, uint32_t interface)
+{
+  m_localDelivered = true;
+}
+
+void
+SatIpv4RoutingEquivalenceTestCase::Error (Ptr<const Packet> p, const Ipv4Header &header, Socket::SocketErrno sockerr)
+{
+  m_error = true;
+}
+
+void
+SatIpv4RoutingEquivalenceTestCase::DoRun (void)
+{
+  // Set simulation output details
+  Singleton<SatEnvVariables>::Get ()->DoInitialize ();
+  Singleton<SatEnvVariables>::Get ()->SetOutputVariables ("test-sat-ipv4-routing", "equivalence", true);
+
+  Ptr<SatHelper> helper = CreateObject<SatHelper> ();
+  helper->CreatePredefinedScenario (SatHelper::LARGER);
+
+  std::vector<Ipv4Address> addresses;
+  AddAddresses (helper->GwNodes (), addresses);
+  AddAddresses (helper->UtNodes (), addresses);
+  AddAddresses (helper->GetGwUsers (), addresses);
+  AddAddresses (helper->GetUtUsers (), addresses);
+
+  NodeContainer nodes = helper->GwNodes ();
+  nodes.Add (helper->GetUserHelper ()->GetRouter ());
+
+  std::vector<Ptr<Ipv4StaticRouting> > references;
+
+  for (NodeContainer::Iterator it = nodes.Begin (); it != nodes.End (); ++it)
+    {
+      Ptr<Ipv4> ipv4 = (*it)->GetObject<Ipv4> ();
+      references.push_back (CreateReferenceRouting (ipv4));
+      CompareRoutings (ipv4, references.back (), addresses);
+    }
+
+  // Set down the satellite interface of the first GW
+  Ptr<Ipv4> ipv4Gw = nodes.Get (0)->GetObject<Ipv4> ();
+  SatIpv4RoutingHelper satRoutingHelper;
+  Ptr<SatIpv4Routing> satRoutingGw = satRoutingHelper.GetSatRouting (ipv4Gw);
+
+  NS_TEST_ASSERT_MSG_NE (satRoutingGw->GetNRoutes (), 0, "No UT network routes at the GW");
+
+  uint32_t interface = satRoutingGw->GetRoute (0).GetInterface ();
+
+  // The reference routing is not installed to the node, so it is notified here
+  ipv4Gw->SetDown (interface);
+  references[0]->NotifyInterfaceDown (interface);
+
+  CompareRoutings (ipv4Gw, references[0], addresses);
+
+  for (std::vector<Ptr<Ipv4StaticRouting> >::iterator it = references.begin (); it != references.end (); ++it)
+    {
+      (*it)->Dispose ();
+    }
+
+  Simulator::Destroy ();
+
+  Singleton<SatEnvVariables>::Get ()->DoDispose ();
+}
+
+/**
+ * \ingroup satellite
+ * \brief Test suite for SatIpv4Routing.
+ */
+class SatIpv4RoutingTestSuite : public TestSuite
+{
+public:
+  SatIpv4RoutingTestSuite ();
+};
+
+SatIpv4RoutingTestSuite::SatIpv4RoutingTestSuite ()
+  : TestSuite ("sat-ipv4-routing-test", UNIT)
+{
+  AddTestCase (new SatIpv4RoutingEquivalenceTestCase, TestCase::QUICK);
+}
+
+// Do allocate an instance of this TestSuite
+static SatIpv4RoutingTestSuite satIpv4RoutingTestSuite;
@@ -25,9 +25,16 @@
  * \brief Test cases for satellite link results.
  */
 
+#include <fstream>
+#include <vector>
 #include <ns3/test.h>
 #include <ns3/satellite-link-results.h>
 #include <ns3/satellite-look-up-table.h>
+#include <ns3/satellite-env-variables.h>
+#include <ns3/satellite-utils.h>
+#include <ns3/singleton.h>
+#include <ns3/config.h>
+#include <ns3/double.h>
 #include <ns3/log.h>
 #include <ns3/ptr.h>
 
@@ -158,6 +165,164 @@ SatLinkResultsDvbS2TestCase::DoRun ()
 
 
 
+/*
+ * LOOK UP TABLE GRID TEST CASE
+ */
+
+/**
+ * \brief Test case for comparing the grid indexed look ups of SatLookUpTable
+ *        with a linear search over the original link results table.
+ *
+ * The link results file is read directly by the test case, and BLER and
+ * Es/No values are calculated from it in the same way as SatLookUpTable did
+ * before indexing the table with a uniform Es/No grid. The look ups are
+ * compared over the whole Es/No range of the file (and beyond) with a fine
+ * resolution, thus also the values close to the grid cell boundaries are
+ * tested.
+ */
+class SatLookUpTableGridTestCase : public TestCase
+{
+public:
+  /**
+   * \param fileName name of the link results file in the link results directory
+   * \param gridStepDb Es/No grid step of the look up table in dB
+   */
+  SatLookUpTableGridTestCase (std::string fileName, double gridStepDb);
+private:
+  virtual void DoRun ();
+
+  /**
+   * \brief Get the BLER by a linear search over the original table
+   * \param esNoDb Es/No in dB
+   * \return BLER
+   */
+  double GetReferenceBler (double esNoDb) const;
+
+  /**
+   * \brief Get the Es/No by a linear search over the original table
+   * \param blerTarget BLER target
+   * \return Es/No in dB
+   */
+  double GetReferenceEsNoDb (double blerTarget) const;
+
+  std::string m_fileName;
+  double m_gridStepDb;
+  std::vector<double> m_esNoDb;
+  std::vector<double> m_bler;
+};
+
+
+SatLookUpTableGridTestCase::SatLookUpTableGridTestCase (std::string fileName, double gridStepDb)
+  : TestCase ("Comparing SatLookUpTable grid look ups of " + fileName + " with the original table"),
+    m_fileName (fileName),
+    m_gridStepDb (gridStepDb)
+{
+}
+
+
+double
+SatLookUpTableGridTestCase::GetReferenceBler (double esNoDb) const
+{
+  uint32_t n = m_esNoDb.size ();
+
+  if (esNoDb < m_esNoDb[0])
+    {
+      return 1.0;
+    }
+
+  uint32_t i = 1;
+
+  while ((i < n) && (esNoDb > m_esNoDb[i]))
+    {
+      i++;
+    }
+
+  if (i >= n)
+    {
+      return 0.0;
+    }
+
+  return SatUtils::Interpolate (esNoDb, m_esNoDb[i - 1], m_esNoDb[i], m_bler[i - 1], m_bler[i]);
+}
+
+
+double
+SatLookUpTableGridTestCase::GetReferenceEsNoDb (double blerTarget) const
+{
+  uint32_t n = m_bler.size ();
+
+  if (blerTarget < m_bler[n - 1])
+    {
+      return m_esNoDb[n - 1];
+    }
+
+  uint32_t i = 1;
+
+  while (blerTarget < m_bler[i])
+    {
+      i++;
+    }
+
+  return SatUtils::Interpolate (blerTarget, m_bler[i - 1], m_bler[i], m_esNoDb[i - 1], m_esNoDb[i]);
+}
+
+
+void
+SatLookUpTableGridTestCase::DoRun ()
+{
+  NS_LOG_FUNCTION (this << m_fileName << m_gridStepDb);
+
+  std::string dataPath = Singleton<SatEnvVariables>::Get ()->LocateDataDirectory ();
+  std::string filePathName = dataPath + "/linkresults/" + m_fileName;
+
+  std::ifstream ifs (filePathName.c_str (), std::ifstream::in);
+  NS_TEST_ASSERT_MSG_EQ (ifs.is_open (), true, "The file " << filePathName << " is not found");
+
+  double esNoDb, bler;
+  ifs >> esNoDb >> bler;
+
+  while (ifs.good ())
+    {
+      m_esNoDb.push_back (esNoDb);
+      m_bler.push_back (bler);
+      ifs >> esNoDb >> bler;
+    }
+
+  NS_TEST_ASSERT_MSG_EQ ((m_esNoDb.size () > 1), true, "Too few rows in " << filePathName);
+
+  Config::SetDefault ("ns3::SatLookUpTable::EsNoGridStepDb", DoubleValue (m_gridStepDb));
+  Ptr<SatLookUpTable> table = CreateObject<SatLookUpTable> (filePathName);
+  Config::Reset ();
+
+  // Es/No sweep over the table range with a resolution finer than the grid
+  for (double esNo = m_esNoDb.front () - 1.0; esNo <= m_esNoDb.back () + 1.0; esNo += 0.001)
+    {
+      NS_TEST_ASSERT_MSG_EQ_TOL (table->GetBler (esNo), GetReferenceBler (esNo), 1e-12,
+                                 "BLER differs from the original table at Es/No " << esNo);
+    }
+
+  // Exactly at the table entries
+  for (uint32_t i = 0; i < m_esNoDb.size (); ++i)
+    {
+      NS_TEST_ASSERT_MSG_EQ_TOL (table->GetBler (m_esNoDb[i]), GetReferenceBler (m_esNoDb[i]), 1e-12,
+                                 "BLER differs from the original table at Es/No " << m_esNoDb[i]);
+    }
+
+  // BLER targets used for the Es/No requirements
+  double blerTargets[] = { 1.0e-1, 1.0e-2, 1.0e-3, 1.0e-4, 1.0e-5, 1.0e-6 };
+
+  for (uint32_t i = 0; i < sizeof (blerTargets) / sizeof (blerTargets[0]); ++i)
+    {
+      if (blerTargets[i] <= m_bler[1])
+        {
+          NS_TEST_ASSERT_MSG_EQ_TOL (table->GetEsNoDb (blerTargets[i]), GetReferenceEsNoDb (blerTargets[i]), 1e-12,
+                                     "Es/No differs from the original table at BLER " << blerTargets[i]);
+        }
+    }
+}
+
+
+
 /*
  * TEST SUITE
  */
@@ -789,6 +954,15 @@ public:
 
     // END OF AUTO-GENERATED TEST CASES
 
+    // Grid indexed look ups with the default grid step and with grid steps
+    // coarser than the Es/No resolution of the link results
+    AddTestCase (new SatLookUpTableGridTestCase ("rcs2_waveformat2.txt", 0.01), TestCase::QUICK);
+    AddTestCase (new SatLookUpTableGridTestCase ("rcs2_waveformat2.txt", 0.37), TestCase::QUICK);
+    AddTestCase (new SatLookUpTableGridTestCase ("rcs2_waveformat14.txt", 0.01), TestCase::QUICK);
+    AddTestCase (new SatLookUpTableGridTestCase ("rcs2_waveformat14.txt", 1.0), TestCase::QUICK);
+    AddTestCase (new SatLookUpTableGridTestCase ("s2_qpsk_1_to_2.txt", 0.01), TestCase::QUICK);
+    AddTestCase (new SatLookUpTableGridTestCase ("s2_qpsk_1_to_2.txt", 0.25), TestCase::QUICK);
+
   } // end of LinkResultTestSuite ()
 
 } g_linkResultTestSuite;
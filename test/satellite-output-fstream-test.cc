@@ -0,0 +1,345 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2016 Magister Solutions Ltd
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: agent <agent@local>
+ */
+
+/**
+ * \file satellite-output-fstream-test.cc
+ * \ingroup satellite
+ * \brief Test cases to unit test the background writing of the output
+ * file stream containers.
+ */
+
+#include <vector>
+#include <string>
+#include <sstream>
+#include <fstream>
+#include <cstring>
+#include <unistd.h>
+#include "ns3/log.h"
+#include "ns3/test.h"
+#include "ns3/ptr.h"
+#include "ns3/uinteger.h"
+#include "../utils/satellite-output-fstream-background-writer.h"
+#include "../utils/satellite-output-fstream-double-container.h"
+
+using namespace ns3;
+
+/**
+ * \ingroup satellite
+ * \brief Read the values of a text file written by SatOutputFileStreamBackgroundWriter
+ * \param fileName Name of the file
+ * \return Values of the file row by row
+ */
+static std::vector<double>
+ReadTextValues (std::string fileName)
+{
+  std::vector<double> values;
+  std::ifstream ifs (fileName.c_str ());
+  double value;
+
+  while (ifs >> value)
+    {
+      values.push_back (value);
+    }
+
+  return values;
+}
+
+/**
+ * \ingroup satellite
+ * \brief Test case to unit test the order of the rows written in the text format.
+ *
+ *   1.  Give one row jobs for two files alternately to a writer, more jobs
+ *       than fit to the job queue of the writer at once.
+ *   2.  Wait until the jobs are written.
+ *
+ *   Expected result:
+ *     Both the files hold their rows in the order the jobs were given, in the
+ *     text format.
+ *
+ */
+class SatBackgroundWriterTextTestCase : public TestCase
+{
+public:
+  SatBackgroundWriterTextTestCase ();
+  virtual ~SatBackgroundWriterTextTestCase ();
+
+private:
+  virtual void DoRun (void);
+};
+
+SatBackgroundWriterTextTestCase::SatBackgroundWriterTextTestCase ()
+  : TestCase ("Test the order of the rows written by the background writer in text format.")
+{
+}
+
+SatBackgroundWriterTextTestCase::~SatBackgroundWriterTextTestCase ()
+{
+}
+
+void
+SatBackgroundWriterTextTestCase::DoRun (void)
+{
+  std::string fileNames[2] = { CreateTempDirFilename ("sat-background-writer-text-0.txt"),
+                               CreateTempDirFilename ("sat-background-writer-text-1.txt") };
+  uint32_t jobs = 200;
+
+  SatOutputFileStreamBackgroundWriter writer;
+
+  for (uint32_t i = 0; i < jobs; ++i)
+    {
+      for (uint32_t f = 0; f < 2; ++f)
+        {
+          std::vector<double> values;
+          values.push_back (f);
+          values.push_back (i);
+
+          std::ios::openmode fileMode = (i == 0) ? std::ofstream::out : (std::ofstream::out | std::ofstream::app);
+          writer.Write (fileNames[f], fileMode, SatOutputFileStreamBackgroundWriter::FORMAT_TEXT, 2, values, false);
+
+          NS_TEST_ASSERT_MSG_EQ (values.empty (), true, "Values not moved to the writer");
+        }
+    }
+
+  writer.Wait ();
+
+  for (uint32_t f = 0; f < 2; ++f)
+    {
+      std::vector<double> values = ReadTextValues (fileNames[f]);
+
+      NS_TEST_ASSERT_MSG_EQ (values.size (), 2 * jobs, "Unexpected number of values in file " << f);
+
+      for (uint32_t i = 0; i < jobs && 2 * i + 1 < values.size (); ++i)
+        {
+          NS_TEST_ASSERT_MSG_EQ (values[2 * i], f, "Unexpected file of row " << i);
+          NS_TEST_ASSERT_MSG_EQ (values[2 * i + 1], i, "Unexpected order of row " << i);
+        }
+
+      unlink (fileNames[f].c_str ());
+    }
+}
+
+/**
+ * \ingroup satellite
+ * \brief Test case to unit test the binary format.
+ *
+ *   1.  Give jobs of several rows to a writer, the first job writing the
+ *       binary file header.
+ *   2.  Wait until the jobs are written.
+ *
+ *   Expected result:
+ *     The file has the header and one block per job, the values of a
+ *     block stored column by column.
+ *
+ */
+class SatBackgroundWriterBinaryTestCase : public TestCase
+{
+public:
+  SatBackgroundWriterBinaryTestCase ();
+  virtual ~SatBackgroundWriterBinaryTestCase ();
+
+private:
+  virtual void DoRun (void);
+};
+
+SatBackgroundWriterBinaryTestCase::SatBackgroundWriterBinaryTestCase ()
+  : TestCase ("Test the binary format written by the background writer.")
+{
+}
+
+SatBackgroundWriterBinaryTestCase::~SatBackgroundWriterBinaryTestCase ()
+{
+}
+
+void
+SatBackgroundWriterBinaryTestCase::DoRun (void)
+{
+  std::string fileName = CreateTempDirFilename ("sat-background-writer-binary.bin");
+  uint32_t valuesInRow = 3;
+  uint32_t jobs = 4;
+
+  SatOutputFileStreamBackgroundWriter writer;
+
+  // job j has j + 1 rows, the value of row i and column c is 100 * j + 10 * i + c
+  for (uint32_t j = 0; j < jobs; ++j)
+    {
+      std::vector<double> values;
+
+      for (uint32_t i = 0; i <= j; ++i)
+        {
+          for (uint32_t c = 0; c < valuesInRow; ++c)
+            {
+              values.push_back (100 * j + 10 * i + c);
+            }
+        }
+
+      std::ios::openmode fileMode = std::ofstream::binary | ((j == 0) ? std::ofstream::out : (std::ofstream::out | std::ofstream::app));
+      writer.Write (fileName, fileMode, SatOutputFileStreamBackgroundWriter::FORMAT_BINARY, valuesInRow, values, j == 0);
+    }
+
+  writer.Wait ();
+
+  std::ifstream ifs (fileName.c_str (), std::ifstream::binary);
+  char magic[8];
+  uint32_t header[2];
+
+  ifs.read (magic, sizeof (magic));
+  ifs.read (reinterpret_cast<char *> (header), sizeof (header));
+
+  NS_TEST_ASSERT_MSG_EQ (ifs.good (), true, "Binary file header not read");
+  NS_TEST_ASSERT_MSG_EQ (std::memcmp (magic, "SATTRACE", sizeof (magic)), 0, "Unexpected identifier");
+  NS_TEST_ASSERT_MSG_EQ (header[0], SatOutputFileStreamBackgroundWriter::BINARY_FORMAT_VERSION, "Unexpected format version");
+  NS_TEST_ASSERT_MSG_EQ (header[1], valuesInRow, "Unexpected number of values in a row");
+
+  for (uint32_t j = 0; j < jobs; ++j)
+    {
+      uint32_t blockHeader[2];
+      ifs.read (reinterpret_cast<char *> (blockHeader), sizeof (blockHeader));
+
+      NS_TEST_ASSERT_MSG_EQ (ifs.good (), true, "Block header " << j << " not read");
+      NS_TEST_ASSERT_MSG_EQ (blockHeader[0], j + 1, "Unexpected number of rows in block " << j);
+
+      std::vector<double> block (blockHeader[0] * valuesInRow);
+      ifs.read (reinterpret_cast<char *> (&block[0]), block.size () * sizeof (double));
+
+      NS_TEST_ASSERT_MSG_EQ (ifs.good (), true, "Block " << j << " not read");
+
+      for (uint32_t c = 0; c < valuesInRow; ++c)
+        {
+          for (uint32_t i = 0; i <= j; ++i)
+            {
+              NS_TEST_ASSERT_MSG_EQ (block[c * (j + 1) + i], 100 * j + 10 * i + c,
+                                     "Unexpected value of row " << i << " column " << c << " in block " << j);
+            }
+        }
+    }
+
+  ifs.peek ();
+  NS_TEST_ASSERT_MSG_EQ (ifs.eof (), true, "Unexpected data after the last block");
+  ifs.close ();
+
+  unlink (fileName.c_str ());
+}
+
+/**
+ * \ingroup satellite
+ * \brief Test case to unit test writing many containers at the same time.
+ *
+ *   1.  Create more double containers than there are file descriptors
+ *       available by default, with a small buffer size.
+ *   2.  Add rows to the containers in turns, so that the buffers of all the
+ *       containers are flushed several times before any of the containers
+ *       is written to the file.
+ *   3.  Write the containers to the files.
+ *
+ *   Expected result:
+ *     The containers do not keep their files open between the flushes, and
+ *     each file holds the rows of its container in order.
+ *
+ */
+class SatDoubleContainerManyFilesTestCase : public TestCase
+{
+public:
+  SatDoubleContainerManyFilesTestCase ();
+  virtual ~SatDoubleContainerManyFilesTestCase ();
+
+private:
+  virtual void DoRun (void);
+};
+
+SatDoubleContainerManyFilesTestCase::SatDoubleContainerManyFilesTestCase ()
+  : TestCase ("Test flushing more double containers than there are file descriptors.")
+{
+}
+
+SatDoubleContainerManyFilesTestCase::~SatDoubleContainerManyFilesTestCase ()
+{
+}
+
+void
+SatDoubleContainerManyFilesTestCase::DoRun (void)
+{
+  uint32_t containerCount = 1100;
+  uint32_t rows = 7;
+
+  std::vector<std::string> fileNames;
+  std::vector<Ptr<SatOutputFileStreamDoubleContainer> > containers;
+
+  for (uint32_t k = 0; k < containerCount; ++k)
+    {
+      std::ostringstream name;
+      name << "sat-double-container-" << k << ".txt";
+      fileNames.push_back (CreateTempDirFilename (name.str ()));
+
+      Ptr<SatOutputFileStreamDoubleContainer> container =
+        CreateObject<SatOutputFileStreamDoubleContainer> (fileNames.back (), std::ofstream::out, 2);
+      container->SetAttribute ("BufferSize", UintegerValue (2));
+      containers.push_back (container);
+    }
+
+  for (uint32_t i = 0; i < rows; ++i)
+    {
+      for (uint32_t k = 0; k < containerCount; ++k)
+        {
+          std::vector<double> row;
+          row.push_back (k);
+          row.push_back (i);
+          containers[k]->AddToContainer (row);
+        }
+    }
+
+  for (uint32_t k = 0; k < containerCount; ++k)
+    {
+      containers[k]->WriteContainerToFile ();
+      containers[k]->Dispose ();
+
+      std::vector<double> values = ReadTextValues (fileNames[k]);
+
+      NS_TEST_ASSERT_MSG_EQ (values.size (), 2 * rows, "Unexpected number of values in file " << k);
+
+      for (uint32_t i = 0; i < rows && 2 * i + 1 < values.size (); ++i)
+        {
+          NS_TEST_ASSERT_MSG_EQ (values[2 * i], k, "Unexpected container of row " << i << " in file " << k);
+          NS_TEST_ASSERT_MSG_EQ (values[2 * i + 1], i, "Unexpected order of row " << i << " in file " << k);
+        }
+
+      unlink (fileNames[k].c_str ());
+    }
+}
+
+/**
+ * \ingroup satellite
+ * \brief Test suite for the output file stream background writing.
+ */
+class SatOutputFileStreamTestSuite : public TestSuite
+{
+public:
+  SatOutputFileStreamTestSuite ();
+};
+
+SatOutputFileStreamTestSuite::SatOutputFileStreamTestSuite ()
+  : TestSuite ("sat-output-fstream-test", UNIT)
+{
+  AddTestCase (new SatBackgroundWriterTextTestCase, TestCase::QUICK);
+  AddTestCase (new SatBackgroundWriterBinaryTestCase, TestCase::QUICK);
+  AddTestCase (new SatDoubleContainerManyFilesTestCase, TestCase::QUICK);
+}
+
+// Do allocate an instance of this TestSuite
+static SatOutputFileStreamTestSuite satOutputFileStreamTestSuite;
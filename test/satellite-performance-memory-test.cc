@@ -38,9 +38,12 @@
 #include "ns3/enum.h"
 #include "ns3/cbr-application.h"
 #include "ns3/cbr-helper.h"
+#include "ns3/system-wall-clock-ms.h"
 #include "../helper/satellite-helper.h"
+#include "../stats/satellite-stats-helper-container.h"
 #include "ns3/singleton.h"
 #include "../utils/satellite-env-variables.h"
+#include <fstream>
 
 using namespace ns3;
 
@@ -156,6 +159,87 @@ Pm1::DoRun (void)
   // <<< End of actual test using Simple scenario <<<
 }
 
+/**
+ * \ingroup satellite
+ * \brief 'Statistics install time' test case implementation, id: pm-2.
+ *
+ * Full scenario created with helper
+ * 1.  A set of global, per beam and per UT statistics is installed.
+ * 2.  The wall clock time of installing the statistics is measured and saved
+ *     into file stats-install-time.txt in the output directory.
+ *
+ * Expected results: The statistics are installed. The measured time is not
+ * compared to any limit, but saved for tracking the install time of the
+ * statistics helpers in the same way as the execution time of pm-1.
+ */
+class Pm2 : public TestCase
+{
+public:
+  Pm2 ();
+  virtual ~Pm2 ();
+
+private:
+  virtual void DoRun (void);
+};
+
+Pm2::Pm2 ()
+  : TestCase ("'Statistics install time' test measures the time of installing statistics to full scenario.")
+{
+}
+
+Pm2::~Pm2 ()
+{
+}
+
+//
+// Pm2 TestCase implementation
+//
+void
+Pm2::DoRun (void)
+{
+  // Set simulation output details
+  Singleton<SatEnvVariables>::Get ()->DoInitialize ();
+  Singleton<SatEnvVariables>::Get ()->SetOutputVariables ("test-sat-perf-mem", "pm2", true);
+
+  // Creating the reference system.
+  Ptr<SatHelper> helper = CreateObject<SatHelper> ();
+  helper->CreatePredefinedScenario (SatHelper::FULL);
+
+  Ptr<SatStatsHelperContainer> s = CreateObject<SatStatsHelperContainer> (helper);
+
+  SystemWallClockMs clock;
+  clock.Start ();
+
+  s->AddPerUtFwdAppThroughput (SatStatsHelper::OUTPUT_SCALAR_FILE);
+  s->AddPerUtRtnAppThroughput (SatStatsHelper::OUTPUT_SCALAR_FILE);
+  s->AddPerUtFwdCompositeSinr (SatStatsHelper::OUTPUT_SCALAR_FILE);
+  s->AddPerUtRtnCompositeSinr (SatStatsHelper::OUTPUT_SCALAR_FILE);
+  s->AddPerBeamFwdDaPacketError (SatStatsHelper::OUTPUT_SCALAR_FILE);
+  s->AddPerBeamRtnDaPacketError (SatStatsHelper::OUTPUT_SCALAR_FILE);
+  s->AddPerBeamSlottedAlohaPacketCollision (SatStatsHelper::OUTPUT_SCALAR_FILE);
+  s->AddPerBeamCrdsaPacketCollision (SatStatsHelper::OUTPUT_SCALAR_FILE);
+  s->AddGlobalFwdFeederLinkSinr (SatStatsHelper::OUTPUT_SCALAR_FILE);
+  s->AddGlobalFwdUserLinkSinr (SatStatsHelper::OUTPUT_SCALAR_FILE);
+  s->AddGlobalRtnFeederLinkSinr (SatStatsHelper::OUTPUT_SCALAR_FILE);
+  s->AddGlobalRtnUserLinkSinr (SatStatsHelper::OUTPUT_SCALAR_FILE);
+  s->AddGlobalFwdFeederLinkRxPower (SatStatsHelper::OUTPUT_SCALAR_FILE);
+  s->AddGlobalFwdUserLinkRxPower (SatStatsHelper::OUTPUT_SCALAR_FILE);
+  s->AddGlobalRtnFeederLinkRxPower (SatStatsHelper::OUTPUT_SCALAR_FILE);
+  s->AddGlobalRtnUserLinkRxPower (SatStatsHelper::OUTPUT_SCALAR_FILE);
+
+  int64_t installTimeMs = clock.End ();
+
+  std::ofstream file ((Singleton<SatEnvVariables>::Get ()->GetOutputPath () + "/stats-install-time.txt").c_str ());
+  file << "UTs: " << helper->GetBeamHelper ()->GetUtNodes ().GetN ()
+       << ", install time [ms]: " << installTimeMs << std::endl;
+  file.close ();
+
+  NS_TEST_ASSERT_MSG_NE (helper->GetBeamHelper ()->GetUtNodes ().GetN (), (uint32_t)0, "No UTs created!");
+
+  Simulator::Destroy ();
+
+  Singleton<SatEnvVariables>::Get ()->DoDispose ();
+}
 
 // The TestSuite class names the TestSuite as sat-perf-mem, identifies what type of TestSuite (SYSTEM),
 // and enables the TestCases to be run.  Typically, only the constructor for
@@ -172,6 +256,8 @@ PerfMemTestSuite::PerfMemTestSuite ()
 {
   // add pm-1 case to suite sat-perf-mem
   AddTestCase (new Pm1, TestCase::QUICK);
+  // add pm-2 case to suite sat-perf-mem
+  AddTestCase (new Pm2, TestCase::QUICK);
 }
 
 // Allocate an instance of this TestSuite
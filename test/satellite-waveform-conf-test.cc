@@ -24,10 +24,12 @@
  * \brief Waveform conf test suite
  */
 
+#include <algorithm>
 #include "ns3/log.h"
 #include "ns3/test.h"
 #include "ns3/ptr.h"
 #include "ns3/boolean.h"
+#include "ns3/double.h"
 #include "ns3/config.h"
 #include "../model/satellite-wave-form-conf.h"
 #include "../model/satellite-bbframe-conf.h"
@@ -202,6 +204,99 @@ SatDvbS2BbFrameConfTestCase::DoRun (void)
   Singleton<SatEnvVariables>::Get ()->DoDispose ();
 }
 
+/**
+ * \ingroup satellite
+ * \brief Test case to unit test the ACM MODCOD selection of BBFrame conf.
+ *
+ * Expected result:
+ * - Creates SatBbFrameConf with ACM enabled
+ * - Selects the best MODCOD for a range of C/Nos one by one and as a batch
+ * - The selected MODCODs shall be the same as the ones found by scanning the
+ *   MODCODs from the best to the worst and picking the first one, whose C/No
+ *   requirement calculated from the link results is met
+ */
+class SatDvbS2BestModcodTestCase : public TestCase
+{
+public:
+  SatDvbS2BestModcodTestCase ();
+  virtual ~SatDvbS2BestModcodTestCase ();
+
+private:
+  virtual void DoRun (void);
+
+};
+
+SatDvbS2BestModcodTestCase::SatDvbS2BestModcodTestCase ()
+  : TestCase ("Test DVB-S2 best MODCOD selection.")
+{
+}
+
+SatDvbS2BestModcodTestCase::~SatDvbS2BestModcodTestCase ()
+{
+}
+
+void
+SatDvbS2BestModcodTestCase::DoRun (void)
+{
+  // Set simulation output details
+  Singleton<SatEnvVariables>::Get ()->DoInitialize ();
+  Singleton<SatEnvVariables>::Get ()->SetOutputVariables ("test-sat-waveform-conf", "dvbs2-acm", true);
+
+  // Enable ACM
+  Config::SetDefault ("ns3::SatBbFrameConf::AcmEnabled", BooleanValue (true));
+
+  double symbolRate (93750000);
+  double targetBler (0.00001);
+  Config::SetDefault ("ns3::SatBbFrameConf::TargetBLER", DoubleValue (targetBler));
+
+  Ptr<SatLinkResultsDvbS2> lr = CreateObject<SatLinkResultsDvbS2> ();
+  lr->Initialize ();
+
+  Ptr<SatBbFrameConf> bbFrameConf = CreateObject<SatBbFrameConf> (symbolRate);
+  bbFrameConf->InitializeCNoRequirements (lr);
+
+  std::vector<SatEnums::SatModcod_t> modcods;
+  SatEnums::GetAvailableModcodsFwdLink (modcods);
+  std::sort (modcods.begin (), modcods.end ());
+
+  SatEnums::SatBbFrameType_t frameType = SatEnums::NORMAL_FRAME;
+
+  std::vector<double> cnos;
+  for (double d = 70.0; d <= 95.0; d += 0.05)
+    {
+      cnos.push_back (SatUtils::DbToLinear (d));
+    }
+  cnos.push_back (NAN);
+
+  std::vector<SatEnums::SatModcod_t> batchModcods;
+  bbFrameConf->GetBestModcods (cnos, frameType, batchModcods);
+
+  NS_TEST_ASSERT_MSG_EQ (batchModcods.size (), cnos.size (), "Unexpected number of MODCODs in batch");
+
+  for (uint32_t i = 0; i < cnos.size (); ++i)
+    {
+      SatEnums::SatModcod_t refModcod = bbFrameConf->GetDefaultModCod ();
+
+      for (std::vector<SatEnums::SatModcod_t>::const_reverse_iterator rit = modcods.rbegin ();
+           rit != modcods.rend ();
+           ++rit)
+        {
+          double cnoReq = SatUtils::DbToLinear (lr->GetEsNoDb (*rit, frameType, targetBler)) * symbolRate;
+          if (cnoReq <= cnos[i])
+            {
+              refModcod = *rit;
+              break;
+            }
+        }
+
+      NS_TEST_ASSERT_MSG_EQ (bbFrameConf->GetBestModcod (cnos[i], frameType), refModcod, "Not expected MODCOD");
+      NS_TEST_ASSERT_MSG_EQ (batchModcods[i], refModcod, "Not expected MODCOD in batch");
+    }
+
+  Config::Reset ();
+  Singleton<SatEnvVariables>::Get ()->DoDispose ();
+}
+
 
 /**
  * \ingroup satellite
@@ -218,6 +313,7 @@ SatWaveformConfTestSuite::SatWaveformConfTestSuite ()
 {
   AddTestCase (new SatDvbRcs2WaveformTableTestCase, TestCase::QUICK);
   AddTestCase (new SatDvbS2BbFrameConfTestCase, TestCase::QUICK);
+  AddTestCase (new SatDvbS2BestModcodTestCase, TestCase::QUICK);
 }
 
 // Do allocate an instance of this TestSuite
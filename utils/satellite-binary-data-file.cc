@@ -0,0 +1,248 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2016 Magister Solutions Ltd.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: agent <agent@local>
+ */
+
+#include <fstream>
+#include <cstring>
+#include <cstdio>
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
+#include "ns3/log.h"
+#include "ns3/fatal-error.h"
+#include "satellite-binary-data-file.h"
+
+NS_LOG_COMPONENT_DEFINE ("SatBinaryDataFile");
+
+namespace ns3 {
+
+const char SatBinaryDataFile::MAGIC[8] = {'S', 'A', 'T', 'B', 'I', 'N', '\0', '\0'};
+
+SatBinaryDataFile::SatBinaryDataFile (void * address, size_t length)
+  : m_address (address),
+    m_length (length)
+{
+  NS_LOG_FUNCTION (this << address << length);
+}
+
+SatBinaryDataFile::~SatBinaryDataFile ()
+{
+  NS_LOG_FUNCTION (this);
+
+  if (m_address != 0)
+    {
+      munmap (m_address, m_length);
+      m_address = 0;
+    }
+}
+
+std::string
+SatBinaryDataFile::GetBinaryFileName (std::string textFilePathName)
+{
+  NS_LOG_FUNCTION (textFilePathName);
+
+  std::string extension = ".txt";
+
+  if (textFilePathName.size () > extension.size ()
+      && textFilePathName.compare (textFilePathName.size () - extension.size (), extension.size (), extension) == 0)
+    {
+      return textFilePathName.substr (0, textFilePathName.size () - extension.size ()) + ".bin";
+    }
+
+  return textFilePathName + ".bin";
+}
+
+Ptr<SatBinaryDataFile>
+SatBinaryDataFile::OpenForTextFile (std::string textFilePathName, ContentType_t contentType)
+{
+  NS_LOG_FUNCTION (textFilePathName << contentType);
+
+  std::string binaryFilePathName = GetBinaryFileName (textFilePathName);
+  struct stat binaryStat;
+  struct stat textStat;
+
+  if (stat (binaryFilePathName.c_str (), &binaryStat) != 0)
+    {
+      // script might be launched by test.py, try a different base path
+      textFilePathName = "../../" + textFilePathName;
+      binaryFilePathName = "../../" + binaryFilePathName;
+
+      if (stat (binaryFilePathName.c_str (), &binaryStat) != 0)
+        {
+          NS_LOG_INFO ("No binary data file found for " << textFilePathName);
+          return 0;
+        }
+    }
+
+  if (stat (textFilePathName.c_str (), &textStat) == 0 && textStat.st_mtime > binaryStat.st_mtime)
+    {
+      NS_LOG_WARN ("The binary data file " << binaryFilePathName << " is older than the text file, using the text file");
+      return 0;
+    }
+
+  if ((size_t) binaryStat.st_size < sizeof (Header_t))
+    {
+      NS_LOG_WARN ("The binary data file " << binaryFilePathName << " is too short, using the text file");
+      return 0;
+    }
+
+  int fd = open (binaryFilePathName.c_str (), O_RDONLY);
+
+  if (fd < 0)
+    {
+      NS_LOG_WARN ("The binary data file " << binaryFilePathName << " cannot be opened, using the text file");
+      return 0;
+    }
+
+  void * address = mmap (0, binaryStat.st_size, PROT_READ, MAP_SHARED, fd, 0);
+  close (fd);
+
+  if (address == MAP_FAILED)
+    {
+      NS_LOG_WARN ("The binary data file " << binaryFilePathName << " cannot be mapped, using the text file");
+      return 0;
+    }
+
+  Ptr<SatBinaryDataFile> file (new SatBinaryDataFile (address, binaryStat.st_size), false);
+  const Header_t * header = file->GetHeader ();
+
+  if (std::memcmp (header->magic, MAGIC, sizeof (MAGIC)) != 0
+      || header->version != FORMAT_VERSION
+      || header->byteOrderMark != BYTE_ORDER_MARK
+      || header->contentType != (uint32_t) contentType)
+    {
+      NS_LOG_WARN ("The binary data file " << binaryFilePathName << " has unsupported format, using the text file");
+      return 0;
+    }
+
+  size_t expectedLength = sizeof (Header_t)
+    + (header->parameterCount + (size_t) header->rows * header->columns) * sizeof (double);
+
+  if (file->m_length != expectedLength)
+    {
+      NS_LOG_WARN ("The binary data file " << binaryFilePathName << " has invalid length, using the text file");
+      return 0;
+    }
+
+  NS_LOG_INFO ("Using binary data file " << binaryFilePathName);
+
+  return file;
+}
+
+void
+SatBinaryDataFile::Write (std::string filePathName,
+                          ContentType_t contentType,
+                          const std::vector<double>& parameters,
+                          uint32_t rows,
+                          uint32_t columns,
+                          const std::vector<double>& data)
+{
+  NS_LOG_FUNCTION (filePathName << contentType << rows << columns);
+
+  if (data.size () != (size_t) rows * columns)
+    {
+      NS_FATAL_ERROR ("SatBinaryDataFile::Write - data size does not match to " << rows << " rows and " << columns << " columns");
+    }
+
+  Header_t header;
+  std::memcpy (header.magic, MAGIC, sizeof (MAGIC));
+  header.version = FORMAT_VERSION;
+  header.byteOrderMark = BYTE_ORDER_MARK;
+  header.contentType = contentType;
+  header.parameterCount = parameters.size ();
+  header.rows = rows;
+  header.columns = columns;
+
+  // The file is written under a temporary name and renamed over the target
+  // only when complete. A reader may have the old file mapped, truncating it
+  // in place would invalidate the mapping of the reader.
+  std::string tmpFilePathName = filePathName + ".tmp";
+  std::ofstream ofs (tmpFilePathName.c_str (), std::ofstream::out | std::ofstream::binary | std::ofstream::trunc);
+
+  if (!ofs.is_open ())
+    {
+      NS_FATAL_ERROR ("SatBinaryDataFile::Write - unable to open " << tmpFilePathName);
+    }
+
+  ofs.write (reinterpret_cast<const char *> (&header), sizeof (header));
+
+  if (!parameters.empty ())
+    {
+      ofs.write (reinterpret_cast<const char *> (&parameters[0]), parameters.size () * sizeof (double));
+    }
+
+  if (!data.empty ())
+    {
+      ofs.write (reinterpret_cast<const char *> (&data[0]), data.size () * sizeof (double));
+    }
+
+  ofs.close ();
+
+  if (!ofs.good ())
+    {
+      std::remove (tmpFilePathName.c_str ());
+      NS_FATAL_ERROR ("SatBinaryDataFile::Write - writing " << tmpFilePathName << " failed");
+    }
+
+  if (std::rename (tmpFilePathName.c_str (), filePathName.c_str ()) != 0)
+    {
+      std::remove (tmpFilePathName.c_str ());
+      NS_FATAL_ERROR ("SatBinaryDataFile::Write - unable to rename " << tmpFilePathName << " to " << filePathName);
+    }
+}
+
+uint32_t
+SatBinaryDataFile::GetParameterCount () const
+{
+  return GetHeader ()->parameterCount;
+}
+
+const double *
+SatBinaryDataFile::GetParameters () const
+{
+  return reinterpret_cast<const double *> (static_cast<const char *> (m_address) + sizeof (Header_t));
+}
+
+uint32_t
+SatBinaryDataFile::GetRows () const
+{
+  return GetHeader ()->rows;
+}
+
+uint32_t
+SatBinaryDataFile::GetColumns () const
+{
+  return GetHeader ()->columns;
+}
+
+const double *
+SatBinaryDataFile::GetData () const
+{
+  return GetParameters () + GetParameterCount ();
+}
+
+const SatBinaryDataFile::Header_t *
+SatBinaryDataFile::GetHeader () const
+{
+  return static_cast<const Header_t *> (m_address);
+}
+
+} // namespace ns3
@@ -0,0 +1,187 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2016 Magister Solutions Ltd.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: agent <agent@local>
+ */
+
+#ifndef SAT_BINARY_DATA_FILE_H
+#define SAT_BINARY_DATA_FILE_H
+
+#include <vector>
+#include <string>
+#include "ns3/ptr.h"
+#include "ns3/simple-ref-count.h"
+
+namespace ns3 {
+
+/**
+ * \brief A class encapsulating a read-only memory mapped binary data file.
+ *
+ * Binary data files are versioned containers for the satellite module input
+ * data (e.g. antenna patterns, link results and input traces), which are generated from the
+ * text input files with the sat-binary-data-converter example. The binary file
+ * of a text file is located in the same directory and it has the same name with
+ * .bin extension instead of .txt. The file is mapped to memory as read-only and
+ * shared, thus the same data is shared by all the simulation processes running
+ * in the same host.
+ *
+ * The file consists of a header, a vector of parameters and a matrix of data
+ * values stored row by row. The parameters and data values are doubles in the
+ * byte order of the host.
+ *
+ * This class uses a basic ns-3 reference counting base class but is not
+ * an ns3::Object with attributes, TypeId, or aggregation.
+ */
+class SatBinaryDataFile : public SimpleRefCount<SatBinaryDataFile>
+{
+public:
+  /**
+   * \brief Type of the content in the binary data file
+   */
+  typedef enum
+  {
+    CONTENT_LINK_RESULTS = 1,
+    CONTENT_ANTENNA_PATTERN = 2,
+    CONTENT_TIME_SERIES = 3
+  } ContentType_t;
+
+  /**
+   * \brief Version of the binary data file format
+   */
+  static const uint32_t FORMAT_VERSION = 1;
+
+  /**
+   * \brief Destructor. Unmaps the file.
+   */
+  ~SatBinaryDataFile ();
+
+  /**
+   * \brief Get the name of the binary data file of a text input file
+   * \param textFilePathName Path and name of the text input file
+   * \return Path and name of the binary data file
+   */
+  static std::string GetBinaryFileName (std::string textFilePathName);
+
+  /**
+   * \brief Open the binary data file of a text input file. The binary file is
+   * opened only if it exists, it has the expected content type and format
+   * version, and it is not older than the text file.
+   * \param textFilePathName Path and name of the text input file
+   * \param contentType Expected content type
+   * \return The opened binary data file or NULL, if the text file should be used
+   */
+  static Ptr<SatBinaryDataFile> OpenForTextFile (std::string textFilePathName, ContentType_t contentType);
+
+  /**
+   * \brief Write a binary data file
+   * \param filePathName Path and name of the binary data file
+   * \param contentType Content type
+   * \param parameters Parameters of the content
+   * \param rows Number of data rows
+   * \param columns Number of data columns
+   * \param data Data values stored row by row
+   */
+  static void Write (std::string filePathName,
+                     ContentType_t contentType,
+                     const std::vector<double>& parameters,
+                     uint32_t rows,
+                     uint32_t columns,
+                     const std::vector<double>& data);
+
+  /**
+   * \brief Get the number of parameters
+   * \return The number of parameters
+   */
+  uint32_t GetParameterCount () const;
+
+  /**
+   * \brief Get the parameters
+   * \return Pointer to the first parameter
+   */
+  const double * GetParameters () const;
+
+  /**
+   * \brief Get the number of data rows
+   * \return The number of data rows
+   */
+  uint32_t GetRows () const;
+
+  /**
+   * \brief Get the number of data columns
+   * \return The number of data columns
+   */
+  uint32_t GetColumns () const;
+
+  /**
+   * \brief Get the data values stored row by row
+   * \return Pointer to the first data value
+   */
+  const double * GetData () const;
+
+private:
+  /**
+   * \brief Header of the binary data file
+   */
+  typedef struct
+  {
+    char magic[8];
+    uint32_t version;
+    uint32_t byteOrderMark;
+    uint32_t contentType;
+    uint32_t parameterCount;
+    uint32_t rows;
+    uint32_t columns;
+  } Header_t;
+
+  /**
+   * \brief Constructor
+   * \param address Address of the mapped file
+   * \param length Length of the mapped file
+   */
+  SatBinaryDataFile (void * address, size_t length);
+
+  /**
+   * \brief Get the header of the file
+   * \return The header
+   */
+  const Header_t * GetHeader () const;
+
+  /**
+   * \brief Identifier in the beginning of the binary data files
+   */
+  static const char MAGIC[8];
+
+  /**
+   * \brief Byte order mark used to check that the file is written in the
+   * byte order of the host
+   */
+  static const uint32_t BYTE_ORDER_MARK = 0x01020304;
+
+  /**
+   * \brief Address of the mapped file
+   */
+  void * m_address;
+
+  /**
+   * \brief Length of the mapped file
+   */
+  size_t m_length;
+};
+
+} // namespace ns3
+
+#endif /* SAT_BINARY_DATA_FILE_H */
@@ -18,7 +18,10 @@
  * Author: Frans Laakso <frans.laakso@magister.fi>
  */
 
+#include <cmath>
+#include <algorithm>
 #include "satellite-input-fstream-time-double-container.h"
+#include "satellite-binary-data-file.h"
 #include "ns3/log.h"
 #include "ns3/abort.h"
 #include "ns3/simulator.h"
@@ -37,15 +40,14 @@ SatInputFileStreamTimeDoubleContainer::GetTypeId (void)
 }
 
 SatInputFileStreamTimeDoubleContainer::SatInputFileStreamTimeDoubleContainer (std::string filename, std::ios::openmode filemode, uint32_t valuesInRow)
-  : m_inputFileStreamWrapper (),
-    m_inputFileStream (),
-    m_container (),
+  : m_columns (),
     m_fileName (filename),
     m_fileMode (filemode),
     m_valuesInRow (valuesInRow),
     m_lastValidPosition (0),
     m_numOfPasses (0),
     m_timeShiftValue (0),
+    m_sampleInterval (0),
     m_timeColumn (0)
 {
   NS_LOG_FUNCTION (this << m_fileName << m_fileMode);
@@ -54,15 +56,14 @@ SatInputFileStreamTimeDoubleContainer::SatInputFileStreamTimeDoubleContainer (st
 }
 
 SatInputFileStreamTimeDoubleContainer::SatInputFileStreamTimeDoubleContainer ()
-  : m_inputFileStreamWrapper (),
-    m_inputFileStream (),
-    m_container (),
+  : m_columns (),
     m_fileName (),
     m_fileMode (),
     m_valuesInRow (),
     m_lastValidPosition (),
     m_numOfPasses (),
     m_timeShiftValue (),
+    m_sampleInterval (),
     m_timeColumn ()
 {
   NS_LOG_FUNCTION (this);
@@ -96,44 +97,113 @@ SatInputFileStreamTimeDoubleContainer::UpdateContainer (std::string filename, st
   m_fileMode = filemode;
   m_valuesInRow = valuesInRow;
 
-  m_inputFileStreamWrapper = new SatInputFileStreamWrapper (filename,filemode);
-  m_inputFileStream = m_inputFileStreamWrapper->GetStream ();
+  NS_ASSERT (m_timeColumn < m_valuesInRow);
 
-  if (m_inputFileStream->is_open ())
-    {
-      std::vector<double> tempVector = ReadRow ();
+  m_columns.resize (m_valuesInRow);
 
-      while (!m_inputFileStream->eof ())
+  if (!LoadFromBinaryFile ())
+    {
+      for (uint32_t i = 0; i < m_valuesInRow; i++)
         {
-          m_container.push_back (tempVector);
-          tempVector = ReadRow ();
+          m_columns[i].clear ();
         }
-      m_inputFileStream->close ();
+
+      LoadFromTextFile ();
     }
-  else
+
+  CheckContainerSanity ();
+}
+
+void
+SatInputFileStreamTimeDoubleContainer::LoadFromTextFile ()
+{
+  NS_LOG_FUNCTION (this);
+
+  Ptr<SatInputFileStreamWrapper> inputFileStreamWrapper = Create<SatInputFileStreamWrapper> (m_fileName, m_fileMode);
+  std::ifstream* inputFileStream = inputFileStreamWrapper->GetStream ();
+
+  if (!inputFileStream->is_open ())
     {
       NS_ABORT_MSG ("Input stream is not valid for reading.");
     }
 
-  CheckContainerSanity ();
+  std::vector<double> row (m_valuesInRow);
 
-  ResetStream ();
+  while (true)
+    {
+      for (uint32_t i = 0; i < m_valuesInRow; i++)
+        {
+          *inputFileStream >> row[i];
+        }
+
+      // The row is stored only if the end of file was not reached while reading it
+      if (inputFileStream->eof ())
+        {
+          break;
+        }
+
+      for (uint32_t i = 0; i < m_valuesInRow; i++)
+        {
+          m_columns[i].push_back (row[i]);
+        }
+    }
+
+  inputFileStream->close ();
 }
 
-std::vector<double>
-SatInputFileStreamTimeDoubleContainer::ReadRow ()
+bool
+SatInputFileStreamTimeDoubleContainer::LoadFromBinaryFile ()
 {
   NS_LOG_FUNCTION (this);
 
-  double tempValue;
-  std::vector<double> tempVector;
+  Ptr<SatBinaryDataFile> file = SatBinaryDataFile::OpenForTextFile (m_fileName, SatBinaryDataFile::CONTENT_TIME_SERIES);
+
+  if (file == 0)
+    {
+      return false;
+    }
+
+  if (file->GetColumns () != m_valuesInRow)
+    {
+      NS_LOG_WARN ("Invalid binary data of " << m_fileName << ", using the text file");
+      return false;
+    }
+
+  uint32_t rows = file->GetRows ();
+  const double * data = file->GetData ();
 
-  for ( uint32_t i = 0; i < m_valuesInRow; i++ )
+  for (uint32_t i = 0; i < m_valuesInRow; i++)
     {
-      *m_inputFileStream >> tempValue;
-      tempVector.push_back (tempValue);
+      m_columns[i].resize (rows);
+
+      for (uint32_t j = 0; j < rows; j++)
+        {
+          m_columns[i][j] = data[j * m_valuesInRow + i];
+        }
     }
-  return tempVector;
+
+  return true;
+}
+
+void
+SatInputFileStreamTimeDoubleContainer::WriteBinaryFile (std::string filePathName) const
+{
+  NS_LOG_FUNCTION (this << filePathName);
+
+  uint32_t rows = GetRowCount ();
+  std::vector<double> data;
+  data.reserve (rows * m_valuesInRow);
+
+  for (uint32_t j = 0; j < rows; j++)
+    {
+      for (uint32_t i = 0; i < m_valuesInRow; i++)
+        {
+          data.push_back (m_columns[i][j]);
+        }
+    }
+
+  SatBinaryDataFile::Write (filePathName, SatBinaryDataFile::CONTENT_TIME_SERIES,
+                            std::vector<double> (), rows, m_valuesInRow, data);
 }
 
 void
@@ -141,31 +211,51 @@ SatInputFileStreamTimeDoubleContainer::CheckContainerSanity ()
 {
   NS_LOG_FUNCTION (this);
 
+  uint32_t rows = GetRowCount ();
+
   /// check time sample sanity
-  if (m_container.size () < 1)
+  if (rows < 1)
     {
       NS_FATAL_ERROR ("SatInputFileStreamDoubleContainer::UpdateContainer - Empty file");
     }
-  else if (m_container.size () == 1)
+
+  const std::vector<double>& times = m_columns[m_timeColumn];
+
+  for (uint32_t i = 1; i < rows; i++)
     {
-      if (m_container[m_container.size () - 1].at (m_timeColumn) == 0)
+      if (times[i - 1] > times[i])
         {
           NS_FATAL_ERROR ("SatInputFileStreamDoubleContainer::UpdateContainer - Invalid input file format (time sample error)");
         }
     }
-  else
+
+  /// the samples are looped with the last time sample as the period
+  if (times[rows - 1] <= 0)
     {
-      double tempValue1 = m_container[0].at (m_timeColumn);
+      NS_FATAL_ERROR ("SatInputFileStreamDoubleContainer::UpdateContainer - Invalid input file format (time sample error)");
+    }
 
-      for (uint32_t i = 1; i < m_container.size (); i++)
+  /// check whether the time samples are uniformly spaced, so that the samples can be located directly by index
+  m_sampleInterval = 0;
+
+  if (rows > 1)
+    {
+      double interval = (times[rows - 1] - times[0]) / (rows - 1);
+      double tolerance = 1e-6 * interval;
+      bool uniform = interval > 0;
+
+      for (uint32_t i = 1; uniform && i < rows; i++)
         {
-          if (tempValue1 > m_container[i].at (m_timeColumn))
-            {
-              NS_FATAL_ERROR ("SatInputFileStreamDoubleContainer::UpdateContainer - Invalid input file format (time sample error)");
-            }
-          tempValue1 = m_container[i].at (m_timeColumn);
+          uniform = std::abs (times[i] - times[0] - i * interval) <= tolerance;
+        }
+
+      if (uniform)
+        {
+          m_sampleInterval = interval;
         }
     }
+
+  NS_LOG_INFO ("Loaded " << rows << " samples from " << m_fileName << ", sample interval " << m_sampleInterval);
 }
 
 std::vector<double>
@@ -173,96 +263,154 @@ SatInputFileStreamTimeDoubleContainer::ProceedToNextClosestTimeSample ()
 {
   NS_LOG_FUNCTION (this);
 
-  while (!FindNextClosest (m_lastValidPosition,m_timeShiftValue, Now ().GetSeconds ()))
-    {
-      m_lastValidPosition = 0;
-      m_numOfPasses++;
-      m_timeShiftValue = m_numOfPasses * m_container[m_container.size () - 1].at (m_timeColumn);
+  LocateNextClosestTimeSample ();
 
-      NS_LOG_INFO ("Looping samples again with shift value: " << m_timeShiftValue);
+  std::vector<double> row (m_valuesInRow);
+
+  for (uint32_t i = 0; i < m_valuesInRow; i++)
+    {
+      row[i] = m_columns[i][m_lastValidPosition];
     }
 
-  if (m_numOfPasses > 0)
+  return row;
+}
+
+double
+SatInputFileStreamTimeDoubleContainer::ProceedToNextClosestTimeSample (uint32_t column)
+{
+  NS_LOG_FUNCTION (this << column);
+
+  if (column >= m_valuesInRow)
     {
-      std::cout << "WARNING! - SatInputFileStreamDoubleContainer::ProceedToNextClosestTimeSample for " << m_fileName << " is out of samples @ time sample " << Now ().GetSeconds () << " (passes " << m_numOfPasses << ")" << std::endl;
-      std::cout << "The container will loop samples from the beginning." << std::endl;
+      NS_FATAL_ERROR ("SatInputFileStreamDoubleContainer::ProceedToNextClosestTimeSample - Invalid column " << column);
     }
 
-  return m_container[m_lastValidPosition];
+  LocateNextClosestTimeSample ();
+
+  return m_columns[column][m_lastValidPosition];
 }
 
-bool
-SatInputFileStreamTimeDoubleContainer::FindNextClosest (uint32_t lastValidPosition, double timeShiftValue, double comparisonTimeValue)
+void
+SatInputFileStreamTimeDoubleContainer::LocateNextClosestTimeSample ()
 {
   NS_LOG_FUNCTION (this);
 
-  NS_ASSERT (m_timeColumn < m_valuesInRow);
-  NS_ASSERT (m_container.size () > 0);
-  NS_ASSERT (lastValidPosition >= 0 && lastValidPosition < m_container.size ());
-
-  NS_LOG_INFO ("SatInputFileStreamDoubleContainer::FindNextClosest: lastValidPosition " << lastValidPosition << " column " << m_timeColumn << " timeShiftValue " << timeShiftValue << " comparisonTimeValue " << comparisonTimeValue);
+  NS_ASSERT (GetRowCount () > 0);
+  NS_ASSERT (m_lastValidPosition < GetRowCount ());
 
-  bool valueFound = false;
+  const std::vector<double>& times = m_columns[m_timeColumn];
+  uint32_t lastPosition = times.size () - 1;
+  double period = times[lastPosition];
+  double comparisonTimeValue = Now ().GetSeconds ();
+  uint32_t firstPosition = m_lastValidPosition;
 
-  for (uint32_t i = lastValidPosition; i < m_container.size (); i++)
+  if (times[lastPosition] + m_timeShiftValue < comparisonTimeValue)
     {
-      if (m_container[i].at (m_timeColumn) + timeShiftValue >= comparisonTimeValue)
+      // Out of samples, compute the first pass which covers the comparison time
+      uint32_t passes = std::max<double> (m_numOfPasses + 1, std::ceil (comparisonTimeValue / period) - 1);
+
+      while (passes > m_numOfPasses + 1 && times[lastPosition] + (passes - 1) * period >= comparisonTimeValue)
         {
-          double difference1 = std::abs (m_container[lastValidPosition].at (m_timeColumn) + timeShiftValue - comparisonTimeValue);
-          double difference2 = std::abs (m_container[i].at (m_timeColumn) + timeShiftValue - comparisonTimeValue);
-
-          if (difference1 < difference2)
-            {
-              m_lastValidPosition = lastValidPosition;
-            }
-          else
-            {
-              m_lastValidPosition = i;
-            }
-          valueFound = true;
-          break;
+          passes--;
         }
-      lastValidPosition = i;
+
+      while (times[lastPosition] + passes * period < comparisonTimeValue)
+        {
+          passes++;
+        }
+
+      m_numOfPasses = passes;
+      m_timeShiftValue = m_numOfPasses * period;
+      firstPosition = 0;
+
+      NS_LOG_INFO ("Looping samples again with shift value: " << m_timeShiftValue);
+
+      std::cout << "WARNING! - SatInputFileStreamDoubleContainer::ProceedToNextClosestTimeSample for " << m_fileName << " is out of samples @ time sample " << comparisonTimeValue << " (passes " << m_numOfPasses << ")" << std::endl;
+      std::cout << "The container will loop samples from the beginning." << std::endl;
     }
 
-  if (valueFound && m_numOfPasses > 0 && m_lastValidPosition == 0)
+  uint32_t position = FindFirstNotBefore (firstPosition, m_timeShiftValue, comparisonTimeValue);
+  uint32_t previousPosition = (position > firstPosition) ? position - 1 : firstPosition;
+
+  double difference1 = std::abs (times[previousPosition] + m_timeShiftValue - comparisonTimeValue);
+  double difference2 = std::abs (times[position] + m_timeShiftValue - comparisonTimeValue);
+
+  m_lastValidPosition = (difference1 < difference2) ? previousPosition : position;
+
+  // The last sample of the previous pass may be closer than the first sample of this pass
+  if (m_numOfPasses > 0 && m_lastValidPosition == 0)
     {
-      double difference1 = std::abs (m_container[m_lastValidPosition].at (m_timeColumn) + timeShiftValue - comparisonTimeValue);
-      double difference2 = std::abs (m_container[m_container.size () - 1].at (m_timeColumn) + ((m_numOfPasses - 1) * m_container[m_container.size () - 1].at (m_timeColumn)) - comparisonTimeValue);
+      difference1 = std::abs (times[m_lastValidPosition] + m_timeShiftValue - comparisonTimeValue);
+      difference2 = std::abs (times[lastPosition] + ((m_numOfPasses - 1) * period) - comparisonTimeValue);
 
       if (difference1 > difference2)
         {
-          m_lastValidPosition = m_container.size () - 1;
+          m_lastValidPosition = lastPosition;
           m_numOfPasses--;
-          m_timeShiftValue = m_numOfPasses * m_container[m_container.size () - 1].at (m_timeColumn);
+          m_timeShiftValue = m_numOfPasses * period;
         }
     }
 
-  NS_LOG_INFO ("Done: " << valueFound << " value: " << m_container[m_lastValidPosition].at (m_timeColumn) << " @ line: " << m_lastValidPosition + 1 << " comparison time value: " << comparisonTimeValue << " passes: " << m_numOfPasses);
-
-  return valueFound;
+  NS_LOG_INFO ("Done: value: " << times[m_lastValidPosition] << " @ line: " << m_lastValidPosition + 1 << " comparison time value: " << comparisonTimeValue << " passes: " << m_numOfPasses);
 }
 
-void
-SatInputFileStreamTimeDoubleContainer::Reset ()
+uint32_t
+SatInputFileStreamTimeDoubleContainer::FindFirstNotBefore (uint32_t firstPosition, double timeShiftValue, double comparisonTimeValue) const
 {
-  NS_LOG_FUNCTION (this);
+  NS_LOG_FUNCTION (this << firstPosition << timeShiftValue << comparisonTimeValue);
 
-  ResetStream ();
-  ClearContainer ();
+  const std::vector<double>& times = m_columns[m_timeColumn];
+  uint32_t lastPosition = times.size () - 1;
+
+  NS_ASSERT (times[lastPosition] + timeShiftValue >= comparisonTimeValue);
+
+  if (m_sampleInterval > 0)
+    {
+      // Uniformly spaced samples, start from the estimated position and correct rounding errors
+      double estimate = std::ceil ((comparisonTimeValue - timeShiftValue - times[0]) / m_sampleInterval);
+      uint32_t position = std::min<double> (std::max<double> (estimate, firstPosition), lastPosition);
+
+      while (position > firstPosition && times[position - 1] + timeShiftValue >= comparisonTimeValue)
+        {
+          position--;
+        }
+
+      while (times[position] + timeShiftValue < comparisonTimeValue)
+        {
+          position++;
+        }
+
+      return position;
+    }
+
+  // Binary search for the first sample in [firstPosition, lastPosition] not before the comparison time
+  uint32_t position = firstPosition;
+  uint32_t count = lastPosition - firstPosition;
+
+  while (count > 0)
+    {
+      uint32_t step = count / 2;
+
+      if (times[position + step] + timeShiftValue < comparisonTimeValue)
+        {
+          position += step + 1;
+          count -= step + 1;
+        }
+      else
+        {
+          count = step;
+        }
+    }
+
+  return position;
 }
 
 void
-SatInputFileStreamTimeDoubleContainer::ResetStream ()
+SatInputFileStreamTimeDoubleContainer::Reset ()
 {
   NS_LOG_FUNCTION (this);
 
-  if (m_inputFileStreamWrapper != NULL)
-    {
-      delete m_inputFileStreamWrapper;
-      m_inputFileStreamWrapper = 0;
-    }
-  m_inputFileStream = 0;
+  ClearContainer ();
 }
 
 void
@@ -270,22 +418,13 @@ SatInputFileStreamTimeDoubleContainer::ClearContainer ()
 {
   NS_LOG_FUNCTION (this);
 
-  if (!m_container.empty ())
-    {
-      for (uint32_t i = 0; i < m_container.size (); i++)
-        {
-          if (!m_container[i].empty ())
-            {
-              m_container[i].clear ();
-            }
-        }
-      m_container.clear ();
-    }
+  m_columns.clear ();
 
   m_valuesInRow = 0;
   m_lastValidPosition = 0;
   m_numOfPasses = 0;
   m_timeShiftValue = 0;
+  m_sampleInterval = 0;
 }
 
 } // namespace ns3
@@ -22,6 +22,7 @@
 #define SAT_INPUT_FSTREAM_TIME_DOUBLE_CONTAINER_H
 
 #include <fstream>
+#include <vector>
 #include "ns3/object.h"
 #include "satellite-input-fstream-wrapper.h"
 
@@ -29,12 +30,22 @@ namespace ns3 {
 
 /**
  * \ingroup satellite
- *
  * \brief Class for input file stream container for storing double values.
  * The class implements reading the values from a file, storing the values
  * and iterating the stored values.
- *
  * Row format is [time, value1, ..., value n].
+ *
+ * The values are stored column by column. The time sample closest to the
+ * current simulation time is located with a binary search starting from the
+ * previously located sample, or directly by index, if the time samples are
+ * uniformly spaced. When the simulation time exceeds the last time sample,
+ * the samples are looped from the beginning by computing the number of
+ * passes directly, without scanning the samples again.
+ *
+ * If the file has a binary data file (see SatBinaryDataFile) which is not
+ * older than the text file, the values are read from it instead of parsing
+ * the text file. The binary data files can be generated with
+ * WriteBinaryFile, e.g. by running the sat-binary-data-converter example.
  */
 class SatInputFileStreamTimeDoubleContainer : public Object
 {
@@ -77,6 +88,19 @@ public:
    */
   std::vector<double> ProceedToNextClosestTimeSample ();
 
+  /**
+   * \brief Function for locating the next closest time sample and returning one of the values related to it
+   * \param column index of the value in a row
+   * \return matching value
+   */
+  double ProceedToNextClosestTimeSample (uint32_t column);
+
+  /**
+   * \brief Write the values to a binary data file
+   * \param filePathName Path and name of the binary data file
+   */
+  void WriteBinaryFile (std::string filePathName) const;
+
   /**
    * \brief Do needed dispose actions
    */
@@ -89,49 +113,53 @@ private:
   void Reset ();
 
   /**
-   * \brief Function for resetting the stream
+   * \brief Function for clearing the container
    */
-  void ResetStream ();
+  void ClearContainer ();
 
   /**
-   * \brief Function for clearing the container
+   * \brief Function for reading the values from the text file
    */
-  void ClearContainer ();
+  void LoadFromTextFile ();
 
   /**
-   * \brief Function for reading a row from file
-   * \return the row
+   * \brief Function for reading the values from the binary data file of the text file
+   * \return true, if the binary data file was used, otherwise false
    */
-  std::vector<double> ReadRow ();
+  bool LoadFromBinaryFile ();
 
   /**
-   * \brief Function for locating the next closest value index. This locator loops the samples if the container does not have enough samples. Next closest index value is saved to a separate member variable.
-   * \param lastValidPosition position of last matching value
-   * \param shiftValue value to shift the time if needed
-   * \param comparisonValue value which next closest match to find
-   * \return was next time sample found
+   * \brief Function for locating the next closest time sample. This locator loops the samples if the container does not have enough samples. The index of the next closest time sample is saved to a separate member variable.
    */
-  bool FindNextClosest (uint32_t lastValidPosition, double timeShiftValue, double comparisonTimeValue);
+  void LocateNextClosestTimeSample ();
 
   /**
-   * \brief Check container time sample sanity
+   * \brief Function for finding the first time sample not before a given time
+   * \param firstPosition position from which to start the search
+   * \param timeShiftValue value to shift the time samples with
+   * \param comparisonTimeValue time to compare the time samples to
+   * \return position of the first matching time sample
    */
-  void CheckContainerSanity ();
+  uint32_t FindFirstNotBefore (uint32_t firstPosition, double timeShiftValue, double comparisonTimeValue) const;
 
   /**
-   * \brief Pointer to input file stream wrapper
+   * \brief Check container time sample sanity and whether the time samples are uniformly spaced
    */
-  SatInputFileStreamWrapper* m_inputFileStreamWrapper;
+  void CheckContainerSanity ();
 
   /**
-   * \brief Pointer to input file stream
+   * \brief Get the number of rows in the container
+   * \return number of rows
    */
-  std::ifstream* m_inputFileStream;
+  inline uint32_t GetRowCount () const
+  {
+    return m_columns.empty () ? 0 : m_columns[m_timeColumn].size ();
+  }
 
   /**
-   * \brief Container for value rows
+   * \brief Container for value columns
    */
-  std::vector<std::vector<double> > m_container;
+  std::vector<std::vector<double> > m_columns;
 
   /**
    * \brief File name
@@ -163,6 +191,11 @@ private:
    */
   double m_timeShiftValue;
 
+  /**
+   * \brief Interval of the time samples, if they are uniformly spaced, otherwise zero
+   */
+  double m_sampleInterval;
+
   /**
    * \brief Index for column which contains time information
    */
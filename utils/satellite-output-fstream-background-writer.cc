@@ -0,0 +1,302 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2016 Magister Solutions Ltd.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: agent <agent@local>
+ */
+
+#include "satellite-output-fstream-background-writer.h"
+#include "ns3/log.h"
+#include "ns3/abort.h"
+#include "ns3/callback.h"
+
+NS_LOG_COMPONENT_DEFINE ("SatOutputFileStreamBackgroundWriter");
+
+namespace ns3 {
+
+#ifdef HAVE_PTHREAD_H
+
+SatOutputFileStreamBackgroundWriter::SatOutputFileStreamBackgroundWriter ()
+  : m_jobs (),
+    m_busy (false),
+    m_stop (false),
+    m_thread ()
+{
+  NS_LOG_FUNCTION (this);
+}
+
+SatOutputFileStreamBackgroundWriter::~SatOutputFileStreamBackgroundWriter ()
+{
+  NS_LOG_FUNCTION (this);
+
+  if (m_thread != 0)
+    {
+      {
+        CriticalSection cs (m_mutex);
+        m_stop = true;
+      }
+
+      m_jobCondition.SetCondition (true);
+      m_jobCondition.Signal ();
+      m_thread->Join ();
+      m_thread = 0;
+    }
+}
+
+void
+SatOutputFileStreamBackgroundWriter::Write (std::string fileName, std::ios::openmode fileMode, Format_t format,
+                                            uint32_t valuesInRow, std::vector<double>& values, bool writeHeader)
+{
+  NS_LOG_FUNCTION (this << fileName << fileMode << format << valuesInRow << values.size () << writeHeader);
+
+  if (m_thread == 0)
+    {
+      m_thread = Create<SystemThread> (MakeCallback (&SatOutputFileStreamBackgroundWriter::Run, this));
+      m_thread->Start ();
+    }
+
+  while (true)
+    {
+      // reset before checking the jobs, a job written after the check sets it again
+      m_doneCondition.SetCondition (false);
+
+      {
+        CriticalSection cs (m_mutex);
+
+        if (m_jobs.size () < MAX_PENDING_JOBS)
+          {
+            m_jobs.push_back (Job_t ());
+            m_jobs.back ().fileName = fileName;
+            m_jobs.back ().fileMode = fileMode;
+            m_jobs.back ().format = format;
+            m_jobs.back ().valuesInRow = valuesInRow;
+            m_jobs.back ().values.swap (values);
+            m_jobs.back ().writeHeader = writeHeader;
+            break;
+          }
+      }
+
+      // the writer thread is lagging behind, wait for room in the job queue
+      m_doneCondition.TimedWait (WAIT_TIMEOUT_NS);
+    }
+
+  values.clear ();
+
+  m_jobCondition.SetCondition (true);
+  m_jobCondition.Signal ();
+}
+
+void
+SatOutputFileStreamBackgroundWriter::Wait ()
+{
+  NS_LOG_FUNCTION (this);
+
+  while (true)
+    {
+      m_doneCondition.SetCondition (false);
+
+      {
+        CriticalSection cs (m_mutex);
+
+        if (m_jobs.empty () && !m_busy)
+          {
+            return;
+          }
+      }
+
+      m_doneCondition.TimedWait (WAIT_TIMEOUT_NS);
+    }
+}
+
+void
+SatOutputFileStreamBackgroundWriter::Run ()
+{
+  // No logging here, the simulator is not accessed from the writer thread
+
+  while (true)
+    {
+      Job_t job;
+      bool hasJob = false;
+
+      // reset before checking the jobs, a job given after the check sets it again
+      m_jobCondition.SetCondition (false);
+
+      {
+        CriticalSection cs (m_mutex);
+
+        if (!m_jobs.empty ())
+          {
+            job.fileName = m_jobs.front ().fileName;
+            job.fileMode = m_jobs.front ().fileMode;
+            job.format = m_jobs.front ().format;
+            job.valuesInRow = m_jobs.front ().valuesInRow;
+            job.values.swap (m_jobs.front ().values);
+            job.writeHeader = m_jobs.front ().writeHeader;
+            m_jobs.pop_front ();
+            m_busy = true;
+            hasJob = true;
+          }
+        else if (m_stop)
+          {
+            return;
+          }
+      }
+
+      if (hasJob)
+        {
+          WriteToFile (job.fileName, job.fileMode, job.format, job.valuesInRow, job.values, job.writeHeader);
+
+          {
+            CriticalSection cs (m_mutex);
+            m_busy = false;
+          }
+
+          m_doneCondition.SetCondition (true);
+          m_doneCondition.Broadcast ();
+        }
+      else
+        {
+          m_jobCondition.TimedWait (WAIT_TIMEOUT_NS);
+        }
+    }
+}
+
+#else /* HAVE_PTHREAD_H */
+
+SatOutputFileStreamBackgroundWriter::SatOutputFileStreamBackgroundWriter ()
+{
+  NS_LOG_FUNCTION (this);
+}
+
+SatOutputFileStreamBackgroundWriter::~SatOutputFileStreamBackgroundWriter ()
+{
+  NS_LOG_FUNCTION (this);
+}
+
+void
+SatOutputFileStreamBackgroundWriter::Write (std::string fileName, std::ios::openmode fileMode, Format_t format,
+                                            uint32_t valuesInRow, std::vector<double>& values, bool writeHeader)
+{
+  NS_LOG_FUNCTION (this << fileName << fileMode << format << valuesInRow << values.size () << writeHeader);
+
+  // no writer thread available, write the rows right away
+  WriteToFile (fileName, fileMode, format, valuesInRow, values, writeHeader);
+  values.clear ();
+}
+
+void
+SatOutputFileStreamBackgroundWriter::Wait ()
+{
+  NS_LOG_FUNCTION (this);
+}
+
+#endif /* HAVE_PTHREAD_H */
+
+void
+SatOutputFileStreamBackgroundWriter::WriteToFile (std::string fileName, std::ios::openmode fileMode, Format_t format,
+                                                  uint32_t valuesInRow, const std::vector<double>& values, bool writeHeader)
+{
+  // No logging here, the function is called also from the writer thread
+
+  std::ofstream stream (fileName.c_str (), fileMode);
+
+  NS_ABORT_MSG_UNLESS (stream.is_open (), "SatOutputFileStreamBackgroundWriter::WriteToFile - Unable to open " << fileName);
+
+  if (writeHeader)
+    {
+      WriteBinaryHeader (&stream, valuesInRow);
+    }
+
+  if (!values.empty ())
+    {
+      WriteValues (&stream, format, valuesInRow, values);
+    }
+
+  stream.close ();
+}
+
+void
+SatOutputFileStreamBackgroundWriter::WriteBinaryHeader (std::ofstream* stream, uint32_t valuesInRow)
+{
+  // No logging here, the function is called also from the writer thread
+
+  const char magic[8] = {'S', 'A', 'T', 'T', 'R', 'A', 'C', 'E'};
+  uint32_t version = BINARY_FORMAT_VERSION;
+
+  stream->write (magic, sizeof (magic));
+  stream->write (reinterpret_cast<const char *> (&version), sizeof (version));
+  stream->write (reinterpret_cast<const char *> (&valuesInRow), sizeof (valuesInRow));
+}
+
+void
+SatOutputFileStreamBackgroundWriter::WriteValues (std::ofstream* stream, Format_t format, uint32_t valuesInRow, const std::vector<double>& values)
+{
+  // No logging here, the function is called also from the writer thread
+
+  uint32_t rows = values.size () / valuesInRow;
+
+  switch (format)
+    {
+    case FORMAT_TEXT:
+      {
+        for (uint32_t i = 0; i < rows; i++)
+          {
+            for (uint32_t j = 0; j < valuesInRow; j++ )
+              {
+                if (j + 1 == valuesInRow)
+                  {
+                    *stream << values[i * valuesInRow + j];
+                  }
+                else
+                  {
+                    *stream << values[i * valuesInRow + j] << "\t";
+                  }
+              }
+            *stream << "\n";
+          }
+        break;
+      }
+    case FORMAT_BINARY:
+      {
+        uint32_t blockHeader[2] = { rows, 0 };
+        stream->write (reinterpret_cast<const char *> (blockHeader), sizeof (blockHeader));
+
+        // values are stored column by column within a block
+        std::vector<double> column (rows);
+
+        for (uint32_t j = 0; j < valuesInRow; j++ )
+          {
+            for (uint32_t i = 0; i < rows; i++)
+              {
+                column[i] = values[i * valuesInRow + j];
+              }
+
+            if (rows > 0)
+              {
+                stream->write (reinterpret_cast<const char *> (&column[0]), rows * sizeof (double));
+              }
+          }
+        break;
+      }
+    default:
+      {
+        NS_ABORT_MSG ("SatOutputFileStreamBackgroundWriter::WriteValues - Invalid format.");
+        break;
+      }
+    }
+}
+
+} // namespace ns3
@@ -0,0 +1,215 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2016 Magister Solutions Ltd.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: agent <agent@local>
+ */
+
+#ifndef SAT_OUTPUT_FSTREAM_BACKGROUND_WRITER_H
+#define SAT_OUTPUT_FSTREAM_BACKGROUND_WRITER_H
+
+#include <fstream>
+#include <string>
+#include <vector>
+#include <deque>
+#include "ns3/core-config.h"
+#include "ns3/ptr.h"
+
+#ifdef HAVE_PTHREAD_H
+#include "ns3/system-thread.h"
+#include "ns3/system-mutex.h"
+#include "ns3/system-condition.h"
+#endif /* HAVE_PTHREAD_H */
+
+namespace ns3 {
+
+/**
+ * \ingroup satellite
+ *
+ * \brief Class for writing buffered rows of double values to output files
+ * in a background thread. The class is used as a singleton by all the output
+ * file stream containers, i.e. there is one writer thread per simulation
+ * process. The rows of a file are written in the order they are given to the
+ * writer. A file is opened for each write job and closed after it, thus only
+ * the file of the job being written is open, however many containers there
+ * are.
+ *
+ * The number of pending write jobs is bounded. If the writer thread does not
+ * keep up with the simulation, the simulation waits until there is room for
+ * a new job, thus the memory used by the buffered rows stays bounded.
+ *
+ * If ns-3 is built without thread support, the rows are written in the
+ * simulation thread already when they are given to the writer.
+ *
+ * The streams are written in one of the following formats:
+ * - text: values of a row separated by tabs, one row per line
+ * - binary: a file header followed by blocks of rows. The file header consists
+ *   of an 8 byte identifier "SATTRACE", the format version and the number of
+ *   values in a row (uint32_t each). A block consists of the number of rows
+ *   in the block and a reserved field (uint32_t each) followed by the values
+ *   of the block column by column. All the values are in the byte order of
+ *   the host.
+ */
+class SatOutputFileStreamBackgroundWriter
+{
+public:
+  /**
+   * \brief Format of the written values
+   */
+  typedef enum
+  {
+    FORMAT_TEXT,
+    FORMAT_BINARY
+  } Format_t;
+
+  /**
+   * \brief Version of the binary format
+   */
+  static const uint32_t BINARY_FORMAT_VERSION = 1;
+
+  /**
+   * \brief Constructor
+   */
+  SatOutputFileStreamBackgroundWriter ();
+
+  /**
+   * \brief Destructor. Writes the pending jobs and stops the writer thread.
+   */
+  ~SatOutputFileStreamBackgroundWriter ();
+
+  /**
+   * \brief Give rows to be written to a file in the background. The values
+   * are moved to the writer, i.e. the given vector is empty after the call.
+   * \param fileName Name of the output file
+   * \param fileMode Mode for opening the file, e.g. std::ofstream::app for
+   * appending the rows to the earlier written ones
+   * \param format Format of the written values
+   * \param valuesInRow Number of values in a row
+   * \param values Values of the rows row by row
+   * \param writeHeader Write the binary file header before the rows
+   */
+  void Write (std::string fileName, std::ios::openmode fileMode, Format_t format,
+              uint32_t valuesInRow, std::vector<double>& values, bool writeHeader);
+
+  /**
+   * \brief Wait until all the given rows have been written
+   */
+  void Wait ();
+
+  /**
+   * \brief Write rows to a file in the calling thread
+   * \param fileName Name of the output file
+   * \param fileMode Mode for opening the file
+   * \param format Format of the written values
+   * \param valuesInRow Number of values in a row
+   * \param values Values of the rows row by row
+   * \param writeHeader Write the binary file header before the rows
+   */
+  static void WriteToFile (std::string fileName, std::ios::openmode fileMode, Format_t format,
+                           uint32_t valuesInRow, const std::vector<double>& values, bool writeHeader);
+
+  /**
+   * \brief Write the binary file header to a stream
+   * \param stream Output file stream
+   * \param valuesInRow Number of values in a row
+   */
+  static void WriteBinaryHeader (std::ofstream* stream, uint32_t valuesInRow);
+
+  /**
+   * \brief Write rows to a stream in the calling thread
+   * \param stream Output file stream
+   * \param format Format of the written values
+   * \param valuesInRow Number of values in a row
+   * \param values Values of the rows row by row
+   */
+  static void WriteValues (std::ofstream* stream, Format_t format, uint32_t valuesInRow, const std::vector<double>& values);
+
+private:
+#ifdef HAVE_PTHREAD_H
+  /**
+   * \brief Struct for a write job
+   */
+  typedef struct
+  {
+    std::string fileName;
+    std::ios::openmode fileMode;
+    Format_t format;
+    uint32_t valuesInRow;
+    std::vector<double> values;
+    bool writeHeader;
+  } Job_t;
+
+  /**
+   * \brief Main loop of the writer thread
+   */
+  void Run ();
+
+  /**
+   * \brief Maximum number of pending write jobs
+   */
+  static const uint32_t MAX_PENDING_JOBS = 64;
+
+  /**
+   * \brief Timeout of a wait for a condition in nanoseconds. The waits are
+   * normally ended by the signal of the condition, the timeout only limits
+   * the wait if a signal is missed.
+   */
+  static const uint64_t WAIT_TIMEOUT_NS = 100000000;
+
+  /**
+   * \brief Pending write jobs
+   */
+  std::deque<Job_t> m_jobs;
+
+  /**
+   * \brief Is the writer thread writing a job
+   */
+  bool m_busy;
+
+  /**
+   * \brief Has the writer thread been requested to stop
+   */
+  bool m_stop;
+
+  /**
+   * \brief Writer thread, started when the first job is given
+   */
+  Ptr<SystemThread> m_thread;
+
+  /**
+   * \brief Mutex protecting the jobs and the state flags
+   */
+  SystemMutex m_mutex;
+
+  /**
+   * \brief Condition signaled when a new job is given or the writer thread
+   * is requested to stop. The writer thread resets it before checking the
+   * jobs, so that a wait returns only after a new signal.
+   */
+  SystemCondition m_jobCondition;
+
+  /**
+   * \brief Condition signaled when a job has been written. The simulation
+   * thread resets it before checking the jobs, so that a wait returns only
+   * after a new signal.
+   */
+  SystemCondition m_doneCondition;
+#endif /* HAVE_PTHREAD_H */
+};
+
+} // namespace ns3
+
+#endif /* SAT_OUTPUT_FSTREAM_BACKGROUND_WRITER_H */
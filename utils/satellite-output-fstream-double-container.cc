@@ -22,6 +22,10 @@
 #include "ns3/log.h"
 #include "ns3/abort.h"
 #include "ns3/simulator.h"
+#include "ns3/singleton.h"
+#include "ns3/uinteger.h"
+#include "ns3/boolean.h"
+#include "ns3/enum.h"
 
 NS_LOG_COMPONENT_DEFINE ("SatOutputFileStreamDoubleContainer");
 
@@ -32,14 +36,32 @@ SatOutputFileStreamDoubleContainer::GetTypeId (void)
 {
   static TypeId tid = TypeId ("ns3::SatOutputFileStreamDoubleContainer")
     .SetParent<Object> ()
-    .AddConstructor<SatOutputFileStreamDoubleContainer> ();
+    .AddConstructor<SatOutputFileStreamDoubleContainer> ()
+    .AddAttribute ("BufferSize",
+                   "Maximum number of rows buffered before writing them to the file",
+                   UintegerValue (4096),
+                   MakeUintegerAccessor (&SatOutputFileStreamDoubleContainer::m_bufferSize),
+                   MakeUintegerChecker<uint32_t> (1))
+    .AddAttribute ("OutputFormat",
+                   "Format of the output file",
+                   EnumValue (SatOutputFileStreamBackgroundWriter::FORMAT_TEXT),
+                   MakeEnumAccessor (&SatOutputFileStreamDoubleContainer::m_outputFormat),
+                   MakeEnumChecker (SatOutputFileStreamBackgroundWriter::FORMAT_TEXT, "Text",
+                                    SatOutputFileStreamBackgroundWriter::FORMAT_BINARY, "Binary"))
+    .AddAttribute ("BackgroundWriting",
+                   "Write the buffered rows to the file in a background thread",
+                   BooleanValue (true),
+                   MakeBooleanAccessor (&SatOutputFileStreamDoubleContainer::m_backgroundWriting),
+                   MakeBooleanChecker ());
   return tid;
 }
 
 SatOutputFileStreamDoubleContainer::SatOutputFileStreamDoubleContainer (std::string filename, std::ios::openmode filemode, uint32_t valuesInRow)
-  : m_outputFileStreamWrapper (),
-    m_outputFileStream (),
-    m_container (),
+  : m_fileCreated (false),
+    m_buffer (),
+    m_bufferSize (4096),
+    m_outputFormat (SatOutputFileStreamBackgroundWriter::FORMAT_TEXT),
+    m_backgroundWriting (true),
     m_fileName (filename),
     m_fileMode (filemode),
     m_valuesInRow (valuesInRow),
@@ -56,9 +78,11 @@ SatOutputFileStreamDoubleContainer::SatOutputFileStreamDoubleContainer (std::str
 }
 
 SatOutputFileStreamDoubleContainer::SatOutputFileStreamDoubleContainer ()
-  : m_outputFileStreamWrapper (),
-    m_outputFileStream (),
-    m_container (),
+  : m_fileCreated (),
+    m_buffer (),
+    m_bufferSize (),
+    m_outputFormat (),
+    m_backgroundWriting (),
     m_fileName (),
     m_fileMode (),
     m_valuesInRow (),
@@ -91,30 +115,12 @@ SatOutputFileStreamDoubleContainer::WriteContainerToFile ()
 {
   NS_LOG_FUNCTION (this);
 
-  OpenStream ();
+  // also creates the file, if no rows have been written
+  FlushBuffer ();
 
-  if (m_outputFileStream->is_open ())
+  if (m_backgroundWriting)
     {
-      for (uint32_t i = 0; i < m_container.size (); i++)
-        {
-          for (uint32_t j = 0; j < m_valuesInRow; j++ )
-            {
-              if (j + 1 == m_valuesInRow)
-                {
-                  *m_outputFileStream << m_container[i].at (j);
-                }
-              else
-                {
-                  *m_outputFileStream << m_container[i].at (j) << "\t";
-                }
-            }
-          *m_outputFileStream << std::endl;
-        }
-      m_outputFileStream->close ();
-    }
-  else
-    {
-      NS_ABORT_MSG ("Output stream is not valid for writing.");
+      Singleton<SatOutputFileStreamBackgroundWriter>::Get ()->Wait ();
     }
 
   if (m_printFigure)
@@ -125,6 +131,46 @@ SatOutputFileStreamDoubleContainer::WriteContainerToFile ()
   Reset ();
 }
 
+void
+SatOutputFileStreamDoubleContainer::FlushBuffer ()
+{
+  NS_LOG_FUNCTION (this);
+
+  if (m_buffer.empty () && m_fileCreated)
+    {
+      return;
+    }
+
+  // The file is opened for each flush and closed after it, instead of
+  // keeping it open, so that the number of open files does not grow with
+  // the number of containers. The first flush creates the file with the
+  // given file mode, the later ones append to it.
+  std::ios::openmode fileMode = m_fileCreated ? (std::ofstream::out | std::ofstream::app) : m_fileMode;
+  bool writeHeader = false;
+
+  if (m_outputFormat == SatOutputFileStreamBackgroundWriter::FORMAT_BINARY)
+    {
+      fileMode |= std::ofstream::binary;
+      writeHeader = !m_fileCreated;
+    }
+
+  m_fileCreated = true;
+
+  if (m_backgroundWriting)
+    {
+      // the buffer is moved to the writer
+      Singleton<SatOutputFileStreamBackgroundWriter>::Get ()->Write (GetOutputFileName (), fileMode, m_outputFormat,
+                                                                     m_valuesInRow, m_buffer, writeHeader);
+      m_buffer.reserve (m_bufferSize * m_valuesInRow);
+    }
+  else
+    {
+      SatOutputFileStreamBackgroundWriter::WriteToFile (GetOutputFileName (), fileMode, m_outputFormat,
+                                                        m_valuesInRow, m_buffer, writeHeader);
+      m_buffer.clear ();
+    }
+}
+
 void
 SatOutputFileStreamDoubleContainer::PrintFigure ()
 {
@@ -150,7 +196,7 @@ SatOutputFileStreamDoubleContainer::PrintFigure ()
 }
 
 void
-SatOutputFileStreamDoubleContainer::AddToContainer (std::vector<double> newItem)
+SatOutputFileStreamDoubleContainer::AddToContainer (const std::vector<double>& newItem)
 {
   NS_LOG_FUNCTION (this);
 
@@ -159,16 +205,76 @@ SatOutputFileStreamDoubleContainer::AddToContainer (std::vector<double> newItem)
       NS_FATAL_ERROR ("SatOutputFileStreamDoubleContainer::AddToContainer - Invalid vector size");
     }
 
-  m_container.push_back (newItem);
+  m_buffer.insert (m_buffer.end (), newItem.begin (), newItem.end ());
+
+  if (m_buffer.size () >= m_bufferSize * m_valuesInRow)
+    {
+      FlushBuffer ();
+    }
+}
+
+std::string
+SatOutputFileStreamDoubleContainer::GetOutputFileName () const
+{
+  if (m_outputFormat == SatOutputFileStreamBackgroundWriter::FORMAT_BINARY)
+    {
+      return m_fileName + ".bin";
+    }
+
+  return m_fileName;
 }
 
 void
-SatOutputFileStreamDoubleContainer::OpenStream ()
+SatOutputFileStreamDoubleContainer::ReadValuesFromFile (std::vector<double>& values)
 {
   NS_LOG_FUNCTION (this);
 
-  m_outputFileStreamWrapper = new SatOutputFileStreamWrapper (m_fileName,m_fileMode);
-  m_outputFileStream = m_outputFileStreamWrapper->GetStream ();
+  values.clear ();
+
+  if (m_outputFormat == SatOutputFileStreamBackgroundWriter::FORMAT_BINARY)
+    {
+      std::ifstream ifs (GetOutputFileName ().c_str (), std::ifstream::in | std::ifstream::binary);
+      char magic[8];
+      uint32_t header[2];
+
+      ifs.read (magic, sizeof (magic));
+      ifs.read (reinterpret_cast<char *> (header), sizeof (header));
+
+      uint32_t blockHeader[2];
+      ifs.read (reinterpret_cast<char *> (blockHeader), sizeof (blockHeader));
+
+      while (ifs.good ())
+        {
+          uint32_t rows = blockHeader[0];
+          std::vector<double> block (rows * m_valuesInRow);
+
+          if (rows > 0)
+            {
+              ifs.read (reinterpret_cast<char *> (&block[0]), block.size () * sizeof (double));
+            }
+
+          // blocks are stored column by column
+          for (uint32_t i = 0; i < rows; i++)
+            {
+              for (uint32_t j = 0; j < m_valuesInRow; j++)
+                {
+                  values.push_back (block[j * rows + i]);
+                }
+            }
+
+          ifs.read (reinterpret_cast<char *> (blockHeader), sizeof (blockHeader));
+        }
+    }
+  else
+    {
+      std::ifstream ifs (GetOutputFileName ().c_str (), std::ifstream::in);
+      double value;
+
+      while (ifs >> value)
+        {
+          values.push_back (value);
+        }
+    }
 }
 
 void
@@ -185,12 +291,12 @@ SatOutputFileStreamDoubleContainer::ResetStream ()
 {
   NS_LOG_FUNCTION (this);
 
-  if (m_outputFileStreamWrapper != NULL)
+  if (m_fileCreated && m_backgroundWriting)
     {
-      delete m_outputFileStreamWrapper;
-      m_outputFileStreamWrapper = 0;
+      // the file may still have pending writes
+      Singleton<SatOutputFileStreamBackgroundWriter>::Get ()->Wait ();
     }
-  m_outputFileStream = 0;
+  m_fileCreated = false;
 
   m_fileName = "";
   m_fileMode = std::ofstream::out;
@@ -201,18 +307,7 @@ SatOutputFileStreamDoubleContainer::ClearContainer ()
 {
   NS_LOG_FUNCTION (this);
 
-  if (!m_container.empty ())
-    {
-      for (uint32_t i = 0; i < m_container.size (); i++)
-        {
-          if (!m_container[i].empty ())
-            {
-              m_container[i].clear ();
-            }
-        }
-      m_container.clear ();
-    }
-
+  m_buffer.clear ();
   m_valuesInRow = 0;
 }
 
@@ -225,15 +320,18 @@ SatOutputFileStreamDoubleContainer::GetGnuplotDataset ()
   ret.SetTitle (m_title);
   ret.SetStyle (m_style);
 
-  if (!m_container.empty ())
+  std::vector<double> values;
+  ReadValuesFromFile (values);
+
+  if (!values.empty ())
     {
       switch (m_valuesInRow)
         {
         case 2:
           {
-            for (uint32_t i = 0; i < m_container.size (); i++)
+            for (uint32_t i = 0; i + 1 < values.size (); i += 2)
               {
-                ret.Add (m_container[i].at (0), ConvertValue (m_container[i].at (1)));
+                ret.Add (values[i], ConvertValue (values[i + 1]));
               }
             break;
           }
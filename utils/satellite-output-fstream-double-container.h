@@ -23,7 +23,7 @@
 
 #include <fstream>
 #include "ns3/object.h"
-#include "satellite-output-fstream-wrapper.h"
+#include "satellite-output-fstream-background-writer.h"
 #include <ns3/gnuplot.h>
 
 namespace ns3 {
@@ -34,6 +34,13 @@ namespace ns3 {
  * \brief Class for output file stream container for double values.
  * The class implements storing the values and writing the stored
  * values into a file. A figure output in two dimensions is also supported.
+ *
+ * The values are stored in a bounded buffer (attribute BufferSize), which is
+ * written to the file whenever it gets full, by default in a background
+ * thread. The file is kept open only while the buffer is written to it. Thus, the memory used by the container does not grow with the
+ * simulation length. The values are written either as tab-separated text or
+ * in the binary format of SatOutputFileStreamBackgroundWriter (attribute
+ * OutputFormat), in which case the file name has .bin extension.
  */
 class SatOutputFileStreamDoubleContainer : public Object
 {
@@ -77,7 +84,7 @@ public:
   /**
    * \brief Function for adding the values to container
    */
-  void AddToContainer (std::vector<double> newItem);
+  void AddToContainer (const std::vector<double>& newItem);
 
   /**
    * \brief Do needed dispose actions
@@ -117,9 +124,15 @@ private:
   void ClearContainer ();
 
   /**
-   * \brief Function for opening the output file stream
+   * \brief Function for writing the buffered values to the file
+   */
+  void FlushBuffer ();
+
+  /**
+   * \brief Function for reading the written values back from the file
+   * \param values Values of the rows row by row
    */
-  void OpenStream ();
+  void ReadValuesFromFile (std::vector<double>& values);
 
   /**
    * \brief Function for printing the container contents into a figure
@@ -134,11 +147,17 @@ private:
   double ConvertValue (double value);
 
   /**
-   * \brief Function for creating Gnuplot datasets
+   * \brief Function for creating Gnuplot datasets from the written values
    * \return dataset
    */
   Gnuplot2dDataset GetGnuplotDataset ();
 
+  /**
+   * \brief Function for getting the name of the output file
+   * \return output file name
+   */
+  std::string GetOutputFileName () const;
+
   /**
    * \brief Function for creating Gnuplots
    * \return Gnuplot
@@ -146,19 +165,29 @@ private:
   Gnuplot GetGnuplot ();
 
   /**
-   * \brief Pointer to output file stream wrapper
+   * \brief Has the output file been created by the first flush
+   */
+  bool m_fileCreated;
+
+  /**
+   * \brief Buffer for the values not yet written, row by row
+   */
+  std::vector<double> m_buffer;
+
+  /**
+   * \brief Maximum number of buffered rows
    */
-  SatOutputFileStreamWrapper* m_outputFileStreamWrapper;
+  uint32_t m_bufferSize;
 
   /**
-   * \brief Pointer to output file stream
+   * \brief Format of the output file
    */
-  std::ofstream* m_outputFileStream;
+  SatOutputFileStreamBackgroundWriter::Format_t m_outputFormat;
 
   /**
-   * \brief Container for value rows
+   * \brief Write the buffered values in a background thread
    */
-  std::vector<std::vector<double> > m_container;
+  bool m_backgroundWriting;
 
   /**
    * \brief File name